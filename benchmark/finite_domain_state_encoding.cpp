@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/finite_domain_state_encoding.hpp"
+#include "mimir/search/grounders/lifted.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+
+using namespace mimir::formalism;
+using namespace mimir::search;
+
+namespace mimir::benchmarks
+{
+
+static const std::vector<std::string> DOMAINS = { "blocks_4", "childsnack", "grid", "gripper", "logistics", "miconic", "rovers", "satellite", "spanner" };
+
+/// @brief Collect the first `max_num_states` states reached in breadth-first order.
+static StateList collect_reachable_states(const SearchContext& context, size_t max_num_states)
+{
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    auto result = StateList {};
+    auto queue = std::deque<State> {};
+    auto applicable_actions = GroundActionList {};
+
+    queue.push_back(state_repository.get_or_create_initial_state().first);
+
+    while (!queue.empty() && result.size() < max_num_states)
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+        result.push_back(state);
+
+        applicable_actions.clear();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            applicable_actions.push_back(action);
+        }
+
+        for (const auto& action : applicable_actions)
+        {
+            const auto num_states = state_repository.get_state_count();
+            const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, 0.);
+            if (state_repository.get_state_count() > num_states)
+            {
+                queue.push_back(successor_state);
+            }
+        }
+    }
+
+    return result;
+}
+
+/// @brief Insert the reachable states of the domain `DOMAINS[state.range(0)]` into a `FiniteDomainStateSet`,
+/// and report the bytes per state of the packed states in the state repository, of a dense bitset, and of the finite-domain encoding.
+static void BM_FiniteDomainStateSetInsert(benchmark::State& state)
+{
+    const auto& domain_name = DOMAINS.at(state.range(0));
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl"));
+    const auto grounder = LiftedGrounder(problem);
+    const auto encoding = FiniteDomainStateEncodingImpl::create(grounder);
+    const auto context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    const auto states = collect_reachable_states(context, 100000);
+
+    auto num_bytes_for_finite_domain_state_set = size_t(0);
+    for (auto _ : state)
+    {
+        auto state_set = FiniteDomainStateSet(encoding);
+        for (const auto& element : states)
+        {
+            benchmark::DoNotOptimize(state_set.insert(element.get_atoms<FluentTag>()));
+        }
+        num_bytes_for_finite_domain_state_set = state_set.get_estimated_memory_usage_in_bytes();
+    }
+
+    const auto num_states = static_cast<double>(states.size());
+    const auto num_fluent_atoms = static_cast<size_t>(std::ranges::distance(problem->get_repositories().get_ground_atoms<FluentTag>()));
+    // The valla tables of the problem and the entries of the state map.
+    const auto num_bytes_for_packed_states = problem->get_index_tree_table().mem_usage() + problem->get_double_leaf_table().mem_usage()
+                                             + states.size() * sizeof(PackedStateImplMap::value_type);
+
+    state.SetLabel(domain_name);
+    state.counters["num_states"] = num_states;
+    state.counters["num_fluent_atoms"] = num_fluent_atoms;
+    state.counters["num_variables"] = encoding->get_variables().size();
+    state.counters["bytes_per_state_packed"] = num_bytes_for_packed_states / num_states;
+    state.counters["bytes_per_state_bitset"] = ((num_fluent_atoms + 63) / 64) * sizeof(uint64_t);
+    state.counters["bytes_per_state_finite_domain"] = encoding->get_num_bytes_per_state();
+    state.counters["bytes_per_state_finite_domain_set"] = num_bytes_for_finite_domain_state_set / num_states;
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+}
+
+BENCHMARK(mimir::benchmarks::BM_FiniteDomainStateSetInsert)->DenseRange(0, 8)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
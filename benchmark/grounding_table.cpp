@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/action.hpp"
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/grounding_table.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/grounders/lifted.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+using namespace mimir::formalism;
+using namespace mimir::search;
+
+namespace mimir::benchmarks
+{
+
+static const std::vector<std::string> DOMAINS = { "blocks_4", "childsnack", "grid", "gripper", "logistics", "miconic", "rovers", "satellite", "spanner" };
+
+/// @brief Look up the ground actions of the domain `DOMAINS[state.range(0)]` by their bindings in grounding tables,
+/// which rank the bindings if `state.range(1)` is 1 and hash them otherwise. The time per item is the lookup cost per ground action.
+/// The counters report the estimated memory usage of the tables and how many of them still rank their bindings after all insertions.
+static void BM_GroundingTableFind(benchmark::State& state)
+{
+    const auto& domain_name = DOMAINS.at(state.range(0));
+    const auto is_ranked = static_cast<bool>(state.range(1));
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl"));
+    const auto ground_actions = LiftedGrounder(problem).create_ground_actions();
+
+    const auto& actions = problem->get_domain()->get_actions();
+    auto tables = std::vector<GroundingTable<GroundAction>> {};
+    for (const auto& action : actions)
+    {
+        const auto max_num_ranked_bindings = is_ranked ? GroundingTable<GroundAction>::MAX_NUM_RANKED_BINDINGS : 0;
+        tables.emplace_back(action->get_parameters(), problem->get_problem_and_domain_objects(), max_num_ranked_bindings);
+    }
+    for (const auto& ground_action : ground_actions)
+    {
+        tables.at(ground_action->get_action()->get_index()).insert(ground_action->get_objects(), ground_action);
+    }
+    auto num_ranked_tables = size_t(0);
+    auto num_bytes = size_t(0);
+    for (const auto& table : tables)
+    {
+        num_ranked_tables += table.is_ranked();
+        num_bytes += table.get_estimated_memory_usage_in_bytes();
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& ground_action : ground_actions)
+        {
+            benchmark::DoNotOptimize(tables[ground_action->get_action()->get_index()].find(ground_action->get_objects()));
+        }
+    }
+
+    state.SetLabel(domain_name + (is_ranked ? "/ranked" : "/hashed"));
+    state.counters["num_ground_actions"] = ground_actions.size();
+    state.counters["num_ranked_tables"] = num_ranked_tables;
+    state.counters["num_bytes"] = num_bytes;
+    state.counters["num_bytes_per_ground_action"] = static_cast<double>(num_bytes) / std::max(ground_actions.size(), size_t(1));
+    state.SetItemsProcessed(state.iterations() * ground_actions.size());
+}
+
+}
+
+BENCHMARK(mimir::benchmarks::BM_GroundingTableFind)->ArgsProduct({ benchmark::CreateDenseRange(0, 8, 1), { 0, 1 } })->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
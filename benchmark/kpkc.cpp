@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/action.hpp"
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+
+using namespace mimir::formalism;
+using namespace mimir::search;
+
+namespace mimir::benchmarks
+{
+
+/// @brief Domains with action schemas of high arity, whose bindings are enumerated as k-cliques in the consistency graphs.
+static const std::vector<std::string> DOMAINS = { "airport", "childsnack", "driverlog", "logistics", "rovers", "satellite", "spanner", "transport" };
+
+/// @brief Collect the first `max_num_states` states reached in breadth-first order.
+static StateList collect_reachable_states(const SearchContext& context, size_t max_num_states)
+{
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    auto result = StateList {};
+    auto queue = std::deque<State> {};
+    auto applicable_actions = GroundActionList {};
+
+    queue.push_back(state_repository.get_or_create_initial_state().first);
+
+    while (!queue.empty() && result.size() < max_num_states)
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+        result.push_back(state);
+
+        applicable_actions.clear();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            applicable_actions.push_back(action);
+        }
+
+        for (const auto& action : applicable_actions)
+        {
+            const auto num_states = state_repository.get_state_count();
+            const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, 0.);
+            if (state_repository.get_state_count() > num_states)
+            {
+                queue.push_back(successor_state);
+            }
+        }
+    }
+
+    return result;
+}
+
+/// @brief Generate the applicable actions of the reachable states of the domain `DOMAINS[state.range(0)]` with the k-clique enumeration.
+///
+/// The states are collected with the same search context beforehand, so the ground actions already exist and the time is dominated by the enumeration.
+static void BM_KPKCApplicableActions(benchmark::State& state)
+{
+    const auto& domain_name = DOMAINS.at(state.range(0));
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl"));
+    const auto context = SearchContextImpl::create(
+        problem,
+        SearchContextImpl::Options(SearchContextImpl::LiftedOptions(SearchContextImpl::LiftedOptions::KPKCOptions(SearchContextImpl::SymmetryPruning::OFF))));
+    const auto states = collect_reachable_states(context, 10000);
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+
+    auto num_applicable_actions = size_t(0);
+    for (auto _ : state)
+    {
+        num_applicable_actions = 0;
+        for (const auto& element : states)
+        {
+            for (const auto& action : applicable_action_generator.create_applicable_action_generator(element))
+            {
+                benchmark::DoNotOptimize(action);
+                ++num_applicable_actions;
+            }
+        }
+    }
+
+    auto max_arity = size_t(0);
+    for (const auto& action : problem->get_domain()->get_actions())
+    {
+        max_arity = std::max(max_arity, action->get_arity());
+    }
+
+    state.SetLabel(domain_name);
+    state.counters["num_states"] = states.size();
+    state.counters["num_applicable_actions"] = num_applicable_actions;
+    state.counters["max_action_arity"] = max_arity;
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+}
+
+BENCHMARK(mimir::benchmarks::BM_KPKCApplicableActions)->DenseRange(0, 7)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
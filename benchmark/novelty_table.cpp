@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/algorithms/iw/novelty_table.hpp"
+#include "mimir/search/algorithms/iw/tuple_index_generators.hpp"
+#include "mimir/search/algorithms/iw/tuple_index_mapper.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace mimir::formalism;
+using namespace mimir::search;
+
+namespace mimir::benchmarks
+{
+
+static const std::vector<std::string> DOMAINS = { "blocks_4", "childsnack", "grid", "gripper", "logistics", "miconic", "rovers", "satellite", "spanner" };
+
+/// @brief Collect the state pairs of the transitions of the first `max_num_states` states reached in breadth-first order.
+static std::vector<std::pair<State, State>> collect_state_pairs(const SearchContext& context, size_t max_num_states)
+{
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    auto states = StateList { state_repository.get_or_create_initial_state().first };
+    auto result = std::vector<std::pair<State, State>> {};
+    auto applicable_actions = GroundActionList {};
+
+    for (size_t i = 0; i < states.size() && i < max_num_states; ++i)
+    {
+        const auto state = states[i];
+
+        applicable_actions.clear();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            applicable_actions.push_back(action);
+        }
+
+        for (const auto& action : applicable_actions)
+        {
+            const auto num_states = state_repository.get_state_count();
+            const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, 0.);
+            result.emplace_back(state, successor_state);
+            if (state_repository.get_state_count() > num_states)
+            {
+                states.push_back(successor_state);
+            }
+        }
+    }
+
+    return result;
+}
+
+static std::pair<SearchContext, std::vector<std::pair<State, State>>> create_state_pairs(const std::string& domain_name)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl"));
+    const auto context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    auto state_pairs = collect_state_pairs(context, 10000);
+    return { context, std::move(state_pairs) };
+}
+
+/// @brief Test the novelty of the state pairs of the domain `DOMAINS[state.range(0)]` with a `DynamicNoveltyTable` of arity `state.range(1)`,
+/// which uses word-parallel updates for arity one and two.
+static void BM_DynamicNoveltyTableStatePairs(benchmark::State& state)
+{
+    const auto& domain_name = DOMAINS.at(state.range(0));
+    const auto arity = static_cast<size_t>(state.range(1));
+    const auto [context, state_pairs] = create_state_pairs(domain_name);
+    const auto num_atoms = static_cast<size_t>(std::ranges::distance(context->get_problem()->get_repositories().get_ground_atoms<FluentTag>()));
+
+    for (auto _ : state)
+    {
+        auto novelty_table = iw::DynamicNoveltyTable(arity, num_atoms);
+        for (const auto& [element, successor_element] : state_pairs)
+        {
+            benchmark::DoNotOptimize(novelty_table.test_novelty_and_update_table(element, successor_element));
+        }
+    }
+
+    state.SetLabel(domain_name);
+    state.SetItemsProcessed(state.iterations() * state_pairs.size());
+}
+
+/// @brief Test the novelty of the same state pairs by enumerating tuple indices with the generic `StatePairTupleIndexGenerator`.
+static void BM_StatePairTupleIndexGenerator(benchmark::State& state)
+{
+    const auto& domain_name = DOMAINS.at(state.range(0));
+    const auto arity = static_cast<size_t>(state.range(1));
+    const auto [context, state_pairs] = create_state_pairs(domain_name);
+    const auto num_atoms = static_cast<size_t>(std::ranges::distance(context->get_problem()->get_repositories().get_ground_atoms<FluentTag>()));
+
+    const auto tuple_index_mapper = iw::TupleIndexMapper(arity, num_atoms);
+    auto generator = iw::StatePairTupleIndexGenerator(&tuple_index_mapper);
+
+    for (auto _ : state)
+    {
+        auto table = std::vector<bool>(tuple_index_mapper.get_max_tuple_index() + 1, false);
+        for (const auto& [element, successor_element] : state_pairs)
+        {
+            auto is_novel = false;
+            for (auto it = generator.begin(element, successor_element); it != generator.end(); ++it)
+            {
+                is_novel |= !table[*it];
+                table[*it] = true;
+            }
+            benchmark::DoNotOptimize(is_novel);
+        }
+    }
+
+    state.SetLabel(domain_name);
+    state.SetItemsProcessed(state.iterations() * state_pairs.size());
+}
+
+}
+
+BENCHMARK(mimir::benchmarks::BM_DynamicNoveltyTableStatePairs)->ArgsProduct({ benchmark::CreateDenseRange(0, 8, 1), { 1, 2 } })->Unit(benchmark::kMillisecond);
+BENCHMARK(mimir::benchmarks::BM_StatePairTupleIndexGenerator)->ArgsProduct({ benchmark::CreateDenseRange(0, 8, 1), { 1, 2 } })->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
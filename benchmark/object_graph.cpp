@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/datasets/object_graph.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/graphs/algorithms/color_refinement.hpp"
+#include "mimir/graphs/algorithms/nauty.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace mimir::datasets;
+using namespace mimir::formalism;
+using namespace mimir::search;
+
+namespace mimir::benchmarks
+{
+
+static const std::vector<std::string> DOMAINS = { "blocks_4", "gripper" };
+
+/// @brief Collect the successor states in the order in which a breadth-first search generates them,
+/// i.e., the successors of the same parent are consecutive, until `max_num_states` states were reached.
+static StateList collect_generated_states(const SearchContext& context, size_t max_num_states)
+{
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    auto result = StateList {};
+    auto queue = std::deque<State> {};
+    auto successors = SuccessorBatch();
+
+    queue.push_back(state_repository.get_or_create_initial_state().first);
+    auto next_state_index = queue.front().get_index() + 1;  ///< New states get consecutive indices.
+
+    while (!queue.empty() && state_repository.get_state_count() < max_num_states)
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+
+        state_repository.expand(state, 0., applicable_action_generator, successors);
+
+        for (const auto& [action, successor_state, successor_state_metric_value] : successors)
+        {
+            result.push_back(successor_state);
+            if (successor_state.get_index() == next_state_index)
+            {
+                ++next_state_index;
+                queue.push_back(successor_state);
+            }
+        }
+    }
+
+    return result;
+}
+
+/// @brief Compute the certificates of the generated states of the domain `DOMAINS[state.range(0)]`
+/// with nauty if `state.range(1)` is 0, and with color refinement otherwise, where the object graphs are created from scratch.
+static void BM_ObjectGraphCertificatesFromScratch(benchmark::State& state)
+{
+    const auto& domain_name = DOMAINS.at(state.range(0));
+    const auto use_nauty = (state.range(1) == 0);
+    const auto context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                                   fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl"));
+    const auto states = collect_generated_states(context, 10000);
+
+    for (auto _ : state)
+    {
+        for (const auto& element : states)
+        {
+            const auto object_graph = create_object_graph(element, *context->get_problem());
+            if (use_nauty)
+            {
+                benchmark::DoNotOptimize(graphs::nauty::SparseGraph(object_graph).canonize());
+            }
+            else
+            {
+                benchmark::DoNotOptimize(graphs::color_refinement::compute_certificate(object_graph));
+            }
+        }
+    }
+
+    state.SetLabel(domain_name + (use_nauty ? "/GI" : "/WL1"));
+    state.counters["num_certificates"] = states.size();
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+/// @brief Same as `BM_ObjectGraphCertificatesFromScratch`, but the object graphs are patched by an `ObjectGraphBuilder`.
+static void BM_ObjectGraphCertificatesIncremental(benchmark::State& state)
+{
+    const auto& domain_name = DOMAINS.at(state.range(0));
+    const auto use_nauty = (state.range(1) == 0);
+    const auto context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                                   fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl"));
+    const auto states = collect_generated_states(context, 10000);
+
+    auto builder = ObjectGraphBuilder(context->get_problem());
+
+    for (auto _ : state)
+    {
+        for (const auto& element : states)
+        {
+            builder.update(element);
+            if (use_nauty)
+            {
+                benchmark::DoNotOptimize(builder.create_nauty_graph().canonize());
+            }
+            else
+            {
+                benchmark::DoNotOptimize(graphs::color_refinement::compute_certificate(builder.get_graph()));
+            }
+        }
+    }
+
+    state.SetLabel(domain_name + (use_nauty ? "/GI" : "/WL1"));
+    state.counters["num_certificates"] = states.size();
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+}
+
+BENCHMARK(mimir::benchmarks::BM_ObjectGraphCertificatesFromScratch)->ArgsProduct({ { 0, 1 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+BENCHMARK(mimir::benchmarks::BM_ObjectGraphCertificatesIncremental)->ArgsProduct({ { 0, 1 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/openlists/bucket.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/openlists/radix_heap.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+
+using namespace mimir::search;
+
+namespace mimir::benchmarks
+{
+
+/// @brief Mimics the 24 byte queue entry of eager A*.
+struct QueueEntry
+{
+    using KeyType = std::pair<double, uint8_t>;
+    using ItemType = std::pair<double, const void*>;
+
+    double f_value;
+    const void* packed_state;
+    uint8_t status;
+
+    KeyType get_key() const { return std::make_pair(f_value, status); }
+    ItemType get_item() const { return std::make_pair(f_value, packed_state); }
+    double get_bucket() const { return f_value * 8 + status; }
+};
+
+/// @brief Simulate an A* search on a unit-cost task: every removed entry generates `state.range(0)` successors
+/// whose f-value increases by at most `state.range(1)`, until 1M entries have been inserted.
+template<typename Queue>
+static void BM_OpenList(benchmark::State& state)
+{
+    const auto branching_factor = static_cast<size_t>(state.range(0));
+    const auto max_f_value_increase = static_cast<uint32_t>(state.range(1));
+    constexpr size_t num_insertions = 1000000;
+
+    for (auto _ : state)
+    {
+        auto rng = std::mt19937(42);
+        auto distribution = std::uniform_int_distribution<uint32_t>(0, max_f_value_increase);
+        auto queue = Queue();
+        auto num_inserted = size_t(1);
+        queue.insert(QueueEntry { 0., nullptr, 3 });
+
+        while (!queue.empty())
+        {
+            const auto [f_value, packed_state] = queue.top();
+            queue.pop();
+
+            for (size_t i = 0; i < branching_factor && num_inserted < num_insertions; ++i, ++num_inserted)
+            {
+                queue.insert(QueueEntry { f_value + distribution(rng), packed_state, 3 });
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_insertions);
+}
+
+}
+
+BENCHMARK(mimir::benchmarks::BM_OpenList<PriorityQueue<mimir::benchmarks::QueueEntry>>)
+    ->ArgsProduct({ { 2, 8 }, { 1, 100 } })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(mimir::benchmarks::BM_OpenList<BucketOpenList<mimir::benchmarks::QueueEntry>>)
+    ->ArgsProduct({ { 2, 8 }, { 1, 100 } })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(mimir::benchmarks::BM_OpenList<RadixHeapOpenList<mimir::benchmarks::QueueEntry>>)
+    ->ArgsProduct({ { 2, 8 }, { 1, 100 } })
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
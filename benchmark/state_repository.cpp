@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <thread>
+
+using namespace mimir::formalism;
+using namespace mimir::search;
+
+namespace mimir::benchmarks
+{
+
+using StateContent = std::pair<GroundAtomList<FluentTag>, FlatDoubleList>;
+
+/// @brief Collect the fluent atoms and numeric variables of the first `max_num_states` states reached in breadth-first order.
+static std::vector<StateContent> collect_reachable_states(const SearchContext& context, size_t max_num_states)
+{
+    auto& problem = *context->get_problem();
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    auto result = std::vector<StateContent> {};
+    auto queue = std::deque<State> {};
+    auto applicable_actions = GroundActionList {};
+
+    const auto [initial_state, initial_state_metric_value] = state_repository.get_or_create_initial_state();
+    queue.push_back(initial_state);
+
+    while (!queue.empty() && result.size() < max_num_states)
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+
+        result.emplace_back(problem.get_repositories().get_ground_atoms_from_indices<FluentTag>(state.get_atoms<FluentTag>()), state.get_numeric_variables());
+
+        applicable_actions.clear();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            applicable_actions.push_back(action);
+        }
+
+        for (const auto& action : applicable_actions)
+        {
+            const auto num_states = state_repository.get_state_count();
+            const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, 0.);
+            if (state_repository.get_state_count() > num_states)
+            {
+                queue.push_back(successor_state);
+            }
+        }
+    }
+
+    return result;
+}
+
+static const std::vector<StateContent>& get_benchmark_states(const SearchContext& context)
+{
+    static const auto states = collect_reachable_states(context, 100000);
+    return states;
+}
+
+static const SearchContext& get_benchmark_context()
+{
+    static const auto context = SearchContextImpl::create(ProblemImpl::create(fs::path(std::string(DATA_DIR) + "sokoban/domain.pddl"),
+                                                                              fs::path(std::string(DATA_DIR) + "sokoban/p68.pddl")),
+                                                          SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    return context;
+}
+
+/// @brief Insert the same set of states into a fresh repository, distributed over `state.range(1)` threads.
+/// The valla tables are shared by all repositories of the problem, hence iterations after the first one measure
+/// the interning of states into the state map together with the lookup of already existing valla slots.
+static void BM_StateRepositoryInsert(benchmark::State& state)
+{
+    const auto thread_safe = static_cast<bool>(state.range(0));
+    const auto num_threads = static_cast<size_t>(state.range(1));
+
+    const auto& context = get_benchmark_context();
+    const auto& states = get_benchmark_states(context);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto options = StateRepositoryImpl::Options();
+        options.thread_safe = thread_safe;
+        auto state_repository = StateRepositoryImpl::create(context->get_state_repository()->get_axiom_evaluator(), options);
+        state.ResumeTiming();
+
+        auto threads = std::vector<std::thread> {};
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back(
+                [&, t]()
+                {
+                    for (size_t i = t; i < states.size(); i += num_threads)
+                    {
+                        const auto& [atoms, numeric_variables] = states[i];
+                        benchmark::DoNotOptimize(state_repository->get_or_create_state(atoms, numeric_variables));
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        benchmark::DoNotOptimize(state_repository->get_state_count());
+    }
+
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+static const std::vector<std::string> EXPAND_DOMAINS = { "visitall", "logistics" };
+
+/// @brief Expand the first 10000 states in breadth-first order of the domain `EXPAND_DOMAINS[state.range(0)]` in a fresh repository,
+/// using `expand` if `state.range(1)` is nonzero, and successive calls to `get_or_create_successor_state` otherwise.
+static void BM_StateRepositoryExpand(benchmark::State& state)
+{
+    const auto& domain_name = EXPAND_DOMAINS.at(state.range(0));
+    const auto batched = static_cast<bool>(state.range(1));
+    const size_t max_num_expansions = 10000;
+
+    const auto context = SearchContextImpl::create(ProblemImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                                                       fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl")),
+                                                   SearchContextImpl::Options(SearchContextImpl::GroundedOptions()));
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+
+    auto successors = SuccessorBatch();
+    auto applicable_actions = GroundActionList {};
+    auto num_expansions = size_t(0);
+    auto num_generations = size_t(0);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto state_repository = StateRepositoryImpl::create(context->get_state_repository()->get_axiom_evaluator());
+        auto queue = std::deque<State> {};
+        queue.push_back(state_repository->get_or_create_initial_state().first);
+        num_expansions = 0;
+        num_generations = 0;
+        state.ResumeTiming();
+
+        while (!queue.empty() && num_expansions < max_num_expansions)
+        {
+            const auto current_state = queue.front();
+            queue.pop_front();
+            ++num_expansions;
+
+            if (batched)
+            {
+                // New states receive consecutive indices in the order of the successors.
+                auto next_state_index = static_cast<Index>(state_repository->get_state_count());
+                state_repository->expand(current_state, 0., applicable_action_generator, successors);
+                for (const auto& [action, successor_state, successor_state_metric_value] : successors)
+                {
+                    if (successor_state.get_index() == next_state_index)
+                    {
+                        queue.push_back(successor_state);
+                        ++next_state_index;
+                    }
+                }
+                num_generations += successors.size();
+            }
+            else
+            {
+                applicable_actions.clear();
+                for (const auto& action : applicable_action_generator.create_applicable_action_generator(current_state))
+                {
+                    applicable_actions.push_back(action);
+                }
+                for (const auto& action : applicable_actions)
+                {
+                    const auto num_states = state_repository->get_state_count();
+                    const auto [successor_state, successor_state_metric_value] = state_repository->get_or_create_successor_state(current_state, action, 0.);
+                    if (state_repository->get_state_count() > num_states)
+                    {
+                        queue.push_back(successor_state);
+                    }
+                }
+                num_generations += applicable_actions.size();
+            }
+        }
+    }
+
+    state.SetLabel(domain_name + (batched ? "/expand" : "/successive"));
+    state.counters["expansions_per_second"] = benchmark::Counter(static_cast<double>(state.iterations() * num_expansions), benchmark::Counter::kIsRate);
+    state.counters["generations_per_expansion"] = static_cast<double>(num_generations) / static_cast<double>(num_expansions);
+}
+
+}
+
+// Baseline: the default repository without locking.
+BENCHMARK(mimir::benchmarks::BM_StateRepositoryInsert)->Args({ 0, 1 })->UseRealTime()->Unit(benchmark::kMillisecond);
+// Scaling of the thread-safe repository with the number of threads.
+BENCHMARK(mimir::benchmarks::BM_StateRepositoryInsert)
+    ->ArgsProduct({ { 1 }, { 1, 2, 4, 8, 16 } })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+// Batched versus successive successor generation on high-branching domains.
+BENCHMARK(mimir::benchmarks::BM_StateRepositoryExpand)->ArgsProduct({ { 0, 1 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
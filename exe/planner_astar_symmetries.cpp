@@ -236,18 +236,27 @@ int main(int argc, char** argv)
               << std::endl;
 
     std::cout << "Peak memory usage in bytes: " << get_peak_memory_usage_in_bytes() << std::endl;
+    const auto unpacked_state_cache_statistics = state_repository->get_unpacked_state_cache_statistics();
+    std::cout << "Number of unpacked state cache hits: " << unpacked_state_cache_statistics.num_hits << std::endl;
+    std::cout << "Number of unpacked state cache misses: " << unpacked_state_cache_statistics.num_misses << std::endl;
+    std::cout << "Memory usage in bytes for cached unpacked states: " << unpacked_state_cache_statistics.num_bytes << std::endl;
     std::cout << "Number of index slots: " << problem->get_index_tree_table().size() << std::endl;
     std::cout << "Number of double slots: " << problem->get_double_leaf_table().size() << std::endl;
     std::cout << "Number of slots: " << problem->get_index_tree_table().size() + problem->get_double_leaf_table().size() << std::endl;
     uint64_t num_fluent_state_variables = 0;
     uint64_t num_derived_state_variables = 0;
     uint64_t num_numeric_state_variables = 0;
-    for (const auto& [packed_state, index] : state_repository->get_states())
+    uint64_t states_capacity = 0;
+    for (const auto& states : state_repository->get_states())
     {
-        auto state = state_repository->get_state(packed_state);
-        num_fluent_state_variables += state.get_atoms<formalism::FluentTag>().count();
-        num_derived_state_variables += state.get_atoms<formalism::DerivedTag>().count();
-        num_numeric_state_variables += state.get_numeric_variables().size();
+        for (const auto& [packed_state, index] : states)
+        {
+            auto state = state_repository->get_state(packed_state);
+            num_fluent_state_variables += state.get_atoms<formalism::FluentTag>().count();
+            num_derived_state_variables += state.get_atoms<formalism::DerivedTag>().count();
+            num_numeric_state_variables += state.get_numeric_variables().size();
+        }
+        states_capacity += states.capacity();
     }
 
     std::cout << "Average number of fluent state variables: " << static_cast<double>(num_fluent_state_variables) / state_repository->get_state_count()
@@ -272,7 +281,7 @@ int main(int argc, char** argv)
 
     std::cout << "Peak memory usage in bytes for states: "
               << problem->get_index_tree_table().mem_usage() + problem->get_double_leaf_table().mem_usage()
-                     + state_repository->get_states().capacity() * (sizeof(PackedStateImpl) + sizeof(Index))
+                     + states_capacity * (sizeof(PackedStateImpl) + sizeof(Index))
               << std::endl;
 
     if (result.status == SearchStatus::SOLVED)
@@ -229,6 +229,10 @@ int main(int argc, char** argv)
               << std::endl;
 
     std::cout << "Peak memory usage in bytes: " << get_peak_memory_usage_in_bytes() << std::endl;
+    const auto unpacked_state_cache_statistics = state_repository->get_unpacked_state_cache_statistics();
+    std::cout << "Number of unpacked state cache hits: " << unpacked_state_cache_statistics.num_hits << std::endl;
+    std::cout << "Number of unpacked state cache misses: " << unpacked_state_cache_statistics.num_misses << std::endl;
+    std::cout << "Memory usage in bytes for cached unpacked states: " << unpacked_state_cache_statistics.num_bytes << std::endl;
 
     if (result.status == SearchStatus::SOLVED)
     {
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_INCLUDE_ALGORITHMS_BLOOM_FILTER_HPP_
+#define MIMIR_INCLUDE_ALGORITHMS_BLOOM_FILTER_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace mimir
+{
+
+/// @brief `BloomFilter` is a probabilistic set of 64-bit hash values that may report false positives but no false negatives.
+///
+/// Each hash value sets `num_hash_functions` bits that are derived from it by double hashing.
+/// With a single hash function, this is bitstate hashing.
+/// Since the filter is used as a closed list, it keeps track of the probability that a new element was reported as contained,
+/// i.e., that a state was omitted during a search.
+class BloomFilter
+{
+private:
+    std::vector<uint64_t> m_words;
+    uint64_t m_num_bits;
+    uint32_t m_num_hash_functions;
+
+    uint64_t m_num_set_bits;
+    uint64_t m_num_elements;
+    double m_log_probability_no_omission;  ///< Sum of log(1 - p_i) where p_i is the false positive probability before the i-th new element.
+    double m_expected_num_omissions;       ///< Sum of p_i.
+
+    /// @brief Finalizer of splitmix64 to decorrelate the bits of weak hash values.
+    static uint64_t mix(uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= uint64_t(0xBF58476D1CE4E5B9);
+        x ^= x >> 27;
+        x *= uint64_t(0x94D049BB133111EB);
+        x ^= x >> 31;
+        return x;
+    }
+
+    template<typename Callback>
+    void for_each_position(uint64_t hash, Callback&& callback) const
+    {
+        const auto h1 = mix(hash);
+        const auto h2 = mix(h1 ^ uint64_t(0x9E3779B97F4A7C15)) | uint64_t(1);
+        for (uint32_t i = 0; i < m_num_hash_functions; ++i)
+        {
+            callback((h1 + i * h2) % m_num_bits);
+        }
+    }
+
+public:
+    /// @brief Create an empty filter.
+    /// @param num_bits is the number of bits, which must be positive.
+    /// @param num_hash_functions is the number of bits per element, which must be positive.
+    BloomFilter(uint64_t num_bits, uint32_t num_hash_functions = 1) :
+        m_words(),
+        m_num_bits(num_bits),
+        m_num_hash_functions(num_hash_functions),
+        m_num_set_bits(0),
+        m_num_elements(0),
+        m_log_probability_no_omission(0.),
+        m_expected_num_omissions(0.)
+    {
+        if (num_bits == 0 || num_hash_functions == 0)
+        {
+            throw std::runtime_error("BloomFilter::BloomFilter: number of bits and number of hash functions must be positive.");
+        }
+        m_words.resize((num_bits + 63) / 64, 0);
+    }
+
+    /// @brief Insert the element with the given hash value.
+    /// @return true if the element was not contained, and false if it was possibly contained.
+    bool insert(uint64_t hash)
+    {
+        const auto false_positive_probability = get_false_positive_probability();
+
+        auto is_new = false;
+        for_each_position(hash,
+                          [&](uint64_t pos)
+                          {
+                              auto& word = m_words[pos / 64];
+                              const auto mask = uint64_t(1) << (pos % 64);
+                              if (!(word & mask))
+                              {
+                                  word |= mask;
+                                  ++m_num_set_bits;
+                                  is_new = true;
+                              }
+                          });
+
+        if (is_new)
+        {
+            ++m_num_elements;
+            if (false_positive_probability > 0.)
+            {
+                m_log_probability_no_omission += std::log1p(-false_positive_probability);
+                m_expected_num_omissions += false_positive_probability;
+            }
+        }
+        return is_new;
+    }
+
+    /// @brief Test whether the element with the given hash value is possibly contained.
+    bool contains(uint64_t hash) const
+    {
+        auto result = true;
+        for_each_position(hash, [&](uint64_t pos) { result = result && (m_words[pos / 64] & (uint64_t(1) << (pos % 64))); });
+        return result;
+    }
+
+    /// @brief Remove all elements.
+    void clear()
+    {
+        std::fill(m_words.begin(), m_words.end(), 0);
+        m_num_set_bits = 0;
+        m_num_elements = 0;
+        m_log_probability_no_omission = 0.;
+        m_expected_num_omissions = 0.;
+    }
+
+    /**
+     * Getters
+     */
+
+    uint64_t get_num_bits() const { return m_num_bits; }
+    uint32_t get_num_hash_functions() const { return m_num_hash_functions; }
+    uint64_t get_num_set_bits() const { return m_num_set_bits; }
+    /// @brief Return the number of insertions that reported a new element.
+    uint64_t get_num_elements() const { return m_num_elements; }
+
+    /// @brief Return the probability that a new element is reported as contained, given the current fill ratio.
+    double get_false_positive_probability() const
+    {
+        return std::pow(static_cast<double>(m_num_set_bits) / static_cast<double>(m_num_bits), static_cast<double>(m_num_hash_functions));
+    }
+
+    /// @brief Return the estimated probability that at least one new element was reported as contained by an earlier insertion.
+    double get_estimated_omission_probability() const { return -std::expm1(m_log_probability_no_omission); }
+
+    /// @brief Return the estimated number of new elements that were reported as contained by earlier insertions.
+    double get_expected_num_omissions() const { return m_expected_num_omissions; }
+
+    size_t get_estimated_memory_usage_in_bytes() const { return m_words.capacity() * sizeof(uint64_t); }
+};
+
+}
+
+#endif
@@ -21,12 +21,84 @@
 #include "mimir/algorithms/generator.hpp"
 
 #include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
 namespace mimir
 {
 
+/// @brief `KPartiteGraph` is an undirected k-partite graph whose adjacency rows are split into word-aligned bitsets, one per partition.
+///
+/// A dense graph stores each row as a bitset over all partitions, and a sparse graph stores the positions of the adjacent vertices of each row,
+/// which takes memory linear in the number of edges. The representation is selected by the number of vertices.
+/// Resetting the graph clears only the rows that received edges since the last reset.
+class KPartiteGraph
+{
+public:
+    /// @brief Graphs with more vertices are sparse by default.
+    static constexpr size_t DEFAULT_MAX_NUM_DENSE_VERTICES = 4096;
+
+    /// @brief Create a graph without edges.
+    /// @param partitions is the vertex partitioning, where the vertices are 0, ..., n-1 for n vertices in total.
+    /// @param max_num_dense_vertices is the maximum number of vertices of a dense graph.
+    explicit KPartiteGraph(std::vector<std::vector<uint32_t>> partitions, size_t max_num_dense_vertices = DEFAULT_MAX_NUM_DENSE_VERTICES);
+
+    /// @brief Add the edge between two vertices of different partitions.
+    void add_edge(uint32_t first_vertex, uint32_t second_vertex);
+
+    /// @brief Remove all edges.
+    void reset();
+
+    /**
+     * Getters
+     */
+
+    const std::vector<std::vector<uint32_t>>& get_partitions() const;
+    size_t get_num_vertices() const;
+    bool is_sparse() const;
+
+    /// @brief Return the number of words of a row.
+    size_t get_num_words() const;
+    /// @brief Return the first word of each partition in a row.
+    const std::vector<uint32_t>& get_word_offsets() const;
+    /// @brief Return the number of words of each partition in a row.
+    const std::vector<uint32_t>& get_num_partition_words() const;
+    /// @brief Return the bit position of the vertex in a row.
+    uint32_t get_position(uint32_t vertex) const;
+
+    /// @brief Return the row of the vertex in a dense graph.
+    const uint64_t* get_dense_row(uint32_t vertex) const;
+    /// @brief Return the bit positions of the adjacent vertices of the vertex in a sparse graph.
+    const std::vector<uint32_t>& get_sparse_row(uint32_t vertex) const;
+
+private:
+    std::vector<std::vector<uint32_t>> m_partitions;
+    bool m_is_sparse;
+
+    std::vector<uint32_t> m_word_offsets;
+    std::vector<uint32_t> m_num_partition_words;
+    std::vector<uint32_t> m_positions;
+    size_t m_num_words;
+
+    std::vector<uint64_t> m_dense_rows;
+    std::vector<std::vector<uint32_t>> m_sparse_rows;
+
+    std::vector<uint8_t> m_is_dirty;
+    std::vector<uint32_t> m_dirty_rows;
+
+    void add_directed_edge(uint32_t source, uint32_t target);
+};
+
+/// @brief Thread-safe k-clique in k-partite graph enumerator.
+///
+/// The enumeration is a depth-first search over an explicit stack that restricts the compatible vertices of each partition word by word.
+/// The graph must not be modified while the generator is in use.
+/// @param graph is the k-partite graph.
+/// @return a generator to enumerate all k-cliques.
+mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const KPartiteGraph& graph);
+
 /// @brief Thread-safe k-clique in k-partite graph enumerator.
 /// @param adjacency_matrix is the adjacency matrix.
 /// @param partitions is the vertex partitioning.
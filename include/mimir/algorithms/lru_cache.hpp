@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_INCLUDE_ALGORITHMS_LRU_CACHE_HPP_
+#define MIMIR_INCLUDE_ALGORITHMS_LRU_CACHE_HPP_
+
+#include <absl/container/flat_hash_map.h>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace mimir
+{
+
+/// @brief `LRUCache` maps at most `capacity` keys to values and evicts the least recently used entry when full.
+///
+/// The entries are stored in a single vector and linked into a recency list by position,
+/// so no allocation happens once the cache is full.
+/// @tparam Key is the key type.
+/// @tparam Value is the value type.
+template<typename Key, typename Value>
+class LRUCache
+{
+private:
+    static constexpr uint32_t NO_POSITION = std::numeric_limits<uint32_t>::max();
+
+    struct Entry
+    {
+        Key key;
+        Value value;
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    size_t m_capacity;
+    std::vector<Entry> m_entries;
+    absl::flat_hash_map<Key, uint32_t> m_positions;
+    uint32_t m_head;  ///< The most recently used entry.
+    uint32_t m_tail;  ///< The least recently used entry.
+
+    void unlink(uint32_t pos)
+    {
+        auto& entry = m_entries[pos];
+
+        if (entry.prev != NO_POSITION)
+            m_entries[entry.prev].next = entry.next;
+        else
+            m_head = entry.next;
+
+        if (entry.next != NO_POSITION)
+            m_entries[entry.next].prev = entry.prev;
+        else
+            m_tail = entry.prev;
+    }
+
+    void push_front(uint32_t pos)
+    {
+        auto& entry = m_entries[pos];
+        entry.prev = NO_POSITION;
+        entry.next = m_head;
+
+        if (m_head != NO_POSITION)
+            m_entries[m_head].prev = pos;
+        m_head = pos;
+
+        if (m_tail == NO_POSITION)
+            m_tail = pos;
+    }
+
+    void touch(uint32_t pos)
+    {
+        if (pos != m_head)
+        {
+            unlink(pos);
+            push_front(pos);
+        }
+    }
+
+public:
+    explicit LRUCache(size_t capacity) :
+        m_capacity(std::min(capacity, static_cast<size_t>(NO_POSITION))),
+        m_entries(),
+        m_positions(),
+        m_head(NO_POSITION),
+        m_tail(NO_POSITION)
+    {
+    }
+
+    /// @brief Find the value of the given `key` and mark it as most recently used.
+    /// @return a pointer to the value, or `nullptr` if the key is not cached.
+    Value* find(const Key& key)
+    {
+        const auto it = m_positions.find(key);
+        if (it == m_positions.end())
+        {
+            return nullptr;
+        }
+
+        touch(it->second);
+
+        return &m_entries[it->second].value;
+    }
+
+    /// @brief Insert or overwrite the value of the given `key` and mark it as most recently used.
+    /// Evicts the least recently used entry if the cache is full. Does nothing if the capacity is 0.
+    void insert(const Key& key, Value value)
+    {
+        if (m_capacity == 0)
+        {
+            return;
+        }
+
+        const auto it = m_positions.find(key);
+        if (it != m_positions.end())
+        {
+            m_entries[it->second].value = std::move(value);
+            touch(it->second);
+            return;
+        }
+
+        if (m_entries.size() < m_capacity)
+        {
+            const auto pos = static_cast<uint32_t>(m_entries.size());
+            m_entries.push_back(Entry { key, std::move(value), NO_POSITION, NO_POSITION });
+            m_positions.emplace(key, pos);
+            push_front(pos);
+            return;
+        }
+
+        // Reuse the least recently used entry.
+        const auto pos = m_tail;
+        assert(pos != NO_POSITION);
+        auto& entry = m_entries[pos];
+        m_positions.erase(entry.key);
+        entry.key = key;
+        entry.value = std::move(value);
+        m_positions.emplace(key, pos);
+        touch(pos);
+    }
+
+    /// @brief Remove all entries.
+    void clear()
+    {
+        m_entries.clear();
+        m_positions.clear();
+        m_head = NO_POSITION;
+        m_tail = NO_POSITION;
+    }
+
+    /// @brief Call `callback` on each cached key and value in unspecified order.
+    template<typename F>
+    void for_each(F&& callback) const
+    {
+        for (const auto& entry : m_entries)
+        {
+            callback(entry.key, entry.value);
+        }
+    }
+
+    size_t size() const { return m_entries.size(); }
+    size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_entries.empty(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_INCLUDE_ALGORITHMS_MAILBOX_HPP_
+#define MIMIR_INCLUDE_ALGORITHMS_MAILBOX_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace mimir
+{
+
+/// @brief `Mailbox` is a lock-free multi-producer single-consumer queue.
+///
+/// Producers push with a single CAS on the head of an intrusive list.
+/// The consumer detaches the whole list with a single exchange and visits the messages in FIFO order.
+/// An idle consumer can block in `wait` until the next message is pushed.
+/// @tparam T is the message type.
+template<typename T>
+class Mailbox
+{
+private:
+    struct Node
+    {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> m_head;
+
+public:
+    Mailbox() : m_head(nullptr) {}
+
+    // Uncopieable and unmoveable because producers hold references.
+    Mailbox(const Mailbox& other) = delete;
+    Mailbox& operator=(const Mailbox& other) = delete;
+    Mailbox(Mailbox&& other) = delete;
+    Mailbox& operator=(Mailbox&& other) = delete;
+
+    ~Mailbox()
+    {
+        auto node = m_head.exchange(nullptr, std::memory_order_acquire);
+        while (node)
+        {
+            auto next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    /// @brief Push a message. Safe to call concurrently from any number of threads.
+    void push(T value)
+    {
+        auto node = new Node { std::move(value), m_head.load(std::memory_order_relaxed) };
+
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+
+        m_head.notify_one();
+    }
+
+    /// @brief Block until the mailbox contains a message.
+    /// Returns immediately if it is already nonempty. Must only be called from the consumer thread.
+    void wait() const { m_head.wait(nullptr, std::memory_order_acquire); }
+
+    /// @brief Remove all messages and call `callback` on each of them in the order in which they were pushed.
+    /// Must only be called from the consumer thread.
+    /// @return the number of messages received.
+    template<typename F>
+    size_t drain(F&& callback)
+    {
+        auto node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+        /* Reverse the list to restore FIFO order. */
+        Node* reversed = nullptr;
+        while (node)
+        {
+            auto next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        size_t num_messages = 0;
+        while (reversed)
+        {
+            auto next = reversed->next;
+            callback(std::move(reversed->value));
+            delete reversed;
+            reversed = next;
+            ++num_messages;
+        }
+        return num_messages;
+    }
+
+    bool empty() const { return m_head.load(std::memory_order_acquire) == nullptr; }
+};
+
+}
+
+#endif
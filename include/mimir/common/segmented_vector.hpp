@@ -19,6 +19,8 @@
 #define MIMIR_COMMON_SEGMENTED_VECTOR_HPP_
 
 #include <bit>
+#include <cassert>
+#include <cstddef>
 #include <vector>
 
 namespace mimir
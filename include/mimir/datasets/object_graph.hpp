@@ -18,12 +18,16 @@
 #ifndef MIMIR_DATASETS_OBJECT_GRAPH_HPP_
 #define MIMIR_DATASETS_OBJECT_GRAPH_HPP_
 
+#include "mimir/common/declarations.hpp"
 #include "mimir/datasets/declarations.hpp"
 #include "mimir/formalism/declarations.hpp"
+#include "mimir/graphs/algorithms/nauty.hpp"
 #include "mimir/graphs/static_graph.hpp"
 #include "mimir/search/declarations.hpp"
 
 #include <ostream>
+#include <utility>
+#include <vector>
 
 namespace mimir::datasets
 {
@@ -33,6 +37,115 @@ namespace mimir::datasets
 /// @param problem is the Problem.
 extern graphs::StaticGraph<graphs::Vertex<graphs::PropertyValue>, graphs::Edge<>> create_object_graph(const search::State& state,
                                                                                                       const formalism::ProblemImpl& problem);
+
+/// @brief `ObjectGraphBuilder` creates the object graphs of a sequence of states by patching the object graph of the previous state.
+///
+/// The vertices of the objects, the static atoms, and the goal literals are created once.
+/// An update only recolors the objects whose unary atoms differ from the previous state,
+/// and inserts or removes the vertices of the other fluent and derived atoms that differ.
+/// During a search, the previous state is usually the parent or a sibling, which differs only in the effects of few actions.
+/// The vertices of each atom occupy a stable slot, and the slots of removed atoms are reused by atoms with the same number of vertices.
+/// The live vertices are compacted into the sparse representation of nauty when a graph is requested,
+/// and the resulting graphs are isomorphic to the graphs of `create_object_graph`.
+/// Invariant: The object in the problem with index i has vertex index i.
+class ObjectGraphBuilder
+{
+public:
+    using GraphType = graphs::StaticGraph<graphs::Vertex<graphs::PropertyValue>, graphs::Edge<>>;
+
+    explicit ObjectGraphBuilder(formalism::Problem problem);
+
+    /// @brief Patch the object graph of the previous state to the object graph of the given state.
+    /// @param state is the state, which must belong to the problem of the builder.
+    void update(const search::State& state);
+
+    /// @brief Create a nauty graph of the object graph of the last updated state.
+    /// @return the `SparseGraph`, which is not canonized.
+    graphs::nauty::SparseGraph create_nauty_graph();
+
+    /// @brief Return the object graph of the last updated state as a `StaticGraph`, which is rebuilt into the same buffers after each update.
+    /// @return the object graph.
+    const GraphType& get_graph();
+
+    size_t get_num_vertices() const;
+    size_t get_num_edges() const;
+    const formalism::Problem& get_problem() const;
+
+private:
+    /// @brief The vertices of an atom or literal, i.e., one vertex per position that is connected to the object at the position
+    /// and to the vertex of the previous position, or a single isolated vertex if the atom is nullary.
+    struct AtomVertices
+    {
+        graphs::PropertyValueList properties;
+        IndexList objects;
+    };
+
+    template<formalism::IsStaticOrFluentOrDerivedTag P>
+    static AtomVertices create_atom_vertices(formalism::GroundAtom<P> atom);
+    template<formalism::IsStaticOrFluentOrDerivedTag P>
+    static AtomVertices create_literal_vertices(formalism::GroundLiteral<P> literal);
+
+    /// @brief Occupy a free slot or append a new slot for the vertices and connect them.
+    /// @return the first vertex of the slot.
+    Index add_atom_vertices(const AtomVertices& atom_vertices);
+    /// @brief Disconnect the vertices in the slot that starts at `first_vertex` and free the slot.
+    void remove_atom_vertices(Index first_vertex, const AtomVertices& atom_vertices);
+
+    void add_vertex(graphs::PropertyValue property, int row_capacity);
+    void add_neighbor(int vertex, int neighbor);
+    void add_edge(int source, int target);
+
+    /// @brief Ensure that `m_v`, `m_d`, and `m_e` hold the live vertices and their edges.
+    void compact();
+
+    template<formalism::IsFluentOrDerivedTag P>
+    void update_atoms(const search::State& state, IndexList& ref_atoms, std::vector<AtomVertices>& ref_atom_vertices, IndexList& ref_atom_slots);
+
+    formalism::Problem m_problem;
+
+    /* Object colors. */
+    std::vector<formalism::PredicateVariantList> m_object_static_predicates;
+    std::vector<formalism::PredicateVariantList> m_object_dynamic_predicates;
+    std::vector<std::vector<std::pair<formalism::PredicateVariant, bool>>> m_object_literals;
+    std::vector<bool> m_is_object_dirty;
+    IndexList m_dirty_objects;
+
+    /* Fluent and derived atoms of the previous state, and the cached vertices and slots of non-unary atoms, indexed by atom index. */
+    IndexList m_fluent_atoms;
+    IndexList m_derived_atoms;
+    std::vector<AtomVertices> m_fluent_atom_vertices;
+    std::vector<AtomVertices> m_derived_atom_vertices;
+    IndexList m_fluent_atom_slots;  ///< The first vertex of each atom of the previous state, or MAX_INDEX.
+    IndexList m_derived_atom_slots;
+    IndexList m_added_atoms;
+    IndexList m_deleted_atoms;
+
+    /* The vertices, where the objects come first, and the free slots indexed by their number of vertices. */
+    graphs::PropertyValueList m_properties;
+    std::vector<bool> m_is_live;
+    std::vector<IndexList> m_free_slots;
+    size_t m_num_live_vertices;
+    size_t m_num_edges;
+
+    /* The neighbors of each vertex are a row in `m_adjacency` with spare capacity, which is moved to the end when it overflows. */
+    std::vector<size_t> m_row_begins;
+    std::vector<int> m_row_sizes;
+    std::vector<int> m_row_capacities;
+    std::vector<int> m_adjacency;
+    std::vector<int> m_object_edge_positions;  ///< The position of each atom vertex in the row of its object.
+    size_t m_num_unused_adjacency;
+
+    /* Sparse representation of nauty over the live vertices. */
+    std::vector<int> m_compact_vertices;
+    std::vector<size_t> m_v;
+    std::vector<int> m_d;
+    std::vector<int> m_e;
+    std::vector<std::pair<graphs::PropertyValue, int>> m_color_vertex_pairs;
+    bool m_is_compact_up_to_date;
+
+    GraphType m_graph;
+    bool m_is_graph_up_to_date;
+};
 }
 
 #endif
@@ -28,6 +28,18 @@
 
 namespace mimir::datasets
 {
+namespace state_space
+{
+/// @brief `SizeEstimate` summarizes an enumeration of the reachable states with a probabilistic closed list.
+struct SizeEstimate
+{
+    uint64_t num_states;
+    uint64_t num_goal_states;
+    /// @brief The estimated probability that at least one reachable state was not counted.
+    double estimated_omission_probability;
+};
+}
+
 /**
  * StateSpaceImpl
  */
@@ -74,6 +86,21 @@ public:
     static std::vector<std::pair<StateSpace, std::optional<CertificateMaps>>> create(search::GeneralizedSearchContext contexts,
                                                                                      const Options& options = Options());
 
+    /// @brief Estimate the number of reachable states without creating the `StateSpace`.
+    ///
+    /// The reachable states are enumerated in breadth-first order with a Bloom filter of `num_bits` bits as closed list,
+    /// which requires a few bits per state instead of a vertex in the graph.
+    /// States that are falsely reported as visited are omitted, hence the number of states is a lower bound.
+    /// Symmetry pruning and sorting are not applied.
+    /// @param context is the `search::SearchContext`.
+    /// @param num_bits is the number of bits of the Bloom filter.
+    /// @param num_hash_functions is the number of bits that are set per state. A single bit per state is bitstate hashing.
+    /// @param options are the `Options`.
+    /// @return the estimate if the enumeration was completed within the limits of `options`,
+    /// and if the problem is solvable or `remove_if_unsolvable` is false.
+    static std::optional<state_space::SizeEstimate>
+    estimate_size(search::SearchContext context, uint64_t num_bits, uint32_t num_hash_functions = 1, const Options& options = Options());
+
     /**
      * Getters
      */
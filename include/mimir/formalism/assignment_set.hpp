@@ -85,6 +85,8 @@ public:
 
     void reset() noexcept;
 
+    void reset(Predicate<P> predicate) noexcept;
+
     void insert_ground_atoms(const GroundAtomList<P>& ground_atoms);
 
     void insert_ground_atom(GroundAtom<P> ground_atom);
@@ -136,8 +138,12 @@ public:
 
     void reset() noexcept;
 
+    void reset(FunctionSkeleton<F> function_skeleton) noexcept;
+
     void insert_ground_function_values(const GroundFunctionList<F>& ground_functions, const FlatDoubleList& numeric_values);
 
+    void insert_ground_function_value(GroundFunction<F> ground_function, ContinuousCost value);
+
     const FunctionSkeletonAssignmentSet<F>& get_set(FunctionSkeleton<F> function_skeleton) const noexcept;
 
     size_t size() const noexcept;
@@ -161,6 +167,12 @@ struct DynamicAssignmentSets
 
     FunctionSkeletonAssignmentSets<FluentTag> fluent_function_skeleton_assignment_sets;
 
+    /// @brief The atoms and numeric variables that the sets contain, which allows updating the sets from the changes to another state.
+    FlatBitset fluent_atoms;
+    FlatBitset derived_atoms;
+    FlatDoubleList numeric_variables;
+    bool is_initialized;
+
     DynamicAssignmentSets();
     DynamicAssignmentSets(const ProblemImpl& problem);
 };
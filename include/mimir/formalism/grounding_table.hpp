@@ -4,17 +4,177 @@
 #include "mimir/formalism/declarations.hpp"
 
 #include <absl/container/flat_hash_map.h>
+#include <array>
+#include <bit>
+#include <limits>
 #include <loki/details/utils/hash.hpp>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
 
 namespace mimir::formalism
 {
 
+/// @brief `PerfectBindingHash` ranks the bindings of a list of parameters in mixed radix over the type-legal objects of each parameter.
+struct PerfectBindingHash
+{
+    static constexpr size_t NO_RANK = std::numeric_limits<size_t>::max();
+
+    size_t m_num_bindings;                           ///< The number of type-legal bindings, or NO_RANK if it exceeds the range of size_t.
+    std::vector<std::vector<uint32_t>> m_remapping;  ///< The remapping of o in O to its index in the domain of each parameter, or MAX_INDEX
+    std::vector<ObjectList> m_domains;               ///< The type-legal objects of each parameter.
+    std::vector<size_t> m_strides;                   ///< The product of the domain sizes of the preceding parameters.
+
+    PerfectBindingHash(const ParameterList& parameters, const ObjectList& objects);
+
+    /// @brief Return the rank of the binding, or NO_RANK if it has the wrong size or some object is not type-legal.
+    size_t get_binding_rank(const ObjectList& binding) const noexcept;
+
+    /// @brief Return the binding with the given rank, which must be less than `size()`.
+    ObjectList get_binding(size_t rank) const;
+
+    size_t size() const noexcept;
+};
+
+/// @brief `GroundingTable` maps the bindings of an action or axiom schema to its groundings.
+///
+/// If the schema has at most `max_num_ranked_bindings` type-legal bindings,
+/// the rank of a binding indexes a two-level array whose pages are allocated on first use.
+/// Otherwise, and for bindings that are not type-legal, the table falls back to hashing the binding.
+/// The groundings of a schema are often a sparse subset of its bindings. Hence, whenever the number of ranked groundings doubles,
+/// the table measures the occupancy of its pages and moves all groundings into the hash table
+/// if the pages use more than `MIN_NUM_BYTES_FOR_FALLBACK` bytes and twice the memory of hashing them.
+/// Few groundings scattered over many pages are moved as well.
 template<typename T>
-using GroundingTable = absl::flat_hash_map<ObjectList, T, loki::Hash<ObjectList>>;
+class GroundingTable
+{
+    static_assert(std::is_pointer_v<T>, "GroundingTable uses nullptr to denote missing groundings.");
+
+public:
+    static constexpr size_t MAX_NUM_RANKED_BINDINGS = size_t(1) << 20;
+    static constexpr size_t PAGE_SIZE = 1024;
+    static constexpr size_t MIN_NUM_BYTES_FOR_FALLBACK = size_t(1) << 16;
+
+    GroundingTable(const ParameterList& parameters, const ObjectList& objects, size_t max_num_ranked_bindings = MAX_NUM_RANKED_BINDINGS) :
+        m_arity(parameters.size()),
+        m_hash(std::nullopt),
+        m_pages(),
+        m_num_pages(0),
+        m_num_ranked(0),
+        m_table(),
+        m_size(0)
+    {
+        auto hash = PerfectBindingHash(parameters, objects);
+        if (hash.size() <= max_num_ranked_bindings)
+        {
+            m_pages.resize((hash.size() + PAGE_SIZE - 1) / PAGE_SIZE);
+            m_hash = std::move(hash);
+        }
+    }
+
+    /// @brief Return the grounding of the binding, or nullptr if it does not exist.
+    T find(const ObjectList& binding) const
+    {
+        const auto rank = m_hash ? m_hash->get_binding_rank(binding) : PerfectBindingHash::NO_RANK;
+        if (rank != PerfectBindingHash::NO_RANK)
+        {
+            const auto page = rank / PAGE_SIZE;
+            return m_pages[page] ? (*m_pages[page])[rank % PAGE_SIZE] : nullptr;
+        }
+
+        const auto it = m_table.find(binding);
+        return (it != m_table.end()) ? it->second : nullptr;
+    }
+
+    /// @brief Insert the grounding of a binding that has no grounding yet.
+    void insert(const ObjectList& binding, T element)
+    {
+        ++m_size;
+
+        const auto rank = m_hash ? m_hash->get_binding_rank(binding) : PerfectBindingHash::NO_RANK;
+        if (rank == PerfectBindingHash::NO_RANK)
+        {
+            m_table.emplace(binding, element);
+            return;
+        }
+
+        const auto page = rank / PAGE_SIZE;
+        if (!m_pages[page])
+        {
+            m_pages[page] = std::make_unique<std::array<T, PAGE_SIZE>>();
+            ++m_num_pages;
+        }
+        (*m_pages[page])[rank % PAGE_SIZE] = element;
+        ++m_num_ranked;
+
+        if (std::has_single_bit(m_num_ranked) && is_sparse())
+        {
+            move_ranked_to_table();
+        }
+    }
+
+    /// @brief Return true iff type-legal bindings are ranked instead of hashed.
+    bool is_ranked() const { return m_hash.has_value(); }
+
+    size_t size() const { return m_size; }
+
+    size_t get_estimated_memory_usage_in_bytes() const
+    {
+        return get_num_bytes_for_pages() + m_table.capacity() * (sizeof(typename decltype(m_table)::value_type) + 1)
+               + m_table.size() * m_arity * sizeof(Object);
+    }
+
+private:
+    size_t get_num_bytes_for_pages() const
+    {
+        return m_pages.capacity() * sizeof(typename decltype(m_pages)::value_type) + m_num_pages * sizeof(std::array<T, PAGE_SIZE>);
+    }
+
+    /// @brief Return true iff the pages use more than `MIN_NUM_BYTES_FOR_FALLBACK` bytes and twice the estimated memory of hashing the ranked groundings.
+    bool is_sparse() const
+    {
+        const auto num_bytes_for_pages = get_num_bytes_for_pages();
+        const auto num_bytes_per_hashed_grounding = 2 * (sizeof(typename decltype(m_table)::value_type) + 1) + m_arity * sizeof(Object);
+        return num_bytes_for_pages > MIN_NUM_BYTES_FOR_FALLBACK && num_bytes_for_pages > 2 * m_num_ranked * num_bytes_per_hashed_grounding;
+    }
+
+    /// @brief Hash all ranked groundings and stop ranking.
+    void move_ranked_to_table()
+    {
+        for (size_t page = 0; page < m_pages.size(); ++page)
+        {
+            if (!m_pages[page])
+            {
+                continue;
+            }
+            for (size_t offset = 0; offset < PAGE_SIZE; ++offset)
+            {
+                if (const auto element = (*m_pages[page])[offset])
+                {
+                    m_table.emplace(m_hash->get_binding(page * PAGE_SIZE + offset), element);
+                }
+            }
+        }
+        m_hash = std::nullopt;
+        m_pages = std::vector<std::unique_ptr<std::array<T, PAGE_SIZE>>>();
+        m_num_pages = 0;
+        m_num_ranked = 0;
+    }
+
+    size_t m_arity;
+    std::optional<PerfectBindingHash> m_hash;
+    std::vector<std::unique_ptr<std::array<T, PAGE_SIZE>>> m_pages;
+    size_t m_num_pages;
+    size_t m_num_ranked;
+    absl::flat_hash_map<ObjectList, T, loki::Hash<ObjectList>> m_table;
+    size_t m_size;
+};
 
+/// @brief The grounding tables are indexed by schema and created on first use.
 template<typename T>
-using GroundingTableList = std::vector<GroundingTable<T>>;
+using GroundingTableList = std::vector<std::optional<GroundingTable<T>>>;
 
 }
 
-#endif
\ No newline at end of file
+#endif
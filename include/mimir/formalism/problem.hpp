@@ -28,6 +28,7 @@
 #include <valla/indexed_hash_set.hpp>
 
 #include <memory>
+#include <shared_mutex>
 
 namespace mimir::formalism
 {
@@ -67,6 +68,7 @@ private:
 
     std::unique_ptr<valla::IndexedHashSet<valla::Slot<Index>, Index>> m_index_tree_table;
     std::unique_ptr<valla::IndexedHashSet<double, Index>> m_double_leaf_table;
+    std::shared_mutex m_table_mutex;  ///< Guards the index tree and double leaf tables, which are shared by all state repositories of the problem.
 
     SharedObjectPool<FlatBitset> m_bitset_pool;
     SharedObjectPool<FlatIndexList> m_index_list_pool;
@@ -138,11 +140,16 @@ public:
     const valla::IndexedHashSet<valla::Slot<Index>, Index>& get_index_tree_table() const;
     valla::IndexedHashSet<double, Index>& get_double_leaf_table();
     const valla::IndexedHashSet<double, Index>& get_double_leaf_table() const;
+    /// @brief Get the mutex that thread-safe state repositories lock to access the index tree and double leaf tables.
+    /// It is shared by all state repositories of the problem because they all insert into the same tables.
+    std::shared_mutex& get_table_mutex();
 
     std::pair<const FlatIndexList*, Index> get_or_create_index_list(const FlatIndexList& list);
     const FlatIndexList* get_index_list(size_t pos) const;
     std::pair<const FlatDoubleList*, Index> get_or_create_double_list(const FlatDoubleList& list);
     const FlatDoubleList* get_double_list(size_t pos) const;
+    /// @brief Estimate the memory usage of the atom and numeric lists that are shared by conditions and effects.
+    size_t get_estimated_memory_usage_of_lists_in_bytes() const;
 
     SharedObjectPool<FlatBitset>& get_bitset_pool();
     SharedObjectPool<FlatIndexList>& get_index_list_pool();
@@ -76,6 +76,17 @@ private:
 public:
     SparseGraph();
 
+    /// @brief Create a `SparseGraph` from the sparse representation of nauty without translating a graph.
+    /// The graph must be undirected and loopless without parallel edges,
+    /// and `coloring` must be sorted such that `lab` and `ptn` partition the vertices into the classes of equal colors.
+    /// @param v is the array of indexes into `e`.
+    /// @param d is the array with the degree of each vertex.
+    /// @param e is the array to hold the lists of neighbors.
+    /// @param lab is the labeling.
+    /// @param ptn is the partition.
+    /// @param coloring is the color of each vertex in `lab`.
+    SparseGraph(std::vector<size_t> v, std::vector<int> d, std::vector<int> e, std::vector<int> lab, std::vector<int> ptn, PropertyValueList coloring);
+
     template<typename Graph>
         requires IsVertexListGraph<Graph> && IsEdgeListGraph<Graph>
     explicit SparseGraph(const Graph& graph) : SparseGraph()
@@ -78,13 +78,16 @@
 #include "mimir/search/algorithms/strategies/exploration_strategy.hpp"
 #include "mimir/search/algorithms/strategies/goal_strategy.hpp"
 #include "mimir/search/algorithms/strategies/pruning_strategy.hpp"
+#include "mimir/search/algorithms/strategies/symmetry_pruning_strategy.hpp"
 #include "mimir/search/applicability.hpp"
 #include "mimir/search/applicable_action_generators.hpp"
 #include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/finite_domain_state_encoding.hpp"
 #include "mimir/search/formatter.hpp"
 #include "mimir/search/generalized_search_context.hpp"
 #include "mimir/search/grounders.hpp"
 #include "mimir/search/heuristics.hpp"
+#include "mimir/search/mutex_groups.hpp"
 #include "mimir/search/openlists.hpp"
 #include "mimir/search/partially_ordered_plan.hpp"
 #include "mimir/search/satisficing_binding_generators.hpp"
@@ -26,8 +26,12 @@
 #include "mimir/search/algorithms/astar_eager/event_handlers.hpp"
 #include "mimir/search/algorithms/astar_lazy.hpp"
 #include "mimir/search/algorithms/astar_lazy/event_handlers.hpp"
+#include "mimir/search/algorithms/astar_parallel.hpp"
+#include "mimir/search/algorithms/bfws.hpp"
+#include "mimir/search/algorithms/bfws/event_handlers.hpp"
 #include "mimir/search/algorithms/brfs.hpp"
 #include "mimir/search/algorithms/brfs/event_handlers.hpp"
+#include "mimir/search/algorithms/brfs_external.hpp"
 #include "mimir/search/algorithms/gbfs_eager.hpp"
 #include "mimir/search/algorithms/gbfs_eager/event_handlers.hpp"
 #include "mimir/search/algorithms/gbfs_lazy.hpp"
@@ -18,6 +18,7 @@
 #ifndef MIMIR_SEARCH_ALGORITHMS_ASTAR_EAGER_HPP_
 #define MIMIR_SEARCH_ALGORITHMS_ASTAR_EAGER_HPP_
 
+#include "mimir/common/filesystem.hpp"
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/search/algorithms/utils.hpp"
@@ -36,8 +37,21 @@ struct Options
     EventHandler event_handler = nullptr;
     GoalStrategy goal_strategy = nullptr;
     PruningStrategy pruning_strategy = nullptr;
+    /// @brief Memoizes heuristic values of reopened states. Defaults to an unbounded cache for the duration of the search.
+    /// Pass a cache created with a memory limit to bound it, or share it between searches on the same `SearchContext`.
+    HeuristicCache heuristic_cache = nullptr;
     uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
     uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    /// @brief Stop with `SearchStatus::OUT_OF_MEMORY` once the estimated memory usage of the search exceeds this budget.
+    uint64_t max_memory_in_bytes = std::numeric_limits<uint64_t>::max();
+    /// @brief Periodically write the search nodes, the open list, and the states to this file
+    /// and to the file with the additional extension `.states`. Disabled if empty.
+    /// A checkpoint is also written when the search runs out of time.
+    fs::path checkpoint_file = fs::path();
+    uint32_t checkpoint_interval_in_ms = 60000;
+    /// @brief Continue the search from `checkpoint_file` if it exists instead of starting from the start state.
+    /// The statistics of the event handler only cover the resumed part of the search.
+    bool resume_from_checkpoint = false;
 
     Options() = default;
 };
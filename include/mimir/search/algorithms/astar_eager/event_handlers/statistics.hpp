@@ -36,6 +36,11 @@ private:
     uint64_t m_num_expanded;
     uint64_t m_num_deadends;
     uint64_t m_num_pruned;
+    uint64_t m_num_heuristic_cache_hits;
+    uint64_t m_num_heuristic_cache_misses;
+    uint64_t m_num_unpacked_state_cache_hits;
+    uint64_t m_num_unpacked_state_cache_misses;
+    uint64_t m_num_bytes_for_unpacked_state_cache;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_search_start_time_point;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_search_end_time_point;
 
@@ -58,6 +63,11 @@ public:
         m_num_expanded(0),
         m_num_deadends(0),
         m_num_pruned(0),
+        m_num_heuristic_cache_hits(0),
+        m_num_heuristic_cache_misses(0),
+        m_num_unpacked_state_cache_hits(0),
+        m_num_unpacked_state_cache_misses(0),
+        m_num_bytes_for_unpacked_state_cache(0),
         m_num_generated_until_f_value(),
         m_num_expanded_until_f_value(),
         m_num_deadends_until_f_value(),
@@ -88,6 +98,11 @@ public:
     void increment_num_expanded() { ++m_num_expanded; }
     void increment_num_deadends() { ++m_num_deadends; }
     void increment_num_pruned() { ++m_num_pruned; }
+    void increment_num_heuristic_cache_hits() { ++m_num_heuristic_cache_hits; }
+    void increment_num_heuristic_cache_misses() { ++m_num_heuristic_cache_misses; }
+    void set_num_unpacked_state_cache_hits(uint64_t num_hits) { m_num_unpacked_state_cache_hits = num_hits; }
+    void set_num_unpacked_state_cache_misses(uint64_t num_misses) { m_num_unpacked_state_cache_misses = num_misses; }
+    void set_num_bytes_for_unpacked_state_cache(uint64_t num_bytes) { m_num_bytes_for_unpacked_state_cache = num_bytes; }
     void set_search_start_time_point(std::chrono::time_point<std::chrono::high_resolution_clock> time_point) { m_search_start_time_point = time_point; }
     void set_search_end_time_point(std::chrono::time_point<std::chrono::high_resolution_clock> time_point) { m_search_end_time_point = time_point; }
 
@@ -107,6 +122,11 @@ public:
     uint64_t get_num_expanded() const { return m_num_expanded; }
     uint64_t get_num_deadends() const { return m_num_deadends; }
     uint64_t get_num_pruned() const { return m_num_pruned; }
+    uint64_t get_num_heuristic_cache_hits() const { return m_num_heuristic_cache_hits; }
+    uint64_t get_num_heuristic_cache_misses() const { return m_num_heuristic_cache_misses; }
+    uint64_t get_num_unpacked_state_cache_hits() const { return m_num_unpacked_state_cache_hits; }
+    uint64_t get_num_unpacked_state_cache_misses() const { return m_num_unpacked_state_cache_misses; }
+    uint64_t get_num_bytes_for_unpacked_state_cache() const { return m_num_bytes_for_unpacked_state_cache; }
 
     std::chrono::milliseconds get_search_time_ms() const
     {
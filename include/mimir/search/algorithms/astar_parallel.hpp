@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_ASTAR_PARALLEL_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_ASTAR_PARALLEL_HPP_
+
+#include "mimir/common/types_cista.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/algorithms/utils.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/state.hpp"
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/// @brief Hash distributed A* (HDA*).
+///
+/// Each worker thread owns the states whose `PackedStateImpl` hashes to it.
+/// A worker keeps its own open list and search nodes for its shard and
+/// forwards generated successors to their owners through lock-free mailboxes.
+/// The search terminates once every worker is idle, no message is in flight,
+/// and no open node has an f-value below the cost of the best solution found,
+/// which preserves optimality for admissible heuristics.
+///
+/// Each worker expands states with its own applicable action generator and heuristic,
+/// and idle workers block on their mailbox. Only the event handler is shared and locked.
+/// Running more than one worker requires a thread-safe state repository and grounded applicable action generators,
+/// since lifted ones ground actions on the fly, which throws a `std::runtime_error` otherwise,
+/// and a goal strategy whose `test_dynamic_goal` can be called concurrently.
+namespace mimir::search::astar_parallel
+{
+struct Options
+{
+    std::optional<State> start_state = std::nullopt;
+    astar_eager::EventHandler event_handler = nullptr;
+    GoalStrategy goal_strategy = nullptr;
+    size_t num_threads = 1;
+    /// @brief Create the grounded applicable action generator of each worker 1, ..., `num_threads` - 1.
+    /// Worker 0 uses the applicable action generator of the search context.
+    std::function<ApplicableActionGenerator()> create_applicable_action_generator = nullptr;
+    /// @brief Create the heuristic of each worker 1, ..., `num_threads` - 1. Worker 0 uses the given heuristic.
+    std::function<Heuristic()> create_heuristic = nullptr;
+    uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
+    uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+
+    Options() = default;
+};
+
+extern SearchResult find_solution(const SearchContext& context, const Heuristic& heuristic, const Options& options = Options());
+
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_BFWS_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_BFWS_HPP_
+
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/algorithms/utils.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/state.hpp"
+
+#include <limits>
+#include <optional>
+
+namespace mimir::search::bfws
+{
+struct Options
+{
+    std::optional<State> start_state = std::nullopt;
+    EventHandler event_handler = nullptr;
+    GoalStrategy goal_strategy = nullptr;
+    PruningStrategy pruning_strategy = nullptr;
+    /// @brief The novelty of a state is the size of its smallest novel tuple of atoms up to this arity, and `max_arity + 1` otherwise.
+    size_t max_arity = 2;
+    uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
+    uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    /// @brief Stop with `SearchStatus::OUT_OF_MEMORY` once the estimated memory usage of the search exceeds this budget.
+    uint64_t max_memory_in_bytes = std::numeric_limits<uint64_t>::max();
+
+    Options() = default;
+};
+
+/// @brief Find a solution with best-first width search BFWS(f5) by Lipovetzky and Geffner (2017).
+///
+/// States are expanded in the order of their novelty, then of their number of unsatisfied goals #g.
+/// The novelty of a state is measured among the generated states with the same #g and #r,
+/// where #r is the number of atoms added by the relaxed plan of its closest ancestor with a lower #g that were false in that ancestor.
+/// The relaxed plan is recomputed with the `FFHeuristic` whenever #g decreases.
+/// @param context is the search context.
+/// @param heuristic is the FF heuristic that computes the relaxed plans.
+/// @param options are the options.
+/// @return the search result.
+extern SearchResult find_solution(const SearchContext& context, const FFHeuristic& heuristic, const Options& options = Options());
+}
+
+#endif
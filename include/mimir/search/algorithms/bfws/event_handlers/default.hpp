@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_BFWS_EVENT_HANDLERS_DEFAULT_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_BFWS_EVENT_HANDLERS_DEFAULT_HPP_
+
+#include "mimir/search/algorithms/bfws/event_handlers/interface.hpp"
+
+namespace mimir::search::bfws
+{
+
+/**
+ * Implementation class
+ */
+class DefaultEventHandlerImpl : public EventHandlerBase<DefaultEventHandlerImpl>
+{
+private:
+    /* Implement EventHandlerBase interface */
+    friend class EventHandlerBase<DefaultEventHandlerImpl>;
+
+    void on_expand_state_impl(const State& state) const;
+
+    void on_expand_goal_state_impl(const State& state) const;
+
+    void
+    on_generate_state_impl(const State& state, formalism::GroundAction action, ContinuousCost action_cost, const State& successor_state, size_t novelty) const;
+
+    void on_prune_state_impl(const State& state) const;
+
+    void on_dead_end_state_impl(const State& state) const;
+
+    void on_start_search_impl(const State& start_state, ContinuousCost g_value, size_t num_unsatisfied_goals) const;
+
+    void on_new_best_num_unsatisfied_goals_impl(size_t num_unsatisfied_goals, uint64_t num_expanded_states, uint64_t num_generated_states) const;
+
+    void on_end_search_impl() const;
+
+    void on_solved_impl(const Plan& plan) const;
+
+    void on_unsolvable_impl() const;
+
+    void on_exhausted_impl() const;
+
+public:
+    DefaultEventHandlerImpl(formalism::Problem problem, bool quiet = true);
+
+    static DefaultEventHandler create(formalism::Problem problem, bool quiet = true);
+};
+
+}
+
+#endif
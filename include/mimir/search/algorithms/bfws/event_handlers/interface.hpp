@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_BFWS_EVENT_HANDLERS_INTERFACE_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_BFWS_EVENT_HANDLERS_INTERFACE_HPP_
+
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/algorithms/bfws/event_handlers/statistics.hpp"
+#include "mimir/search/declarations.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+
+namespace mimir::search::bfws
+{
+
+/**
+ * Interface class
+ */
+
+/// @brief `IEventHandler` to react on event during BFWS search.
+class IEventHandler
+{
+public:
+    virtual ~IEventHandler() = default;
+
+    /// @brief React on expanding a state. This is called immediately after popping from the queue.
+    virtual void on_expand_state(const State& state) = 0;
+
+    /// @brief React on expanding a goal `state`. This may be called after on_expand_state.
+    virtual void on_expand_goal_state(const State& state) = 0;
+
+    /// @brief React on generating a successor `state` with the given `novelty` by applying an action.
+    virtual void
+    on_generate_state(const State& state, formalism::GroundAction action, ContinuousCost action_cost, const State& successor_state, size_t novelty) = 0;
+
+    /// @brief React on pruning a state.
+    virtual void on_prune_state(const State& state) = 0;
+
+    /// @brief React on detecting a dead end `state`, i.e., a state without a relaxed plan.
+    virtual void on_dead_end_state(const State& state) = 0;
+
+    /// @brief React on computing a relaxed plan for a `state` with the given FF heuristic value.
+    virtual void on_compute_relaxed_plan(const State& state, ContinuousCost h_value) = 0;
+
+    /// @brief React on starting a search.
+    virtual void on_start_search(const State& start_state, ContinuousCost g_value, size_t num_unsatisfied_goals) = 0;
+
+    /// @brief React on a new lowest number of unsatisfied goals.
+    virtual void on_new_best_num_unsatisfied_goals(size_t num_unsatisfied_goals) = 0;
+
+    /// @brief React on ending a search.
+    virtual void on_end_search(uint64_t num_reached_fluent_atoms,
+                               uint64_t num_reached_derived_atoms,
+                               uint64_t num_states,
+                               uint64_t num_nodes,
+                               uint64_t num_partitions,
+                               uint64_t novelty_table_memory_usage_in_bytes) = 0;
+
+    /// @brief React on solving a search.
+    virtual void on_solved(const Plan& plan) = 0;
+
+    /// @brief React on proving unsolvability during a search.
+    virtual void on_unsolvable() = 0;
+
+    /// @brief React on exhausting a search.
+    virtual void on_exhausted() = 0;
+
+    virtual const Statistics& get_statistics() const = 0;
+};
+
+/**
+ * Static base class (for C++)
+ *
+ * Collect statistics and call implementation of derived class.
+ */
+template<typename Derived_>
+class EventHandlerBase : public IEventHandler
+{
+protected:
+    Statistics m_statistics;
+    formalism::Problem m_problem;
+    bool m_quiet;
+
+private:
+    EventHandlerBase() = default;
+    friend Derived_;
+
+    /// @brief Helper to cast to Derived.
+    constexpr const auto& self() const { return static_cast<const Derived_&>(*this); }
+    constexpr auto& self() { return static_cast<Derived_&>(*this); }
+
+public:
+    EventHandlerBase(formalism::Problem problem, bool quiet = true) : m_statistics(), m_problem(problem), m_quiet(quiet) {}
+
+    void on_expand_state(const State& state) override
+    {
+        m_statistics.increment_num_expanded();
+
+        if (!m_quiet)
+        {
+            self().on_expand_state_impl(state);
+        }
+    }
+
+    void on_expand_goal_state(const State& state) override
+    {
+        if (!m_quiet)
+        {
+            self().on_expand_goal_state_impl(state);
+        }
+    }
+
+    void on_generate_state(const State& state, formalism::GroundAction action, ContinuousCost action_cost, const State& successor_state, size_t novelty) override
+    {
+        m_statistics.increment_num_generated(novelty);
+
+        if (!m_quiet)
+        {
+            self().on_generate_state_impl(state, action, action_cost, successor_state, novelty);
+        }
+    }
+
+    void on_prune_state(const State& state) override
+    {
+        m_statistics.increment_num_pruned();
+
+        if (!m_quiet)
+        {
+            self().on_prune_state_impl(state);
+        }
+    }
+
+    void on_dead_end_state(const State& state) override
+    {
+        m_statistics.increment_num_deadends();
+
+        if (!m_quiet)
+        {
+            self().on_dead_end_state_impl(state);
+        }
+    }
+
+    void on_compute_relaxed_plan(const State& state, ContinuousCost h_value) override { m_statistics.increment_num_relaxed_plans(); }
+
+    void on_start_search(const State& start_state, ContinuousCost g_value, size_t num_unsatisfied_goals) override
+    {
+        m_statistics = Statistics();
+
+        m_statistics.set_search_start_time_point(std::chrono::high_resolution_clock::now());
+
+        if (!m_quiet)
+        {
+            self().on_start_search_impl(start_state, g_value, num_unsatisfied_goals);
+        }
+    }
+
+    void on_new_best_num_unsatisfied_goals(size_t num_unsatisfied_goals) override
+    {
+        if (!m_quiet)
+        {
+            self().on_new_best_num_unsatisfied_goals_impl(num_unsatisfied_goals, m_statistics.get_num_expanded(), m_statistics.get_num_generated());
+        }
+    }
+
+    void on_end_search(uint64_t num_reached_fluent_atoms,
+                       uint64_t num_reached_derived_atoms,
+                       uint64_t num_states,
+                       uint64_t num_nodes,
+                       uint64_t num_partitions,
+                       uint64_t novelty_table_memory_usage_in_bytes) override
+    {
+        m_statistics.set_search_end_time_point(std::chrono::high_resolution_clock::now());
+        m_statistics.set_num_reached_fluent_atoms(num_reached_fluent_atoms);
+        m_statistics.set_num_reached_derived_atoms(num_reached_derived_atoms);
+        m_statistics.set_num_states(num_states);
+        m_statistics.set_num_nodes(num_nodes);
+        m_statistics.set_num_partitions(num_partitions);
+        m_statistics.set_novelty_table_memory_usage_in_bytes(novelty_table_memory_usage_in_bytes);
+
+        if (!m_quiet)
+        {
+            self().on_end_search_impl();
+        }
+    }
+
+    void on_solved(const Plan& plan) override
+    {
+        if (!m_quiet)
+        {
+            self().on_solved_impl(plan);
+        }
+    }
+
+    void on_unsolvable() override
+    {
+        if (!m_quiet)
+        {
+            self().on_unsolvable_impl();
+        }
+    }
+
+    void on_exhausted() override
+    {
+        if (!m_quiet)
+        {
+            self().on_exhausted_impl();
+        }
+    }
+
+    /**
+     * Getters
+     */
+
+    const Statistics& get_statistics() const override { return m_statistics; }
+    bool is_quiet() const { return m_quiet; }
+};
+
+}
+
+#endif
@@ -38,10 +38,27 @@ struct Options
     bool stop_if_goal = true;
     uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
     uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    /// @brief Stop with `SearchStatus::OUT_OF_MEMORY` once the estimated memory usage of the search exceeds this budget.
+    uint64_t max_memory_in_bytes = std::numeric_limits<uint64_t>::max();
+    /// @brief Replace the closed list by a Bloom filter with this number of bits over the hashes of the fluent atoms and numeric variables if positive.
+    uint64_t bitstate_num_bits = 0;
+    /// @brief The number of bits that are set per state in the Bloom filter. A single bit per state is bitstate hashing.
+    uint32_t bitstate_num_hash_functions = 1;
+    /// @brief The maximum number of states that are kept in memory while expanding a layer in the bitstate mode.
+    uint32_t bitstate_max_num_states_in_memory = 1 << 16;
 
     Options() = default;
 };
 
+/// @brief Find a plan with breadth-first search.
+///
+/// If `bitstate_num_bits` is positive, duplicates are detected with a Bloom filter instead of the closed list.
+/// A state that is reported as visited by a false positive is omitted together with the states that are only reachable through it,
+/// and the estimated omission probability is reported with `IEventHandler::on_end_bitstate_search`.
+/// In this mode, only the records of the states in the current and next layer are kept besides the Bloom filter,
+/// and the `pruning_strategy` is ignored.
+/// Each state keeps its position in the previous layer and its generating action (8 bytes) so that a plan can be extracted.
+/// The number of states is bounded by `max_num_states` as before.
 extern SearchResult find_solution(const SearchContext& context, const Options& options = Options());
 
 }
@@ -60,6 +60,8 @@ private:
                             uint64_t num_actions,
                             uint64_t num_axioms) const;
 
+    void on_end_bitstate_search_impl(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) const;
+
     void on_solved_impl(const Plan& plan) const;
 
     void on_unsolvable_impl() const;
@@ -68,6 +68,12 @@ public:
                                uint64_t num_actions,
                                uint64_t num_axioms) = 0;
 
+    /// @brief React on ending a search whose closed list is a Bloom filter. This is called immediately after on_end_search.
+    /// @param num_bits is the number of bits of the Bloom filter.
+    /// @param num_set_bits is the number of bits that are set.
+    /// @param estimated_omission_probability is the estimated probability that at least one reachable state was not visited.
+    virtual void on_end_bitstate_search(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) = 0;
+
     /// @brief React on solving a search.
     virtual void on_solved(const Plan& plan) = 0;
 
@@ -193,6 +199,17 @@ public:
         }
     }
 
+    void on_end_bitstate_search(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) override
+    {
+        m_statistics.set_num_bitstate_bits(num_bits);
+        m_statistics.set_estimated_omission_probability(estimated_omission_probability);
+
+        if (!m_quiet)
+        {
+            self().on_end_bitstate_search_impl(num_bits, num_set_bits, estimated_omission_probability);
+        }
+    }
+
     void on_solved(const Plan& plan) override
     {
         if (!m_quiet)
@@ -49,6 +49,9 @@ private:
     uint64_t m_num_actions;
     uint64_t m_num_axioms;
 
+    uint64_t m_num_bitstate_bits;
+    double m_estimated_omission_probability;
+
 public:
     Statistics() :
         m_num_generated(0),
@@ -64,7 +67,9 @@ public:
         m_num_states(0),
         m_num_nodes(0),
         m_num_actions(0),
-        m_num_axioms(0)
+        m_num_axioms(0),
+        m_num_bitstate_bits(0),
+        m_estimated_omission_probability(0.)
     {
     }
 
@@ -96,6 +101,9 @@ public:
     void set_num_actions(uint64_t num_actions) { m_num_actions = num_actions; }
     void set_num_axioms(uint64_t num_axioms) { m_num_axioms = num_axioms; }
 
+    void set_num_bitstate_bits(uint64_t num_bitstate_bits) { m_num_bitstate_bits = num_bitstate_bits; }
+    void set_estimated_omission_probability(double estimated_omission_probability) { m_estimated_omission_probability = estimated_omission_probability; }
+
     /**
      * Getters
      */
@@ -121,6 +129,10 @@ public:
     uint64_t get_num_nodes() const { return m_num_nodes; }
     uint64_t get_num_actions() const { return m_num_actions; }
     uint64_t get_num_axioms() const { return m_num_axioms; }
+    /// @brief Return the number of bits of the Bloom filter that replaced the closed list, or 0 if duplicates were detected exactly.
+    uint64_t get_num_bitstate_bits() const { return m_num_bitstate_bits; }
+    /// @brief Return the estimated probability that at least one reachable state was not visited, which is 0 if duplicates were detected exactly.
+    double get_estimated_omission_probability() const { return m_estimated_omission_probability; }
 
     const std::vector<uint64_t>& get_num_generated_until_g_value() const { return m_num_generated_until_g_value; }
     const std::vector<uint64_t>& get_num_expanded_until_g_value() const { return m_num_expanded_until_g_value; }
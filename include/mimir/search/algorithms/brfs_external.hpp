@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_BRFS_EXTERNAL_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_BRFS_EXTERNAL_HPP_
+
+#include "mimir/common/filesystem.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/algorithms/brfs.hpp"
+#include "mimir/search/algorithms/utils.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/state.hpp"
+
+#include <optional>
+
+/// @brief External-memory breadth-first search with delayed duplicate detection.
+///
+/// Each g-layer is stored as a sorted sequence of states in a memory-mapped file.
+/// The successors of a layer are collected in sorted runs of bounded size
+/// and merged on disk, removing the states that occur in a window of earlier layers.
+/// States are rebuilt layer by layer in a temporary state repository with private tables
+/// that is discarded whenever it holds `max_num_states_in_memory` states.
+/// If the window covers all earlier layers, the g-layers, and hence the goal distances, coincide with `brfs::find_solution`.
+namespace mimir::search::brfs_external
+{
+struct Options
+{
+    std::optional<State> start_state = std::nullopt;
+    /// @brief Receives the same events as in `brfs::find_solution`.
+    /// `on_generate_state_in_search_tree` is called for successors that are not duplicates of a state in memory.
+    /// Such a successor may still be removed when the layer is merged with the earlier layers.
+    brfs::EventHandler event_handler = nullptr;
+    GoalStrategy goal_strategy = nullptr;
+    bool stop_if_goal = true;
+    /// @brief The directory in which the layer files are created. Uses the temporary directory if empty.
+    /// The files are removed when the search ends.
+    fs::path directory = fs::path();
+    /// @brief The maximum number of states that are kept in memory while expanding a layer.
+    uint32_t max_num_states_in_memory = 1 << 20;
+    /// @brief The number of most recent layers, including the expanded one, that are checked for duplicates of the successors.
+    /// If successors are at most `k - 1` layers before their predecessor, `k` layers suffice, e.g., 2 if every action can be undone by one action.
+    /// A smaller window may expand states again in later layers.
+    uint32_t num_layers_for_duplicate_detection = std::numeric_limits<uint32_t>::max();
+    uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
+    uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+
+    Options() = default;
+};
+
+extern SearchResult find_solution(const SearchContext& context, const Options& options = Options());
+
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_CHECKPOINT_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_CHECKPOINT_HPP_
+
+#include "cista/containers/vector.h"
+#include "cista/mmap.h"
+#include "cista/serialization.h"
+#include "cista/targets/buf.h"
+#include "mimir/common/filesystem.hpp"
+#include "mimir/common/segmented_vector.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/search_node.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/// @brief Checkpoints store the progress of a search such that an interrupted search can be resumed.
+///
+/// A checkpoint consists of two files. The file `checkpoint_file` stores the search nodes, ordered by state index,
+/// the open list entries, which refer to states by index, and a few algorithm specific values.
+/// The file `get_checkpoint_states_file(checkpoint_file)` stores the states of the state repository.
+/// Both files are first written under a temporary name and then renamed, states first.
+/// Since states are never removed from a repository, an older search file remains consistent with a newer states file.
+namespace mimir::search
+{
+
+/// @brief The layout of a file written by `save_checkpoint`.
+struct SerializedCheckpoint
+{
+    uint64_t search_node_size;
+    uint64_t entry_size;
+    cista::offset::vector<uint8_t> search_nodes;  ///< The search nodes ordered by state index.
+    cista::offset::vector<uint8_t> entries;       ///< The open list entries.
+    cista::offset::vector<double> values;         ///< Algorithm specific values.
+};
+
+inline constexpr auto CHECKPOINT_SERIALIZATION_MODE = cista::mode::WITH_VERSION | cista::mode::WITH_INTEGRITY;
+
+inline fs::path get_checkpoint_states_file(const fs::path& checkpoint_file)
+{
+    auto states_file = checkpoint_file;
+    states_file += ".states";
+    return states_file;
+}
+
+/// @brief Write a checkpoint of a search.
+/// @tparam SearchNode is the search node type, whose `parent_state` member is a state index.
+/// @tparam Entry is the open list entry type, whose `state_index` member is a state index.
+/// @param checkpoint_file is the file to write.
+/// @param state_repository is the state repository of the search.
+/// @param search_nodes are the search nodes ordered by state index.
+/// @param entries are the open list entries.
+/// @param values are algorithm specific values.
+template<typename SearchNode, typename Entry>
+void save_checkpoint(const fs::path& checkpoint_file,
+                     const StateRepositoryImpl& state_repository,
+                     const SegmentedVector<SearchNode>& search_nodes,
+                     const std::vector<Entry>& entries,
+                     const std::vector<double>& values)
+{
+    static_assert(std::is_trivially_copyable_v<SearchNode> && std::is_trivially_copyable_v<Entry>);
+
+    const auto states_file = get_checkpoint_states_file(checkpoint_file);
+    auto tmp_states_file = states_file;
+    tmp_states_file += ".tmp";
+    auto tmp_checkpoint_file = checkpoint_file;
+    tmp_checkpoint_file += ".tmp";
+
+    state_repository.serialize(tmp_states_file);
+
+    {
+        auto data = SerializedCheckpoint();
+        data.search_node_size = sizeof(SearchNode);
+        data.entry_size = sizeof(Entry);
+
+        data.search_nodes.resize(search_nodes.size() * sizeof(SearchNode));
+        for (size_t i = 0; i < search_nodes.size(); ++i)
+        {
+            std::memcpy(data.search_nodes.data() + i * sizeof(SearchNode), &search_nodes[i], sizeof(SearchNode));
+        }
+        data.entries.resize(entries.size() * sizeof(Entry));
+        if (!entries.empty())
+        {
+            std::memcpy(data.entries.data(), entries.data(), entries.size() * sizeof(Entry));
+        }
+        for (const auto value : values)
+        {
+            data.values.push_back(value);
+        }
+
+        auto buf = cista::buf<cista::mmap>(cista::mmap(tmp_checkpoint_file.string().c_str(), cista::mmap::protection::WRITE));
+        cista::serialize<CHECKPOINT_SERIALIZATION_MODE>(buf, data);
+    }
+
+    fs::rename(tmp_states_file, states_file);
+    fs::rename(tmp_checkpoint_file, checkpoint_file);
+}
+
+/// @brief Read a checkpoint written by `save_checkpoint` for the same problem.
+/// The states are created in `state_repository` and all state indices are translated to the indices in `state_repository`.
+/// Ground action indices depend on the order of grounding, so parent actions are reset to unknown and recomputed during plan extraction.
+/// @param checkpoint_file is the file to read.
+/// @param state_repository is the state repository of the search.
+/// @param default_node is the search node of states that have none.
+/// @param out_search_nodes are the search nodes ordered by state index.
+/// @param on_entry is called with each open list entry and the packed state it refers to.
+/// @return the algorithm specific values.
+template<typename SearchNode, typename Entry, typename F>
+std::vector<double> load_checkpoint(const fs::path& checkpoint_file,
+                                    StateRepositoryImpl& state_repository,
+                                    const SearchNode& default_node,
+                                    SegmentedVector<SearchNode>& out_search_nodes,
+                                    F&& on_entry)
+{
+    static_assert(std::is_trivially_copyable_v<SearchNode> && std::is_trivially_copyable_v<Entry>);
+
+    const auto packed_states = state_repository.deserialize(get_checkpoint_states_file(checkpoint_file));
+    auto state_indices = IndexList {};
+    for (const auto& packed_state : packed_states)
+    {
+        state_indices.push_back(state_repository.get_state_index(*packed_state));
+    }
+
+    const auto mmap = cista::mmap(checkpoint_file.string().c_str(), cista::mmap::protection::READ);
+    const auto* data = cista::deserialize<const SerializedCheckpoint, CHECKPOINT_SERIALIZATION_MODE>(mmap.data(), mmap.data() + mmap.size());
+
+    if (data->search_node_size != sizeof(SearchNode) || data->entry_size != sizeof(Entry))
+    {
+        throw std::runtime_error("load_checkpoint: the file " + checkpoint_file.string() + " was written by a different search algorithm.");
+    }
+
+    const auto num_search_nodes = data->search_nodes.size() / sizeof(SearchNode);
+    for (size_t i = 0; i < num_search_nodes; ++i)
+    {
+        auto search_node = SearchNode();
+        std::memcpy(&search_node, data->search_nodes.data() + i * sizeof(SearchNode), sizeof(SearchNode));
+        if (search_node.parent_state != MAX_INDEX)
+        {
+            search_node.parent_state = state_indices.at(search_node.parent_state);
+        }
+        if constexpr (IsSearchNodeWithParentAction<SearchNode>)
+        {
+            search_node.parent_action = SearchNode::UNKNOWN_PARENT_ACTION;
+        }
+
+        const auto state_index = state_indices.at(i);
+        while (state_index >= out_search_nodes.size())
+        {
+            out_search_nodes.push_back(default_node);
+        }
+        out_search_nodes[state_index] = search_node;
+    }
+
+    const auto num_entries = data->entries.size() / sizeof(Entry);
+    for (size_t i = 0; i < num_entries; ++i)
+    {
+        auto entry = Entry();
+        std::memcpy(&entry, data->entries.data() + i * sizeof(Entry), sizeof(Entry));
+
+        on_entry(entry, packed_states.at(entry.state_index));
+    }
+
+    return std::vector<double>(data->values.begin(), data->values.end());
+}
+
+}
+
+#endif
@@ -53,6 +53,15 @@ public:
     /// @brief React on pruning a state.
     virtual void on_prune_state(const State& state) = 0;
 
+    /// @brief React on finding the heuristic value of a `state` in the heuristic cache.
+    virtual void on_heuristic_cache_hit(const State& state) = 0;
+
+    /// @brief React on computing the heuristic value of a `state` because it is not in the heuristic cache.
+    virtual void on_heuristic_cache_miss(const State& state) = 0;
+
+    /// @brief React on the statistics of the unpacked state cache of the state repository, which are reported before ending a search.
+    virtual void on_unpacked_state_cache_statistics(uint64_t num_hits, uint64_t num_misses, uint64_t num_bytes) = 0;
+
     /// @brief React on starting a search.
     virtual void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) = 0;
 
@@ -141,6 +150,17 @@ public:
         }
     }
 
+    void on_heuristic_cache_hit(const State& state) override { m_statistics.increment_num_heuristic_cache_hits(); }
+
+    void on_heuristic_cache_miss(const State& state) override { m_statistics.increment_num_heuristic_cache_misses(); }
+
+    void on_unpacked_state_cache_statistics(uint64_t num_hits, uint64_t num_misses, uint64_t num_bytes) override
+    {
+        m_statistics.set_num_unpacked_state_cache_hits(num_hits);
+        m_statistics.set_num_unpacked_state_cache_misses(num_misses);
+        m_statistics.set_num_bytes_for_unpacked_state_cache(num_bytes);
+    }
+
     void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) override
     {
         m_statistics = Statistics();
@@ -40,6 +40,8 @@ struct Options
     ExplorationStategy exploration_strategy = nullptr;
     uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
     uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    /// @brief Stop with `SearchStatus::OUT_OF_MEMORY` once the estimated memory usage of the search exceeds this budget.
+    uint64_t max_memory_in_bytes = std::numeric_limits<uint64_t>::max();
     std::array<size_t, 6> openlist_weights = { 1, 1, 1, 1, 64, 1 };
 
     Options() = default;
@@ -30,6 +30,8 @@ struct Options
     brfs::EventHandler brfs_event_handler = nullptr;
     GoalStrategy goal_strategy = nullptr;
     size_t max_arity = MAX_ARITY - 1;
+    /// @brief Stop with `SearchStatus::OUT_OF_MEMORY` once the estimated memory usage of the search exceeds this budget.
+    uint64_t max_memory_in_bytes = std::numeric_limits<uint64_t>::max();
 
     Options() = default;
 };
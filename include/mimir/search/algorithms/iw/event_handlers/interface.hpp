@@ -44,8 +44,8 @@ public:
     /// @brief React on starting a search.
     virtual void on_start_arity_search(const State& initial_state, size_t arity) = 0;
 
-    /// @brief React on starting a search.
-    virtual void on_end_arity_search(const brfs::Statistics& brfs_statistics) = 0;
+    /// @brief React on ending a search with a fixed arity.
+    virtual void on_end_arity_search(const brfs::Statistics& brfs_statistics, size_t novelty_table_memory_usage_in_bytes) = 0;
 
     /// @brief React on ending a search.
     virtual void on_end_search() = 0;
@@ -107,9 +107,10 @@ public:
         }
     }
 
-    void on_end_arity_search(const brfs::Statistics& brfs_statistics) override
+    void on_end_arity_search(const brfs::Statistics& brfs_statistics, size_t novelty_table_memory_usage_in_bytes) override
     {
         m_statistics.push_back_algorithm_statistics(brfs_statistics);
+        m_statistics.push_back_novelty_table_memory_usage_in_bytes(novelty_table_memory_usage_in_bytes);
 
         if (!m_quiet)
         {
@@ -32,14 +32,16 @@ class Statistics
 {
 private:
     brfs::StatisticsList m_brfs_statistics_by_arity;
+    std::vector<size_t> m_novelty_table_memory_usage_in_bytes_by_arity;
 
     std::chrono::time_point<std::chrono::high_resolution_clock> m_search_start_time_point;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_search_end_time_point;
 
 public:
-    Statistics() : m_brfs_statistics_by_arity() {}
+    Statistics() : m_brfs_statistics_by_arity(), m_novelty_table_memory_usage_in_bytes_by_arity() {}
 
     void push_back_algorithm_statistics(brfs::Statistics algorithm_statistics) { m_brfs_statistics_by_arity.push_back(std::move(algorithm_statistics)); }
+    void push_back_novelty_table_memory_usage_in_bytes(size_t num_bytes) { m_novelty_table_memory_usage_in_bytes_by_arity.push_back(num_bytes); }
 
     void set_search_start_time_point(std::chrono::time_point<std::chrono::high_resolution_clock> time_point) { m_search_start_time_point = time_point; }
     void set_search_end_time_point(std::chrono::time_point<std::chrono::high_resolution_clock> time_point) { m_search_end_time_point = time_point; }
@@ -52,6 +54,7 @@ public:
     }
 
     const brfs::StatisticsList& get_brfs_statistics_by_arity() const { return m_brfs_statistics_by_arity; }
+    const std::vector<size_t>& get_novelty_table_memory_usage_in_bytes_by_arity() const { return m_novelty_table_memory_usage_in_bytes_by_arity; }
 };
 
 /**
@@ -22,27 +22,55 @@
 #include "mimir/search/algorithms/iw/tuple_index_mapper.hpp"
 #include "mimir/search/declarations.hpp"
 
+#include <absl/container/flat_hash_set.h>
 #include <concepts>
+#include <cstdint>
 
 namespace mimir::search::iw
 {
 
 /// @brief `DynamicNoveltyTable` encapsulates a table to test novelty of tuples of atoms of size at most arity.
+///
+/// The table starts dense, i.e., as a bitset over all tuple indices of the `TupleIndexMapper`.
+/// For arity one and two, the dense table is updated on state pairs with word-parallel operations on the atom bitsets.
 /// It automatically resizes when the atoms do not fit into the table anymore.
 /// When the table resizes, tuple indices are remapped to take into account the higher number of atoms.
+/// When a dense table would have more than `MAX_DENSE_TABLE_SIZE` entries, the table switches to a sparse table
+/// that only stores the tuples that were seen, packed into 64-bit keys with one field per atom.
+/// The sparse table does not depend on the number of atoms and never needs to be remapped.
 class DynamicNoveltyTable
 {
 private:
     TupleIndexMapper m_tuple_index_mapper;
 
-    std::vector<bool> m_table;
+    std::vector<uint64_t> m_table;
+
+    bool m_is_sparse;
+    size_t m_num_bits_per_atom;
+    absl::flat_hash_set<uint64_t> m_sparse_table;
 
     void resize_to_fit(AtomIndex atom_index);
     void resize_to_fit(const State& state);
 
+    void switch_to_sparse_table();
+
+    bool test_novelty_and_update_dense_table_of_arity_one(const State& state, const State& succ_state);
+    bool test_novelty_and_update_dense_table_of_arity_two(const State& state, const State& succ_state);
+
+    uint64_t to_sparse_key(const AtomIndexList& atom_indices) const;
+    void to_atom_indices(uint64_t sparse_key, AtomIndexList& out_atom_indices) const;
+
+    template<typename Callback>
+    void for_each_sparse_key(size_t begin, size_t depth, uint64_t key, Callback& callback) const;
+    template<typename Callback>
+    void for_each_sparse_pair_key(size_t begin, size_t depth, uint64_t key, bool has_added_atom, Callback& callback) const;
+
     // Preallocated memory that will be modified.
     StateTupleIndexGenerator m_state_tuple_index_generator;
     StatePairTupleIndexGenerator m_state_pair_tuple_index_generator;
+    AtomIndexList m_atom_indices;
+    IndexList m_next_added_atom_positions;
+    std::vector<uint64_t> m_added_atom_words;
 
 public:
     explicit DynamicNoveltyTable(size_t arity);
@@ -58,7 +86,11 @@ public:
 
     void reset();
 
+    /// @brief Get the tuple index mapper that defines the layout of the dense table.
+    /// After switching to a sparse table, it keeps the number of atoms at the time of the switch.
     const TupleIndexMapper& get_tuple_index_mapper() const;
+    bool is_sparse() const;
+    size_t get_estimated_memory_usage_in_bytes() const;
 };
 
 }
@@ -56,6 +56,8 @@ public:
 
     bool test_prune_initial_state(const State& state) override;
     bool test_prune_successor_state(const State& state, const State& succ_state, bool is_new_succ) override;
+
+    const DynamicNoveltyTable& get_novelty_table() const;
 };
 }
 
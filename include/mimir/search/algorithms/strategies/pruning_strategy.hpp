@@ -32,6 +32,14 @@ public:
 
     virtual bool test_prune_initial_state(const State& state) = 0;
     virtual bool test_prune_successor_state(const State& state, const State& succ_state, bool is_new_succ) = 0;
+
+    /// @brief Test whether a successor that is reached with cost `succ_g_value` must be pruned.
+    /// Optimal searches call this variant so that strategies can keep successors that are cheaper than the states they subsume.
+    /// The default ignores the cost.
+    virtual bool test_prune_successor_state_with_g_value(const State& state, const State& succ_state, bool is_new_succ, ContinuousCost succ_g_value)
+    {
+        return test_prune_successor_state(state, succ_state, is_new_succ);
+    }
 };
 
 /// @brief `NoPruningStrategyImpl` never prunes a newly generated state.
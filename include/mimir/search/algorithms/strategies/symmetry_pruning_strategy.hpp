@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_STRATEGIES_SYMMETRY_PRUNING_STRATEGY_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_STRATEGIES_SYMMETRY_PRUNING_STRATEGY_HPP_
+
+#include "mimir/common/declarations.hpp"
+#include "mimir/datasets/object_graph.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/graphs/algorithms/color_refinement.hpp"
+#include "mimir/graphs/algorithms/nauty.hpp"
+#include "mimir/search/algorithms/strategies/pruning_strategy.hpp"
+#include "mimir/search/declarations.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+namespace mimir::search
+{
+
+/// @brief `SymmetryPruningStrategyImpl` prunes a newly generated state if a symmetric state was generated before.
+///
+/// Two states are symmetric if the canonical certificates of their object graphs are equal.
+/// The object graph encodes the goal, hence symmetric states have the same goal distance.
+/// Without costs, the first generated state of each equivalence class is kept, which is sufficient for satisficing searches.
+/// With costs, a symmetric state is only pruned if its equivalence class was reached with a lower or equal cost,
+/// which preserves the optimality of A* for heuristics that assign equal values to symmetric states.
+/// States are only pruned and never replaced by their representatives, so plans consist of the actions in the original state space.
+/// Numeric variables are not encoded in the object graph, hence problems with fluent numeric variables are rejected.
+/// The state indices must stem from a single `StateRepositoryImpl`.
+class SymmetryPruningStrategyImpl : public IPruningStrategy
+{
+public:
+    enum class CertificateType
+    {
+        GI,   ///< Canonical graph computed by nauty, which identifies states up to isomorphism.
+        WL1,  ///< Color refinement certificate, which is cheaper but may also identify non-isomorphic states, i.e., pruning can be incomplete.
+    };
+
+    struct Statistics
+    {
+        uint64_t num_certificates = 0;                                            ///< The number of computed certificates.
+        uint64_t num_certificate_cache_hits = 0;                                  ///< The number of states whose representative was cached.
+        uint64_t num_equivalence_classes = 0;                                     ///< The number of distinct certificates.
+        uint64_t num_pruned_states = 0;                                           ///< The number of successor states that were pruned.
+        uint64_t num_improving_states = 0;                                        ///< The number of kept symmetric states that improved their class.
+        std::chrono::nanoseconds certificate_time = std::chrono::nanoseconds(0);  ///< The time spent on object graphs and certificates.
+
+        std::chrono::milliseconds get_certificate_time_ms() const { return std::chrono::duration_cast<std::chrono::milliseconds>(certificate_time); }
+    };
+
+    SymmetryPruningStrategyImpl(formalism::Problem problem, CertificateType certificate_type = CertificateType::GI);
+
+    static SymmetryPruningStrategy create(formalism::Problem problem, CertificateType certificate_type = CertificateType::GI);
+
+    bool test_prune_initial_state(const State& state) override;
+    bool test_prune_successor_state(const State& state, const State& succ_state, bool is_new_succ) override;
+    bool test_prune_successor_state_with_g_value(const State& state, const State& succ_state, bool is_new_succ, ContinuousCost succ_g_value) override;
+
+    /// @brief Return the index of the first generated state that is symmetric to the given `state`.
+    Index get_or_create_representative(const State& state);
+
+    CertificateType get_certificate_type() const;
+    const formalism::Problem& get_problem() const;
+    const Statistics& get_statistics() const;
+
+private:
+    formalism::Problem m_problem;
+    CertificateType m_certificate_type;
+
+    UnorderedMap<graphs::nauty::SparseGraph, Index> m_gi_certificate_to_representative;
+    std::unordered_map<graphs::color_refinement::CertificateImpl,
+                       Index,
+                       loki::Hash<graphs::color_refinement::CertificateImpl>,
+                       std::equal_to<graphs::color_refinement::CertificateImpl>>
+        m_wl1_certificate_to_representative;  ///< Compares the full certificate because its identifying members omit the color compression.
+
+    IndexMap<Index> m_state_to_representative;             ///< The certificate cache.
+    IndexMap<ContinuousCost> m_representative_to_g_value;  ///< The lowest cost with which a state of each equivalence class was reached.
+
+    datasets::ObjectGraphBuilder m_object_graph_builder;
+
+    Statistics m_statistics;
+};
+
+}
+
+#endif
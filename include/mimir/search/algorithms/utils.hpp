@@ -20,7 +20,12 @@
 
 #include "mimir/search/declarations.hpp"
 #include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <optional>
 
 namespace mimir::search
@@ -45,6 +50,53 @@ struct SearchResult
     std::optional<State> goal_state = std::nullopt;
 };
 
+/// @brief Report the statistics of the unpacked state cache of `state_repository` to `event_handler`.
+/// Hits and misses are counted since `start_statistics`, which are taken at the beginning of the search.
+template<typename EventHandler>
+void report_unpacked_state_cache_statistics(const StateRepositoryImpl& state_repository,
+                                            const StateRepositoryImpl::UnpackedStateCacheStatistics& start_statistics,
+                                            EventHandler& event_handler)
+{
+    const auto statistics = state_repository.get_unpacked_state_cache_statistics();
+    event_handler.on_unpacked_state_cache_statistics(statistics.num_hits - start_statistics.num_hits,
+                                                     statistics.num_misses - start_statistics.num_misses,
+                                                     statistics.num_bytes);
+}
+
+/// @brief `MemoryLimit` tests whether the memory used by a search exceeds a budget.
+/// Estimating the memory usage visits all tables of the search context,
+/// so the estimate is only recomputed on the first and then every `check_interval` tests.
+class MemoryLimit
+{
+private:
+    uint64_t m_max_num_bytes;
+    uint32_t m_check_interval;
+    uint32_t m_num_tests;
+
+public:
+    explicit MemoryLimit(uint64_t max_num_bytes, uint32_t check_interval = 1000) :
+        m_max_num_bytes(max_num_bytes),
+        m_check_interval(std::max(check_interval, uint32_t(1))),
+        m_num_tests(m_check_interval - 1)
+    {
+    }
+
+    /// @brief Test whether the memory usage exceeds the budget.
+    /// @param context is the search context.
+    /// @param get_num_bytes_for_search returns the bytes held by the search itself, e.g., its search nodes and open list.
+    template<typename F>
+    bool has_exceeded(const SearchContextImpl& context, F&& get_num_bytes_for_search)
+    {
+        if (m_max_num_bytes == std::numeric_limits<uint64_t>::max() || ++m_num_tests < m_check_interval)
+        {
+            return false;
+        }
+        m_num_tests = 0;
+
+        return context.get_memory_usage().get_total() + get_num_bytes_for_search() > m_max_num_bytes;
+    }
+};
+
 }
 
 #endif
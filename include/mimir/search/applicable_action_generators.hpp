@@ -27,5 +27,6 @@
 #include "mimir/search/applicable_action_generators/lifted/kpkc.hpp"
 #include "mimir/search/applicable_action_generators/lifted/kpkc/event_handlers/debug.hpp"
 #include "mimir/search/applicable_action_generators/lifted/kpkc/event_handlers/default.hpp"
+#include "mimir/search/applicable_action_generators/stubborn_sets.hpp"
 
 #endif
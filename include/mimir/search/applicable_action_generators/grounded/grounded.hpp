@@ -73,6 +73,9 @@ public:
     /// @return a generator to yield the applicable actions for the given state.
     mimir::generator<formalism::GroundAction> create_applicable_action_generator(const State& state) override;
 
+    /// @brief Collect the applicable actions directly from the match tree without creating a coroutine.
+    void generate_applicable_actions(const State& state, formalism::GroundActionList& out_actions) override;
+
     void on_finish_search_layer() override;
     void on_end_search() override;
 
@@ -37,6 +37,19 @@ public:
     /// @brief Generate all applicable actions for a given state.
     virtual mimir::generator<formalism::GroundAction> create_applicable_action_generator(const State& state) = 0;
 
+    /// @brief Collect all applicable actions for a given state into a reusable buffer.
+    /// The default implementation drains `create_applicable_action_generator`.
+    /// @param state is the state.
+    /// @param out_actions are the applicable actions in the order in which the generator yields them.
+    virtual void generate_applicable_actions(const State& state, formalism::GroundActionList& out_actions)
+    {
+        out_actions.clear();
+        for (const auto& action : create_applicable_action_generator(state))
+        {
+            out_actions.push_back(action);
+        }
+    }
+
     /// @brief Accumulate event handler statistics during search.
     virtual void on_finish_search_layer() = 0;
     virtual void on_end_search() = 0;
@@ -18,6 +18,7 @@
 #ifndef MIMIR_SEARCH_APPLICABLE_ACTION_GENERATORS_LIFTED_HPP_
 #define MIMIR_SEARCH_APPLICABLE_ACTION_GENERATORS_LIFTED_HPP_
 
+#include "mimir/datasets/object_graph.hpp"
 #include "mimir/formalism/assignment_set.hpp"
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/formalism/problem_details.hpp"
@@ -27,6 +28,8 @@
 #include "mimir/search/satisficing_binding_generators/action.hpp"
 #include "mimir/search/search_context.hpp"
 
+#include <optional>
+
 namespace mimir::search
 {
 /// @brief `KPKCLiftedApplicableActionGeneratorImpl` implements lifted applicable action generation
@@ -84,6 +87,8 @@ private:
     ActionSatisficingBindingGeneratorList m_action_grounding_data;
 
     formalism::DynamicAssignmentSets m_dynamic_assignment_sets;
+
+    std::optional<datasets::ObjectGraphBuilder> m_object_graph_builder;  ///< Only used with symmetry pruning.
 };
 
 }  // namespace mimir
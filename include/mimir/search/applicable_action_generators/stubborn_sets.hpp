@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_APPLICABLE_ACTION_GENERATORS_STUBBORN_SETS_HPP_
+#define MIMIR_SEARCH_APPLICABLE_ACTION_GENERATORS_STUBBORN_SETS_HPP_
+
+#include "mimir/common/declarations.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/declarations.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace mimir::search
+{
+
+/// @brief `StubbornSetsApplicableActionGeneratorImpl` decorates an applicable action generator with strong stubborn set pruning,
+/// a partial-order reduction that only keeps the applicable actions of a strong stubborn set, as described by Wehrle and Helmert (ICAPS2014).
+///
+/// The stubborn set is seeded with the achievers of an unsatisfied goal literal.
+/// Applicable actions in the set add the actions that interfere with them,
+/// and inapplicable actions add the achievers of one of their unsatisfied preconditions.
+/// Pruning preserves completeness and optimality, hence it can be used with any search algorithm.
+///
+/// The achievers, deleters, and requirers of fluent atoms are either taken from the given delete-relaxed-reachable ground actions,
+/// or computed on demand per atom by unifying it with the effects or preconditions of the action schemas,
+/// and grounding only the bindings that are well-typed and consistent with the static atoms.
+/// The interference relation is either precomputed for all ground actions, or computed on demand for the applicable actions in stubborn sets.
+///
+/// Pruning is disabled for problems with derived predicates, conditional effects, numeric constraints, or fluent numeric effects,
+/// and it is disabled automatically when the pruning ratio after a number of states is low.
+class StubbornSetsApplicableActionGeneratorImpl : public IApplicableActionGenerator
+{
+public:
+    struct Options
+    {
+        /// @brief Disable pruning if less than this ratio of applicable actions was pruned after `num_states_before_checking` states.
+        double min_pruning_ratio = 0.2;
+        uint64_t num_states_before_checking = 1000;
+        /// @brief Compute the interference relation for all ground actions upfront instead of on demand.
+        bool precompute_interference = false;
+
+        Options() = default;
+    };
+
+    struct Statistics
+    {
+        uint64_t num_states = 0;              ///< The number of states for which a stubborn set was computed.
+        uint64_t num_unpruned_actions = 0;    ///< The number of applicable actions in these states.
+        uint64_t num_pruned_actions = 0;      ///< The number of applicable actions that were pruned.
+        uint64_t num_interference_lists = 0;  ///< The number of ground actions whose interfering actions were computed.
+        uint64_t num_ground_actions = 0;      ///< The number of ground actions that are known to the pruning.
+        bool is_supported = true;             ///< False if the problem has features that stubborn sets do not support.
+        bool is_disabled = false;             ///< True if pruning was disabled due to a low pruning ratio.
+
+        double get_pruning_ratio() const { return (num_unpruned_actions == 0) ? 0. : static_cast<double>(num_pruned_actions) / num_unpruned_actions; }
+    };
+
+    /// @brief Prune the actions of the given generator using the ground actions that are created on demand from the action schemas.
+    StubbornSetsApplicableActionGeneratorImpl(ApplicableActionGenerator applicable_action_generator, const Options& options = Options());
+
+    /// @brief Prune the actions of the given generator using the given delete-relaxed-reachable ground actions.
+    StubbornSetsApplicableActionGeneratorImpl(ApplicableActionGenerator applicable_action_generator,
+                                              const formalism::GroundActionList& ground_actions,
+                                              const Options& options = Options());
+
+    static StubbornSetsApplicableActionGenerator create(ApplicableActionGenerator applicable_action_generator, const Options& options = Options());
+
+    static StubbornSetsApplicableActionGenerator
+    create(ApplicableActionGenerator applicable_action_generator, const formalism::GroundActionList& ground_actions, const Options& options = Options());
+
+    // Uncopyable
+    StubbornSetsApplicableActionGeneratorImpl(const StubbornSetsApplicableActionGeneratorImpl& other) = delete;
+    StubbornSetsApplicableActionGeneratorImpl& operator=(const StubbornSetsApplicableActionGeneratorImpl& other) = delete;
+    // Unmovable
+    StubbornSetsApplicableActionGeneratorImpl(StubbornSetsApplicableActionGeneratorImpl&& other) = delete;
+    StubbornSetsApplicableActionGeneratorImpl& operator=(StubbornSetsApplicableActionGeneratorImpl&& other) = delete;
+
+    /// @brief Yield the applicable actions in the stubborn set of the given state.
+    mimir::generator<formalism::GroundAction> create_applicable_action_generator(const State& state) override;
+
+    /// @brief Collect the applicable actions in the stubborn set of the given state in the order of the decorated generator.
+    void generate_applicable_actions(const State& state, formalism::GroundActionList& out_actions) override;
+
+    void on_finish_search_layer() override;
+    void on_end_search() override;
+
+    /**
+     * Getters
+     */
+
+    const formalism::Problem& get_problem() const override;
+    const ApplicableActionGenerator& get_applicable_action_generator() const;
+    const Options& get_options() const;
+    const Statistics& get_statistics() const;
+
+private:
+    void initialize(const formalism::GroundActionList& ground_actions);
+
+    void add_ground_action(formalism::GroundAction action);
+
+    /// @brief Return the actions with the fluent atom in their effects or preconditions, and compute them first in lifted mode.
+    const IndexList& get_or_create_actions(std::vector<std::optional<IndexList>>& ref_atom_to_actions, Index atom, bool polarity, bool is_effect);
+
+    /// @brief Ground the bindings of the action schemas that are consistent with the fluent atom in their effects or preconditions.
+    void ground_unifying_actions(Index atom, bool polarity, bool is_effect, IndexList& out_actions);
+
+    void ground_consistent_bindings(size_t action_schema_pos, size_t parameter_index, formalism::ObjectList& ref_binding, IndexList& out_actions);
+
+    const IndexList& get_or_create_interfering_actions(formalism::GroundAction action);
+
+    /// @brief Add the actions that must be in every stubborn set containing an action that requires the literal, if the literal does not hold.
+    void add_necessary_enabling_set(Index atom, bool polarity);
+
+    void add_to_stubborn_set(const IndexList& actions);
+
+    ApplicableActionGenerator m_applicable_action_generator;
+    Options m_options;
+    Statistics m_statistics;
+
+    bool m_is_lifted;
+
+    /* The type-legal objects per action schema and parameter, used in lifted mode. */
+    std::vector<std::vector<formalism::ObjectList>> m_parameter_domains;
+
+    /* The ground actions and their relations indexed by action index, and the actions per fluent atom indexed by atom index. */
+    std::vector<formalism::GroundAction> m_ground_actions;
+    std::vector<std::optional<IndexList>> m_interfering_actions;
+    std::vector<std::optional<IndexList>> m_achievers;
+    std::vector<std::optional<IndexList>> m_deleters;
+    std::vector<std::optional<IndexList>> m_positive_requirers;
+    std::vector<std::optional<IndexList>> m_negative_requirers;
+
+    /* Reusable buffers. */
+    std::vector<bool> m_is_stubborn;
+    IndexList m_stubborn_actions;
+    IndexList m_queue;
+};
+
+/**
+ * Pretty printing
+ */
+
+extern std::ostream& operator<<(std::ostream& os, const StubbornSetsApplicableActionGeneratorImpl::Statistics& statistics);
+
+}
+
+#endif
@@ -27,6 +27,13 @@ namespace mimir::search
 /// @param unpacked_state
 /// @param out_details
 extern void initialize(const UnpackedStateImpl& unpacked_state, formalism::DynamicAssignmentSets& out_dynamic_assignment_sets);
+
+/// @brief Updates the assignment sets from the atoms and numeric variables that changed since they were last initialized or updated.
+/// Added atoms are inserted, and the sets of predicates with a deleted atom and of function skeletons with a changed value are rebuilt.
+/// Falls back to `initialize` if the sets were never initialized or if the states differ in more atoms than the given state contains.
+/// @param unpacked_state
+/// @param out_dynamic_assignment_sets
+extern void update(const UnpackedStateImpl& unpacked_state, formalism::DynamicAssignmentSets& out_dynamic_assignment_sets);
 }
 
 #endif
@@ -39,6 +39,7 @@ using GeneralizedSearchContext = std::shared_ptr<GeneralizedSearchContextImpl>;
 // StateRepositoryImpl
 class StateRepositoryImpl;
 using StateRepository = std::shared_ptr<StateRepositoryImpl>;
+class SuccessorBatch;
 
 // PackedState
 class PackedStateImpl;
@@ -52,6 +53,11 @@ class UnpackedStateImpl;
 // State
 class State;
 
+// FiniteDomainStateEncodingImpl
+class FiniteDomainStateEncodingImpl;
+using FiniteDomainStateEncoding = std::shared_ptr<FiniteDomainStateEncodingImpl>;
+class FiniteDomainStateSet;
+
 /* Grounder */
 class Grounder;
 class LiftedGrounder;
@@ -78,6 +84,8 @@ class KPKCLiftedApplicableActionGeneratorImpl;
 using KPKCLiftedApplicableActionGenerator = std::shared_ptr<KPKCLiftedApplicableActionGeneratorImpl>;
 class ExhaustiveLiftedApplicableActionGeneratorImpl;
 using ExhaustiveLiftedApplicableActionGenerator = std::shared_ptr<ExhaustiveLiftedApplicableActionGeneratorImpl>;
+class StubbornSetsApplicableActionGeneratorImpl;
+using StubbornSetsApplicableActionGenerator = std::shared_ptr<StubbornSetsApplicableActionGeneratorImpl>;
 
 namespace applicable_action_generator::grounded
 {
@@ -174,6 +182,8 @@ class SetAddHeuristicImpl;
 using SetAddHeuristic = std::shared_ptr<SetAddHeuristicImpl>;
 class FFHeuristicImpl;
 using FFHeuristic = std::shared_ptr<FFHeuristicImpl>;
+class HeuristicCacheImpl;
+using HeuristicCache = std::shared_ptr<HeuristicCacheImpl>;
 
 /* Algorithms */
 class IPruningStrategy;
@@ -182,6 +192,8 @@ class NoPruningStrategyImpl;
 using NoPruningStrategy = std::shared_ptr<NoPruningStrategyImpl>;
 class DuplicatePruningStrategyImpl;
 using DuplicatePruningStrategy = std::shared_ptr<DuplicatePruningStrategyImpl>;
+class SymmetryPruningStrategyImpl;
+using SymmetryPruningStrategy = std::shared_ptr<SymmetryPruningStrategyImpl>;
 namespace iw
 {
 class ArityZeroNoveltyPruningStrategyImpl;
@@ -221,6 +233,16 @@ using DefaultEventHandler = std::shared_ptr<DefaultEventHandlerImpl>;
 class Statistics;
 }
 
+// Best-first width search
+namespace bfws
+{
+class IEventHandler;
+using EventHandler = std::shared_ptr<IEventHandler>;
+class DefaultEventHandlerImpl;
+using DefaultEventHandler = std::shared_ptr<DefaultEventHandlerImpl>;
+class Statistics;
+}
+
 // Breadth-first search
 namespace brfs
 {
@@ -280,6 +302,12 @@ const size_t MAX_ARITY = 6;
 
 const size_t INITIAL_TABLE_ATOMS = 64;
 
+/**
+ * Maximum number of entries of a dense DynamicNoveltyTable before it switches to a sparse table
+ */
+
+const size_t MAX_DENSE_TABLE_SIZE = size_t(1) << 27;
+
 /**
  * Type aliases for readability
  */
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_FINITE_DOMAIN_STATE_ENCODING_HPP_
+#define MIMIR_SEARCH_FINITE_DOMAIN_STATE_ENCODING_HPP_
+
+#include "mimir/common/types_cista.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/mutex_groups.hpp"
+
+#include <absl/container/flat_hash_set.h>
+#include <absl/types/span.h>
+#include <cstdint>
+#include <vector>
+
+namespace mimir::search
+{
+
+/// @brief `FiniteDomainStateEncodingImpl` packs the fluent atoms of a state into a fixed number of 64-bit words.
+///
+/// Each mutex group becomes a finite-domain variable whose values are its atoms plus a value for "none of them",
+/// encoded in the minimum number of bits. Fluent atoms that are not covered by a group become binary variables.
+/// Variables may straddle word boundaries. Numeric variables and derived atoms are not encoded.
+class FiniteDomainStateEncodingImpl
+{
+public:
+    struct Variable
+    {
+        IndexList atoms;  ///< The atom with value `i + 1` is `atoms[i]`, and value 0 means that none of them holds.
+        size_t bit_offset;
+        size_t num_bits;
+    };
+
+private:
+    formalism::Problem m_problem;
+
+    std::vector<Variable> m_variables;
+    std::vector<std::pair<Index, Index>> m_atom_to_variable_and_value;  ///< Indexed by fluent atom index, `MAX_INDEX` if not covered.
+    size_t m_num_bits;
+    size_t m_num_words;
+
+public:
+    /// @brief Create an encoding for all fluent ground atoms of the problem from the given mutex groups.
+    /// The groups are selected greedily by size, and atoms in multiple groups are assigned to the first selected group.
+    FiniteDomainStateEncodingImpl(formalism::Problem problem, const MutexGroupList& mutex_groups);
+
+    /// @brief Create an encoding from the mutex groups synthesized by `compute_mutex_groups`.
+    static FiniteDomainStateEncoding create(const IGrounder& grounder);
+
+    static FiniteDomainStateEncoding create(formalism::Problem problem, const MutexGroupList& mutex_groups);
+
+    /// @brief Encode the given fluent atoms.
+    /// Throws an exception if an atom was unknown at construction or two atoms of the same variable hold.
+    /// @param fluent_atoms are the fluent atoms of a state.
+    /// @param out_words is the pointer to `get_num_words()` words that are overwritten.
+    void encode(const FlatBitset& fluent_atoms, uint64_t* out_words) const;
+
+    /// @brief Decode the fluent atoms from the given words.
+    /// @param words is the pointer to `get_num_words()` words written by `encode`.
+    /// @param out_fluent_atoms are the decoded fluent atoms.
+    void decode(const uint64_t* words, FlatBitset& out_fluent_atoms) const;
+
+    /**
+     * Getters
+     */
+
+    const formalism::Problem& get_problem() const;
+    const std::vector<Variable>& get_variables() const;
+    size_t get_num_bits() const;
+    size_t get_num_words() const;
+    /// @brief Return the number of bytes of an encoded state.
+    size_t get_num_bytes_per_state() const;
+};
+
+/// @brief `FiniteDomainStateSet` stores states encoded by a `FiniteDomainStateEncoding` contiguously
+/// and detects duplicates by hashing and comparing the fixed-width packed words.
+class FiniteDomainStateSet
+{
+private:
+    struct WordsHash
+    {
+        using is_transparent = void;
+
+        const FiniteDomainStateSet* set;
+
+        size_t operator()(Index index) const;
+        size_t operator()(absl::Span<const uint64_t> words) const;
+    };
+
+    struct WordsEqualTo
+    {
+        using is_transparent = void;
+
+        const FiniteDomainStateSet* set;
+
+        bool operator()(Index lhs, Index rhs) const;
+        bool operator()(Index lhs, absl::Span<const uint64_t> rhs) const;
+        bool operator()(absl::Span<const uint64_t> lhs, Index rhs) const;
+    };
+
+    FiniteDomainStateEncoding m_encoding;
+
+    std::vector<uint64_t> m_words;  ///< The words of the state with index `i` start at `i * get_num_words()`.
+    absl::flat_hash_set<Index, WordsHash, WordsEqualTo> m_indices;
+
+    mutable std::vector<uint64_t> m_buffer;
+
+    absl::Span<const uint64_t> get_words(Index index) const;
+
+public:
+    explicit FiniteDomainStateSet(FiniteDomainStateEncoding encoding);
+
+    FiniteDomainStateSet(const FiniteDomainStateSet& other) = delete;
+    FiniteDomainStateSet& operator=(const FiniteDomainStateSet& other) = delete;
+    FiniteDomainStateSet(FiniteDomainStateSet&& other) = delete;
+    FiniteDomainStateSet& operator=(FiniteDomainStateSet&& other) = delete;
+
+    /// @brief Insert the state with the given fluent atoms.
+    /// @return the dense index of the state and true if it was newly inserted.
+    std::pair<Index, bool> insert(const FlatBitset& fluent_atoms);
+
+    /// @brief Test whether the state with the given fluent atoms was inserted.
+    bool contains(const FlatBitset& fluent_atoms) const;
+
+    /// @brief Decode the fluent atoms of the state with the given index.
+    void get_fluent_atoms(Index index, FlatBitset& out_fluent_atoms) const;
+
+    const FiniteDomainStateEncoding& get_encoding() const;
+    size_t size() const;
+
+    /// @brief Estimate the memory usage of the packed states and the hash set.
+    size_t get_estimated_memory_usage_in_bytes() const;
+};
+
+}
+
+#endif
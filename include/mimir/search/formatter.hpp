@@ -52,6 +52,11 @@ namespace astar_lazy
 extern std::ostream& operator<<(std::ostream& os, const Statistics& statistics);
 }  // end astar_lazy
 
+namespace bfws
+{
+extern std::ostream& operator<<(std::ostream& out, const Statistics& element);
+}  // end bfws
+
 namespace brfs
 {
 extern std::ostream& operator<<(std::ostream& out, const Statistics& element);
@@ -83,6 +88,8 @@ extern std::ostream& print(std::ostream& os, const mimir::search::astar_eager::S
 
 extern std::ostream& print(std::ostream& os, const mimir::search::astar_lazy::Statistics& statistics);
 
+extern std::ostream& print(std::ostream& out, const mimir::search::bfws::Statistics& element);
+
 extern std::ostream& print(std::ostream& out, const mimir::search::brfs::Statistics& element);
 
 extern std::ostream& print(std::ostream& out, const mimir::search::gbfs_eager::Statistics& element);
@@ -64,6 +64,16 @@ public:
     create_grounded_applicable_action_generator(const match_tree::Options& options = match_tree::Options(),
                                                 applicable_action_generator::grounded::EventHandler event_handler = nullptr) const;
 
+    /// @brief Create a grounded applicable action generator for ground actions that were already created with `create_ground_actions`.
+    /// @param ground_actions the ground actions.
+    /// @param options the match tree options
+    /// @param event_handler the grounded applicable action generator event handler.
+    /// @return a grounded applicable action generator.
+    GroundedApplicableActionGenerator
+    create_grounded_applicable_action_generator(const formalism::GroundActionList& ground_actions,
+                                                const match_tree::Options& options = match_tree::Options(),
+                                                applicable_action_generator::grounded::EventHandler event_handler = nullptr) const;
+
     /// @brief Get the input problem.
     /// @return the input problem.
     const formalism::Problem& get_problem() const;
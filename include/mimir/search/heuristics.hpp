@@ -20,6 +20,7 @@
 
 #include "mimir/search/heuristics/add.hpp"
 #include "mimir/search/heuristics/blind.hpp"
+#include "mimir/search/heuristics/cache.hpp"
 #include "mimir/search/heuristics/ff.hpp"
 #include "mimir/search/heuristics/max.hpp"
 #include "mimir/search/heuristics/perfect.hpp"
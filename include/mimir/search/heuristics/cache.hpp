@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_SEARCH_HEURISTICS_CACHE_HPP_
+#define MIMIR_SEARCH_HEURISTICS_CACHE_HPP_
+
+#include "mimir/common/segmented_vector.hpp"
+#include "mimir/search/declarations.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace mimir::search
+{
+
+/// @brief `HeuristicCacheImpl` memoizes heuristic values in a dense table indexed by state index.
+///
+/// State indices are only unique within a `StateRepositoryImpl`, hence a cache must only be used
+/// for states of a single repository and values of a single heuristic.
+/// The table does not grow beyond `max_num_bytes`, states with larger indices are not memoized.
+class HeuristicCacheImpl
+{
+private:
+    SegmentedVector<ContinuousCost> m_values;
+    size_t m_max_num_entries;
+
+    uint64_t m_num_hits;
+    uint64_t m_num_misses;
+
+public:
+    explicit HeuristicCacheImpl(size_t max_num_bytes = std::numeric_limits<size_t>::max());
+
+    static HeuristicCache create(size_t max_num_bytes = std::numeric_limits<size_t>::max());
+
+    /// @brief Return the cached heuristic value of `state` or compute it with `heuristic` and memoize it.
+    /// @return the heuristic value and whether it was cached.
+    std::pair<ContinuousCost, bool> get_or_compute_heuristic(IHeuristic& heuristic, const State& state);
+
+    /// @brief Return the cached heuristic value of `state` or memoize `h_value`, which was computed for it elsewhere, e.g., in a batch.
+    /// @return the heuristic value and whether it was cached.
+    std::pair<ContinuousCost, bool> get_or_insert_heuristic(const State& state, ContinuousCost h_value);
+
+    /// @brief Return the cached heuristic value of the state with index `state_index` if it exists.
+    std::optional<ContinuousCost> get(Index state_index) const;
+
+    /// @brief Memoize the heuristic value `h_value` of the state with index `state_index` if it fits into the table.
+    void insert(Index state_index, ContinuousCost h_value);
+
+    void clear();
+
+    /**
+     * Getters
+     */
+
+    size_t get_max_num_entries() const;
+    uint64_t get_num_hits() const;
+    uint64_t get_num_misses() const;
+    size_t get_estimated_memory_usage_in_bytes() const;
+};
+
+}
+
+#endif
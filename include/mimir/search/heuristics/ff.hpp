@@ -38,6 +38,9 @@ public:
 
     static FFHeuristic create(const IGrounder& grounder);
 
+    /// @brief Get the relaxed plan of the state of the last call to `compute_heuristic`.
+    const formalism::GroundActionSet& get_relaxed_plan() const { return m_relaxed_plan; }
+
 private:
     /**
      * The initialize and update step closely follows the `AddHeuristic`.
@@ -99,8 +102,6 @@ private:
 
     formalism::GroundActionSet m_relaxed_plan;
 
-    auto& get_relaxed_plan() { return m_relaxed_plan; }
-
     static Index& get_achiever(rpg::Annotations<Index, bool>& annotation) { return std::get<0>(annotation); }
     static Index get_achiever(const rpg::Annotations<Index, bool>& annotation) { return std::get<0>(annotation); }
     static bool& is_marked(rpg::Annotations<Index, bool>& annotation) { return std::get<1>(annotation); }
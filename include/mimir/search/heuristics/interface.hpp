@@ -21,6 +21,8 @@
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/search/declarations.hpp"
 
+#include <span>
+
 namespace mimir::search
 {
 
@@ -40,6 +42,18 @@ public:
 
     virtual ContinuousCost compute_heuristic(const State& state, formalism::GroundConjunctiveCondition goal = nullptr) = 0;
 
+    /// @brief Compute the heuristic values of several states at once.
+    /// The default implementation calls `compute_heuristic` for each state.
+    /// Batched evaluations do not update the preferred actions.
+    /// @param states are the states.
+    /// @param out_values are the heuristic values of the states, which must have the same size as `states`.
+    /// @param goal is the goal, or nullptr to use the goal of the problem.
+    virtual void compute_heuristics(std::span<const State> states, std::span<ContinuousCost> out_values, formalism::GroundConjunctiveCondition goal = nullptr);
+
+    /// @brief Return true iff `compute_heuristics` is faster than evaluating the states one at a time.
+    /// Searches only collect successors into batches if this is true.
+    virtual bool supports_batch_evaluation() const { return false; }
+
     virtual const PreferredActions& get_preferred_actions() const { return m_preferred_actions; }
 
 protected:
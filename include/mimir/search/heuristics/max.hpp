@@ -34,7 +34,40 @@ public:
 
     static MaxHeuristic create(const IGrounder& grounder);
 
+    /// @brief Compute h_max of up to 64 states at a time by a bit-parallel relaxed exploration.
+    /// Bit i of each word refers to the i-th state of a chunk, and the exploration proceeds in layers of unit-cost actions
+    /// until the goal is reached in each state of the chunk.
+    void compute_heuristics(std::span<const State> states, std::span<ContinuousCost> out_values, formalism::GroundConjunctiveCondition goal = nullptr) override;
+
+    bool supports_batch_evaluation() const override { return true; }
+
 private:
+    /// @brief The preconditions and effects of the "And"-structure nodes in compressed row storage.
+    struct BitParallelStructures
+    {
+        IndexList precondition_begins;  ///< The preconditions of structure i are in [precondition_begins[i], precondition_begins[i + 1]).
+        IndexList preconditions;        ///< The precondition propositions.
+        IndexList effects;              ///< The effect proposition, or MAX_INDEX if the structure can never be applied.
+    };
+
+    template<rpg::IsStructure S>
+    static BitParallelStructures
+    create_bit_parallel_structures(const std::vector<S>& structures, const IndexList& effects, const rpg::PropositionList& propositions);
+
+    /// @brief Add the effects of all structures whose preconditions are reached in `reached` to `ref_next_reached`.
+    /// @return true iff a bit in `ref_next_reached` changed.
+    static bool apply_bit_parallel_structures(const BitParallelStructures& structures,
+                                              uint64_t active,
+                                              const std::vector<uint64_t>& reached,
+                                              std::vector<uint64_t>& ref_next_reached);
+
+    void compute_heuristics_chunk(std::span<const State> states, std::span<ContinuousCost> out_values);
+
+    BitParallelStructures m_bit_parallel_actions;
+    BitParallelStructures m_bit_parallel_axioms;
+    std::vector<uint64_t> m_reached;
+    std::vector<uint64_t> m_next_reached;
+
     /// @brief Initialize "And"-structure node annotations.
     /// Sets the cost for each structure node to 0.
     void initialize_and_annotations_impl(const rpg::Action& action);
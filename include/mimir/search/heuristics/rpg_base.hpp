@@ -156,8 +156,8 @@ private:
         }
     }
 
-    template<formalism::IsFluentOrDerivedTag P>
-    void initialize_or_annotations_and_queue_helper(const State& state)
+    template<formalism::IsFluentOrDerivedTag P, typename Callback>
+    void for_each_initial_proposition_helper(const State& state, Callback&& callback)
     {
         if constexpr (std::is_same_v<P, formalism::DerivedTag>)
         {
@@ -168,12 +168,12 @@ private:
 
             for (const auto& atom_index : state.get_atoms<P>())
             {
-                self().initialize_or_annotations_and_queue_impl(m_propositions[positive_offsets[atom_index]]);
+                callback(m_propositions[positive_offsets[atom_index]]);
             }
 
             for (const auto& atom_index : get<P>(get_atom_indices()))
             {
-                self().initialize_or_annotations_and_queue_impl(m_propositions[negative_offsets[atom_index]]);
+                callback(m_propositions[negative_offsets[atom_index]]);
             }
         }
         else
@@ -191,43 +191,50 @@ private:
             {
                 if (*it == *it2)
                 {
-                    self().initialize_or_annotations_and_queue_impl(m_propositions[positive_offsets[*it]]);
+                    callback(m_propositions[positive_offsets[*it]]);
                     ++it;
                     ++it2;
                 }
                 else if (*it < *it2)
                 {
-                    self().initialize_or_annotations_and_queue_impl(m_propositions[positive_offsets[*it]]);
+                    callback(m_propositions[positive_offsets[*it]]);
                     ++it;
                 }
                 else
                 {
-                    self().initialize_or_annotations_and_queue_impl(m_propositions[negative_offsets[*it2]]);
+                    callback(m_propositions[negative_offsets[*it2]]);
                     ++it2;
                 }
             }
             while (it != end)
             {
-                self().initialize_or_annotations_and_queue_impl(m_propositions[positive_offsets[*it]]);
+                callback(m_propositions[positive_offsets[*it]]);
                 ++it;
             }
             while (it2 != end2)
             {
-                self().initialize_or_annotations_and_queue_impl(m_propositions[negative_offsets[*it2]]);
+                callback(m_propositions[negative_offsets[*it2]]);
                 ++it2;
             }
         }
     }
 
+    /// @brief Call `callback` on each proposition that is true in the first layer for the given `state`.
+    template<typename Callback>
+    void for_each_initial_proposition(const State& state, Callback&& callback)
+    {
+        for_each_initial_proposition_helper<formalism::FluentTag>(state, callback);
+        for_each_initial_proposition_helper<formalism::DerivedTag>(state, callback);
+
+        // Trivial dummy proposition to trigger actions and axioms without preconditions
+        callback(m_propositions[DUMMY_PROPOSITION_INDEX]);
+    }
+
     void initialize_or_annotations_and_queue(const State& state)
     {
         this->m_queue.clear();
 
-        initialize_or_annotations_and_queue_helper<formalism::FluentTag>(state);
-        initialize_or_annotations_and_queue_helper<formalism::DerivedTag>(state);
-
-        // Trivial dummy proposition to trigger actions and axioms without preconditions
-        self().initialize_or_annotations_and_queue_impl(m_propositions[0]);
+        for_each_initial_proposition(state, [this](const Proposition& proposition) { self().initialize_or_annotations_and_queue_impl(proposition); });
     }
 
     void on_process_effect(const Action& structure)
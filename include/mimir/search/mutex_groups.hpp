@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_MUTEX_GROUPS_HPP_
+#define MIMIR_SEARCH_MUTEX_GROUPS_HPP_
+
+#include "mimir/common/declarations.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/grounders/interface.hpp"
+
+#include <vector>
+
+namespace mimir::search
+{
+
+/// @brief A `MutexGroup` is a sorted list of fluent ground atom indices of which at most one holds in every reachable state.
+using MutexGroup = IndexList;
+using MutexGroupList = std::vector<MutexGroup>;
+
+/// @brief Synthesize mutex groups from monotonicity invariants in the style of Helmert's invariant synthesis.
+///
+/// A candidate invariant consists of parts, each a fluent predicate with at most one counted argument position.
+/// Its instances group the atoms of all parts that agree on the remaining arguments, e.g., {at(b, *), carry(b, *)} in gripper.
+/// A candidate is accepted if the initial state contains at most one atom of each instance
+/// and every ground action that adds an atom of an instance also deletes an atom of the same instance that it requires to hold.
+/// If an added atom is only balanced by a required deleted atom of another predicate, the candidate is refined by a part for that predicate.
+/// The check is performed on the delete-relaxed-reachable ground actions.
+/// @param grounder is the grounder of the problem.
+/// @return the mutex groups with at least two atoms. Groups of different invariants may overlap.
+extern MutexGroupList compute_mutex_groups(const IGrounder& grounder);
+
+}
+
+#endif
@@ -19,6 +19,8 @@
 #define MIMIR_SEARCH_OPENLISTS_HPP_
 
 #include "mimir/search/openlists/alternating.hpp"
+#include "mimir/search/openlists/bucket.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/openlists/radix_heap.hpp"
 
 #endif
@@ -128,6 +128,11 @@ public:
         return std::apply([](auto&&... queues) { return (queues.get().size() + ...); }, m_queues);
     }
 
+    std::size_t get_estimated_memory_usage_in_bytes() const
+    {
+        return std::apply([](auto&&... queues) { return (queues.get().get_estimated_memory_usage_in_bytes() + ...); }, m_queues);
+    }
+
 private:
     std::tuple<std::reference_wrapper<Os>...> m_queues;
 
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_SEARCH_OPENLISTS_BUCKET_HPP_
+#define MIMIR_SEARCH_OPENLISTS_BUCKET_HPP_
+
+#include "mimir/search/openlists/interface.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+namespace mimir::search
+{
+
+template<typename T>
+concept IsBucketQueueEntry = IsPriorityQueueEntry<T> && requires(const T a) {
+    { a.get_bucket() } -> std::convertible_to<double>;
+};
+
+/// @brief `BucketOpenList` is a bucket queue (Dial's algorithm) over integral bucket keys.
+///
+/// Insertion and removal take constant time and keys may decrease over time.
+/// Entries in the same bucket are removed in the order in which they were inserted.
+/// Once an entry has a bucket key that is not a non-negative integer below `MAX_NUM_BUCKETS`,
+/// all entries are moved into a `PriorityQueue` that orders them by `get_key()` instead.
+template<IsBucketQueueEntry E>
+class BucketOpenList
+{
+public:
+    using EntryType = E;
+    using KeyType = typename E::KeyType;
+    using ItemType = typename E::ItemType;
+
+    static constexpr std::size_t MAX_NUM_BUCKETS = std::size_t(1) << 20;
+
+private:
+    struct Bucket
+    {
+        std::vector<E> entries;
+        std::size_t head = 0;
+
+        bool empty() const { return head == entries.size(); }
+    };
+
+    std::vector<Bucket> m_buckets;
+    std::size_t m_min_bucket;  ///< All buckets before it are empty.
+    std::size_t m_size;
+
+    bool m_use_fallback;
+    PriorityQueue<E> m_fallback;
+
+    static std::optional<std::size_t> get_bucket_index(const E& entry)
+    {
+        const auto bucket = static_cast<double>(entry.get_bucket());
+
+        if (!(bucket >= 0.) || bucket >= static_cast<double>(MAX_NUM_BUCKETS) || bucket != std::floor(bucket))
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>(bucket);
+    }
+
+    void switch_to_fallback()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            for (auto i = bucket.head; i < bucket.entries.size(); ++i)
+            {
+                m_fallback.insert(std::move(bucket.entries[i]));
+            }
+        }
+        m_buckets.clear();
+        m_min_bucket = 0;
+        m_size = 0;
+        m_use_fallback = true;
+    }
+
+public:
+    BucketOpenList() : m_buckets(), m_min_bucket(0), m_size(0), m_use_fallback(false), m_fallback() {}
+
+    void insert(E entry)
+    {
+        if (!m_use_fallback)
+        {
+            if (const auto index = get_bucket_index(entry))
+            {
+                if (index.value() >= m_buckets.size())
+                {
+                    m_buckets.resize(index.value() + 1);
+                }
+                m_buckets[index.value()].entries.push_back(std::move(entry));
+                m_min_bucket = (m_size == 0) ? index.value() : std::min(m_min_bucket, index.value());
+                ++m_size;
+                return;
+            }
+
+            switch_to_fallback();
+        }
+
+        m_fallback.insert(std::move(entry));
+    }
+
+    decltype(auto) top() const { return top_entry().get_item(); }
+
+    const E& top_entry() const
+    {
+        assert(!empty());
+
+        if (m_use_fallback)
+        {
+            return m_fallback.top_entry();
+        }
+
+        const auto& bucket = m_buckets[m_min_bucket];
+        return bucket.entries[bucket.head];
+    }
+
+    void pop()
+    {
+        assert(!empty());
+
+        if (m_use_fallback)
+        {
+            m_fallback.pop();
+            return;
+        }
+
+        auto& bucket = m_buckets[m_min_bucket];
+        ++bucket.head;
+        --m_size;
+
+        if (bucket.empty())
+        {
+            bucket.entries.clear();
+            bucket.head = 0;
+
+            if (m_size > 0)
+            {
+                while (m_buckets[m_min_bucket].empty())
+                {
+                    ++m_min_bucket;
+                }
+            }
+        }
+        else if (2 * bucket.head >= bucket.entries.size())
+        {
+            /* Release removed entries of buckets that are refilled while being removed from. */
+            bucket.entries.erase(bucket.entries.begin(), bucket.entries.begin() + bucket.head);
+            bucket.head = 0;
+        }
+    }
+
+    void clear()
+    {
+        m_buckets.clear();
+        m_min_bucket = 0;
+        m_size = 0;
+        m_use_fallback = false;
+        m_fallback.clear();
+    }
+
+    bool empty() const { return (m_use_fallback) ? m_fallback.empty() : (m_size == 0); }
+
+    std::size_t size() const { return (m_use_fallback) ? m_fallback.size() : m_size; }
+
+    /// @brief Return true iff the entries are ordered by a `PriorityQueue`.
+    bool uses_fallback() const { return m_use_fallback; }
+
+    /// @brief Return the number of bytes allocated for the buckets, including removed entries before each bucket's head.
+    std::size_t get_estimated_memory_usage_in_bytes() const
+    {
+        auto num_bytes = m_buckets.capacity() * sizeof(Bucket) + m_fallback.get_estimated_memory_usage_in_bytes();
+        for (const auto& bucket : m_buckets)
+        {
+            num_bytes += bucket.entries.capacity() * sizeof(E);
+        }
+        return num_bytes;
+    }
+
+    /// @brief Call `callback` on each entry, in the order of removal unless the fallback is used.
+    template<typename F>
+    void for_each(F&& callback) const
+    {
+        if (m_use_fallback)
+        {
+            m_fallback.for_each(callback);
+            return;
+        }
+
+        for (const auto& bucket : m_buckets)
+        {
+            for (auto i = bucket.head; i < bucket.entries.size(); ++i)
+            {
+                callback(bucket.entries[i]);
+            }
+        }
+    }
+};
+
+}
+
+#endif
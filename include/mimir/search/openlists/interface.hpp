@@ -34,6 +34,7 @@ concept IsOpenList = requires(T a, typename T::EntryType entry, typename T::Item
     { a.clear() } -> std::same_as<void>;
     { a.empty() } -> std::same_as<bool>;
     { a.size() } -> std::same_as<std::size_t>;
+    { a.get_estimated_memory_usage_in_bytes() } -> std::same_as<std::size_t>;
 };
 
 template<typename First, typename... Rest>
@@ -46,6 +47,7 @@ concept IsOpenListComposition = requires(T a, typename T::ItemType item) {
     { a.clear() } -> std::same_as<void>;
     { a.empty() } -> std::same_as<bool>;
     { a.size() } -> std::same_as<std::size_t>;
+    { a.get_estimated_memory_usage_in_bytes() } -> std::same_as<std::size_t>;
 };
 
 }
@@ -20,8 +20,9 @@
 
 #include "mimir/search/openlists/interface.hpp"
 
+#include <algorithm>
 #include <cassert>
-#include <queue>
+#include <vector>
 
 namespace mimir::search
 {
@@ -40,7 +41,7 @@ class PriorityQueue
 private:
     struct EntryComparator
     {
-        bool operator()(const E& l, const E& r) { return l.get_key() > r.get_key(); }
+        bool operator()(const E& l, const E& r) const { return l.get_key() > r.get_key(); }
     };
 
 public:
@@ -48,38 +49,57 @@ public:
     using KeyType = typename E::KeyType;
     using ItemType = typename E::ItemType;
 
-    void insert(E entry) { m_priority_queue.push(std::move(entry)); }
+    void insert(E entry)
+    {
+        m_entries.push_back(std::move(entry));
+        std::push_heap(m_entries.begin(), m_entries.end(), EntryComparator());
+    }
 
     decltype(auto) top() const
     {
         assert(!empty());
-        return m_priority_queue.top().get_item();
+        return m_entries.front().get_item();
     }
 
     const auto& top_entry() const
     {
         assert(!empty());
-        return m_priority_queue.top();
+        return m_entries.front();
     }
 
     void pop()
     {
         assert(!empty());
-        m_priority_queue.pop();
+        std::pop_heap(m_entries.begin(), m_entries.end(), EntryComparator());
+        m_entries.pop_back();
     }
 
     void clear()
     {
-        auto tmp = std::priority_queue<E, std::vector<E>, EntryComparator> {};
-        std::swap(m_priority_queue, tmp);
+        auto tmp = std::vector<E> {};
+        std::swap(m_entries, tmp);
     }
 
-    bool empty() const { return m_priority_queue.empty(); }
+    bool empty() const { return m_entries.empty(); }
+
+    std::size_t size() const { return m_entries.size(); }
 
-    std::size_t size() const { return m_priority_queue.size(); }
+    /// @brief Return the number of bytes allocated for the entries.
+    std::size_t get_estimated_memory_usage_in_bytes() const { return m_entries.capacity() * sizeof(E); }
+
+    /// @brief Call `callback` on each entry in unspecified order.
+    template<typename F>
+    void for_each(F&& callback) const
+    {
+        for (const auto& entry : m_entries)
+        {
+            callback(entry);
+        }
+    }
 
 private:
-    std::priority_queue<E, std::vector<E>, EntryComparator> m_priority_queue;
+    /// @brief A binary heap ordered by `EntryComparator`, as in `std::priority_queue`.
+    std::vector<E> m_entries;
 };
 
 }
@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_SEARCH_OPENLISTS_RADIX_HEAP_HPP_
+#define MIMIR_SEARCH_OPENLISTS_RADIX_HEAP_HPP_
+
+#include "mimir/search/openlists/bucket.hpp"
+#include "mimir/search/openlists/interface.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace mimir::search
+{
+
+/// @brief `RadixHeapOpenList` is a radix heap over monotone integral bucket keys.
+///
+/// An entry with key k is stored in the bucket given by the most significant bit in which k differs from the last removed key.
+/// Insertion takes constant time and removal takes amortized O(log C) time, where C is the largest key, independent of the number of entries.
+/// Entries with the smallest bucket key are kept in a binary heap and removed in the order of `get_key()`,
+/// hence secondary criteria such as the node status belong into `get_key()` and not into the bucket key.
+/// Once an entry has a bucket key that is not a non-negative integer or that is smaller than the last removed key,
+/// all entries are moved into a `PriorityQueue` that orders them by `get_key()` instead.
+template<IsBucketQueueEntry E>
+class RadixHeapOpenList
+{
+public:
+    using EntryType = E;
+    using KeyType = typename E::KeyType;
+    using ItemType = typename E::ItemType;
+
+    /// @brief Bucket keys must be exactly representable as double.
+    static constexpr std::uint64_t MAX_KEY = std::uint64_t(1) << 53;
+
+private:
+    static constexpr std::size_t NUM_BUCKETS = 65;
+
+    struct EntryComparator
+    {
+        bool operator()(const std::pair<std::uint64_t, E>& l, const std::pair<std::uint64_t, E>& r) const
+        {
+            return l.second.get_key() > r.second.get_key();
+        }
+    };
+
+    /* Buckets are redistributed lazily when accessing the top entry, hence they are mutable. */
+    mutable std::array<std::vector<std::pair<std::uint64_t, E>>, NUM_BUCKETS> m_buckets;  ///< Bucket 0 is a binary heap ordered by `EntryComparator`.
+    mutable std::vector<std::pair<std::uint64_t, E>> m_buffer;
+    mutable std::uint64_t m_last;  ///< Smallest key, which is the key of all entries in bucket 0.
+    std::size_t m_size;
+
+    bool m_use_fallback;
+    PriorityQueue<E> m_fallback;
+
+    static std::optional<std::uint64_t> get_radix_key(const E& entry)
+    {
+        const auto bucket = static_cast<double>(entry.get_bucket());
+
+        if (!(bucket >= 0.) || bucket >= static_cast<double>(MAX_KEY) || bucket != std::floor(bucket))
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::uint64_t>(bucket);
+    }
+
+    static std::size_t get_bucket_index(std::uint64_t key, std::uint64_t last)
+    {
+        return (key == last) ? 0 : NUM_BUCKETS - 1 - std::countl_zero(key ^ last);
+    }
+
+    /// @brief Move the entries of the first nonempty bucket into the lower buckets relative to its minimum key
+    /// if bucket 0 is empty.
+    void redistribute() const
+    {
+        assert(m_size > 0);
+
+        if (!m_buckets[0].empty())
+        {
+            return;
+        }
+
+        auto i = std::size_t(1);
+        while (m_buckets[i].empty())
+        {
+            ++i;
+        }
+
+        /* Swap with a buffer to keep the capacity of both vectors. */
+        std::swap(m_buffer, m_buckets[i]);
+
+        m_last = std::min_element(m_buffer.begin(), m_buffer.end(), [](auto&& l, auto&& r) { return l.first < r.first; })->first;
+
+        for (auto& [key, entry] : m_buffer)
+        {
+            m_buckets[get_bucket_index(key, m_last)].emplace_back(key, std::move(entry));
+        }
+        m_buffer.clear();
+
+        std::make_heap(m_buckets[0].begin(), m_buckets[0].end(), EntryComparator());
+    }
+
+    void switch_to_fallback()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            for (auto& [key, entry] : bucket)
+            {
+                m_fallback.insert(std::move(entry));
+            }
+            bucket.clear();
+        }
+        m_size = 0;
+        m_use_fallback = true;
+    }
+
+public:
+    RadixHeapOpenList() : m_buckets(), m_buffer(), m_last(0), m_size(0), m_use_fallback(false), m_fallback() {}
+
+    void insert(E entry)
+    {
+        if (!m_use_fallback)
+        {
+            const auto key = get_radix_key(entry);
+
+            if (key && (m_size == 0 || key.value() >= m_last))
+            {
+                if (m_size == 0)
+                {
+                    m_last = std::min(m_last, key.value());
+                }
+                const auto index = get_bucket_index(key.value(), m_last);
+                m_buckets[index].emplace_back(key.value(), std::move(entry));
+                if (index == 0)
+                {
+                    std::push_heap(m_buckets[0].begin(), m_buckets[0].end(), EntryComparator());
+                }
+                ++m_size;
+                return;
+            }
+
+            switch_to_fallback();
+        }
+
+        m_fallback.insert(std::move(entry));
+    }
+
+    decltype(auto) top() const { return top_entry().get_item(); }
+
+    const E& top_entry() const
+    {
+        assert(!empty());
+
+        if (m_use_fallback)
+        {
+            return m_fallback.top_entry();
+        }
+
+        redistribute();
+
+        return m_buckets[0].front().second;
+    }
+
+    void pop()
+    {
+        assert(!empty());
+
+        if (m_use_fallback)
+        {
+            m_fallback.pop();
+            return;
+        }
+
+        redistribute();
+
+        std::pop_heap(m_buckets[0].begin(), m_buckets[0].end(), EntryComparator());
+        m_buckets[0].pop_back();
+        --m_size;
+    }
+
+    void clear()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            bucket.clear();
+        }
+        m_last = 0;
+        m_size = 0;
+        m_use_fallback = false;
+        m_fallback.clear();
+    }
+
+    bool empty() const { return (m_use_fallback) ? m_fallback.empty() : (m_size == 0); }
+
+    std::size_t size() const { return (m_use_fallback) ? m_fallback.size() : m_size; }
+
+    /// @brief Return true iff the entries are ordered by a `PriorityQueue`.
+    bool uses_fallback() const { return m_use_fallback; }
+
+    /// @brief Return the number of bytes allocated for the buckets and the redistribution buffer.
+    std::size_t get_estimated_memory_usage_in_bytes() const
+    {
+        auto num_bytes = m_buffer.capacity() * sizeof(std::pair<std::uint64_t, E>) + m_fallback.get_estimated_memory_usage_in_bytes();
+        for (const auto& bucket : m_buckets)
+        {
+            num_bytes += bucket.capacity() * sizeof(std::pair<std::uint64_t, E>);
+        }
+        return num_bytes;
+    }
+
+    /// @brief Call `callback` on each entry in unspecified order.
+    template<typename F>
+    void for_each(F&& callback) const
+    {
+        if (m_use_fallback)
+        {
+            m_fallback.for_each(callback);
+            return;
+        }
+
+        for (const auto& bucket : m_buckets)
+        {
+            for (const auto& [key, entry] : bucket)
+            {
+                callback(entry);
+            }
+        }
+    }
+};
+
+}
+
+#endif
@@ -49,13 +49,13 @@ public:
 
     SatisficingBindingGenerator(formalism::ConjunctiveCondition conjunctive_condition, formalism::Problem problem, EventHandler event_handler = nullptr);
 
-    mimir::generator<formalism::ObjectList> create_binding_generator(const State& state,
-                                                                     const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
-                                                                     const std::optional<boost::dynamic_bitset<>>& vertex_mask);
+    mimir::generator<const formalism::ObjectList&> create_binding_generator(const State& state,
+                                                                            const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
+                                                                            const std::optional<boost::dynamic_bitset<>>& vertex_mask);
 
-    mimir::generator<formalism::ObjectList> create_binding_generator(const UnpackedStateImpl& unpacked_state,
-                                                                     const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
-                                                                     const std::optional<boost::dynamic_bitset<>>& vertex_mask);
+    mimir::generator<const formalism::ObjectList&> create_binding_generator(const UnpackedStateImpl& unpacked_state,
+                                                                            const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
+                                                                            const std::optional<boost::dynamic_bitset<>>& vertex_mask);
 
     mimir::generator<std::pair<formalism::ObjectList,
                                std::tuple<formalism::GroundLiteralList<formalism::StaticTag>,
@@ -86,7 +86,7 @@ protected:
     formalism::StaticConsistencyGraph m_static_consistency_graph;
 
     /* Memory for reuse */
-    std::vector<boost::dynamic_bitset<>> m_full_consistency_graph;
+    KPartiteGraph m_full_consistency_graph;
 
     /// @brief Helper to cast to Derived_.
     constexpr const auto& self() const { return static_cast<const Derived_&>(*this); }
@@ -104,15 +104,15 @@ protected:
 
     bool is_valid_binding(const UnpackedStateImpl& unpacked_state, const formalism::ObjectList& binding);
 
-    mimir::generator<formalism::ObjectList> nullary_case(const UnpackedStateImpl& unpacked_state);
+    mimir::generator<const formalism::ObjectList&> nullary_case(const UnpackedStateImpl& unpacked_state);
 
-    mimir::generator<formalism::ObjectList> unary_case(const UnpackedStateImpl& unpacked_state,
-                                                       const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
-                                                       const std::optional<boost::dynamic_bitset<>>& vertex_mask);
+    mimir::generator<const formalism::ObjectList&> unary_case(const UnpackedStateImpl& unpacked_state,
+                                                              const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
+                                                              const std::optional<boost::dynamic_bitset<>>& vertex_mask);
 
-    mimir::generator<formalism::ObjectList> general_case(const UnpackedStateImpl& unpacked_state,
-                                                         const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
-                                                         const std::optional<boost::dynamic_bitset<>>& vertex_mask);
+    mimir::generator<const formalism::ObjectList&> general_case(const UnpackedStateImpl& unpacked_state,
+                                                                const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
+                                                                const std::optional<boost::dynamic_bitset<>>& vertex_mask);
 };
 
 }
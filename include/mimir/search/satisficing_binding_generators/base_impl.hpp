@@ -45,18 +45,6 @@ namespace mimir::search
  * Implementations
  */
 
-/**
- * Helpers
- */
-
-inline void clear_full_consistency_graph(std::vector<boost::dynamic_bitset<>>& full_consistency_graph)
-{
-    for (auto& row : full_consistency_graph)
-    {
-        row.reset();
-    }
-}
-
 /**
  * SatisficingBindingGenerator
  */
@@ -146,49 +134,49 @@ bool SatisficingBindingGenerator<Derived_>::is_valid_binding(const UnpackedState
 }
 
 template<typename Derived_>
-mimir::generator<formalism::ObjectList> SatisficingBindingGenerator<Derived_>::nullary_case(const UnpackedStateImpl& unpacked_state)
+mimir::generator<const formalism::ObjectList&> SatisficingBindingGenerator<Derived_>::nullary_case(const UnpackedStateImpl& unpacked_state)
 {
     // There are no parameters, meaning that the preconditions are already fully ground. Simply check if the single ground action is applicable.
     auto binding = formalism::ObjectList {};
 
     if (is_valid_binding(unpacked_state, binding))
-        co_yield std::move(binding);
+        co_yield binding;
 }
 
 template<typename Derived_>
-mimir::generator<formalism::ObjectList> SatisficingBindingGenerator<Derived_>::unary_case(const UnpackedStateImpl& unpacked_state,
-                                                                                          const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
-                                                                                          const std::optional<boost::dynamic_bitset<>>& vertex_mask)
+mimir::generator<const formalism::ObjectList&>
+SatisficingBindingGenerator<Derived_>::unary_case(const UnpackedStateImpl& unpacked_state,
+                                                  const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
+                                                  const std::optional<boost::dynamic_bitset<>>& vertex_mask)
 {
+    // The binding is reused for all vertices, so consumers must copy it to keep it.
+    auto binding = formalism::ObjectList(1);
+
     for (const auto& vertex : m_static_consistency_graph.consistent_vertices(m_problem->get_static_assignment_sets(), dynamic_assignment_sets, vertex_mask))
     {
-        auto binding = formalism::ObjectList { m_problem->get_repositories().get_object(vertex.get_object_index()) };
+        binding.front() = m_problem->get_repositories().get_object(vertex.get_object_index());
 
         if (is_valid_binding(unpacked_state, binding))
-            co_yield std::move(binding);
+            co_yield binding;
     }
 }
 
 template<typename Derived_>
-mimir::generator<formalism::ObjectList> SatisficingBindingGenerator<Derived_>::general_case(const UnpackedStateImpl& unpacked_state,
-                                                                                            const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
-                                                                                            const std::optional<boost::dynamic_bitset<>>& vertex_mask)
+mimir::generator<const formalism::ObjectList&>
+SatisficingBindingGenerator<Derived_>::general_case(const UnpackedStateImpl& unpacked_state,
+                                                    const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
+                                                    const std::optional<boost::dynamic_bitset<>>& vertex_mask)
 {
     if (m_static_consistency_graph.get_num_edges() == 0)
     {
         co_return;
     }
 
-    clear_full_consistency_graph(m_full_consistency_graph);
+    m_full_consistency_graph.reset();
 
     for (const auto& edge : m_static_consistency_graph.consistent_edges(m_problem->get_static_assignment_sets(), dynamic_assignment_sets, vertex_mask))
     {
-        const auto first_index = edge.get_src().get_index();
-        const auto second_index = edge.get_dst().get_index();
-        auto& first_row = m_full_consistency_graph[first_index];
-        auto& second_row = m_full_consistency_graph[second_index];
-        first_row[second_index] = 1;
-        second_row[first_index] = 1;
+        m_full_consistency_graph.add_edge(edge.get_src().get_index(), edge.get_dst().get_index());
     }
 
     // Find all cliques of size num_parameters whose labels denote complete assignments that might yield an applicable precondition. The relatively few
@@ -197,11 +185,13 @@ mimir::generator<formalism::ObjectList> SatisficingBindingGenerator<Derived_>::g
 
     const auto& problem = *m_problem;
 
+    // The binding is reused for all cliques, so consumers must copy it to keep it.
+    auto binding = formalism::ObjectList(m_conjunctive_condition->get_arity());
+
     const auto& vertices = m_static_consistency_graph.get_vertices();
-    const auto& partitions = m_static_consistency_graph.get_vertices_by_parameter_index();
-    for (const auto& clique : create_k_clique_in_k_partite_graph_generator(m_full_consistency_graph, partitions))
+    for (const auto& clique : create_k_clique_in_k_partite_graph_generator(m_full_consistency_graph))
     {
-        auto binding = formalism::ObjectList(clique.size());
+        assert(clique.size() == binding.size());
 
         for (std::size_t index = 0; index < clique.size(); ++index)
         {
@@ -212,7 +202,7 @@ mimir::generator<formalism::ObjectList> SatisficingBindingGenerator<Derived_>::g
         }
 
         if (is_valid_binding(unpacked_state, binding))
-            co_yield std::move(binding);
+            co_yield binding;
     }
 }
 
@@ -224,12 +214,12 @@ SatisficingBindingGenerator<Derived_>::SatisficingBindingGenerator(formalism::Co
     m_problem(problem),
     m_event_handler(event_handler ? event_handler : std::make_shared<DefaultEventHandlerImpl>()),
     m_static_consistency_graph(*m_problem, m_conjunctive_condition, 0, m_conjunctive_condition->get_parameters().size()),
-    m_full_consistency_graph(m_static_consistency_graph.get_vertices().size(), boost::dynamic_bitset<>(m_static_consistency_graph.get_vertices().size()))
+    m_full_consistency_graph(m_static_consistency_graph.get_vertices_by_parameter_index())
 {
 }
 
 template<typename Derived_>
-mimir::generator<formalism::ObjectList>
+mimir::generator<const formalism::ObjectList&>
 SatisficingBindingGenerator<Derived_>::create_binding_generator(const State& state,
                                                                 const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
                                                                 const std::optional<boost::dynamic_bitset<>>& vertex_mask)
@@ -238,7 +228,7 @@ SatisficingBindingGenerator<Derived_>::create_binding_generator(const State& sta
 }
 
 template<typename Derived_>
-mimir::generator<formalism::ObjectList>
+mimir::generator<const formalism::ObjectList&>
 SatisficingBindingGenerator<Derived_>::create_binding_generator(const UnpackedStateImpl& unpacked_state,
                                                                 const formalism::DynamicAssignmentSets& dynamic_assignment_sets,
                                                                 const std::optional<boost::dynamic_bitset<>>& vertex_mask)
@@ -31,6 +31,19 @@ private:
     ApplicableActionGenerator m_applicable_action_generator;
     StateRepository m_state_repository;
 
+    /// @brief The bytes of the vectors owned by the first `num_objects` ground objects of a repository.
+    /// Ground objects are immutable, so `get_memory_usage` only visits the objects created since its last call.
+    struct DynamicStorage
+    {
+        size_t num_objects = 0;
+        size_t num_bytes = 0;
+    };
+
+    mutable DynamicStorage m_ground_action_storage;
+    mutable DynamicStorage m_ground_conjunctive_condition_storage;
+    mutable DynamicStorage m_ground_conjunctive_effect_storage;
+    mutable DynamicStorage m_ground_axiom_storage;
+
     SearchContextImpl(formalism::Problem problem, ApplicableActionGenerator applicable_action_generator, StateRepository state_repository);
 
 public:
@@ -71,9 +84,12 @@ public:
     struct Options
     {
         SearchMode mode;
+        /// @brief Prune the applicable actions with strong stubborn sets, which preserves completeness and optimality.
+        /// The interference relation is precomputed in grounded mode and computed on demand in lifted mode.
+        bool stubborn_sets;
 
-        Options() : mode(GroundedOptions()) {}
-        explicit Options(SearchMode mode) : mode(mode) {}
+        Options() : mode(GroundedOptions()), stubborn_sets(false) {}
+        explicit Options(SearchMode mode, bool stubborn_sets = false) : mode(mode), stubborn_sets(stubborn_sets) {}
     };
 
     /// @brief Construction from `ProblemImpl` construction API.
@@ -93,9 +109,29 @@ public:
     /// @param state_repository
     static SearchContext create(formalism::Problem problem, ApplicableActionGenerator applicable_action_generator, StateRepository state_repository);
 
+    /// @brief The estimated number of bytes held by the components of a search context.
+    struct MemoryUsage
+    {
+        size_t num_bytes_for_index_tree_table = 0;   ///< The index tree table that stores the packed states.
+        size_t num_bytes_for_double_leaf_table = 0;  ///< The double leaf table that stores the packed numeric variables.
+        size_t num_bytes_for_states = 0;             ///< The state maps and unpacked states of the state repository.
+        size_t num_bytes_for_ground_actions = 0;     ///< The ground actions, including their conditions and effects.
+        size_t num_bytes_for_ground_axioms = 0;      ///< The ground axioms.
+        size_t num_bytes_for_lists = 0;              ///< The atom and numeric lists shared by conditions and effects.
+
+        size_t get_total() const;
+    };
+
     const formalism::Problem& get_problem() const;
     const ApplicableActionGenerator get_applicable_action_generator() const;
     const StateRepository get_state_repository() const;
+
+    /// @brief Estimate the memory usage of the problem tables, the state repository, and the ground actions and axioms.
+    /// Containers are counted by capacity. The hash sets of the repositories are estimated by one pointer, index, and control byte per element,
+    /// and ground function expressions are not counted, so the estimate is a lower bound.
+    /// Must not be called concurrently with the creation of states or ground objects.
+    /// @return the memory usage.
+    MemoryUsage get_memory_usage() const;
 };
 }
 
@@ -21,11 +21,16 @@
 #include "mimir/common/declarations.hpp"
 #include "mimir/common/segmented_vector.hpp"
 
+#include <cstdint>
+#include <limits>
 #include <tuple>
 
 namespace mimir::search
 {
 
+/// @brief The status of a search node.
+/// Search nodes that pack the status into a bitfield next to other bitfields declare it over `Index`
+/// and convert it in accessors, because MSVC only packs adjacent bitfields with the same underlying type.
 enum SearchNodeStatus : uint8_t
 {
     GOAL = 0,
@@ -40,6 +45,31 @@ concept IsSearchNode = requires(const T a) {
     { a.parent_state } -> std::convertible_to<Index>;
 };
 
+/// @brief A search node that additionally records the index of the ground action that generated it.
+/// The index is typically stored in a bitfield of the node, where `T::UNKNOWN_PARENT_ACTION` is the largest representable value.
+/// It marks nodes without a generating action and nodes whose action index does not fit.
+template<typename T>
+concept IsSearchNodeWithParentAction = IsSearchNode<T> && requires(const T a) {
+    { T::UNKNOWN_PARENT_ACTION } -> std::convertible_to<Index>;
+    { a.parent_action } -> std::convertible_to<Index>;
+};
+
+/// @brief Return the largest value of a bitfield with `NumBits` bits to be used as `UNKNOWN_PARENT_ACTION`.
+template<size_t NumBits>
+    requires(NumBits > 0 && NumBits <= 32)
+consteval Index get_unknown_parent_action()
+{
+    return (NumBits == 32) ? std::numeric_limits<Index>::max() : static_cast<Index>((uint64_t(1) << NumBits) - 1);
+}
+
+/// @brief Record the index of the generating `action_index` in the given `search_node`.
+/// Indices that are not representable are recorded as unknown, which are recomputed during plan extraction.
+template<IsSearchNodeWithParentAction SearchNode>
+void set_parent_action(SearchNode& search_node, Index action_index)
+{
+    search_node.parent_action = (action_index < SearchNode::UNKNOWN_PARENT_ACTION) ? action_index : SearchNode::UNKNOWN_PARENT_ACTION;
+}
+
 }
 
 #endif
\ No newline at end of file
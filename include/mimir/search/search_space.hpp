@@ -20,8 +20,11 @@
 
 #include "mimir/common/segmented_vector.hpp"
 #include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
 #include "mimir/search/applicability.hpp"
 #include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/search_context.hpp"
 #include "mimir/search/search_node.hpp"
 #include "mimir/search/state_repository.hpp"
 
@@ -80,6 +83,34 @@ inline Plan extract_total_ordered_plan(State start_state,
 
     for (size_t i = 0; i < state_trajectory.size() - 1; ++i)
     {
+        if constexpr (IsSearchNodeWithParentAction<SearchNode>)
+        {
+            // The search node records the generating action, hence we can avoid generating all applicable actions.
+            const auto& successor_search_node = (i + 2 == state_trajectory.size()) ? final_search_node : search_nodes.at(state_trajectory.at(i + 1));
+
+            if (successor_search_node.parent_action != SearchNode::UNKNOWN_PARENT_ACTION)
+            {
+                const auto action = boost::hana::at_key(context->get_problem()->get_repositories().get_hana_repositories(),
+                                                        boost::hana::type<formalism::GroundActionImpl> {})
+                                        .at(successor_search_node.parent_action);
+
+                assert(is_applicable(action, state));
+
+                const auto [successor_state, successor_state_metric_value] =
+                    context->get_state_repository()->get_or_create_successor_state(state, action, state_metric_value);
+
+                if (successor_state.get_index() != state_trajectory.at(i + 1))
+                    throw std::runtime_error("Failed to reconstruct plan from solution trace.");
+
+                actions.push_back(action);
+                states.push_back(successor_state);
+                state = successor_state;
+                state_metric_value = successor_state_metric_value;
+
+                continue;
+            }
+        }
+
         // We have to take the (state,action) pair that yields lowest metric value.
         auto lowest_action = formalism::GroundAction { nullptr };
         auto lowest_state = std::optional<State> { std::nullopt };
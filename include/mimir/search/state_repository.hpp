@@ -18,39 +18,190 @@
 #ifndef MIMIR_SEARCH_STATE_REPOSITORY_HPP_
 #define MIMIR_SEARCH_STATE_REPOSITORY_HPP_
 
+#include "mimir/algorithms/lru_cache.hpp"
 #include "mimir/algorithms/shared_object_pool.hpp"
+#include "mimir/common/filesystem.hpp"
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/search/declarations.hpp"
 #include "mimir/search/state.hpp"
 #include "mimir/search/state_unpacked.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
 namespace mimir::search
 {
 
+/// @brief `SuccessorBatch` holds the successors of a state that were created by `StateRepositoryImpl::expand`.
+/// A batch is meant to be reused across expansions so that its buffers are only allocated once.
+class SuccessorBatch
+{
+public:
+    struct Successor
+    {
+        formalism::GroundAction action;
+        State state;
+        ContinuousCost state_metric_value;
+    };
+
+private:
+    /// @brief A successor with packed fluent atoms and numeric variables whose extended state was not looked up yet.
+    /// The dense successor is only materialized from the parent and the applied effects if it is not cached.
+    struct Candidate
+    {
+        IndexList applied_negative_effect_atoms;
+        IndexList applied_positive_effect_atoms;
+        FlatDoubleList fluent_numeric_variables;  ///< Only valid if `fluent_numeric_variables_changed`.
+        valla::Slot<Index> fluent_atoms;
+        valla::Slot<Index> numeric_variables;
+        ContinuousCost state_metric_value;
+        bool fluent_numeric_variables_changed;
+        bool is_parent;  ///< True if the action leaves the state unchanged.
+    };
+
+    formalism::GroundActionList m_actions;
+    std::vector<Candidate> m_candidates;
+    std::vector<Successor> m_successors;
+
+    friend class StateRepositoryImpl;
+
+public:
+    SuccessorBatch() = default;
+
+    /// @brief Clear the successors but keep the candidates to reuse their effect lists.
+    void clear()
+    {
+        m_actions.clear();
+        m_successors.clear();
+    }
+
+    size_t size() const { return m_successors.size(); }
+    bool empty() const { return m_successors.empty(); }
+    const Successor& operator[](size_t pos) const { return m_successors[pos]; }
+    std::vector<Successor>::const_iterator begin() const { return m_successors.begin(); }
+    std::vector<Successor>::const_iterator end() const { return m_successors.end(); }
+};
+
 class StateRepositoryImpl : public std::enable_shared_from_this<StateRepositoryImpl>
 {
+public:
+    struct Options
+    {
+        /// @brief Allow concurrent calls to `get_or_create_*`, `get_state`, and `get_state_index` from multiple threads.
+        /// A `State` must be copied and destroyed only on the thread that created it.
+        /// All repositories of a problem share its index tree and double leaf tables, which are guarded by `ProblemImpl::get_table_mutex`.
+        /// Hence, a repository that is not thread-safe must not be used concurrently with any other repository of the same problem.
+        bool thread_safe = false;
+        /// @brief Pack the states into index tree and double leaf tables owned by the repository instead of the tables of the problem.
+        /// The tables are freed with the repository, and its packed states can only be unpacked by the repository itself.
+        bool private_tables = false;
+        /// @brief The number of independently locked partitions of the state map if `thread_safe` is enabled.
+        size_t num_shards = 64;
+        /// @brief The maximum number of recently used unpacked states that `get_state` returns without decompression.
+        /// The cache is private to each thread and disabled if 0.
+        size_t unpacked_state_cache_size = 1024;
+
+        Options() = default;
+    };
+
+    struct UnpackedStateCacheStatistics
+    {
+        uint64_t num_hits = 0;    ///< The number of calls to `get_state` that skipped decompression.
+        uint64_t num_misses = 0;  ///< The number of calls to `get_state` that decompressed the state.
+        size_t num_entries = 0;   ///< The number of cached unpacked states.
+        size_t num_bytes = 0;     ///< The estimated memory usage of the cached unpacked states.
+    };
+
 private:
+    /// @brief Memory for reuse that is private to a single thread.
+    struct ThreadContext
+    {
+        SuccessorBatch::Candidate candidate;  ///< The candidate of `get_or_create_successor_state`.
+
+        /// @brief The fluent atoms of the state with index `successor_parent_index`.
+        /// The effects of an action are applied in place to pack a successor and reverted afterwards.
+        FlatBitset successor_fluent_atoms;
+        Index successor_parent_index;
+
+        IndexList index_list;
+
+        FlatBitset reached_fluent_atoms;   ///< Stores all fluent atoms encountered by this thread.
+        FlatBitset reached_derived_atoms;  ///< Stores all derived atoms encountered by this thread.
+
+        SharedObjectPool<UnpackedStateImpl> unpacked_state_pool;
+
+        /// @brief Keeps recently used unpacked states alive, indexed by state index.
+        /// Declared after `unpacked_state_pool` to be destroyed before it.
+        LRUCache<Index, SharedObjectPoolPtr<UnpackedStateImpl>> unpacked_state_cache;
+        uint64_t num_unpacked_state_cache_hits;
+        uint64_t num_unpacked_state_cache_misses;
+
+        explicit ThreadContext(size_t unpacked_state_cache_size);
+    };
+
+    Options m_options;
+    uint64_t m_id;  ///< Identifies the repository in the thread-local context cache.
+
     AxiomEvaluator m_axiom_evaluator;  ///< The axiom evaluator.
 
-    PackedStateImplMap m_states;  ///< Stores all created extended states.
+    std::unique_ptr<valla::IndexedHashSet<valla::Slot<Index>, Index>> m_private_index_tree_table;  ///< Only used if `private_tables` is enabled.
+    std::unique_ptr<valla::IndexedHashSet<double, Index>> m_private_double_leaf_table;             ///< Only used if `private_tables` is enabled.
+    std::shared_mutex m_private_table_mutex;
+    valla::IndexedHashSet<valla::Slot<Index>, Index>* m_index_tree_table;  ///< The private table or the table of the problem.
+    valla::IndexedHashSet<double, Index>* m_double_leaf_table;             ///< The private table or the table of the problem.
+    std::shared_mutex* m_table_mutex;                                      ///< Guards `m_index_tree_table` and `m_double_leaf_table`.
+
+    std::vector<PackedStateImplMap> m_states;  ///< Stores all created extended states, partitioned by hash.
+    std::vector<std::mutex> m_state_mutexes;   ///< One mutex per partition of `m_states`.
+    std::atomic<Index> m_num_states;           ///< Source of the dense state indices.
+
+    std::mutex m_axiom_evaluator_mutex;  ///< Guards the axiom evaluator.
+
+    mutable std::mutex m_thread_contexts_mutex;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<ThreadContext>>> m_thread_contexts;
+    uint64_t m_num_released_unpacked_state_cache_hits;    ///< The cache hits of released thread contexts.
+    uint64_t m_num_released_unpacked_state_cache_misses;  ///< The cache misses of released thread contexts.
 
-    FlatBitset m_reached_fluent_atoms;   ///< Stores all encountered fluent atoms.
-    FlatBitset m_reached_derived_atoms;  ///< Stores all encountered derived atoms.
+    mutable FlatBitset m_reached_fluent_atoms;   ///< Union of the reached fluent atoms over all thread contexts, including released ones.
+    mutable FlatBitset m_reached_derived_atoms;  ///< Union of the reached derived atoms over all thread contexts, including released ones.
 
-    /* Memory for reuse */
+    /// @brief The repository id and thread context that the calling thread used most recently.
+    static std::pair<uint64_t, ThreadContext*>& get_cached_thread_context();
 
-    FlatBitset m_applied_positive_effect_atoms;
-    FlatBitset m_applied_negative_effect_atoms;
+    ThreadContext& get_thread_context();
 
-    IndexList m_index_list;
+    size_t get_shard(const PackedStateImpl& state) const;
 
-    SharedObjectPool<UnpackedStateImpl> m_unpacked_state_pool;
+    /// @brief Find the stored state that is equal to the given `state`.
+    /// @return the stored state and its index, or `nullptr` if no such state exists.
+    std::pair<PackedState, Index> find_state(const PackedStateImpl& state);
+
+    /// @brief Find the stored state that is equal to the given `state`, or store it with a fresh index.
+    /// @return the stored state and its index.
+    std::pair<PackedState, Index> get_or_create_state_index(const PackedStateImpl& state);
+
+    /// @brief Collect the effects of `action` in `state` and pack the fluent atoms and numeric variables of the successor.
+    void create_successor_candidate(const State& state,
+                                    formalism::GroundAction action,
+                                    ContinuousCost state_metric_value,
+                                    ThreadContext& thread_context,
+                                    SuccessorBatch::Candidate& out_candidate);
+
+    /// @brief Copy the parent `state` and apply the effects of the `candidate` to a fresh dense state without derived atoms.
+    SharedObjectPoolPtr<UnpackedStateImpl>
+    unpack_successor_state(const State& state, ThreadContext& thread_context, const SuccessorBatch::Candidate& candidate);
+
+    /// @brief Find the extended successor state of the `candidate` or create it by evaluating the axioms.
+    std::pair<State, ContinuousCost> intern_successor_state(const State& state, ThreadContext& thread_context, SuccessorBatch::Candidate& candidate);
 
 public:
-    explicit StateRepositoryImpl(AxiomEvaluator axiom_evaluator);
+    explicit StateRepositoryImpl(AxiomEvaluator axiom_evaluator, const Options& options = Options());
 
-    static StateRepository create(AxiomEvaluator axiom_evaluator);
+    static StateRepository create(AxiomEvaluator axiom_evaluator, const Options& options = Options());
 
     StateRepositoryImpl(const StateRepositoryImpl& other) = delete;
     StateRepositoryImpl& operator=(const StateRepositoryImpl& other) = delete;
@@ -69,14 +220,26 @@ public:
                                                          const FlatDoubleList& fluent_numeric_variables);
 
     /// @brief Get or create the successor state when applying the given ground `action` in the given `state`.
+    /// Only the atoms in the applied add and delete lists are touched, and the packed fluent atoms
+    /// and numeric variables of `state` are reused if the action leaves them unchanged.
     /// @param state is the state.
     /// @param action is the ground action.
     /// @param state_metric_value is the metric value of the state.
     /// @return the successor state and its associated metric value.
     std::pair<State, ContinuousCost> get_or_create_successor_state(const State& state, formalism::GroundAction action, ContinuousCost state_metric_value);
 
+    /// @brief Get or create the successor states of all applicable actions in the given `state`.
+    /// The actions are collected at once, all successors are packed before the state map is probed,
+    /// and the buckets of the state map are prefetched in between if the repository is not thread-safe.
+    /// The successors and their indices are the same as for successive calls to `get_or_create_successor_state`.
+    /// @param state is the state.
+    /// @param state_metric_value is the metric value of the state.
+    /// @param applicable_action_generator generates the applicable actions.
+    /// @param out_batch is the batch that is overwritten with the successors in the order of the applicable actions.
+    void expand(const State& state, ContinuousCost state_metric_value, IApplicableActionGenerator& applicable_action_generator, SuccessorBatch& out_batch);
+
     /// @brief Get the state with the given packed state.
-    /// This operation unpacks the state.
+    /// This operation unpacks the state unless it was recently used by the calling thread.
     /// @param state is the packed state.
     /// @return the state.
     State get_state(const PackedStateImpl& state);
@@ -87,28 +250,66 @@ public:
     /// @return the index.
     Index get_state_index(const PackedStateImpl& state);
 
+    /// @brief Free the buffers and unpacked states of the calling thread if the repository is thread-safe.
+    /// Its reached atoms and cache statistics are retained, and the thread gets a fresh context on its next use of the repository.
+    /// Must be called by worker threads before they exit, after they destroyed all states they created.
+    void release_thread_context();
+
+    /**
+     * Serialization
+     */
+
+    /// @brief Write the fluent atoms and numeric variables of all states to `file`, ordered by state index.
+    /// Ground atoms are stored by the names of their predicates and objects because their indices depend on the order of grounding.
+    /// Must not be called concurrently with the creation of states.
+    /// @param file is the file to write.
+    void serialize(const fs::path& file) const;
+
+    /// @brief Get or create the states in a `file` written by `serialize` for the same problem, in the order of their indices.
+    /// The file is memory-mapped and read in place. Derived atoms are recomputed,
+    /// and the index tree and double leaf tables of the problem are extended by the loaded states.
+    /// If the repository was empty, each loaded state keeps its stored index.
+    /// @param file is the file to read.
+    /// @return the packed states in the order of their stored indices.
+    std::vector<PackedState> deserialize(const fs::path& file);
+
     /**
      * Getters
      */
 
     const formalism::Problem& get_problem() const;
 
+    const Options& get_options() const;
+
     /// @brief Return the number of created states.
     /// @return the number of created states.
     size_t get_state_count() const;
 
-    /// @brief Return the state map.
-    /// @return the states map.
-    const PackedStateImplMap& get_states() const;
+    /// @brief Return the state maps, one per partition.
+    /// @return the state maps.
+    const std::vector<PackedStateImplMap>& get_states() const;
 
     /// @brief Return the reached fluent ground atoms.
+    /// Must not be called concurrently with the creation of states.
     /// @return a bitset that stores the reached fluent ground atom indices.
     const FlatBitset& get_reached_fluent_ground_atoms_bitset() const;
 
     /// @brief Return the reached derived ground atoms.
+    /// Must not be called concurrently with the creation of states.
     /// @return a bitset that stores the reached derived ground atom indices.
     const FlatBitset& get_reached_derived_ground_atoms_bitset() const;
 
+    /// @brief Estimate the memory usage of the state maps, the unpacked states, and the per-thread buffers.
+    /// The packed states themselves are stored in the tables of the problem and are not included.
+    /// Must not be called concurrently with the creation of states.
+    /// @return the estimated memory usage in bytes.
+    size_t get_estimated_memory_usage_in_bytes() const;
+
+    /// @brief Return the statistics of the unpacked state cache, summed over all threads.
+    /// Must not be called concurrently with the creation of states.
+    /// @return the unpacked state cache statistics.
+    UnpackedStateCacheStatistics get_unpacked_state_cache_statistics() const;
+
     /// @brief Get the underlying axiom evaluator.
     /// @return the axiom evaluator.
     const AxiomEvaluator& get_axiom_evaluator() const;
@@ -44,6 +44,9 @@ class CustomBrFSEventHandler(search.IBrFSEventHandler):
     def on_end_search(self, num_reached_fluent_atoms : int, num_reached_derived_atoms: int, num_states: int, num_nodes: int, num_actions: int, num_axioms: int):
         pass
 
+    def on_end_bitstate_search(self, num_bits: int, num_set_bits: int, estimated_omission_probability: float):
+        pass
+
     def on_solved(self, plan: search.Plan):
         pass
 
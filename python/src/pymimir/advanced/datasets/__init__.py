@@ -22,6 +22,7 @@ from pymimir.pymimir.advanced.datasets import (
 
     StateSpace,
     StateSpaceOptions,
+    StateSpaceSizeEstimate,
 )
 
 # GeneralizedStateSpace
@@ -81,6 +82,7 @@ __all__ = [
     "BidirectionalStaticProblemGraph",
     "StateSpace",
     "StateSpaceOptions",
+    "StateSpaceSizeEstimate",
     # GeneralizedStateSpace
     "ClassVertex",
     "ClassEdge",
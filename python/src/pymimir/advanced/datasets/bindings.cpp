@@ -63,6 +63,11 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("max_num_states", &StateSpaceImpl::Options::max_num_states)
         .def_rw("timeout_ms", &StateSpaceImpl::Options::timeout_ms);
 
+    nb::class_<state_space::SizeEstimate>(m, "StateSpaceSizeEstimate")
+        .def_ro("num_states", &state_space::SizeEstimate::num_states)
+        .def_ro("num_goal_states", &state_space::SizeEstimate::num_goal_states)
+        .def_ro("estimated_omission_probability", &state_space::SizeEstimate::estimated_omission_probability);
+
     nb::class_<TupleGraphImpl::Options>(m, "TupleGraphOptions")
         .def(nb::init<>())
         .def(nb::init<size_t, bool>(), "width"_a, "enable_dominance_pruning"_a)
@@ -97,6 +102,12 @@ void bind_module_definitions(nb::module_& m)
             { return StateSpaceImpl::create(contexts, options); },
             "contexts"_a,
             "options"_a)
+        .def_static("estimate_size",
+                    &StateSpaceImpl::estimate_size,
+                    "context"_a,
+                    "num_bits"_a,
+                    "num_hash_functions"_a = 1,
+                    "options"_a = StateSpaceImpl::Options())
         .def("get_search_context", &StateSpaceImpl::get_search_context, nb::rv_policy::copy)
         .def("get_graph", &StateSpaceImpl::get_graph, nb::rv_policy::reference_internal)
         .def("get_initial_vertex", &StateSpaceImpl::get_initial_vertex, nb::rv_policy::copy)
@@ -31,6 +31,7 @@
 #include <nanobind/stl/bind_vector.h>  ///< TODO: implement our own with PyImmutable
 #include <nanobind/stl/chrono.h>
 #include <nanobind/stl/filesystem.h>
+#include <nanobind/stl/function.h>
 #include <nanobind/stl/map.h>
 #include <nanobind/stl/optional.h>
 #include <nanobind/stl/pair.h>
@@ -62,6 +62,9 @@ from pymimir.pymimir.advanced.search import (
     IPruningStrategy,
     NoPruningStrategy,
     DuplicatePruningStrategy,
+    SymmetryCertificateType,
+    SymmetryPruningStatistics,
+    SymmetryPruningStrategy,
     ArityZeroNoveltyPruningStrategy,
     ArityKNoveltyPruningStrategy,
 
@@ -96,6 +99,8 @@ from pymimir.pymimir.advanced.search import (
     DefaultBrFSEventHandler,
     BrFSOptions,
     find_solution_brfs,
+    BrFSExternalOptions,
+    find_solution_brfs_external,
 )
 
 # GBFS_EAGER
@@ -166,7 +171,15 @@ from pymimir.pymimir.advanced.search import (
     GroundedAxiomEvaluator,
     IGroundedApplicableActionGeneratorEventHandler,
     IGroundedAxiomEvaluatorEventHandler,
+    StubbornSetsApplicableActionGenerator,
+    StubbornSetsStatistics,
     IGrounder,
     LiftedGrounder,
     MatchTreeOptions,
 )
+
+# Finite-domain state encoding
+from pymimir.pymimir.advanced.search import (
+    compute_mutex_groups,
+    FiniteDomainStateEncoding,
+)
@@ -63,7 +63,7 @@ public:
 class IPyAStarEagerEventHandler : public astar_eager::IEventHandler
 {
 public:
-    NB_TRAMPOLINE(astar_eager::IEventHandler, 14);
+    NB_TRAMPOLINE(astar_eager::IEventHandler, 17);
 
     /* Trampoline (need one for each virtual function) */
     void on_expand_state(const State& state) override { NB_OVERRIDE_PURE(on_expand_state, state); }
@@ -85,6 +85,12 @@ public:
     void on_close_state(const State& state) override { NB_OVERRIDE_PURE(on_close_state, state); }
     void on_finish_f_layer(ContinuousCost f_value) override { NB_OVERRIDE_PURE(on_finish_f_layer, f_value); }
     void on_prune_state(const State& state) override { NB_OVERRIDE_PURE(on_prune_state, state); }
+    void on_heuristic_cache_hit(const State& state) override { NB_OVERRIDE_PURE(on_heuristic_cache_hit, state); }
+    void on_heuristic_cache_miss(const State& state) override { NB_OVERRIDE_PURE(on_heuristic_cache_miss, state); }
+    void on_unpacked_state_cache_statistics(uint64_t num_hits, uint64_t num_misses, uint64_t num_bytes) override
+    {
+        NB_OVERRIDE_PURE(on_unpacked_state_cache_statistics, num_hits, num_misses, num_bytes);
+    }
     void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) override
     {
         NB_OVERRIDE_PURE(on_start_search, start_state, g_value, h_value);
@@ -151,7 +157,7 @@ public:
 class IPyBrFSEventHandler : public brfs::IEventHandler
 {
 public:
-    NB_TRAMPOLINE(brfs::IEventHandler, 12);
+    NB_TRAMPOLINE(brfs::IEventHandler, 13);
 
     /* Trampoline (need one for each virtual function) */
     void on_expand_state(const State& state) override { NB_OVERRIDE_PURE(on_expand_state, state); }
@@ -182,6 +188,10 @@ public:
     {
         NB_OVERRIDE_PURE(on_end_search, num_reached_fluent_atoms, num_reached_derived_atoms, num_states, num_nodes, num_actions, num_axioms);
     }
+    void on_end_bitstate_search(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) override
+    {
+        NB_OVERRIDE_PURE(on_end_bitstate_search, num_bits, num_set_bits, estimated_omission_probability);
+    }
     void on_solved(const Plan& plan) override { NB_OVERRIDE_PURE(on_solved, plan); }
     void on_unsolvable() override { NB_OVERRIDE_PURE(on_unsolvable); }
     void on_exhausted() override { NB_OVERRIDE_PURE(on_exhausted); }
@@ -191,7 +201,7 @@ public:
 class IPyGBFSEagerEventHandler : public gbfs_eager::IEventHandler
 {
 public:
-    NB_TRAMPOLINE(gbfs_eager::IEventHandler, 11);
+    NB_TRAMPOLINE(gbfs_eager::IEventHandler, 14);
 
     /* Trampoline (need one for each virtual function) */
     void on_expand_state(const State& state) override { NB_OVERRIDE_PURE(on_expand_state, state); }
@@ -203,6 +213,12 @@ public:
         NB_OVERRIDE_PURE(on_generate_state, state, action, action_cost, successor_state);
     }
     void on_prune_state(const State& state) override { NB_OVERRIDE_PURE(on_prune_state, state); }
+    void on_heuristic_cache_hit(const State& state) override { NB_OVERRIDE_PURE(on_heuristic_cache_hit, state); }
+    void on_heuristic_cache_miss(const State& state) override { NB_OVERRIDE_PURE(on_heuristic_cache_miss, state); }
+    void on_unpacked_state_cache_statistics(uint64_t num_hits, uint64_t num_misses, uint64_t num_bytes) override
+    {
+        NB_OVERRIDE_PURE(on_unpacked_state_cache_statistics, num_hits, num_misses, num_bytes);
+    }
     void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) override
     {
         NB_OVERRIDE_PURE(on_start_search, start_state, g_value, h_value);
@@ -315,8 +331,18 @@ void bind_module_definitions(nb::module_& m)
 
     nb::class_<SearchContextImpl::Options>(m, "SearchContextOptions")
         .def(nb::init<>())
-        .def(nb::init<SearchContextImpl::SearchMode>(), "mode"_a)
-        .def_rw("mode", &SearchContextImpl::Options::mode);
+        .def(nb::init<SearchContextImpl::SearchMode, bool>(), "mode"_a, "stubborn_sets"_a = false)
+        .def_rw("mode", &SearchContextImpl::Options::mode)
+        .def_rw("stubborn_sets", &SearchContextImpl::Options::stubborn_sets);
+
+    nb::class_<SearchContextImpl::MemoryUsage>(m, "SearchContextMemoryUsage")
+        .def_ro("num_bytes_for_index_tree_table", &SearchContextImpl::MemoryUsage::num_bytes_for_index_tree_table)
+        .def_ro("num_bytes_for_double_leaf_table", &SearchContextImpl::MemoryUsage::num_bytes_for_double_leaf_table)
+        .def_ro("num_bytes_for_states", &SearchContextImpl::MemoryUsage::num_bytes_for_states)
+        .def_ro("num_bytes_for_ground_actions", &SearchContextImpl::MemoryUsage::num_bytes_for_ground_actions)
+        .def_ro("num_bytes_for_ground_axioms", &SearchContextImpl::MemoryUsage::num_bytes_for_ground_axioms)
+        .def_ro("num_bytes_for_lists", &SearchContextImpl::MemoryUsage::num_bytes_for_lists)
+        .def("get_total", &SearchContextImpl::MemoryUsage::get_total);
 
     nb::class_<SearchContextImpl>(m, "SearchContext")
         .def_static(
@@ -334,7 +360,8 @@ void bind_module_definitions(nb::module_& m)
                     "state_repository"_a)
         .def("get_problem", &SearchContextImpl::get_problem)
         .def("get_applicable_action_generator", &SearchContextImpl::get_applicable_action_generator)
-        .def("get_state_repository", &SearchContextImpl::get_state_repository);
+        .def("get_state_repository", &SearchContextImpl::get_state_repository)
+        .def("get_memory_usage", &SearchContextImpl::get_memory_usage);
 
     /* GeneralizedSearchContext */
     nb::class_<GeneralizedSearchContextImpl>(m, "GeneralizedSearchContext")
@@ -572,6 +599,20 @@ void bind_module_definitions(nb::module_& m)
         .def_static("create", &GroundedApplicableActionGeneratorImpl::DebugEventHandlerImpl::create, "quiet"_a = true);
     nb::class_<GroundedApplicableActionGeneratorImpl, IApplicableActionGenerator>(m, "GroundedApplicableActionGenerator");
 
+    // Stubborn sets
+    nb::class_<StubbornSetsApplicableActionGeneratorImpl::Statistics>(m, "StubbornSetsStatistics")
+        .def_ro("num_states", &StubbornSetsApplicableActionGeneratorImpl::Statistics::num_states)
+        .def_ro("num_unpruned_actions", &StubbornSetsApplicableActionGeneratorImpl::Statistics::num_unpruned_actions)
+        .def_ro("num_pruned_actions", &StubbornSetsApplicableActionGeneratorImpl::Statistics::num_pruned_actions)
+        .def_ro("num_interference_lists", &StubbornSetsApplicableActionGeneratorImpl::Statistics::num_interference_lists)
+        .def_ro("num_ground_actions", &StubbornSetsApplicableActionGeneratorImpl::Statistics::num_ground_actions)
+        .def_ro("is_supported", &StubbornSetsApplicableActionGeneratorImpl::Statistics::is_supported)
+        .def_ro("is_disabled", &StubbornSetsApplicableActionGeneratorImpl::Statistics::is_disabled)
+        .def("get_pruning_ratio", &StubbornSetsApplicableActionGeneratorImpl::Statistics::get_pruning_ratio)
+        .def("__str__", [](const StubbornSetsApplicableActionGeneratorImpl::Statistics& self) { return to_string(self); });
+    nb::class_<StubbornSetsApplicableActionGeneratorImpl, IApplicableActionGenerator>(m, "StubbornSetsApplicableActionGenerator")  //
+        .def("get_statistics", &StubbornSetsApplicableActionGeneratorImpl::get_statistics, nb::rv_policy::reference_internal);
+
     /* IAxiomEvaluator */
     nb::class_<IAxiomEvaluator>(m, "IAxiomEvaluator")  //
         .def("get_problem", &IAxiomEvaluator::get_problem);
@@ -615,8 +656,21 @@ void bind_module_definitions(nb::module_& m)
     /* StateRepositoryImpl */
     m.def("compute_state_metric_value", &compute_state_metric_value, "state"_a);
 
+    nb::class_<StateRepositoryImpl::Options>(m, "StateRepositoryOptions")
+        .def(nb::init<>())
+        .def_rw("thread_safe", &StateRepositoryImpl::Options::thread_safe)
+        .def_rw("private_tables", &StateRepositoryImpl::Options::private_tables)
+        .def_rw("num_shards", &StateRepositoryImpl::Options::num_shards)
+        .def_rw("unpacked_state_cache_size", &StateRepositoryImpl::Options::unpacked_state_cache_size);
+
+    nb::class_<StateRepositoryImpl::UnpackedStateCacheStatistics>(m, "UnpackedStateCacheStatistics")
+        .def_ro("num_hits", &StateRepositoryImpl::UnpackedStateCacheStatistics::num_hits)
+        .def_ro("num_misses", &StateRepositoryImpl::UnpackedStateCacheStatistics::num_misses)
+        .def_ro("num_entries", &StateRepositoryImpl::UnpackedStateCacheStatistics::num_entries)
+        .def_ro("num_bytes", &StateRepositoryImpl::UnpackedStateCacheStatistics::num_bytes);
+
     nb::class_<StateRepositoryImpl>(m, "StateRepository")
-        .def_static("create", &StateRepositoryImpl::create, "axiom_evaluator"_a)
+        .def_static("create", &StateRepositoryImpl::create, "axiom_evaluator"_a, "options"_a = StateRepositoryImpl::Options())
         .def("get_or_create_initial_state", &StateRepositoryImpl::get_or_create_initial_state, nb::rv_policy::copy)
         .def(
             "get_or_create_state",
@@ -634,8 +688,22 @@ void bind_module_definitions(nb::module_& m)
         .def("get_state", &StateRepositoryImpl::get_state, nb::rv_policy::copy, "packed_state"_a)
         .def("get_state_index", &StateRepositoryImpl::get_state_index, nb::rv_policy::copy, "packed_state"_a)
         .def("get_state_count", &StateRepositoryImpl::get_state_count, nb::rv_policy::copy)
+        .def("serialize", &StateRepositoryImpl::serialize, "file"_a)
+        .def(
+            "deserialize",
+            [](StateRepositoryImpl& self, const fs::path& file)
+            {
+                auto states = StateList {};
+                for (const auto& packed_state : self.deserialize(file))
+                {
+                    states.push_back(self.get_state(*packed_state));
+                }
+                return states;
+            },
+            "file"_a)
         .def("get_reached_fluent_ground_atoms_bitset", &StateRepositoryImpl::get_reached_fluent_ground_atoms_bitset, nb::rv_policy::copy)
-        .def("get_reached_derived_ground_atoms_bitset", &StateRepositoryImpl::get_reached_derived_ground_atoms_bitset, nb::rv_policy::copy);
+        .def("get_reached_derived_ground_atoms_bitset", &StateRepositoryImpl::get_reached_derived_ground_atoms_bitset, nb::rv_policy::copy)
+        .def("get_unpacked_state_cache_statistics", &StateRepositoryImpl::get_unpacked_state_cache_statistics);
 
     /* Grounder */
 
@@ -656,13 +724,30 @@ void bind_module_definitions(nb::module_& m)
              "match_tree_options"_a,
              "axiom_evaluator_event_handler"_a = nullptr)
         .def("create_grounded_applicable_action_generator",
-             &IGrounder::create_grounded_applicable_action_generator,
+             nb::overload_cast<const match_tree::Options&, applicable_action_generator::grounded::EventHandler>(
+                 &IGrounder::create_grounded_applicable_action_generator,
+                 nb::const_),
              "match_tree_options"_a,
              "axiom_evaluator_event_handler"_a = nullptr);
 
     nb::class_<LiftedGrounder, IGrounder>(m, "LiftedGrounder")  //
         .def(nb::init<Problem>(), "problem"_a);
 
+    /* FiniteDomainStateEncoding */
+    m.def("compute_mutex_groups", &compute_mutex_groups, "grounder"_a);
+
+    nb::class_<FiniteDomainStateEncodingImpl>(m, "FiniteDomainStateEncoding")
+        .def_static("create", nb::overload_cast<const IGrounder&>(&FiniteDomainStateEncodingImpl::create), "grounder"_a)
+        .def_static("create",
+                    nb::overload_cast<Problem, const MutexGroupList&>(&FiniteDomainStateEncodingImpl::create),
+                    "problem"_a,
+                    "mutex_groups"_a)
+        .def("get_problem", &FiniteDomainStateEncodingImpl::get_problem, nb::rv_policy::copy)
+        .def("get_num_variables", [](const FiniteDomainStateEncodingImpl& self) { return self.get_variables().size(); })
+        .def("get_num_bits", &FiniteDomainStateEncodingImpl::get_num_bits)
+        .def("get_num_words", &FiniteDomainStateEncodingImpl::get_num_words)
+        .def("get_num_bytes_per_state", &FiniteDomainStateEncodingImpl::get_num_bytes_per_state);
+
     /* Heuristics */
     nb::class_<PreferredActions>(m, "PreferredActions")  //
         .def_rw("data", &PreferredActions::data);
@@ -693,6 +778,14 @@ void bind_module_definitions(nb::module_& m)
     nb::class_<H2HeuristicImpl, IHeuristic>(m, "H2Heuristic")  //
         .def_static("create", &H2HeuristicImpl::create, "delete_relaxed_problem_explorator"_a);
 
+    nb::class_<HeuristicCacheImpl>(m, "HeuristicCache")  //
+        .def_static("create", &HeuristicCacheImpl::create, "max_num_bytes"_a = std::numeric_limits<size_t>::max())
+        .def("clear", &HeuristicCacheImpl::clear)
+        .def("get_max_num_entries", &HeuristicCacheImpl::get_max_num_entries)
+        .def("get_num_hits", &HeuristicCacheImpl::get_num_hits)
+        .def("get_num_misses", &HeuristicCacheImpl::get_num_misses)
+        .def("get_estimated_memory_usage_in_bytes", &HeuristicCacheImpl::get_estimated_memory_usage_in_bytes);
+
     /* Algorithms */
 
     // SearchResult
@@ -725,6 +818,29 @@ void bind_module_definitions(nb::module_& m)
         .def(nb::init<>())
         .def_static("create", &DuplicatePruningStrategyImpl::create);
 
+    nb::enum_<SymmetryPruningStrategyImpl::CertificateType>(m, "SymmetryCertificateType")
+        .value("GI", SymmetryPruningStrategyImpl::CertificateType::GI)
+        .value("WL1", SymmetryPruningStrategyImpl::CertificateType::WL1);
+
+    nb::class_<SymmetryPruningStrategyImpl::Statistics>(m, "SymmetryPruningStatistics")
+        .def_ro("num_certificates", &SymmetryPruningStrategyImpl::Statistics::num_certificates)
+        .def_ro("num_certificate_cache_hits", &SymmetryPruningStrategyImpl::Statistics::num_certificate_cache_hits)
+        .def_ro("num_equivalence_classes", &SymmetryPruningStrategyImpl::Statistics::num_equivalence_classes)
+        .def_ro("num_pruned_states", &SymmetryPruningStrategyImpl::Statistics::num_pruned_states)
+        .def_ro("num_improving_states", &SymmetryPruningStrategyImpl::Statistics::num_improving_states)
+        .def("get_certificate_time_ms", &SymmetryPruningStrategyImpl::Statistics::get_certificate_time_ms);
+
+    nb::class_<SymmetryPruningStrategyImpl, IPruningStrategy>(m, "SymmetryPruningStrategy")  //
+        .def(nb::init<Problem, SymmetryPruningStrategyImpl::CertificateType>(),
+             "problem"_a,
+             "certificate_type"_a = SymmetryPruningStrategyImpl::CertificateType::GI)
+        .def_static("create",
+                    &SymmetryPruningStrategyImpl::create,
+                    "problem"_a,
+                    "certificate_type"_a = SymmetryPruningStrategyImpl::CertificateType::GI)
+        .def("get_certificate_type", &SymmetryPruningStrategyImpl::get_certificate_type)
+        .def("get_statistics", &SymmetryPruningStrategyImpl::get_statistics, nb::rv_policy::reference_internal);
+
     nb::class_<iw::ArityZeroNoveltyPruningStrategyImpl, IPruningStrategy>(m, "ArityZeroNoveltyPruningStrategy")  //
         .def(nb::init<State>(), "initial_state"_a)
         .def_static("create", &iw::ArityZeroNoveltyPruningStrategyImpl::create, "initial_state"_a);
@@ -746,6 +862,11 @@ void bind_module_definitions(nb::module_& m)
         .def("get_num_expanded", &astar_eager::Statistics::get_num_expanded)
         .def("get_num_deadends", &astar_eager::Statistics::get_num_deadends)
         .def("get_num_pruned", &astar_eager::Statistics::get_num_pruned)
+        .def("get_num_heuristic_cache_hits", &astar_eager::Statistics::get_num_heuristic_cache_hits)
+        .def("get_num_heuristic_cache_misses", &astar_eager::Statistics::get_num_heuristic_cache_misses)
+        .def("get_num_unpacked_state_cache_hits", &astar_eager::Statistics::get_num_unpacked_state_cache_hits)
+        .def("get_num_unpacked_state_cache_misses", &astar_eager::Statistics::get_num_unpacked_state_cache_misses)
+        .def("get_num_bytes_for_unpacked_state_cache", &astar_eager::Statistics::get_num_bytes_for_unpacked_state_cache)
         .def("get_num_generated_until_f_value", &astar_eager::Statistics::get_num_generated_until_f_value)
         .def("get_num_expanded_until_f_value", &astar_eager::Statistics::get_num_expanded_until_f_value)
         .def("get_num_deadends_until_f_value", &astar_eager::Statistics::get_num_deadends_until_f_value)
@@ -763,6 +884,9 @@ void bind_module_definitions(nb::module_& m)
         .def("on_close_state", &astar_eager::IEventHandler::on_close_state)
         .def("on_finish_f_layer", &astar_eager::IEventHandler::on_finish_f_layer)
         .def("on_prune_state", &astar_eager::IEventHandler::on_prune_state)
+        .def("on_heuristic_cache_hit", &astar_eager::IEventHandler::on_heuristic_cache_hit)
+        .def("on_heuristic_cache_miss", &astar_eager::IEventHandler::on_heuristic_cache_miss)
+        .def("on_unpacked_state_cache_statistics", &astar_eager::IEventHandler::on_unpacked_state_cache_statistics)
         .def("on_start_search", &astar_eager::IEventHandler::on_start_search)
         .def("on_end_search", &astar_eager::IEventHandler::on_end_search)
         .def("on_solved", &astar_eager::IEventHandler::on_solved)
@@ -783,11 +907,35 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("event_handler", &astar_eager::Options::event_handler)
         .def_rw("goal_strategy", &astar_eager::Options::goal_strategy)
         .def_rw("pruning_strategy", &astar_eager::Options::pruning_strategy)
+        .def_rw("heuristic_cache", &astar_eager::Options::heuristic_cache)
         .def_rw("max_num_states", &astar_eager::Options::max_num_states)
-        .def_rw("max_time_in_ms", &astar_eager::Options::max_time_in_ms);
+        .def_rw("max_time_in_ms", &astar_eager::Options::max_time_in_ms)
+        .def_rw("max_memory_in_bytes", &astar_eager::Options::max_memory_in_bytes)
+        .def_rw("checkpoint_file", &astar_eager::Options::checkpoint_file)
+        .def_rw("checkpoint_interval_in_ms", &astar_eager::Options::checkpoint_interval_in_ms)
+        .def_rw("resume_from_checkpoint", &astar_eager::Options::resume_from_checkpoint);
 
     m.def("find_solution_astar_eager", &astar_eager::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
 
+    // AStar_PARALLEL
+    nb::class_<astar_parallel::Options>(m, "AStarParallelOptions")  //
+        .def(nb::init<>())
+        .def_rw("start_state", &astar_parallel::Options::start_state)
+        .def_rw("event_handler", &astar_parallel::Options::event_handler)
+        .def_rw("goal_strategy", &astar_parallel::Options::goal_strategy)
+        .def_rw("num_threads", &astar_parallel::Options::num_threads)
+        .def_rw("create_applicable_action_generator", &astar_parallel::Options::create_applicable_action_generator)
+        .def_rw("create_heuristic", &astar_parallel::Options::create_heuristic)
+        .def_rw("max_num_states", &astar_parallel::Options::max_num_states)
+        .def_rw("max_time_in_ms", &astar_parallel::Options::max_time_in_ms);
+
+    m.def("find_solution_astar_parallel",
+          &astar_parallel::find_solution,
+          "search_context"_a,
+          "heuristic"_a,
+          "options"_a,
+          nb::call_guard<nb::gil_scoped_release>());
+
     // AStar_LAZY
     nb::class_<astar_lazy::Statistics>(m, "AStarLazyStatistics")  //
         .def(nb::init<>())
@@ -835,6 +983,7 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("pruning_strategy", &astar_lazy::Options::pruning_strategy)
         .def_rw("max_num_states", &astar_lazy::Options::max_num_states)
         .def_rw("max_time_in_ms", &astar_lazy::Options::max_time_in_ms)
+        .def_rw("max_memory_in_bytes", &astar_lazy::Options::max_memory_in_bytes)
         .def_rw("openlist_weights", &astar_lazy::Options::openlist_weights);
 
     m.def("find_solution_astar_lazy", &astar_lazy::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
@@ -851,6 +1000,8 @@ void bind_module_definitions(nb::module_& m)
         .def("get_num_expanded_until_g_value", &brfs::Statistics::get_num_expanded_until_g_value)
         .def("get_num_deadends_until_g_value", &brfs::Statistics::get_num_deadends_until_g_value)
         .def("get_num_pruned_until_g_value", &brfs::Statistics::get_num_pruned_until_g_value)
+        .def("get_num_bitstate_bits", &brfs::Statistics::get_num_bitstate_bits)
+        .def("get_estimated_omission_probability", &brfs::Statistics::get_estimated_omission_probability)
         .def("get_search_time_ms", &brfs::Statistics::get_search_time_ms);
 
     nb::class_<brfs::IEventHandler, IPyBrFSEventHandler>(m, "IBrFSEventHandler")  //
@@ -863,6 +1014,7 @@ void bind_module_definitions(nb::module_& m)
         .def("on_finish_g_layer", &brfs::IEventHandler::on_finish_g_layer)
         .def("on_start_search", &brfs::IEventHandler::on_start_search)
         .def("on_end_search", &brfs::IEventHandler::on_end_search)
+        .def("on_end_bitstate_search", &brfs::IEventHandler::on_end_bitstate_search)
         .def("on_solved", &brfs::IEventHandler::on_solved)
         .def("on_unsolvable", &brfs::IEventHandler::on_unsolvable)
         .def("on_exhausted", &brfs::IEventHandler::on_exhausted)
@@ -883,10 +1035,29 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("pruning_strategy", &brfs::Options::pruning_strategy)
         .def_rw("stop_if_goal", &brfs::Options::stop_if_goal)
         .def_rw("max_num_states", &brfs::Options::max_num_states)
-        .def_rw("max_time_in_ms", &brfs::Options::max_time_in_ms);
+        .def_rw("max_time_in_ms", &brfs::Options::max_time_in_ms)
+        .def_rw("max_memory_in_bytes", &brfs::Options::max_memory_in_bytes)
+        .def_rw("bitstate_num_bits", &brfs::Options::bitstate_num_bits)
+        .def_rw("bitstate_num_hash_functions", &brfs::Options::bitstate_num_hash_functions)
+        .def_rw("bitstate_max_num_states_in_memory", &brfs::Options::bitstate_max_num_states_in_memory);
 
     m.def("find_solution_brfs", &brfs::find_solution, "search_context"_a, "options"_a);
 
+    // BrFS_EXTERNAL
+    nb::class_<brfs_external::Options>(m, "BrFSExternalOptions")  //
+        .def(nb::init<>())
+        .def_rw("start_state", &brfs_external::Options::start_state)
+        .def_rw("event_handler", &brfs_external::Options::event_handler)
+        .def_rw("goal_strategy", &brfs_external::Options::goal_strategy)
+        .def_rw("stop_if_goal", &brfs_external::Options::stop_if_goal)
+        .def_rw("directory", &brfs_external::Options::directory)
+        .def_rw("max_num_states_in_memory", &brfs_external::Options::max_num_states_in_memory)
+        .def_rw("num_layers_for_duplicate_detection", &brfs_external::Options::num_layers_for_duplicate_detection)
+        .def_rw("max_num_states", &brfs_external::Options::max_num_states)
+        .def_rw("max_time_in_ms", &brfs_external::Options::max_time_in_ms);
+
+    m.def("find_solution_brfs_external", &brfs_external::find_solution, "search_context"_a, "options"_a);
+
     // GBFS_EAGER
     nb::class_<gbfs_eager::Statistics>(m, "GBFSEagerStatistics")  //
         .def(nb::init<>())
@@ -895,6 +1066,11 @@ void bind_module_definitions(nb::module_& m)
         .def("get_num_expanded", &gbfs_eager::Statistics::get_num_expanded)
         .def("get_num_deadends", &gbfs_eager::Statistics::get_num_deadends)
         .def("get_num_pruned", &gbfs_eager::Statistics::get_num_pruned)
+        .def("get_num_heuristic_cache_hits", &gbfs_eager::Statistics::get_num_heuristic_cache_hits)
+        .def("get_num_heuristic_cache_misses", &gbfs_eager::Statistics::get_num_heuristic_cache_misses)
+        .def("get_num_unpacked_state_cache_hits", &gbfs_eager::Statistics::get_num_unpacked_state_cache_hits)
+        .def("get_num_unpacked_state_cache_misses", &gbfs_eager::Statistics::get_num_unpacked_state_cache_misses)
+        .def("get_num_bytes_for_unpacked_state_cache", &gbfs_eager::Statistics::get_num_bytes_for_unpacked_state_cache)
         .def("get_search_time_ms", &gbfs_eager::Statistics::get_search_time_ms);
 
     nb::class_<gbfs_eager::IEventHandler, IPyGBFSEagerEventHandler>(m, "IGBFSEagerEventHandler")  //
@@ -903,6 +1079,9 @@ void bind_module_definitions(nb::module_& m)
         .def("on_expand_goal_state", &gbfs_eager::IEventHandler::on_expand_goal_state)
         .def("on_generate_state", &gbfs_eager::IEventHandler::on_generate_state)
         .def("on_prune_state", &gbfs_eager::IEventHandler::on_prune_state)
+        .def("on_heuristic_cache_hit", &gbfs_eager::IEventHandler::on_heuristic_cache_hit)
+        .def("on_heuristic_cache_miss", &gbfs_eager::IEventHandler::on_heuristic_cache_miss)
+        .def("on_unpacked_state_cache_statistics", &gbfs_eager::IEventHandler::on_unpacked_state_cache_statistics)
         .def("on_start_search", &gbfs_eager::IEventHandler::on_start_search)
         .def("on_new_best_h_value", &gbfs_eager::IEventHandler::on_new_best_h_value)
         .def("on_end_search", &gbfs_eager::IEventHandler::on_end_search)
@@ -924,9 +1103,14 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("event_handler", &gbfs_eager::Options::event_handler)
         .def_rw("goal_strategy", &gbfs_eager::Options::goal_strategy)
         .def_rw("pruning_strategy", &gbfs_eager::Options::pruning_strategy)
+        .def_rw("heuristic_cache", &gbfs_eager::Options::heuristic_cache)
         .def_rw("exploration_strategy", &gbfs_eager::Options::exploration_strategy)
         .def_rw("max_num_states", &gbfs_eager::Options::max_num_states)
         .def_rw("max_time_in_ms", &gbfs_eager::Options::max_time_in_ms)
+        .def_rw("max_memory_in_bytes", &gbfs_eager::Options::max_memory_in_bytes)
+        .def_rw("checkpoint_file", &gbfs_eager::Options::checkpoint_file)
+        .def_rw("checkpoint_interval_in_ms", &gbfs_eager::Options::checkpoint_interval_in_ms)
+        .def_rw("resume_from_checkpoint", &gbfs_eager::Options::resume_from_checkpoint)
         .def_rw("openlist_weights", &gbfs_eager::Options::openlist_weights);
 
     m.def("find_solution_gbfs_eager", &gbfs_eager::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
@@ -971,6 +1155,7 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("exploration_strategy", &gbfs_lazy::Options::exploration_strategy)
         .def_rw("max_num_states", &gbfs_lazy::Options::max_num_states)
         .def_rw("max_time_in_ms", &gbfs_lazy::Options::max_time_in_ms)
+        .def_rw("max_memory_in_bytes", &gbfs_lazy::Options::max_memory_in_bytes)
         .def_rw("openlist_weights", &gbfs_lazy::Options::openlist_weights);
 
     m.def("find_solution_gbfs_lazy", &gbfs_lazy::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
@@ -1015,7 +1200,9 @@ void bind_module_definitions(nb::module_& m)
              "state"_a,
              "succ_state"_a)
         .def("reset", &iw::DynamicNoveltyTable::reset)
-        .def("get_tuple_index_mapper", &iw::DynamicNoveltyTable::get_tuple_index_mapper, nb::rv_policy::reference_internal);
+        .def("get_tuple_index_mapper", &iw::DynamicNoveltyTable::get_tuple_index_mapper, nb::rv_policy::reference_internal)
+        .def("is_sparse", &iw::DynamicNoveltyTable::is_sparse)
+        .def("get_estimated_memory_usage_in_bytes", &iw::DynamicNoveltyTable::get_estimated_memory_usage_in_bytes);
 
     nb::class_<iw::StateTupleIndexGenerator>(m, "StateTupleIndexGenerator")  //
         .def(nb::init<const iw::TupleIndexMapper*>(), "tuple_index_mapper"_a)
@@ -1048,6 +1235,7 @@ void bind_module_definitions(nb::module_& m)
         .def("__str__", [](const iw::Statistics& self) { return to_string(self); })
         .def("get_effective_width", &iw::Statistics::get_effective_width)
         .def("get_brfs_statistics_by_arity", &iw::Statistics::get_brfs_statistics_by_arity)
+        .def("get_novelty_table_memory_usage_in_bytes_by_arity", &iw::Statistics::get_novelty_table_memory_usage_in_bytes_by_arity)
         .def("get_search_time_ms", &iw::Statistics::get_search_time_ms);
 
     nb::class_<iw::IEventHandler>(m, "IIWEventHandler")  //
@@ -1061,7 +1249,8 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("iw_event_handler", &iw::Options::iw_event_handler)
         .def_rw("brfs_event_handler", &iw::Options::brfs_event_handler)
         .def_rw("goal_strategy", &iw::Options::goal_strategy)
-        .def_rw("max_arity", &iw::Options::max_arity);
+        .def_rw("max_arity", &iw::Options::max_arity)
+        .def_rw("max_memory_in_bytes", &iw::Options::max_memory_in_bytes);
 
     m.def("find_solution_iw", &iw::find_solution, "search_context"_a, "options"_a);
 
@@ -1085,9 +1274,41 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("iw_event_handler", &siw::Options::iw_event_handler)
         .def_rw("brfs_event_handler", &siw::Options::brfs_event_handler)
         .def_rw("goal_strategy", &siw::Options::goal_strategy)
-        .def_rw("max_arity", &siw::Options::max_arity);
+        .def_rw("max_arity", &siw::Options::max_arity)
+        .def_rw("max_memory_in_bytes", &siw::Options::max_memory_in_bytes);
 
     m.def("find_solution_siw", &siw::find_solution, "search_context"_a, "options"_a);
+
+    // BFWS
+    nb::class_<bfws::Statistics>(m, "BFWSStatistics")  //
+        .def(nb::init<>())
+        .def("__str__", [](const bfws::Statistics& self) { return to_string(self); })
+        .def("get_num_generated", &bfws::Statistics::get_num_generated)
+        .def("get_num_expanded", &bfws::Statistics::get_num_expanded)
+        .def("get_num_deadends", &bfws::Statistics::get_num_deadends)
+        .def("get_num_pruned", &bfws::Statistics::get_num_pruned)
+        .def("get_num_relaxed_plans", &bfws::Statistics::get_num_relaxed_plans)
+        .def("get_num_generated_by_novelty", &bfws::Statistics::get_num_generated_by_novelty)
+        .def("get_num_partitions", &bfws::Statistics::get_num_partitions)
+        .def("get_novelty_table_memory_usage_in_bytes", &bfws::Statistics::get_novelty_table_memory_usage_in_bytes)
+        .def("get_search_time_ms", &bfws::Statistics::get_search_time_ms);
+
+    nb::class_<bfws::IEventHandler>(m, "IBFWSEventHandler")  //
+        .def("get_statistics", &bfws::IEventHandler::get_statistics);
+    nb::class_<bfws::DefaultEventHandlerImpl, bfws::IEventHandler>(m, "DefaultBFWSEventHandler").def(nb::init<Problem, bool>(), "problem"_a, "quiet"_a = true);
+
+    nb::class_<bfws::Options>(m, "BFWSOptions")  //
+        .def(nb::init<>())
+        .def_rw("start_state", &bfws::Options::start_state)
+        .def_rw("event_handler", &bfws::Options::event_handler)
+        .def_rw("goal_strategy", &bfws::Options::goal_strategy)
+        .def_rw("pruning_strategy", &bfws::Options::pruning_strategy)
+        .def_rw("max_arity", &bfws::Options::max_arity)
+        .def_rw("max_num_states", &bfws::Options::max_num_states)
+        .def_rw("max_time_in_ms", &bfws::Options::max_time_in_ms)
+        .def_rw("max_memory_in_bytes", &bfws::Options::max_memory_in_bytes);
+
+    m.def("find_solution_bfws", &bfws::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
 }
 
 }
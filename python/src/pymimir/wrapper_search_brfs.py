@@ -105,6 +105,7 @@ def brfs(problem: 'Problem',
         # The following events are ignored in this interface.
         def on_close_state(self, arg0): pass
         def on_end_search(self, arg0, arg1, arg2, arg3, arg4, arg5): pass
+        def on_end_bitstate_search(self, arg0, arg1, arg2): pass
         def on_exhausted(self): pass
         def on_generate_state_not_relaxed(self, arg0, arg1, arg2, arg3): pass
         def on_generate_state_relaxed(self, arg0, arg1, arg2, arg3): pass
@@ -77,6 +77,7 @@ def iw(problem: 'Problem',
         def on_finish_g_layer(self, value: int): pass
         def on_start_search(self, arg: 'AdvancedState'): pass
         def on_end_search(self, arg0: int, arg1: int, arg2: int, arg3: int, arg4: int, arg5: int): pass
+        def on_end_bitstate_search(self, arg0: int, arg1: int, arg2: float): pass
         def on_solved(self, arg): pass
         def on_unsolvable(self): pass
         def on_exhausted(self): pass
@@ -20,145 +20,280 @@
 #include "mimir/algorithms/unique_object_pool.hpp"
 #include "mimir/common/collections.hpp"
 
-#include <functional>
-#include <iostream>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace mimir
 {
 
-/**
- * Heap-managed coroutine variables.
- */
+static constexpr size_t WORD_SIZE = 64;
 
-static thread_local UniqueObjectPool<std::vector<uint32_t>> s_solution_pool;
-using SolutionPtr = UniqueObjectPoolPtr<std::vector<uint32_t>>;
-
-static thread_local UniqueObjectPool<boost::dynamic_bitset<>> s_bitset_pool;
-using BitsetUniquePtr = UniqueObjectPoolPtr<boost::dynamic_bitset<>>;
+static uint32_t count_bits(const uint64_t* words, size_t num_words)
+{
+    auto count = uint32_t(0);
+    for (size_t i = 0; i < num_words; ++i)
+    {
+        count += std::popcount(words[i]);
+    }
+    return count;
+}
 
-static thread_local UniqueObjectPool<std::vector<BitsetUniquePtr>> s_bitset_list_pool;
-using BitsetListUniquePtr = UniqueObjectPoolPtr<std::vector<BitsetUniquePtr>>;
+/// @brief `out[i] = lhs[i] & rhs[i]` for all words, and return the number of set bits of `out`.
+static uint32_t intersect_and_count(uint64_t* out, const uint64_t* lhs, const uint64_t* rhs, size_t num_words)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= num_words; i += 4)
+    {
+        const auto words = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i)),
+                                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), words);
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 2 <= num_words; i += 2)
+    {
+        vst1q_u64(out + i, vandq_u64(vld1q_u64(lhs + i), vld1q_u64(rhs + i)));
+    }
+#endif
+    for (; i < num_words; ++i)
+    {
+        out[i] = lhs[i] & rhs[i];
+    }
 
-static thread_local UniqueObjectPool<std::vector<BitsetListUniquePtr>> s_bitset_list_list_pool;
-using BitsetMatrixUniquePtr = UniqueObjectPoolPtr<std::vector<BitsetListUniquePtr>>;
+    return count_bits(out, num_words);
+}
 
 /**
- * Recursive call
+ * KPartiteGraph
  */
 
-mimir::generator<const std::vector<uint32_t>&> find_all_k_cliques_in_k_partite_graph_helper(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
-                                                                                            const std::vector<std::vector<uint32_t>>& partitions,
-                                                                                            std::vector<uint32_t>& partial_solution,
-                                                                                            boost::dynamic_bitset<>& partition_bits,
-                                                                                            std::vector<BitsetListUniquePtr>& k_compatible_vertices,
-                                                                                            uint32_t depth)
+KPartiteGraph::KPartiteGraph(std::vector<std::vector<uint32_t>> partitions, size_t max_num_dense_vertices) :
+    m_partitions(std::move(partitions)),
+    m_is_sparse(false),
+    m_word_offsets(),
+    m_num_partition_words(),
+    m_positions(),
+    m_num_words(0),
+    m_dense_rows(),
+    m_sparse_rows(),
+    m_is_dirty(),
+    m_dirty_rows()
 {
-    assert(depth < partitions.size());
-
-    uint32_t k = partitions.size();
-    uint32_t best_set_bits = std::numeric_limits<uint32_t>::max();
-    uint32_t best_partition = std::numeric_limits<uint32_t>::max();
-
-    assert(is_within_bounds(k_compatible_vertices, depth));
-    auto& compatible_vertices = *k_compatible_vertices[depth];
+    auto num_vertices = size_t(0);
+    for (const auto& partition : m_partitions)
+    {
+        num_vertices += partition.size();
+    }
+    m_positions.resize(num_vertices);
 
-    // Find the best partition to work with
-    for (uint32_t partition = 0; partition < k; ++partition)
+    for (const auto& partition : m_partitions)
     {
-        assert(is_within_bounds(compatible_vertices, partition));
-        auto num_set_bits = compatible_vertices[partition]->count();
-        if (!partition_bits[partition] && (num_set_bits < best_set_bits))
+        for (size_t index = 0; index < partition.size(); ++index)
         {
-            best_set_bits = num_set_bits;
-            best_partition = partition;
+            assert(is_within_bounds(m_positions, partition[index]));
+            m_positions[partition[index]] = static_cast<uint32_t>(m_num_words * WORD_SIZE + index);
         }
+        const auto num_partition_words = (partition.size() + WORD_SIZE - 1) / WORD_SIZE;
+        m_word_offsets.push_back(static_cast<uint32_t>(m_num_words));
+        m_num_partition_words.push_back(static_cast<uint32_t>(num_partition_words));
+        m_num_words += num_partition_words;
     }
 
-    // Iterate through compatible vertices in the best partition
-    assert(is_within_bounds(compatible_vertices, best_partition));
-    auto& best_partition_compatible_vertices = *compatible_vertices[best_partition];
-    uint32_t adjacent_index = best_partition_compatible_vertices.find_first();
-    while (adjacent_index < best_partition_compatible_vertices.size())
+    m_is_sparse = (num_vertices > max_num_dense_vertices);
+    if (m_is_sparse)
+    {
+        m_sparse_rows.resize(num_vertices);
+    }
+    else
+    {
+        m_dense_rows.resize(num_vertices * m_num_words, 0);
+    }
+    m_is_dirty.resize(num_vertices, 0);
+}
+
+void KPartiteGraph::add_directed_edge(uint32_t source, uint32_t target)
+{
+    assert(is_within_bounds(m_positions, source) && is_within_bounds(m_positions, target));
+
+    if (!m_is_dirty[source])
+    {
+        m_is_dirty[source] = 1;
+        m_dirty_rows.push_back(source);
+    }
+
+    const auto position = m_positions[target];
+    if (m_is_sparse)
+    {
+        m_sparse_rows[source].push_back(position);
+    }
+    else
     {
-        assert(is_within_bounds(partitions, best_partition) && is_within_bounds(partitions[best_partition], adjacent_index));
-        uint32_t vertex = partitions[best_partition][adjacent_index];
-        assert(is_within_bounds(compatible_vertices, best_partition) && is_within_bounds(best_partition_compatible_vertices, adjacent_index));
-        best_partition_compatible_vertices[adjacent_index] = 0;
+        m_dense_rows[source * m_num_words + position / WORD_SIZE] |= uint64_t(1) << (position % WORD_SIZE);
+    }
+}
 
-        partial_solution.push_back(vertex);
+void KPartiteGraph::add_edge(uint32_t first_vertex, uint32_t second_vertex)
+{
+    add_directed_edge(first_vertex, second_vertex);
+    add_directed_edge(second_vertex, first_vertex);
+}
 
-        if (partial_solution.size() == k)
+void KPartiteGraph::reset()
+{
+    for (const auto vertex : m_dirty_rows)
+    {
+        if (m_is_sparse)
         {
-            co_yield partial_solution;
+            m_sparse_rows[vertex].clear();
         }
         else
         {
-            assert(partial_solution.size() - 1 == depth);
+            std::fill_n(m_dense_rows.begin() + vertex * m_num_words, m_num_words, uint64_t(0));
+        }
+        m_is_dirty[vertex] = 0;
+    }
+    m_dirty_rows.clear();
+}
 
-            // Update compatible vertices for the next recursion
-            assert(is_within_bounds(k_compatible_vertices, depth + 1));
-            auto& compatible_vertices_next = *k_compatible_vertices[depth + 1];
-            for (uint32_t partition = 0; partition < k; ++partition)
-            {
-                assert(is_within_bounds(compatible_vertices_next, partition));
-                assert(is_within_bounds(compatible_vertices, partition));
-                auto& partition_compatible_vertices_next = *compatible_vertices_next[partition];
-                auto& partition_compatible_vertices = *compatible_vertices[partition];
-                assert(partition_compatible_vertices_next.size() == partition_compatible_vertices.size());
-                partition_compatible_vertices_next = partition_compatible_vertices;  // copy bitsets from current to next iteration
-            }
+const std::vector<std::vector<uint32_t>>& KPartiteGraph::get_partitions() const { return m_partitions; }
 
-            uint32_t offset = 0;
-            for (uint32_t partition = 0; partition < k; ++partition)
-            {
-                assert(is_within_bounds(compatible_vertices_next, partition));
-                auto& partition_compatible_vertices_next = *compatible_vertices_next[partition];
-                auto partition_size = partition_compatible_vertices_next.size();
-                if (!partition_bits[partition])
-                {
-                    for (uint32_t index = 0; index < partition_size; ++index)
-                    {
-                        assert(is_within_bounds(compatible_vertices_next, partition));
-                        partition_compatible_vertices_next[index] &= adjacency_matrix[vertex][index + offset];
-                    }
-                }
-                offset += partition_size;
-            }
+size_t KPartiteGraph::get_num_vertices() const { return m_positions.size(); }
 
-            partition_bits[best_partition] = 1;
+bool KPartiteGraph::is_sparse() const { return m_is_sparse; }
 
-            uint32_t possible_additions = 0;
-            for (uint32_t partition = 0; partition < k; ++partition)
-            {
-                assert(is_within_bounds(compatible_vertices, partition));
-                auto& partition_compatible_vertices = *compatible_vertices[partition];
-                if (!partition_bits[partition] && partition_compatible_vertices.any())
-                {
-                    ++possible_additions;
-                }
-            }
+size_t KPartiteGraph::get_num_words() const { return m_num_words; }
 
-            if ((partial_solution.size() + possible_additions) == k)
-            {
-                for (const auto& result : find_all_k_cliques_in_k_partite_graph_helper(adjacency_matrix,
-                                                                                       partitions,
-                                                                                       partial_solution,
-                                                                                       partition_bits,
-                                                                                       k_compatible_vertices,
-                                                                                       depth + 1))
-                {
-                    co_yield result;
-                }
-            }
+const std::vector<uint32_t>& KPartiteGraph::get_word_offsets() const { return m_word_offsets; }
+
+const std::vector<uint32_t>& KPartiteGraph::get_num_partition_words() const { return m_num_partition_words; }
+
+uint32_t KPartiteGraph::get_position(uint32_t vertex) const { return m_positions[vertex]; }
+
+const uint64_t* KPartiteGraph::get_dense_row(uint32_t vertex) const
+{
+    assert(!m_is_sparse);
+    return m_dense_rows.data() + vertex * m_num_words;
+}
+
+const std::vector<uint32_t>& KPartiteGraph::get_sparse_row(uint32_t vertex) const
+{
+    assert(m_is_sparse);
+    return m_sparse_rows[vertex];
+}
+
+/**
+ * Enumeration
+ */
+
+/// @brief The buffers of an enumeration.
+///
+/// Each level of `compatible_vertices` has the layout of a row of the graph and stores the compatible vertices at a depth.
+struct KPKCWorkspace
+{
+    /// @brief The vertex chosen at a depth is taken from `partition`, and the next candidate is searched from word `word`.
+    struct Frame
+    {
+        uint32_t partition;
+        uint32_t word;
+    };
+
+    std::vector<uint64_t> compatible_vertices;
+    std::vector<uint8_t> is_assigned;
+    std::vector<Frame> stack;
+    std::vector<uint32_t> solution;
+};
+
+static thread_local UniqueObjectPool<KPKCWorkspace> s_workspace_pool;
 
-            partition_bits[best_partition] = 0;
+/// @brief Initialize the compatible vertices at depth 0.
+/// @return false if some partition is empty, i.e., there is no k-clique.
+static bool initialize_workspace(const KPartiteGraph& graph, KPKCWorkspace& workspace)
+{
+    const auto& partitions = graph.get_partitions();
+    const auto k = partitions.size();
+
+    workspace.compatible_vertices.assign(k * graph.get_num_words(), 0);
+    for (uint32_t partition = 0; partition < k; ++partition)
+    {
+        const auto size = partitions[partition].size();
+        if (size == 0)
+        {
+            return false;
+        }
+        auto* words = workspace.compatible_vertices.data() + graph.get_word_offsets()[partition];
+        for (size_t word = 0; word < size / WORD_SIZE; ++word)
+        {
+            words[word] = std::numeric_limits<uint64_t>::max();
         }
+        if (size % WORD_SIZE)
+        {
+            words[size / WORD_SIZE] = (uint64_t(1) << (size % WORD_SIZE)) - 1;
+        }
+    }
+
+    workspace.is_assigned.assign(k, 0);
+    workspace.stack.clear();
+    workspace.stack.reserve(k);
+    workspace.solution.clear();
 
-        partial_solution.pop_back();
+    return true;
+}
+
+/// @brief Return the unassigned partition with the fewest compatible vertices at the given level.
+static uint32_t select_partition(const KPartiteGraph& graph, const KPKCWorkspace& workspace, const uint64_t* compatible_vertices)
+{
+    auto best_count = std::numeric_limits<uint32_t>::max();
+    auto best_partition = std::numeric_limits<uint32_t>::max();
+    for (uint32_t partition = 0; partition < graph.get_partitions().size(); ++partition)
+    {
+        if (workspace.is_assigned[partition])
+        {
+            continue;
+        }
+        const auto* words = compatible_vertices + graph.get_word_offsets()[partition];
+        auto count = uint32_t(0);
+        for (uint32_t word = 0; word < graph.get_num_partition_words()[partition]; ++word)
+        {
+            count += std::popcount(words[word]);
+        }
+        if (count < best_count)
+        {
+            best_count = count;
+            best_partition = partition;
+        }
+    }
+    return best_partition;
+}
 
-        adjacent_index = best_partition_compatible_vertices.find_next(adjacent_index);
+/// @brief Restrict the compatible vertices of the unassigned partitions to the adjacent vertices of `vertex` in a sparse graph.
+static void intersect_sparse(const KPartiteGraph& graph,
+                             const KPKCWorkspace& workspace,
+                             uint32_t vertex,
+                             const uint64_t* compatible_vertices,
+                             uint64_t* compatible_vertices_next)
+{
+    for (uint32_t partition = 0; partition < graph.get_partitions().size(); ++partition)
+    {
+        if (!workspace.is_assigned[partition])
+        {
+            std::fill_n(compatible_vertices_next + graph.get_word_offsets()[partition], graph.get_num_partition_words()[partition], uint64_t(0));
+        }
+    }
+    // The words of assigned partitions are never read at the next depth, so they need not be masked.
+    for (const auto position : graph.get_sparse_row(vertex))
+    {
+        const auto word = position / WORD_SIZE;
+        compatible_vertices_next[word] |= compatible_vertices[word] & (uint64_t(1) << (position % WORD_SIZE));
     }
 }
 
@@ -180,57 +315,129 @@ bool verify_input_dimensions(const std::vector<boost::dynamic_bitset<>>& adjacen
     return true;
 }
 
-mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
-                                                                                            const std::vector<std::vector<uint32_t>>& partitions)
+mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const KPartiteGraph& graph)
 {
-    assert(verify_input_dimensions(adjacency_matrix, partitions));
+    const auto& partitions = graph.get_partitions();
+    const auto k = static_cast<uint32_t>(partitions.size());
 
-    const auto k = partitions.size();
+    auto workspace_ptr = s_workspace_pool.get_or_allocate();
+    auto& workspace = *workspace_ptr;
 
-    /* Allocate and initialize solution */
-    auto solution = s_solution_pool.get_or_allocate();
-    solution->clear();
+    if (k == 0 || !initialize_workspace(graph, workspace))
+    {
+        co_return;
+    }
 
-    /* Allocate and initialize partition bits */
-    auto partition_bits = s_bitset_pool.get_or_allocate();
-    partition_bits->reset();
-    partition_bits->resize(k, false);
+    const auto num_words = graph.get_num_words();
+    const auto& word_offsets = graph.get_word_offsets();
+    const auto& num_partition_words = graph.get_num_partition_words();
+    auto& solution = workspace.solution;
+    auto& stack = workspace.stack;
 
-    /* Allocate and initialize k_compatible_vertices */
-    auto k_compatible_vertices = s_bitset_list_list_pool.get_or_allocate();
+    /* Enumerate all k-cliques by depth-first search over an explicit stack with one frame per assigned partition. */
+    const auto push_frame = [&](uint32_t partition)
+    {
+        workspace.is_assigned[partition] = 1;
+        stack.push_back(KPKCWorkspace::Frame { partition, word_offsets[partition] });
+    };
 
-    k_compatible_vertices->clear();
-    k_compatible_vertices->resize(k);
+    push_frame(select_partition(graph, workspace, workspace.compatible_vertices.data()));
 
-    for (uint32_t k1 = 0; k1 < k; ++k1)
+    while (!stack.empty())
     {
-        auto biset_vec = s_bitset_list_pool.get_or_allocate();
+        const auto depth = stack.size() - 1;
+        auto& frame = stack.back();
+        auto* compatible_vertices = workspace.compatible_vertices.data() + depth * num_words;
+        const auto end_word = word_offsets[frame.partition] + num_partition_words[frame.partition];
 
-        biset_vec->clear();
-        biset_vec->resize(k);
+        // Find and remove the next compatible vertex of the partition, or backtrack.
+        while (frame.word < end_word && compatible_vertices[frame.word] == 0)
+        {
+            ++frame.word;
+        }
+        if (frame.word == end_word)
+        {
+            workspace.is_assigned[frame.partition] = 0;
+            stack.pop_back();
+            if (!stack.empty())
+            {
+                solution.pop_back();
+            }
+            continue;
+        }
+        const auto bit = std::countr_zero(compatible_vertices[frame.word]);
+        compatible_vertices[frame.word] &= compatible_vertices[frame.word] - 1;
+        const auto index = (frame.word - word_offsets[frame.partition]) * WORD_SIZE + bit;
 
-        (*k_compatible_vertices)[k1] = std::move(biset_vec);
+        assert(is_within_bounds(partitions[frame.partition], index));
+        const auto vertex = partitions[frame.partition][index];
+        solution.push_back(vertex);
 
-        for (uint32_t k2 = 0; k2 < k; ++k2)
+        if (solution.size() == k)
         {
-            auto bitset = s_bitset_pool.get_or_allocate();
+            co_yield solution;
+            solution.pop_back();
+            continue;
+        }
 
-            bitset->reset();
-            bitset->resize(partitions[k2].size(), false);
+        // Restrict the compatible vertices of the unassigned partitions to the adjacent vertices of the vertex.
+        auto* compatible_vertices_next = compatible_vertices + num_words;
+        const auto* dense_row = graph.is_sparse() ? nullptr : graph.get_dense_row(vertex);
+        if (graph.is_sparse())
+        {
+            intersect_sparse(graph, workspace, vertex, compatible_vertices, compatible_vertices_next);
+        }
+        auto best_count = std::numeric_limits<uint32_t>::max();
+        auto best_partition = std::numeric_limits<uint32_t>::max();
+        for (uint32_t partition = 0; partition < k; ++partition)
+        {
+            if (workspace.is_assigned[partition])
+            {
+                continue;
+            }
+            const auto offset = word_offsets[partition];
+            auto* next_words = compatible_vertices_next + offset;
+            const auto count = dense_row ? intersect_and_count(next_words, compatible_vertices + offset, dense_row + offset, num_partition_words[partition])
+                                         : count_bits(next_words, num_partition_words[partition]);
+            if (count < best_count)
+            {
+                best_count = count;
+                best_partition = partition;
+            }
+            if (count == 0)
+            {
+                break;
+            }
+        }
 
-            (*(*k_compatible_vertices)[k1])[k2] = std::move(bitset);
+        if (best_count == 0)
+        {
+            solution.pop_back();
+            continue;
         }
+
+        push_frame(best_partition);
     }
+}
+
+mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
+                                                                                            const std::vector<std::vector<uint32_t>>& partitions)
+{
+    assert(verify_input_dimensions(adjacency_matrix, partitions));
 
-    for (uint32_t k1 = 0; k1 < k; ++k1)
+    auto graph = KPartiteGraph(partitions);
+    for (uint32_t vertex = 0; vertex < adjacency_matrix.size(); ++vertex)
     {
-        (*k_compatible_vertices->front())[k1]->set();
+        const auto& row = adjacency_matrix[vertex];
+        for (auto adjacent_vertex = row.find_next(vertex); adjacent_vertex < row.size(); adjacent_vertex = row.find_next(adjacent_vertex))
+        {
+            graph.add_edge(vertex, adjacent_vertex);
+        }
     }
 
-    /* Enumerate all k-cliques. */
-    for (const auto& result : find_all_k_cliques_in_k_partite_graph_helper(adjacency_matrix, partitions, *solution, *partition_bits, *k_compatible_vertices, 0))
+    for (const auto& clique : create_k_clique_in_k_partite_graph_generator(graph))
     {
-        co_yield result;
+        co_yield clique;
     }
 }
 
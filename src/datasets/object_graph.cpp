@@ -24,7 +24,10 @@
 #include "mimir/graphs/property.hpp"
 #include "mimir/search/state.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <random>
+#include <stdexcept>
 
 using namespace mimir::formalism;
 using namespace mimir::search;
@@ -211,4 +214,487 @@ graphs::StaticGraph<graphs::Vertex<graphs::PropertyValue>, graphs::Edge<>> creat
     return vertex_colored_digraph;
 }
 
+/**
+ * ObjectGraphBuilder
+ */
+
+template<IsStaticOrFluentOrDerivedTag P>
+ObjectGraphBuilder::AtomVertices ObjectGraphBuilder::create_atom_vertices(GroundAtom<P> atom)
+{
+    auto result = AtomVertices();
+    if (atom->get_arity() == 0)
+    {
+        result.properties.push_back(graphs::PropertyValue(atom->get_predicate()));
+    }
+    else if (atom->get_arity() >= 2)
+    {
+        for (size_t pos = 0; pos < atom->get_arity(); ++pos)
+        {
+            result.properties.push_back(graphs::PropertyValue(atom->get_predicate(), pos));
+            result.objects.push_back(atom->get_objects().at(pos)->get_index());
+        }
+    }
+    return result;
+}
+
+template<IsStaticOrFluentOrDerivedTag P>
+ObjectGraphBuilder::AtomVertices ObjectGraphBuilder::create_literal_vertices(GroundLiteral<P> literal)
+{
+    const auto atom = literal->get_atom();
+
+    auto result = AtomVertices();
+    if (atom->get_arity() == 0)
+    {
+        result.properties.push_back(graphs::PropertyValue(atom->get_predicate(), literal->get_polarity()));
+    }
+    else if (atom->get_arity() >= 2)
+    {
+        for (size_t pos = 0; pos < atom->get_arity(); ++pos)
+        {
+            result.properties.push_back(graphs::PropertyValue(atom->get_predicate(), pos, literal->get_polarity()));
+            result.objects.push_back(atom->get_objects().at(pos)->get_index());
+        }
+    }
+    return result;
+}
+
+void ObjectGraphBuilder::add_vertex(graphs::PropertyValue property, int row_capacity)
+{
+    m_properties.push_back(std::move(property));
+    m_is_live.push_back(true);
+    m_row_begins.push_back(m_adjacency.size());
+    m_row_sizes.push_back(0);
+    m_row_capacities.push_back(row_capacity);
+    m_adjacency.resize(m_adjacency.size() + row_capacity);
+    m_object_edge_positions.push_back(-1);
+    ++m_num_live_vertices;
+}
+
+void ObjectGraphBuilder::add_neighbor(int vertex, int neighbor)
+{
+    if (m_row_sizes[vertex] == m_row_capacities[vertex])
+    {
+        // Move the row to the end with twice the capacity, and compact all rows once half of the adjacency is unused.
+        const auto capacity = std::max(2 * m_row_capacities[vertex], 4);
+        const auto begin = m_adjacency.size();
+        m_adjacency.resize(begin + capacity);
+        std::copy_n(m_adjacency.begin() + m_row_begins[vertex], m_row_sizes[vertex], m_adjacency.begin() + begin);
+        m_num_unused_adjacency += m_row_capacities[vertex];
+        m_row_begins[vertex] = begin;
+        m_row_capacities[vertex] = capacity;
+
+        if (2 * m_num_unused_adjacency > m_adjacency.size())
+        {
+            auto adjacency = std::vector<int>();
+            adjacency.reserve(m_adjacency.size() - m_num_unused_adjacency);
+            for (size_t other = 0; other < m_row_begins.size(); ++other)
+            {
+                const auto other_begin = m_adjacency.begin() + m_row_begins[other];
+                m_row_begins[other] = adjacency.size();
+                adjacency.insert(adjacency.end(), other_begin, other_begin + m_row_capacities[other]);
+            }
+            m_adjacency = std::move(adjacency);
+            m_num_unused_adjacency = 0;
+        }
+    }
+    m_adjacency[m_row_begins[vertex] + m_row_sizes[vertex]++] = neighbor;
+}
+
+void ObjectGraphBuilder::add_edge(int source, int target)
+{
+    add_neighbor(source, target);
+    add_neighbor(target, source);
+    ++m_num_edges;
+}
+
+Index ObjectGraphBuilder::add_atom_vertices(const AtomVertices& atom_vertices)
+{
+    const auto num_vertices = atom_vertices.properties.size();
+    if (num_vertices >= m_free_slots.size())
+    {
+        m_free_slots.resize(num_vertices + 1);
+    }
+
+    auto& free_slots = m_free_slots[num_vertices];
+    auto first_vertex = static_cast<Index>(m_properties.size());
+    if (free_slots.empty())
+    {
+        // An atom vertex is adjacent to its object and to the vertices of the previous and next position.
+        for (const auto& property : atom_vertices.properties)
+        {
+            add_vertex(property, 3);
+        }
+    }
+    else
+    {
+        first_vertex = free_slots.back();
+        free_slots.pop_back();
+        for (size_t pos = 0; pos < num_vertices; ++pos)
+        {
+            m_properties[first_vertex + pos] = atom_vertices.properties[pos];
+            m_is_live[first_vertex + pos] = true;
+        }
+        m_num_live_vertices += num_vertices;
+    }
+
+    for (size_t pos = 0; pos < atom_vertices.objects.size(); ++pos)
+    {
+        const auto vertex = static_cast<int>(first_vertex + pos);
+        const auto object = static_cast<int>(atom_vertices.objects[pos]);
+
+        m_object_edge_positions[vertex] = m_row_sizes[object];
+        add_edge(vertex, object);
+
+        if (pos > 0)
+        {
+            add_edge(vertex - 1, vertex);
+        }
+    }
+
+    m_is_compact_up_to_date = false;
+
+    return first_vertex;
+}
+
+void ObjectGraphBuilder::remove_atom_vertices(Index first_vertex, const AtomVertices& atom_vertices)
+{
+    const auto num_vertices = atom_vertices.properties.size();
+
+    for (size_t pos = 0; pos < atom_vertices.objects.size(); ++pos)
+    {
+        // Replace the vertex in the row of its object by the last vertex of the row.
+        const auto vertex = static_cast<int>(first_vertex + pos);
+        const auto object = static_cast<int>(atom_vertices.objects[pos]);
+        const auto position = m_object_edge_positions[vertex];
+        const auto last_vertex = m_adjacency[m_row_begins[object] + --m_row_sizes[object]];
+
+        m_adjacency[m_row_begins[object] + position] = last_vertex;
+        m_object_edge_positions[last_vertex] = position;
+
+        m_num_edges -= (pos > 0) ? 2 : 1;
+    }
+
+    for (size_t pos = 0; pos < num_vertices; ++pos)
+    {
+        m_row_sizes[first_vertex + pos] = 0;
+        m_is_live[first_vertex + pos] = false;
+    }
+    m_num_live_vertices -= num_vertices;
+    m_free_slots[num_vertices].push_back(first_vertex);
+
+    m_is_compact_up_to_date = false;
+}
+
+ObjectGraphBuilder::ObjectGraphBuilder(Problem problem) :
+    m_problem(std::move(problem)),
+    m_object_static_predicates(m_problem->get_problem_and_domain_objects().size()),
+    m_object_dynamic_predicates(m_problem->get_problem_and_domain_objects().size()),
+    m_object_literals(m_problem->get_problem_and_domain_objects().size()),
+    m_is_object_dirty(m_problem->get_problem_and_domain_objects().size(), false),
+    m_dirty_objects(),
+    m_fluent_atoms(),
+    m_derived_atoms(),
+    m_fluent_atom_vertices(),
+    m_derived_atom_vertices(),
+    m_fluent_atom_slots(),
+    m_derived_atom_slots(),
+    m_added_atoms(),
+    m_deleted_atoms(),
+    m_properties(),
+    m_is_live(),
+    m_free_slots(),
+    m_num_live_vertices(0),
+    m_num_edges(0),
+    m_row_begins(),
+    m_row_sizes(),
+    m_row_capacities(),
+    m_adjacency(),
+    m_object_edge_positions(),
+    m_num_unused_adjacency(0),
+    m_compact_vertices(),
+    m_v(),
+    m_d(),
+    m_e(),
+    m_color_vertex_pairs(),
+    m_is_compact_up_to_date(false),
+    m_graph(),
+    m_is_graph_up_to_date(false)
+{
+    const auto num_objects = m_problem->get_problem_and_domain_objects().size();
+
+    /* Colors of the objects in a state without fluent and derived atoms. */
+
+    for (const auto& atom : m_problem->get_static_initial_atoms())
+    {
+        if (atom->get_arity() == 1)
+        {
+            m_object_static_predicates[atom->get_objects().front()->get_index()].push_back(atom->get_predicate());
+        }
+    }
+    boost::hana::for_each(m_problem->get_goal_literals(),
+                          [&](auto&& pair)
+                          {
+                              for (const auto& literal : boost::hana::second(pair))
+                              {
+                                  if (literal->get_atom()->get_arity() == 1)
+                                  {
+                                      m_object_literals[literal->get_atom()->get_objects().front()->get_index()].emplace_back(
+                                          literal->get_atom()->get_predicate(),
+                                          literal->get_polarity());
+                                  }
+                              }
+                          });
+
+    for (Index object_index = 0; object_index < num_objects; ++object_index)
+    {
+        std::sort(m_object_literals[object_index].begin(), m_object_literals[object_index].end());
+
+        auto atoms = m_object_static_predicates[object_index];
+        std::sort(atoms.begin(), atoms.end());
+
+        add_vertex(graphs::PropertyValue(std::move(atoms), m_object_literals[object_index]), 0);
+    }
+
+    /* Vertices of the static atoms and goal literals. */
+
+    for (const auto& atom : m_problem->get_static_initial_atoms())
+    {
+        add_atom_vertices(create_atom_vertices(atom));
+    }
+    boost::hana::for_each(m_problem->get_goal_literals(),
+                          [&](auto&& pair)
+                          {
+                              for (const auto& literal : boost::hana::second(pair))
+                              {
+                                  add_atom_vertices(create_literal_vertices(literal));
+                              }
+                          });
+}
+
+template<IsFluentOrDerivedTag P>
+void ObjectGraphBuilder::update_atoms(const State& state, IndexList& ref_atoms, std::vector<AtomVertices>& ref_atom_vertices, IndexList& ref_atom_slots)
+{
+    const auto& repositories = m_problem->get_repositories();
+
+    /* Compute the difference to the atoms of the previous state, which are both sorted. */
+
+    m_added_atoms.clear();
+    m_deleted_atoms.clear();
+
+    auto it = ref_atoms.begin();
+    for (const auto atom_index : state.get_atoms<P>())
+    {
+        while (it != ref_atoms.end() && *it < atom_index)
+        {
+            m_deleted_atoms.push_back(*it++);
+        }
+        if (it != ref_atoms.end() && *it == atom_index)
+        {
+            ++it;
+        }
+        else
+        {
+            m_added_atoms.push_back(atom_index);
+        }
+    }
+    m_deleted_atoms.insert(m_deleted_atoms.end(), it, ref_atoms.end());
+
+    if (m_added_atoms.empty() && m_deleted_atoms.empty())
+    {
+        return;
+    }
+
+    /* Recolor the objects of unary atoms, and remove the vertices of deleted atoms before adding new ones to reuse their slots. */
+
+    const auto mark_dirty = [&](Index object_index)
+    {
+        if (!m_is_object_dirty[object_index])
+        {
+            m_is_object_dirty[object_index] = true;
+            m_dirty_objects.push_back(object_index);
+        }
+    };
+
+    for (const auto atom_index : m_deleted_atoms)
+    {
+        const auto atom = repositories.get_ground_atom<P>(atom_index);
+        if (atom->get_arity() == 1)
+        {
+            const auto object_index = atom->get_objects().front()->get_index();
+            auto& predicates = m_object_dynamic_predicates[object_index];
+            const auto predicate_it = std::find(predicates.begin(), predicates.end(), PredicateVariant(atom->get_predicate()));
+            assert(predicate_it != predicates.end());
+            *predicate_it = predicates.back();
+            predicates.pop_back();
+            mark_dirty(object_index);
+        }
+        else
+        {
+            remove_atom_vertices(ref_atom_slots[atom_index], ref_atom_vertices[atom_index]);
+            ref_atom_slots[atom_index] = MAX_INDEX;
+        }
+    }
+    for (const auto atom_index : m_added_atoms)
+    {
+        const auto atom = repositories.get_ground_atom<P>(atom_index);
+        if (atom->get_arity() == 1)
+        {
+            const auto object_index = atom->get_objects().front()->get_index();
+            m_object_dynamic_predicates[object_index].push_back(atom->get_predicate());
+            mark_dirty(object_index);
+        }
+        else
+        {
+            if (atom_index >= ref_atom_vertices.size())
+            {
+                ref_atom_vertices.resize(atom_index + 1);
+                ref_atom_slots.resize(atom_index + 1, MAX_INDEX);
+            }
+            if (ref_atom_vertices[atom_index].properties.empty())
+            {
+                ref_atom_vertices[atom_index] = create_atom_vertices(atom);
+            }
+            ref_atom_slots[atom_index] = add_atom_vertices(ref_atom_vertices[atom_index]);
+        }
+    }
+
+    ref_atoms.clear();
+    for (const auto atom_index : state.get_atoms<P>())
+    {
+        ref_atoms.push_back(atom_index);
+    }
+}
+
+void ObjectGraphBuilder::update(const State& state)
+{
+    if (&state.get_problem() != m_problem.get())
+    {
+        throw std::runtime_error("ObjectGraphBuilder::update: the state does not belong to the problem of the builder.");
+    }
+
+    update_atoms<FluentTag>(state, m_fluent_atoms, m_fluent_atom_vertices, m_fluent_atom_slots);
+    update_atoms<DerivedTag>(state, m_derived_atoms, m_derived_atom_vertices, m_derived_atom_slots);
+
+    /* Patch the colors of the objects. */
+
+    auto atoms = PredicateVariantList {};
+    for (const auto object_index : m_dirty_objects)
+    {
+        atoms = m_object_static_predicates[object_index];
+        atoms.insert(atoms.end(), m_object_dynamic_predicates[object_index].begin(), m_object_dynamic_predicates[object_index].end());
+        std::sort(atoms.begin(), atoms.end());
+
+        m_properties[object_index] = graphs::PropertyValue(atoms, m_object_literals[object_index]);
+        m_is_object_dirty[object_index] = false;
+        m_is_compact_up_to_date = false;
+    }
+    m_dirty_objects.clear();
+}
+
+void ObjectGraphBuilder::compact()
+{
+    if (m_is_compact_up_to_date)
+    {
+        return;
+    }
+
+    /* Number the live vertices consecutively, which keeps the objects at their indices. */
+
+    m_compact_vertices.resize(m_properties.size());
+    auto num_vertices = 0;
+    for (size_t vertex = 0; vertex < m_properties.size(); ++vertex)
+    {
+        m_compact_vertices[vertex] = m_is_live[vertex] ? num_vertices++ : -1;
+    }
+
+    m_v.resize(num_vertices);
+    m_d.resize(num_vertices);
+    m_e.resize(2 * m_num_edges);
+    auto offset = size_t(0);
+    for (size_t vertex = 0; vertex < m_properties.size(); ++vertex)
+    {
+        if (!m_is_live[vertex])
+        {
+            continue;
+        }
+        const auto compact_vertex = m_compact_vertices[vertex];
+        m_v[compact_vertex] = offset;
+        m_d[compact_vertex] = m_row_sizes[vertex];
+        for (int i = 0; i < m_row_sizes[vertex]; ++i)
+        {
+            m_e[offset++] = m_compact_vertices[m_adjacency[m_row_begins[vertex] + i]];
+        }
+    }
+    assert(offset == m_e.size());
+
+    m_is_compact_up_to_date = true;
+    m_is_graph_up_to_date = false;
+}
+
+graphs::nauty::SparseGraph ObjectGraphBuilder::create_nauty_graph()
+{
+    compact();
+
+    m_color_vertex_pairs.clear();
+    for (size_t vertex = 0; vertex < m_properties.size(); ++vertex)
+    {
+        if (m_is_live[vertex])
+        {
+            m_color_vertex_pairs.emplace_back(m_properties[vertex], m_compact_vertices[vertex]);
+        }
+    }
+    std::sort(m_color_vertex_pairs.begin(), m_color_vertex_pairs.end());
+
+    const auto num_vertices = static_cast<int>(m_color_vertex_pairs.size());
+
+    auto coloring = graphs::PropertyValueList {};
+    coloring.reserve(num_vertices);
+    auto lab = std::vector<int>(num_vertices, 0);
+    auto ptn = std::vector<int>(num_vertices, 0);
+    for (int i = 0; i < num_vertices; ++i)
+    {
+        coloring.push_back(m_color_vertex_pairs[i].first);
+        lab[i] = m_color_vertex_pairs[i].second;
+        ptn[i] = (i + 1 < num_vertices && m_color_vertex_pairs[i].first == m_color_vertex_pairs[i + 1].first) ? 1 : 0;
+    }
+
+    return graphs::nauty::SparseGraph(m_v, m_d, m_e, std::move(lab), std::move(ptn), std::move(coloring));
+}
+
+const ObjectGraphBuilder::GraphType& ObjectGraphBuilder::get_graph()
+{
+    compact();
+
+    if (!m_is_graph_up_to_date)
+    {
+        m_graph.clear();
+        for (size_t vertex = 0; vertex < m_properties.size(); ++vertex)
+        {
+            if (m_is_live[vertex])
+            {
+                m_graph.add_vertex(graphs::PropertyValue(m_properties[vertex]));
+            }
+        }
+        for (size_t vertex = 0; vertex < m_v.size(); ++vertex)
+        {
+            for (int i = 0; i < m_d[vertex]; ++i)
+            {
+                const auto neighbor = static_cast<size_t>(m_e[m_v[vertex] + i]);
+                if (vertex < neighbor)
+                {
+                    m_graph.add_undirected_edge(vertex, neighbor);
+                }
+            }
+        }
+        m_is_graph_up_to_date = true;
+    }
+    return m_graph;
+}
+
+size_t ObjectGraphBuilder::get_num_vertices() const { return m_num_live_vertices; }
+
+size_t ObjectGraphBuilder::get_num_edges() const { return 2 * m_num_edges; }
+
+const Problem& ObjectGraphBuilder::get_problem() const { return m_problem; }
+
 }
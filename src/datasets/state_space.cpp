@@ -93,10 +93,16 @@ private:
 
     IndexMap<graphs::VertexIndex> m_state_to_vertex_index;
 
+    ObjectGraphBuilder m_object_graph_builder;
+
     /* Implement AlgorithmEventHandlerBase interface */
     friend class brfs::EventHandlerBase<SymmetryReducedProblemGraphEventHandler>;
 
-    auto compute_canonical_graph(const State& state) { return nauty::SparseGraph(create_object_graph(state, *m_problem)).canonize(); }
+    auto compute_canonical_graph(const State& state)
+    {
+        m_object_graph_builder.update(state);
+        return m_object_graph_builder.create_nauty_graph().canonize();
+    }
 
     void on_expand_state_impl(const State& state) {}
 
@@ -168,6 +174,8 @@ private:
     {
     }
 
+    void on_end_bitstate_search_impl(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) const {}
+
     void on_solved_impl(const Plan& plan) {}
 
     void on_unsolvable_impl() {}
@@ -186,7 +194,9 @@ public:
         m_options(options),
         m_graph(graph),
         m_goal_vertices(goal_vertices),
-        m_symm_data(symm_data)
+        m_symm_data(symm_data),
+        m_state_to_vertex_index(),
+        m_object_graph_builder(state_repository->get_problem())
     {
     }
 };
@@ -246,6 +256,8 @@ private:
     {
     }
 
+    void on_end_bitstate_search_impl(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) const {}
+
     void on_solved_impl(const Plan& plan) {}
 
     void on_unsolvable_impl() {}
@@ -407,6 +419,54 @@ static std::optional<StateSpace> compute_problem_graph_without_symmetry_reductio
     return perform_reachability_analysis(context, std::move(graph), std::move(goal_vertices), options);
 }
 
+/// @brief `GoalCountingEventHandler` counts the expanded goal states.
+class GoalCountingEventHandler : public brfs::EventHandlerBase<GoalCountingEventHandler>
+{
+private:
+    uint64_t& m_num_goal_states;
+
+    /* Implement AlgorithmEventHandlerBase interface */
+    friend class EventHandlerBase<GoalCountingEventHandler>;
+
+    void on_expand_state_impl(const State& state) {}
+
+    void on_expand_goal_state_impl(const State& state) { ++m_num_goal_states; }
+
+    void on_generate_state_impl(const State& state, GroundAction action, ContinuousCost action_cost, const State& successor_state) {}
+
+    void on_generate_state_in_search_tree_impl(const State& state, GroundAction action, ContinuousCost action_cost, const State& successor_state) {}
+
+    void on_generate_state_not_in_search_tree_impl(const State& state, GroundAction action, ContinuousCost action_cost, const State& successor_state) {}
+
+    void on_finish_g_layer_impl(uint32_t g_value, uint64_t num_expanded_states, uint64_t num_generated_states) {}
+
+    void on_start_search_impl(const State& start_state) {}
+
+    void on_end_search_impl(uint64_t num_reached_fluent_atoms,
+                            uint64_t num_reached_derived_atoms,
+                            uint64_t num_states,
+                            uint64_t num_nodes,
+                            uint64_t num_actions,
+                            uint64_t num_axioms) const
+    {
+    }
+
+    void on_end_bitstate_search_impl(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) const {}
+
+    void on_solved_impl(const Plan& plan) {}
+
+    void on_unsolvable_impl() {}
+
+    void on_exhausted_impl() {}
+
+public:
+    GoalCountingEventHandler(Problem problem, uint64_t& num_goal_states) :
+        brfs::EventHandlerBase<GoalCountingEventHandler>(problem, false),
+        m_num_goal_states(num_goal_states)
+    {
+    }
+};
+
 StateSpaceImpl::StateSpaceImpl(bool is_symmetry_reduced,
                                search::SearchContext context,
                                graphs::ProblemGraph graph,
@@ -473,6 +533,36 @@ std::vector<std::pair<StateSpace, std::optional<CertificateMaps>>> StateSpaceImp
     return state_spaces;
 }
 
+std::optional<state_space::SizeEstimate>
+StateSpaceImpl::estimate_size(search::SearchContext context, uint64_t num_bits, uint32_t num_hash_functions, const Options& options)
+{
+    auto num_goal_states = uint64_t(0);
+
+    const auto event_handler = std::make_shared<GoalCountingEventHandler>(context->get_problem(), num_goal_states);
+    auto brfs_options = brfs::Options();
+    brfs_options.event_handler = event_handler;
+    brfs_options.stop_if_goal = false;
+    brfs_options.max_num_states = options.max_num_states;
+    brfs_options.max_time_in_ms = options.timeout_ms;
+    brfs_options.bitstate_num_bits = num_bits;
+    brfs_options.bitstate_num_hash_functions = num_hash_functions;
+    const auto result = find_solution(context, brfs_options);
+
+    if (result.status != SearchStatus::EXHAUSTED)
+    {
+        return std::nullopt;  ///< ran out of resources.
+    }
+
+    if (options.remove_if_unsolvable && num_goal_states == 0)
+    {
+        return std::nullopt;  ///< initial vertex is unsolvable.
+    }
+
+    const auto& statistics = event_handler->get_statistics();
+
+    return state_space::SizeEstimate { statistics.get_num_states(), num_goal_states, statistics.get_estimated_omission_probability() };
+}
+
 bool StateSpaceImpl::is_symmetry_reduced() const { return m_is_symmetry_reduced; }
 
 const search::SearchContext& StateSpaceImpl::get_search_context() const { return m_context; }
@@ -171,6 +171,12 @@ void PredicateAssignmentSets<P>::reset() noexcept
         set.reset();
 }
 
+template<IsStaticOrFluentOrDerivedTag P>
+void PredicateAssignmentSets<P>::reset(Predicate<P> predicate) noexcept
+{
+    m_sets[predicate->get_index()].reset();
+}
+
 template<IsStaticOrFluentOrDerivedTag P>
 void PredicateAssignmentSets<P>::insert_ground_atoms(const GroundAtomList<P>& ground_atoms)
 {
@@ -294,6 +300,12 @@ void FunctionSkeletonAssignmentSets<F>::reset() noexcept
         set.reset();
 }
 
+template<IsStaticOrFluentTag F>
+void FunctionSkeletonAssignmentSets<F>::reset(FunctionSkeleton<F> function_skeleton) noexcept
+{
+    m_sets[function_skeleton->get_index()].reset();
+}
+
 template<IsStaticOrFluentTag F>
 void FunctionSkeletonAssignmentSets<F>::insert_ground_function_values(const GroundFunctionList<F>& ground_functions, const FlatDoubleList& numeric_values)
 {
@@ -307,6 +319,12 @@ void FunctionSkeletonAssignmentSets<F>::insert_ground_function_values(const Grou
         m_sets[ground_functions[i]->get_function_skeleton()->get_index()].insert_ground_function_value(ground_functions[i], numeric_values[i]);
 }
 
+template<IsStaticOrFluentTag F>
+void FunctionSkeletonAssignmentSets<F>::insert_ground_function_value(GroundFunction<F> ground_function, ContinuousCost value)
+{
+    m_sets[ground_function->get_function_skeleton()->get_index()].insert_ground_function_value(ground_function, value);
+}
+
 template<IsStaticOrFluentTag F>
 const FunctionSkeletonAssignmentSet<F>& FunctionSkeletonAssignmentSets<F>::get_set(FunctionSkeleton<F> function_skeleton) const noexcept
 {
@@ -340,12 +358,16 @@ StaticAssignmentSets::StaticAssignmentSets(const ProblemImpl& problem) :
                                                                            problem.get_initial_function_to_value<StaticTag>());
 }
 
-DynamicAssignmentSets::DynamicAssignmentSets() {}
+DynamicAssignmentSets::DynamicAssignmentSets() : is_initialized(false) {}
 
 DynamicAssignmentSets::DynamicAssignmentSets(const ProblemImpl& problem) :
     fluent_predicate_assignment_sets(problem.get_problem_and_domain_objects(), problem.get_domain()->get_predicates<FluentTag>()),
     derived_predicate_assignment_sets(problem.get_problem_and_domain_objects(), problem.get_problem_and_domain_derived_predicates()),
-    fluent_function_skeleton_assignment_sets(problem.get_problem_and_domain_objects(), problem.get_domain()->get_function_skeletons<FluentTag>())
+    fluent_function_skeleton_assignment_sets(problem.get_problem_and_domain_objects(), problem.get_domain()->get_function_skeletons<FluentTag>()),
+    fluent_atoms(),
+    derived_atoms(),
+    numeric_variables(),
+    is_initialized(false)
 {
 }
 
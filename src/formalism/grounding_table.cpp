@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/grounding_table.hpp"
+
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/parameter.hpp"
+#include "mimir/formalism/type.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace mimir::formalism
+{
+
+PerfectBindingHash::PerfectBindingHash(const ParameterList& parameters, const ObjectList& objects) :
+    m_num_bindings(1),
+    m_remapping(),
+    m_domains(),
+    m_strides()
+{
+    auto max_object_index = Index { 0 };
+    for (const auto& object : objects)
+    {
+        max_object_index = std::max(max_object_index, object->get_index());
+    }
+
+    for (const auto& parameter : parameters)
+    {
+        auto remapping = std::vector<uint32_t>(objects.empty() ? 0 : max_object_index + 1, MAX_INDEX);
+        auto domain = ObjectList {};
+        for (const auto& object : objects)
+        {
+            // An untyped parameter admits all objects.
+            if (parameter->get_bases().empty() || is_subtypeeq(object->get_bases(), parameter->get_bases()))
+            {
+                remapping[object->get_index()] = static_cast<uint32_t>(domain.size());
+                domain.push_back(object);
+            }
+        }
+        const auto domain_size = domain.size();
+
+        m_remapping.push_back(std::move(remapping));
+        m_domains.push_back(std::move(domain));
+        m_strides.push_back(m_num_bindings);
+
+        if (m_num_bindings != NO_RANK)
+        {
+            m_num_bindings = (domain_size != 0 && m_num_bindings > NO_RANK / domain_size) ? NO_RANK : m_num_bindings * domain_size;
+        }
+    }
+}
+
+size_t PerfectBindingHash::get_binding_rank(const ObjectList& binding) const noexcept
+{
+    if (binding.size() != m_remapping.size())
+    {
+        return NO_RANK;
+    }
+
+    auto result = size_t { 0 };
+    for (size_t i = 0; i < binding.size(); ++i)
+    {
+        const auto& remapping = m_remapping[i];
+        const auto object_index = binding[i]->get_index();
+        if (object_index >= remapping.size() || remapping[object_index] == MAX_INDEX)
+        {
+            return NO_RANK;
+        }
+        result += remapping[object_index] * m_strides[i];
+    }
+
+    assert(result < m_num_bindings);
+
+    return result;
+}
+
+ObjectList PerfectBindingHash::get_binding(size_t rank) const
+{
+    assert(rank < m_num_bindings);
+
+    auto result = ObjectList {};
+    result.reserve(m_domains.size());
+    for (size_t i = 0; i < m_domains.size(); ++i)
+    {
+        result.push_back(m_domains[i][(rank / m_strides[i]) % m_domains[i].size()]);
+    }
+    return result;
+}
+
+size_t PerfectBindingHash::size() const noexcept { return m_num_bindings; }
+
+}
@@ -91,6 +91,7 @@ ProblemImpl::ProblemImpl(Index index,
     m_flat_double_lists(),
     m_index_tree_table(std::make_unique<valla::IndexedHashSet<valla::Slot<Index>, Index>>()),
     m_double_leaf_table(std::make_unique<valla::IndexedHashSet<double, Index>>()),
+    m_table_mutex(),
     m_bitset_pool(),
     m_index_list_pool(),
     m_double_list_pool()
@@ -257,6 +258,8 @@ const valla::IndexedHashSet<valla::Slot<Index>, Index>& ProblemImpl::get_index_t
 valla::IndexedHashSet<double, Index>& ProblemImpl::get_double_leaf_table() { return *m_double_leaf_table; }
 const valla::IndexedHashSet<double, Index>& ProblemImpl::get_double_leaf_table() const { return *m_double_leaf_table; }
 
+std::shared_mutex& ProblemImpl::get_table_mutex() { return m_table_mutex; }
+
 std::pair<const FlatIndexList*, Index> ProblemImpl::get_or_create_index_list(const FlatIndexList& list)
 {
     auto result = m_flat_index_list_map.emplace(list, m_flat_index_list_map.size());
@@ -293,6 +296,11 @@ const FlatDoubleList* ProblemImpl::get_double_list(size_t pos) const
     assert(pos < m_flat_double_lists.size());
     return m_flat_double_lists[pos];
 }
+size_t ProblemImpl::get_estimated_memory_usage_of_lists_in_bytes() const
+{
+    return m_flat_index_list_map.get_estimated_memory_usage_in_bytes() + m_flat_index_lists.capacity() * sizeof(const FlatIndexList*)
+           + m_flat_double_list_map.get_estimated_memory_usage_in_bytes() + m_flat_double_lists.capacity() * sizeof(const FlatDoubleList*);
+}
 
 SharedObjectPool<FlatBitset>& ProblemImpl::get_bitset_pool() { return m_bitset_pool; }
 SharedObjectPool<FlatIndexList>& ProblemImpl::get_index_list_pool() { return m_index_list_pool; }
@@ -640,11 +648,14 @@ GroundAction ProblemImpl::ground(Action action, const ObjectList& binding)
         grounding_tables.resize(action_index + 1);
     }
     auto& grounding_table = grounding_tables.at(action_index);
+    if (!grounding_table)
+    {
+        grounding_table.emplace(action->get_parameters(), get_problem_and_domain_objects());
+    }
 
-    auto it = grounding_table.find(binding);
-    if (it != grounding_table.end())
+    if (const auto grounding = grounding_table->find(binding))
     {
-        return it->second;
+        return grounding;
     }
 
     /* 2. Ground the action */
@@ -698,7 +709,7 @@ GroundAction ProblemImpl::ground(Action action, const ObjectList& binding)
 
     /* 3. Insert to groundings table */
 
-    grounding_table.emplace(binding, GroundAction(grounded_action));
+    grounding_table->insert(binding, grounded_action);
 
     /* 4. Return the resulting ground action */
 
@@ -719,11 +730,14 @@ GroundAxiom ProblemImpl::ground(Axiom axiom, const ObjectList& binding)
         grounding_tables.resize(axiom_index + 1);
     }
     auto& grounding_table = grounding_tables.at(axiom_index);
+    if (!grounding_table)
+    {
+        grounding_table.emplace(axiom->get_parameters(), get_problem_and_domain_objects());
+    }
 
-    auto it = grounding_table.find(binding);
-    if (it != grounding_table.end())
+    if (const auto grounding = grounding_table->find(binding))
     {
-        return it->second;
+        return grounding;
     }
 
     /* 2. Ground the axiom */
@@ -735,7 +749,7 @@ GroundAxiom ProblemImpl::ground(Axiom axiom, const ObjectList& binding)
 
     /* 3. Insert to groundings table */
 
-    grounding_table.emplace(binding, GroundAxiom(grounded_axiom));
+    grounding_table->insert(binding, grounded_axiom);
 
     /* 4. Return the resulting ground axiom */
 
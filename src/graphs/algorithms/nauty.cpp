@@ -65,6 +65,20 @@ void SparseGraph::initialize(size_t nde,
         details::SparseGraphImpl>(nde, v, nv, std::move(d), std::move(e), vlen, dlen, elen, std::move(lab), std::move(ptn), std::move(coloring));
 }
 
+SparseGraph::SparseGraph(std::vector<size_t> v,
+                         std::vector<int> d,
+                         std::vector<int> e,
+                         std::vector<int> lab,
+                         std::vector<int> ptn,
+                         PropertyValueList coloring) :
+    SparseGraph()
+{
+    const auto nv = static_cast<int>(d.size());
+    const auto nde = e.size();
+
+    initialize(nde, std::move(v), nv, std::move(d), std::move(e), nv, nv, nde, std::move(lab), std::move(ptn), std::move(coloring));
+}
+
 SparseGraph::SparseGraph(const SparseGraph& other) = default;
 
 SparseGraph& SparseGraph::operator=(const SparseGraph& other) = default;
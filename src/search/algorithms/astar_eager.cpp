@@ -23,20 +23,25 @@
 #include "mimir/formalism/metric.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/search/algorithms/astar_eager/event_handlers.hpp"
+#include "mimir/search/algorithms/checkpoint.hpp"
 #include "mimir/search/algorithms/strategies/goal_strategy.hpp"
 #include "mimir/search/algorithms/strategies/pruning_strategy.hpp"
 #include "mimir/search/applicability.hpp"
 #include "mimir/search/applicable_action_generators/interface.hpp"
 #include "mimir/search/axiom_evaluators/interface.hpp"
+#include "mimir/search/heuristics/cache.hpp"
 #include "mimir/search/heuristics/interface.hpp"
 #include "mimir/search/openlists/interface.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/openlists/radix_heap.hpp"
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/search_node.hpp"
 #include "mimir/search/search_space.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include "heuristic_batch.hpp"
+
 using namespace mimir::formalism;
 
 namespace mimir::search::astar_eager
@@ -48,22 +53,29 @@ namespace mimir::search::astar_eager
 
 struct SearchNode
 {
+    static constexpr Index UNKNOWN_PARENT_ACTION = get_unknown_parent_action<29>();
+
     ContinuousCost g_value;
     Index parent_state;
-    SearchNodeStatus status;
+    Index parent_action : 29;
+    Index status : 3;
+
+    SearchNodeStatus get_status() const { return static_cast<SearchNodeStatus>(status); }
+    void set_status(SearchNodeStatus value) { status = value; }
 };
 
 static_assert(sizeof(SearchNode) == 16);
 
 using SearchNodeVector = SegmentedVector<SearchNode>;
 
+static constexpr auto DEFAULT_SEARCH_NODE =
+    SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNode::UNKNOWN_PARENT_ACTION, SearchNodeStatus::NEW };
+
 static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVector& search_nodes)
 {
-    static constexpr auto default_node = SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNodeStatus::NEW };
-
     while (state_index >= search_nodes.size())
     {
-        search_nodes.push_back(default_node);
+        search_nodes.push_back(DEFAULT_SEARCH_NODE);
     }
     return search_nodes[state_index];
 }
@@ -83,11 +95,21 @@ struct QueueEntry
 
     KeyType get_key() const { return std::make_pair(f_value, status); }
     ItemType get_item() const { return std::make_pair(f_value, packed_state); }
+    /// @brief Bucket by f-value. The radix heap orders entries with the same f-value by status, such that goal entries come first.
+    ContinuousCost get_bucket() const { return f_value; }
 };
 
 static_assert(sizeof(QueueEntry) == 24);
 
-using Queue = PriorityQueue<QueueEntry>;
+using Queue = RadixHeapOpenList<QueueEntry>;
+
+/// @brief A queue entry that refers to its state by index, as stored in checkpoints.
+struct CheckpointEntry
+{
+    ContinuousCost f_value;
+    Index state_index;
+    SearchNodeStatus status;
+};
 
 /**
  * AStar
@@ -100,6 +122,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     auto& problem = *context->get_problem();
     auto& applicable_action_generator = *context->get_applicable_action_generator();
     auto& state_repository = *context->get_state_repository();
+    const auto start_unpacked_state_cache_statistics = state_repository.get_unpacked_state_cache_statistics();
 
     const auto [start_state, start_g_value] = (options.start_state) ?
                                                   std::make_pair(options.start_state.value(), compute_state_metric_value(options.start_state.value())) :
@@ -107,6 +130,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     const auto event_handler = (options.event_handler) ? options.event_handler : DefaultEventHandlerImpl::create(context->get_problem());
     const auto goal_strategy = (options.goal_strategy) ? options.goal_strategy : ProblemGoalStrategyImpl::create(context->get_problem());
     const auto pruning_strategy = (options.pruning_strategy) ? options.pruning_strategy : NoPruningStrategyImpl::create();
+    const auto heuristic_cache = (options.heuristic_cache) ? options.heuristic_cache : HeuristicCacheImpl::create();
 
     const auto& ground_action_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundActionImpl> {});
     const auto& ground_axiom_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
@@ -129,6 +153,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
     if (goal_strategy->test_dynamic_goal(start_state))
     {
+        report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
         event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
                                      state_repository.get_reached_derived_ground_atoms_bitset().count(),
                                      state_repository.get_state_count(),
@@ -153,18 +178,18 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     {
         throw std::runtime_error("find_solution_astar(...): evaluating the metric on the start state yielded NaN.");
     }
-    const auto start_h_value = heuristic->compute_heuristic(start_state);
+    const auto start_h_value = compute_heuristic(*heuristic, heuristic_cache.get(), *event_handler, start_state);
     const auto start_f_value = start_g_value + start_h_value;
 
     event_handler->on_start_search(start_state, start_g_value, start_f_value);
 
     auto& start_search_node = get_or_create_search_node(start_state.get_index(), search_nodes);
-    start_search_node.status = (start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN;
+    start_search_node.set_status((start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN);
     start_search_node.g_value = start_g_value;
 
     /* Test whether start state is deadend. */
 
-    if (start_search_node.status == SearchNodeStatus::DEAD_END)
+    if (start_search_node.get_status() == SearchNodeStatus::DEAD_END)
     {
         event_handler->on_unsolvable();
 
@@ -180,23 +205,84 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
         return result;
     }
 
-    auto applicable_actions = GroundActionList {};
+    auto successors = SuccessorBatch();
+    auto heuristic_batch = HeuristicBatch();
+    const auto use_heuristic_batch = heuristic->supports_batch_evaluation();
     auto f_value = start_f_value;
-    openlist.insert(QueueEntry { start_f_value, start_state.get_packed_state(), start_search_node.status });
+
+    if (options.resume_from_checkpoint && fs::exists(options.checkpoint_file))
+    {
+        search_nodes = SearchNodeVector();
+        const auto values = load_checkpoint<SearchNode, CheckpointEntry>(
+            options.checkpoint_file,
+            state_repository,
+            DEFAULT_SEARCH_NODE,
+            search_nodes,
+            [&](const CheckpointEntry& entry, PackedState packed_state) { openlist.insert(QueueEntry { entry.f_value, packed_state, entry.status }); });
+        f_value = values.at(0);
+    }
+    else
+    {
+        openlist.insert(QueueEntry { start_f_value, start_state.get_packed_state(), start_search_node.get_status() });
+    }
 
     event_handler->on_finish_f_layer(f_value);
 
     auto stopwatch = StopWatch(options.max_time_in_ms);
     stopwatch.start();
 
+    auto memory_limit = MemoryLimit(options.max_memory_in_bytes);
+    auto get_num_bytes_for_search = [&]()
+    {
+        return search_nodes.capacity() * sizeof(SearchNode) + openlist.get_estimated_memory_usage_in_bytes()
+               + heuristic_cache->get_estimated_memory_usage_in_bytes();
+    };
+
+    auto checkpoint_stopwatch = StopWatch(options.checkpoint_interval_in_ms);
+    checkpoint_stopwatch.start();
+    auto write_checkpoint = [&]()
+    {
+        auto entries = std::vector<CheckpointEntry> {};
+        openlist.for_each([&](const QueueEntry& entry)
+                          { entries.push_back(CheckpointEntry { entry.f_value, state_repository.get_state_index(*entry.packed_state), entry.status }); });
+        save_checkpoint(options.checkpoint_file, state_repository, search_nodes, entries, std::vector<double> { f_value });
+        checkpoint_stopwatch.start();
+    };
+
     while (!openlist.empty())
     {
         if (stopwatch.has_finished())
         {
+            if (!options.checkpoint_file.empty())
+            {
+                write_checkpoint();
+            }
+
             result.status = SearchStatus::OUT_OF_TIME;
             return result;
         }
 
+        if (!options.checkpoint_file.empty() && checkpoint_stopwatch.has_finished())
+        {
+            write_checkpoint();
+        }
+
+        if (memory_limit.has_exceeded(*context, get_num_bytes_for_search))
+        {
+            report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
+            event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
+                                         state_repository.get_reached_derived_ground_atoms_bitset().count(),
+                                         state_repository.get_state_count(),
+                                         search_nodes.size(),
+                                         ground_action_repository.size(),
+                                         ground_axiom_repository.size());
+            applicable_action_generator.on_end_search();
+            state_repository.get_axiom_evaluator()->on_end_search();
+
+            result.status = SearchStatus::OUT_OF_MEMORY;
+            return result;
+        }
+
         const auto [state_f_value, packed_state] = openlist.top();
         openlist.pop();
         const auto state = state_repository.get_state(*packed_state);
@@ -204,7 +290,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         /* Avoid unnecessary extra work by testing whether shortest distance was proven. */
 
-        if (search_node.status == SearchNodeStatus::CLOSED || search_node.status == SearchNodeStatus::DEAD_END)
+        if (search_node.get_status() == SearchNodeStatus::CLOSED || search_node.get_status() == SearchNodeStatus::DEAD_END)
         {
             continue;
         }
@@ -221,10 +307,11 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         /* Test whether state achieves the dynamic goal. */
 
-        if (search_node.status == SearchNodeStatus::GOAL)
+        if (search_node.get_status() == SearchNodeStatus::GOAL)
         {
             event_handler->on_expand_goal_state(state);
 
+            report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
             event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
                                          state_repository.get_reached_derived_ground_atoms_bitset().count(),
                                          state_repository.get_state_count(),
@@ -251,13 +338,29 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         /* Ensure that the state is closed */
 
-        search_node.status = SearchNodeStatus::CLOSED;
+        search_node.set_status(SearchNodeStatus::CLOSED);
+
+        state_repository.expand(state, search_node.g_value, applicable_action_generator, successors);
+
+        if (use_heuristic_batch)
+        {
+            // Evaluate the successors that are opened or reopened below at once.
+            heuristic_batch.clear();
+            for (const auto& successor : successors)
+            {
+                const auto successor_index = successor.state.get_index();
+                if (successor_index >= search_nodes.size() || successor.state_metric_value < search_nodes[successor_index].g_value)
+                {
+                    heuristic_batch.add(successor.state, heuristic_cache.get());
+                }
+            }
+            heuristic_batch.compute(*heuristic);
+        }
 
-        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        for (const auto& [action, successor_state, successor_state_metric_value] : successors)
         {
             assert(is_applicable(action, state));
 
-            const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, search_node.g_value);
             auto& successor_search_node = get_or_create_search_node(successor_state.get_index(), search_nodes);
             const auto action_cost = successor_state_metric_value - search_node.g_value;
 
@@ -266,7 +369,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                 throw std::runtime_error("find_solution_astar(...): evaluating the metric on the successor state yielded NaN.");
             }
 
-            const bool is_new_successor_state = (successor_search_node.status == SearchNodeStatus::NEW);
+            const bool is_new_successor_state = (successor_search_node.get_status() == SearchNodeStatus::NEW);
 
             if (is_new_successor_state && search_nodes.size() >= options.max_num_states)
             {
@@ -276,7 +379,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
             /* Customization point 1: pruning strategy, default never prunes. */
 
-            if (pruning_strategy->test_prune_successor_state(state, successor_state, is_new_successor_state))
+            if (pruning_strategy->test_prune_successor_state_with_g_value(state, successor_state, is_new_successor_state, successor_state_metric_value))
             {
                 event_handler->on_prune_state(successor_state);
                 continue;
@@ -290,27 +393,29 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             {
                 /* Open/Reopen state with updated f_value. */
 
-                successor_search_node.status = SearchNodeStatus::OPEN;
+                successor_search_node.set_status(SearchNodeStatus::OPEN);
                 successor_search_node.parent_state = state.get_index();
+                set_parent_action(successor_search_node, action->get_index());
                 successor_search_node.g_value = successor_state_metric_value;
 
                 if (is_new_successor_state && goal_strategy->test_dynamic_goal(successor_state))
                 {
-                    successor_search_node.status = SearchNodeStatus::GOAL;
+                    successor_search_node.set_status(SearchNodeStatus::GOAL);
                 }
 
-                const auto successor_h_value = heuristic->compute_heuristic(successor_state);
+                const auto successor_h_value =
+                    compute_heuristic(*heuristic, heuristic_cache.get(), *event_handler, successor_state, use_heuristic_batch ? &heuristic_batch : nullptr);
 
                 if (successor_h_value == INFINITY_CONTINUOUS_COST)
                 {
-                    successor_search_node.status = SearchNodeStatus::DEAD_END;
+                    successor_search_node.set_status(SearchNodeStatus::DEAD_END);
                     continue;
                 }
 
                 event_handler->on_generate_state_relaxed(state, action, action_cost, successor_state);
 
                 const auto successor_f_value = successor_search_node.g_value + successor_h_value;
-                openlist.insert(QueueEntry { successor_f_value, successor_state.get_packed_state(), successor_search_node.status });
+                openlist.insert(QueueEntry { successor_f_value, successor_state.get_packed_state(), successor_search_node.get_status() });
             }
             else
             {
@@ -319,6 +424,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
         }
     }
 
+    report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
     event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
                                  state_repository.get_reached_derived_ground_atoms_bitset().count(),
                                  state_repository.get_state_count(),
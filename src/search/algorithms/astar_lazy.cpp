@@ -32,6 +32,7 @@
 #include "mimir/search/openlists/alternating.hpp"
 #include "mimir/search/openlists/interface.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/openlists/radix_heap.hpp"
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/search_node.hpp"
@@ -49,9 +50,15 @@ namespace mimir::search::astar_lazy
 
 struct SearchNode
 {
+    static constexpr Index UNKNOWN_PARENT_ACTION = get_unknown_parent_action<29>();
+
     ContinuousCost g_value;
     Index parent_state;
-    SearchNodeStatus status;
+    Index parent_action : 29;
+    Index status : 3;
+
+    SearchNodeStatus get_status() const { return static_cast<SearchNodeStatus>(status); }
+    void set_status(SearchNodeStatus value) { status = value; }
 };
 
 static_assert(sizeof(SearchNode) == 16);
@@ -60,7 +67,7 @@ using SearchNodeVector = SegmentedVector<SearchNode>;
 
 static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVector& search_nodes)
 {
-    static constexpr auto default_node = SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNodeStatus::NEW };
+    static constexpr auto default_node = SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNode::UNKNOWN_PARENT_ACTION, SearchNodeStatus::NEW };
 
     while (state_index >= search_nodes.size())
     {
@@ -83,11 +90,12 @@ struct QueueEntry
 
     KeyType get_key() const { return f_value; }
     ItemType get_item() const { return std::make_pair(f_value, packed_state); }
+    ContinuousCost get_bucket() const { return f_value; }
 };
 
 static_assert(sizeof(QueueEntry) == 16);
 
-using Queue = PriorityQueue<QueueEntry>;
+using Queue = RadixHeapOpenList<QueueEntry>;
 
 /**
  * AStar
@@ -162,12 +170,12 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     event_handler->on_start_search(start_state, start_g_value, start_f_value);
 
     auto& start_search_node = get_or_create_search_node(start_state.get_index(), search_nodes);
-    start_search_node.status = (start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN;
+    start_search_node.set_status((start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN);
     start_search_node.g_value = start_g_value;
 
     /* Test whether start state is deadend. */
 
-    if (start_search_node.status == SearchNodeStatus::DEAD_END)
+    if (start_search_node.get_status() == SearchNodeStatus::DEAD_END)
     {
         event_handler->on_unsolvable();
 
@@ -192,6 +200,9 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     auto stopwatch = StopWatch(options.max_time_in_ms);
     stopwatch.start();
 
+    auto memory_limit = MemoryLimit(options.max_memory_in_bytes);
+    auto get_num_bytes_for_search = [&]() { return search_nodes.capacity() * sizeof(SearchNode) + openlist.get_estimated_memory_usage_in_bytes(); };
+
     while (!openlist.empty())
     {
         if (stopwatch.has_finished())
@@ -200,6 +211,21 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             return result;
         }
 
+        if (memory_limit.has_exceeded(*context, get_num_bytes_for_search))
+        {
+            event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
+                                         state_repository.get_reached_derived_ground_atoms_bitset().count(),
+                                         state_repository.get_state_count(),
+                                         search_nodes.size(),
+                                         ground_action_repository.size(),
+                                         ground_axiom_repository.size());
+            applicable_action_generator.on_end_search();
+            state_repository.get_axiom_evaluator()->on_end_search();
+
+            result.status = SearchStatus::OUT_OF_MEMORY;
+            return result;
+        }
+
         const auto [state_f_value, packed_state] = openlist.top();
         openlist.pop();
         const auto state = state_repository.get_state(*packed_state);
@@ -207,7 +233,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         /* Avoid unnecessary extra work by testing whether shortest distance was proven. */
 
-        if (search_node.status == SearchNodeStatus::CLOSED || search_node.status == SearchNodeStatus::DEAD_END)
+        if (search_node.get_status() == SearchNodeStatus::CLOSED || search_node.get_status() == SearchNodeStatus::DEAD_END)
         {
             continue;
         }
@@ -215,7 +241,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
         const auto state_h_value = heuristic->compute_heuristic(state);
         if (state_h_value == INFINITY_CONTINUOUS_COST)
         {
-            search_node.status = SearchNodeStatus::DEAD_END;
+            search_node.set_status(SearchNodeStatus::DEAD_END);
             continue;
         }
 
@@ -231,7 +257,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         /* Test whether state achieves the dynamic goal. */
 
-        if (search_node.status == SearchNodeStatus::GOAL)
+        if (search_node.get_status() == SearchNodeStatus::GOAL)
         {
             event_handler->on_expand_goal_state(state);
 
@@ -265,7 +291,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         /* Ensure that the state is closed */
 
-        search_node.status = SearchNodeStatus::CLOSED;
+        search_node.set_status(SearchNodeStatus::CLOSED);
 
         for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
         {
@@ -279,7 +305,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             }
 
             const auto is_preferred = preferred_actions.data.contains(action);
-            const bool is_new_successor_state = (successor_search_node.status == SearchNodeStatus::NEW);
+            const bool is_new_successor_state = (successor_search_node.get_status() == SearchNodeStatus::NEW);
 
             if (is_new_successor_state && search_nodes.size() >= options.max_num_states)
             {
@@ -289,7 +315,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
             /* Customization point 1: pruning strategy, default never prunes. */
 
-            if (pruning_strategy->test_prune_successor_state(state, successor_state, is_new_successor_state))
+            if (pruning_strategy->test_prune_successor_state_with_g_value(state, successor_state, is_new_successor_state, successor_state_metric_value))
             {
                 event_handler->on_prune_state(successor_state);
                 continue;
@@ -303,13 +329,14 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             {
                 /* Open/Reopen state with updated f_value. */
 
-                successor_search_node.status = SearchNodeStatus::OPEN;
+                successor_search_node.set_status(SearchNodeStatus::OPEN);
                 successor_search_node.parent_state = state.get_index();
+                set_parent_action(successor_search_node, action->get_index());
                 successor_search_node.g_value = successor_state_metric_value;
 
                 if (is_new_successor_state && goal_strategy->test_dynamic_goal(successor_state))
                 {
-                    successor_search_node.status = SearchNodeStatus::GOAL;
+                    successor_search_node.set_status(SearchNodeStatus::GOAL);
                 }
 
                 event_handler->on_generate_state_relaxed(state, action, action_cost, successor_state);
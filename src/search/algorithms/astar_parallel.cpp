@@ -0,0 +1,624 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/astar_parallel.hpp"
+
+#include "mimir/algorithms/BS_thread_pool.hpp"
+#include "mimir/algorithms/mailbox.hpp"
+#include "mimir/common/segmented_vector.hpp"
+#include "mimir/common/timers.hpp"
+#include "mimir/formalism/ground_function_expressions.hpp"
+#include "mimir/formalism/metric.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/astar_eager/event_handlers.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicability.hpp"
+#include "mimir/search/applicable_action_generators/grounded/grounded.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/axiom_evaluators/interface.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/openlists/interface.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/search_node.hpp"
+#include "mimir/search/search_space.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::astar_parallel
+{
+
+/**
+ * AStar search node
+ */
+
+struct SearchNode
+{
+    static constexpr Index UNKNOWN_PARENT_ACTION = get_unknown_parent_action<29>();
+
+    ContinuousCost g_value;
+    Index parent_state;
+    Index parent_action : 29;
+    Index status : 3;
+
+    SearchNodeStatus get_status() const { return static_cast<SearchNodeStatus>(status); }
+    void set_status(SearchNodeStatus value) { status = value; }
+};
+
+static_assert(sizeof(SearchNode) == 16);
+
+using SearchNodeVector = SegmentedVector<SearchNode>;
+
+static constexpr auto default_node = SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNode::UNKNOWN_PARENT_ACTION, SearchNodeStatus::NEW };
+
+/**
+ * AStar queue entry
+ */
+
+struct QueueEntry
+{
+    using KeyType = std::pair<ContinuousCost, SearchNodeStatus>;
+    using ItemType = std::pair<ContinuousCost, PackedState>;
+
+    ContinuousCost f_value;
+    PackedState packed_state;
+    Index local_index;
+    SearchNodeStatus status;
+
+    KeyType get_key() const { return std::make_pair(f_value, status); }
+    ItemType get_item() const { return std::make_pair(f_value, packed_state); }
+};
+
+static_assert(sizeof(QueueEntry) == 24);
+
+using Queue = PriorityQueue<QueueEntry>;
+
+/**
+ * Messages
+ */
+
+/// @brief A generated successor that is forwarded to the worker owning it.
+struct Message
+{
+    Index state_index;
+    Index parent_state;
+    Index parent_action;
+    PackedState packed_state;
+    ContinuousCost g_value;
+    ContinuousCost h_value;
+    bool is_goal;
+};
+
+/// @brief Messages are sent in batches, one batch per destination and expansion,
+/// to amortize the cost of the atomic operations in the mailbox.
+using MessageBatch = std::vector<Message>;
+
+/**
+ * Workers
+ */
+
+/// @brief The shard of the search space owned by a single worker.
+struct Worker
+{
+    Mailbox<MessageBatch> mailbox;
+    Queue openlist;
+    SearchNodeVector search_nodes;
+    absl::flat_hash_map<Index, Index> local_indices;  ///< Maps state indices to positions in `search_nodes`.
+    std::vector<MessageBatch> outgoing;               ///< Outgoing messages per destination.
+    bool idle = false;
+
+    ApplicableActionGenerator applicable_action_generator;  ///< Private to the worker.
+    Heuristic heuristic;                                    ///< Private to the worker.
+    SuccessorBatch successors;                              ///< Reused across expansions.
+
+    Worker(size_t num_threads, ApplicableActionGenerator applicable_action_generator, Heuristic heuristic) :
+        mailbox(),
+        openlist(),
+        search_nodes(),
+        local_indices(),
+        outgoing(num_threads),
+        applicable_action_generator(std::move(applicable_action_generator)),
+        heuristic(std::move(heuristic)),
+        successors()
+    {
+    }
+
+    /// @brief Relax the search node of the received state and (re)open it if its g-value improved.
+    void receive(const Message& message)
+    {
+        const auto [it, inserted] = local_indices.try_emplace(message.state_index, search_nodes.size());
+        if (inserted)
+        {
+            search_nodes.push_back(default_node);
+        }
+        const auto local_index = it->second;
+        auto& search_node = search_nodes[local_index];
+
+        if (message.g_value < search_node.g_value)
+        {
+            search_node.set_status((message.is_goal) ? SearchNodeStatus::GOAL : SearchNodeStatus::OPEN);
+            search_node.parent_state = message.parent_state;
+            set_parent_action(search_node, message.parent_action);
+            search_node.g_value = message.g_value;
+
+            openlist.insert(QueueEntry { message.g_value + message.h_value, message.packed_state, local_index, search_node.get_status() });
+        }
+    }
+};
+
+/// @brief Shared termination state.
+///
+/// The number of idle workers and the number of in-flight batches are packed into a single word
+/// such that a single load yields a consistent snapshot of both.
+/// A receiving worker first leaves the idle state before it acknowledges the batch,
+/// hence the word can only equal `num_threads << 32` once all work is done.
+class Termination
+{
+private:
+    static constexpr uint64_t IDLE_ONE = uint64_t(1) << 32;
+
+    std::atomic<uint64_t> m_word;
+    uint64_t m_num_threads;
+
+public:
+    explicit Termination(size_t num_threads) : m_word(0), m_num_threads(num_threads) {}
+
+    void on_send() { m_word.fetch_add(1, std::memory_order_acq_rel); }
+    void on_receive(size_t num_batches) { m_word.fetch_sub(num_batches, std::memory_order_acq_rel); }
+    void on_idle() { m_word.fetch_add(IDLE_ONE, std::memory_order_acq_rel); }
+    void on_active() { m_word.fetch_sub(IDLE_ONE, std::memory_order_acq_rel); }
+
+    bool is_terminated() const { return m_word.load(std::memory_order_acquire) == (m_num_threads << 32); }
+};
+
+/**
+ * AStar parallel
+ */
+
+/// @brief Lifted applicable action generators ground actions on the fly, which races on the problem's repositories.
+static bool is_grounded(const ApplicableActionGenerator& applicable_action_generator)
+{
+    return dynamic_cast<const GroundedApplicableActionGeneratorImpl*>(applicable_action_generator.get()) != nullptr;
+}
+
+SearchResult find_solution(const SearchContext& context, const Heuristic& heuristic, const Options& options)
+{
+    assert(heuristic);
+
+    if (options.num_threads == 0)
+    {
+        throw std::runtime_error("find_solution_astar_parallel(...): the number of threads must be positive.");
+    }
+
+    auto& problem = *context->get_problem();
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+    const auto start_unpacked_state_cache_statistics = state_repository.get_unpacked_state_cache_statistics();
+
+    const auto [start_state, start_g_value] = (options.start_state) ?
+                                                  std::make_pair(options.start_state.value(), compute_state_metric_value(options.start_state.value())) :
+                                                  state_repository.get_or_create_initial_state();
+    const auto event_handler = (options.event_handler) ? options.event_handler : astar_eager::DefaultEventHandlerImpl::create(context->get_problem());
+    const auto goal_strategy = (options.goal_strategy) ? options.goal_strategy : ProblemGoalStrategyImpl::create(context->get_problem());
+
+    const auto& ground_action_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundActionImpl> {});
+    const auto& ground_axiom_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
+
+    const auto num_threads = options.num_threads;
+
+    if (num_threads > 1)
+    {
+        if (!state_repository.get_options().thread_safe)
+        {
+            throw std::runtime_error("find_solution_astar_parallel(...): running more than one thread requires a thread-safe state repository.");
+        }
+        if (!options.create_applicable_action_generator || !options.create_heuristic)
+        {
+            throw std::runtime_error("find_solution_astar_parallel(...): running more than one thread requires factories for the applicable action "
+                                     "generators and heuristics of the additional threads.");
+        }
+        if (!is_grounded(context->get_applicable_action_generator()))
+        {
+            throw std::runtime_error("find_solution_astar_parallel(...): running more than one thread requires a grounded applicable action generator.");
+        }
+    }
+
+    auto result = SearchResult();
+
+    /* Test static goal. */
+
+    if (!goal_strategy->test_static_goal())
+    {
+        event_handler->on_unsolvable();
+
+        result.status = SearchStatus::UNSOLVABLE;
+        return result;
+    }
+
+    /* Test whether initial state is goal. */
+
+    if (goal_strategy->test_dynamic_goal(start_state))
+    {
+        report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
+        event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
+                                     state_repository.get_reached_derived_ground_atoms_bitset().count(),
+                                     state_repository.get_state_count(),
+                                     0,
+                                     ground_action_repository.size(),
+                                     ground_axiom_repository.size());
+        applicable_action_generator.on_end_search();
+        state_repository.get_axiom_evaluator()->on_end_search();
+
+        result.plan = Plan(context, StateList { start_state }, GroundActionList {}, 0);
+        result.goal_state = start_state;
+        result.status = SearchStatus::SOLVED;
+
+        event_handler->on_solved(result.plan.value());
+
+        return result;
+    }
+
+    if (std::isnan(start_g_value))
+    {
+        throw std::runtime_error("find_solution_astar_parallel(...): evaluating the metric on the start state yielded NaN.");
+    }
+    const auto start_h_value = heuristic->compute_heuristic(start_state);
+    const auto start_f_value = start_g_value + start_h_value;
+
+    event_handler->on_start_search(start_state, start_g_value, start_f_value);
+
+    /* Test whether start state is deadend. */
+
+    if (start_h_value == INFINITY_CONTINUOUS_COST)
+    {
+        event_handler->on_unsolvable();
+
+        result.status = SearchStatus::UNSOLVABLE;
+        return result;
+    }
+
+    event_handler->on_finish_f_layer(start_f_value);
+
+    /* Create the workers. */
+
+    auto workers = std::vector<std::unique_ptr<Worker>> {};
+    workers.push_back(std::make_unique<Worker>(num_threads, context->get_applicable_action_generator(), heuristic));
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        auto worker_applicable_action_generator = options.create_applicable_action_generator();
+        if (!is_grounded(worker_applicable_action_generator))
+        {
+            throw std::runtime_error("find_solution_astar_parallel(...): the applicable action generators of the additional threads must be grounded.");
+        }
+        workers.push_back(std::make_unique<Worker>(num_threads, std::move(worker_applicable_action_generator), options.create_heuristic()));
+    }
+
+    /* Distribute the start state to its owner. */
+
+    const auto get_owner = [num_threads](const PackedStateImpl& packed_state) { return loki::Hash<PackedStateImpl> {}(packed_state) % num_threads; };
+
+    workers[get_owner(*start_state.get_packed_state())]->receive(
+        Message { start_state.get_index(), MAX_INDEX, SearchNode::UNKNOWN_PARENT_ACTION, start_state.get_packed_state(), start_g_value, start_h_value, false });
+
+    /* Shared search state. */
+
+    // The event handler is the only component that is shared by the workers.
+    // Each worker locks it once per expansion to report all of its events.
+    auto event_handler_mutex = std::mutex {};
+
+    auto termination = Termination(num_threads);
+    auto stop = std::atomic<bool>(false);
+    auto stop_status = std::atomic<SearchStatus>(SearchStatus::IN_PROGRESS);
+    auto exception_mutex = std::mutex {};
+    auto exception = std::exception_ptr {};
+
+    // The incumbent is the cost of the best solution found so far. Nodes with an f-value that is not smaller are pruned.
+    // The goal state is stored in packed form because a `State` must not be copied across threads.
+    auto incumbent_mutex = std::mutex {};
+    auto incumbent = std::atomic<ContinuousCost>(INFINITY_CONTINUOUS_COST);
+    auto incumbent_packed_state = PackedState(nullptr);
+
+    auto stopwatch = StopWatch(options.max_time_in_ms);
+    stopwatch.start();
+
+    // Stop all workers and wake up those that are blocked on their mailbox.
+    const auto stop_all = [&]()
+    {
+        stop.store(true, std::memory_order_release);
+        for (auto& worker : workers)
+        {
+            termination.on_send();
+            worker->mailbox.push(MessageBatch {});
+        }
+    };
+
+    const auto request_stop = [&](SearchStatus status)
+    {
+        auto expected = SearchStatus::IN_PROGRESS;
+        stop_status.compare_exchange_strong(expected, status);
+        stop_all();
+    };
+
+    const auto run_worker = [&](size_t worker_index)
+    {
+        auto& worker = *workers[worker_index];
+
+        const auto flush = [&]()
+        {
+            for (size_t destination = 0; destination < num_threads; ++destination)
+            {
+                auto& batch = worker.outgoing[destination];
+                if (batch.empty())
+                {
+                    continue;
+                }
+                if (destination == worker_index)
+                {
+                    for (const auto& message : batch)
+                    {
+                        worker.receive(message);
+                    }
+                    batch.clear();
+                }
+                else
+                {
+                    termination.on_send();
+                    workers[destination]->mailbox.push(std::move(batch));
+                    batch = MessageBatch {};
+                }
+            }
+        };
+
+        while (!stop.load(std::memory_order_acquire))
+        {
+            /* Receive successors generated by other workers. */
+
+            const auto num_batches = worker.mailbox.drain(
+                [&](MessageBatch&& batch)
+                {
+                    for (const auto& message : batch)
+                    {
+                        worker.receive(message);
+                    }
+                });
+            if (num_batches > 0)
+            {
+                if (worker.idle)
+                {
+                    worker.idle = false;
+                    termination.on_active();
+                }
+                termination.on_receive(num_batches);
+            }
+
+            /* Discard nodes that cannot improve on the incumbent solution. */
+
+            if (!worker.openlist.empty() && worker.openlist.top_entry().f_value >= incumbent.load(std::memory_order_acquire))
+            {
+                worker.openlist.clear();
+            }
+
+            if (worker.openlist.empty())
+            {
+                if (!worker.idle)
+                {
+                    worker.idle = true;
+                    termination.on_idle();
+                }
+                if (termination.is_terminated())
+                {
+                    stop_all();
+                    break;
+                }
+                worker.mailbox.wait();
+                continue;
+            }
+
+            if (stopwatch.has_finished())
+            {
+                request_stop(SearchStatus::OUT_OF_TIME);
+                break;
+            }
+
+            const auto entry = worker.openlist.top_entry();
+            worker.openlist.pop();
+            auto& search_node = worker.search_nodes[entry.local_index];
+
+            /* Avoid unnecessary extra work by testing whether shortest distance was proven. */
+
+            if (search_node.get_status() == SearchNodeStatus::CLOSED || search_node.get_status() == SearchNodeStatus::DEAD_END)
+            {
+                continue;
+            }
+
+            /* Test whether state achieves the dynamic goal. */
+
+            if (search_node.get_status() == SearchNodeStatus::GOAL)
+            {
+                search_node.set_status(SearchNodeStatus::CLOSED);
+
+                auto lock = std::lock_guard<std::mutex>(incumbent_mutex);
+                if (search_node.g_value < incumbent.load(std::memory_order_acquire))
+                {
+                    incumbent_packed_state = entry.packed_state;
+                    incumbent.store(search_node.g_value, std::memory_order_release);
+
+                    const auto state = state_repository.get_state(*entry.packed_state);
+
+                    auto event_handler_lock = std::lock_guard<std::mutex>(event_handler_mutex);
+                    event_handler->on_expand_goal_state(state);
+                }
+                continue;
+            }
+
+            /* Expand the successors of the state. */
+
+            search_node.set_status(SearchNodeStatus::CLOSED);
+            const auto g_value = search_node.g_value;
+
+            const auto state = state_repository.get_state(*entry.packed_state);
+
+            state_repository.expand(state, g_value, *worker.applicable_action_generator, worker.successors);
+
+            for (const auto& [action, successor_state, successor_state_metric_value] : worker.successors)
+            {
+                assert(is_applicable(action, state));
+
+                if (std::isnan(successor_state_metric_value))
+                {
+                    throw std::runtime_error("find_solution_astar_parallel(...): evaluating the metric on the successor state yielded NaN.");
+                }
+
+                const auto successor_h_value = worker.heuristic->compute_heuristic(successor_state);
+
+                if (successor_h_value == INFINITY_CONTINUOUS_COST)
+                {
+                    continue;
+                }
+
+                const auto& successor_packed_state = successor_state.get_packed_state();
+
+                worker.outgoing[get_owner(*successor_packed_state)].push_back(Message { successor_state.get_index(),
+                                                                                        state.get_index(),
+                                                                                        action->get_index(),
+                                                                                        successor_packed_state,
+                                                                                        successor_state_metric_value,
+                                                                                        successor_h_value,
+                                                                                        goal_strategy->test_dynamic_goal(successor_state) });
+            }
+
+            {
+                auto event_handler_lock = std::lock_guard<std::mutex>(event_handler_mutex);
+
+                event_handler->on_expand_state(state);
+                for (const auto& [action, successor_state, successor_state_metric_value] : worker.successors)
+                {
+                    event_handler->on_generate_state(state, action, successor_state_metric_value - g_value, successor_state);
+                }
+            }
+
+            if (state_repository.get_state_count() >= options.max_num_states)
+            {
+                request_stop(SearchStatus::OUT_OF_STATES);
+                break;
+            }
+
+            flush();
+        }
+    };
+
+    {
+        auto pool = BS::thread_pool(num_threads);
+        pool.detach_sequence(size_t(0),
+                             num_threads,
+                             [&](size_t worker_index)
+                             {
+                                 try
+                                 {
+                                     run_worker(worker_index);
+                                 }
+                                 catch (...)
+                                 {
+                                     {
+                                         auto lock = std::lock_guard<std::mutex>(exception_mutex);
+                                         if (!exception)
+                                         {
+                                             exception = std::current_exception();
+                                         }
+                                     }
+                                     request_stop(SearchStatus::FAILED);
+                                 }
+                                 // States must be destroyed on the thread that created them, before its thread context is released.
+                                 workers[worker_index]->successors.clear();
+                                 state_repository.release_thread_context();
+                             });
+        pool.wait();
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+
+    if (stop_status.load() != SearchStatus::IN_PROGRESS)
+    {
+        result.status = stop_status.load();
+        return result;
+    }
+
+    auto num_search_nodes = size_t(0);
+    for (const auto& worker : workers)
+    {
+        num_search_nodes += worker->search_nodes.size();
+    }
+
+    report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
+    event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
+                                 state_repository.get_reached_derived_ground_atoms_bitset().count(),
+                                 state_repository.get_state_count(),
+                                 num_search_nodes,
+                                 ground_action_repository.size(),
+                                 ground_axiom_repository.size());
+
+    if (!incumbent_packed_state)
+    {
+        event_handler->on_exhausted();
+
+        result.status = SearchStatus::EXHAUSTED;
+        return result;
+    }
+
+    applicable_action_generator.on_end_search();
+    state_repository.get_axiom_evaluator()->on_end_search();
+
+    /* Merge the shards into a single search space indexed by state, and extract the plan from it. */
+
+    auto search_nodes = SearchNodeVector();
+    while (search_nodes.size() < state_repository.get_state_count())
+    {
+        search_nodes.push_back(default_node);
+    }
+    for (const auto& worker : workers)
+    {
+        for (const auto& [state_index, local_index] : worker->local_indices)
+        {
+            search_nodes[state_index] = worker->search_nodes[local_index];
+        }
+    }
+
+    const auto goal_state = state_repository.get_state(*incumbent_packed_state);
+    const auto& goal_search_node = search_nodes[goal_state.get_index()];
+
+    result.plan = extract_total_ordered_plan(start_state, start_g_value, goal_search_node, goal_state.get_index(), search_nodes, context);
+    // A node on the path to the goal can still be improved by a message that was in flight when the goal became the incumbent,
+    // which rewires the path to a cheaper prefix. The plan reports the cost of the extracted path.
+    assert(result.plan->get_cost() <= goal_search_node.g_value);
+    result.goal_state = goal_state;
+    result.status = SearchStatus::SOLVED;
+
+    event_handler->on_solved(result.plan.value());
+
+    return result;
+}
+}
@@ -0,0 +1,471 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/bfws.hpp"
+
+#include "mimir/common/segmented_vector.hpp"
+#include "mimir/common/timers.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/ground_effects.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/bfws/event_handlers.hpp"
+#include "mimir/search/algorithms/iw/novelty_table.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/algorithms/strategies/pruning_strategy.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/axiom_evaluators/interface.hpp"
+#include "mimir/search/heuristics/ff.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/search_node.hpp"
+#include "mimir/search/search_space.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <algorithm>
+#include <deque>
+#include <string>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::bfws
+{
+
+/**
+ * BFWS search node
+ */
+
+struct SearchNode
+{
+    static constexpr Index UNKNOWN_PARENT_ACTION = get_unknown_parent_action<29>();
+
+    ContinuousCost g_value;
+    Index parent_state;
+    Index parent_action : 29;
+    Index status : 3;
+    Index num_unsatisfied_goals;
+    Index relaxed_plan;  ///< Index of the atoms added by the relaxed plan that #r counts.
+
+    SearchNodeStatus get_status() const { return static_cast<SearchNodeStatus>(status); }
+    void set_status(SearchNodeStatus value) { status = value; }
+};
+
+static_assert(sizeof(SearchNode) == 24);
+
+using SearchNodeVector = SegmentedVector<SearchNode>;
+
+static constexpr auto DEFAULT_SEARCH_NODE =
+    SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNode::UNKNOWN_PARENT_ACTION, SearchNodeStatus::NEW, MAX_INDEX, MAX_INDEX };
+
+static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVector& search_nodes)
+{
+    while (state_index >= search_nodes.size())
+    {
+        search_nodes.push_back(DEFAULT_SEARCH_NODE);
+    }
+    return search_nodes[state_index];
+}
+
+/**
+ * BFWS queue entry
+ */
+
+struct QueueEntry
+{
+    using KeyType = std::tuple<Index, Index, Index>;
+    using ItemType = PackedState;
+
+    PackedState packed_state;
+    Index novelty;
+    Index num_unsatisfied_goals;
+    Index step;
+
+    /// @brief Order by novelty, then by #g, and break ties by insertion order.
+    KeyType get_key() const { return std::make_tuple(novelty, num_unsatisfied_goals, step); }
+    ItemType get_item() const { return packed_state; }
+};
+
+static_assert(sizeof(QueueEntry) == 24);
+
+using Queue = PriorityQueue<QueueEntry>;
+
+/**
+ * Partitions
+ */
+
+/// @brief `Partitions` maps each (#g, #r) pair to novelty tables of arity 1 to `max_arity`.
+///
+/// The tables are stored in a deque because they must not be moved.
+class Partitions
+{
+private:
+    size_t m_max_arity;
+
+    absl::flat_hash_map<std::pair<Index, Index>, Index> m_partition_indices;
+    std::deque<iw::DynamicNoveltyTable> m_novelty_tables;
+
+public:
+    explicit Partitions(size_t max_arity) : m_max_arity(max_arity), m_partition_indices(), m_novelty_tables() {}
+
+    /// @brief Compute the novelty of the state in its partition and insert its tuples.
+    /// @return the size of the smallest novel tuple, or `max_arity + 1` if there is none.
+    Index test_novelty_and_update_tables(const State& state, Index num_unsatisfied_goals, Index num_relaxed_plan_atoms)
+    {
+        const auto [it, inserted] = m_partition_indices.emplace(std::make_pair(num_unsatisfied_goals, num_relaxed_plan_atoms), m_partition_indices.size());
+        if (inserted)
+        {
+            for (size_t arity = 1; arity <= m_max_arity; ++arity)
+            {
+                m_novelty_tables.emplace_back(arity);
+            }
+        }
+
+        // Every table must be updated, also if a smaller tuple is already novel.
+        auto novelty = static_cast<Index>(m_max_arity + 1);
+        for (size_t arity = 1; arity <= m_max_arity; ++arity)
+        {
+            if (m_novelty_tables[it->second * m_max_arity + arity - 1].test_novelty_and_update_table(state))
+            {
+                novelty = std::min(novelty, static_cast<Index>(arity));
+            }
+        }
+        return novelty;
+    }
+
+    size_t size() const { return m_partition_indices.size(); }
+
+    size_t get_estimated_memory_usage_in_bytes() const
+    {
+        auto result = m_partition_indices.capacity() * (sizeof(std::pair<Index, Index>) + sizeof(Index) + 1);
+        for (const auto& novelty_table : m_novelty_tables)
+        {
+            result += novelty_table.get_estimated_memory_usage_in_bytes();
+        }
+        return result;
+    }
+};
+
+static Index count_unsatisfied_goals(const ProblemImpl& problem, const State& state)
+{
+    const auto& goal_condition = *problem.get_goal_condition();
+
+    auto num_unsatisfied_goals = Index(0);
+    num_unsatisfied_goals += count_set_difference(goal_condition.get_precondition<PositiveTag, FluentTag>(), state.get_atoms<FluentTag>());
+    num_unsatisfied_goals += count_set_difference(goal_condition.get_precondition<PositiveTag, DerivedTag>(), state.get_atoms<DerivedTag>());
+    num_unsatisfied_goals += count_set_intersection(goal_condition.get_precondition<NegativeTag, FluentTag>(), state.get_atoms<FluentTag>());
+    num_unsatisfied_goals += count_set_intersection(goal_condition.get_precondition<NegativeTag, DerivedTag>(), state.get_atoms<DerivedTag>());
+    return num_unsatisfied_goals;
+}
+
+/**
+ * BFWS
+ */
+
+SearchResult find_solution(const SearchContext& context, const FFHeuristic& heuristic, const Options& options)
+{
+    assert(heuristic);
+
+    auto& problem = *context->get_problem();
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    const auto [start_state, start_g_value] = (options.start_state) ?
+                                                  std::make_pair(options.start_state.value(), compute_state_metric_value(options.start_state.value())) :
+                                                  state_repository.get_or_create_initial_state();
+    const auto event_handler = (options.event_handler) ? options.event_handler : DefaultEventHandlerImpl::create(context->get_problem());
+    const auto goal_strategy = (options.goal_strategy) ? options.goal_strategy : ProblemGoalStrategyImpl::create(context->get_problem());
+    const auto pruning_strategy = (options.pruning_strategy) ? options.pruning_strategy : NoPruningStrategyImpl::create();
+
+    if (options.max_arity == 0 || options.max_arity > MAX_ARITY)
+    {
+        throw std::runtime_error("bfws::find_solution(...): max_arity (" + std::to_string(options.max_arity) + ") must be between 1 and MAX_ARITY ("
+                                 + std::to_string(MAX_ARITY) + ").");
+    }
+
+    auto step = Index(0);
+
+    auto result = SearchResult();
+
+    /* Test static goal. */
+
+    if (!goal_strategy->test_static_goal())
+    {
+        event_handler->on_unsolvable();
+
+        result.status = SearchStatus::UNSOLVABLE;
+        return result;
+    }
+
+    auto search_nodes = SearchNodeVector();
+    auto partitions = Partitions(options.max_arity);
+    auto relaxed_plans = std::vector<IndexList> {};
+
+    auto end_search = [&]()
+    {
+        event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
+                                     state_repository.get_reached_derived_ground_atoms_bitset().count(),
+                                     state_repository.get_state_count(),
+                                     search_nodes.size(),
+                                     partitions.size(),
+                                     partitions.get_estimated_memory_usage_in_bytes());
+        applicable_action_generator.on_end_search();
+        state_repository.get_axiom_evaluator()->on_end_search();
+    };
+
+    /* Test whether initial state is goal. */
+
+    if (goal_strategy->test_dynamic_goal(start_state))
+    {
+        end_search();
+
+        result.plan = Plan(context, StateList { start_state }, GroundActionList {}, 0);
+        result.goal_state = start_state;
+        result.status = SearchStatus::SOLVED;
+
+        event_handler->on_solved(result.plan.value());
+
+        return result;
+    }
+
+    if (std::isnan(start_g_value))
+    {
+        throw std::runtime_error("bfws::find_solution(...): evaluating the metric on the start state yielded NaN.");
+    }
+
+    // Store the atoms that the relaxed plan of the state adds and that are false in the state, and return their index, or MAX_INDEX for a dead end.
+    auto compute_relaxed_plan = [&](const State& state)
+    {
+        const auto h_value = heuristic->compute_heuristic(state);
+        event_handler->on_compute_relaxed_plan(state, h_value);
+        if (h_value == INFINITY_CONTINUOUS_COST)
+        {
+            return MAX_INDEX;
+        }
+
+        const auto& fluent_atoms = state.get_atoms<FluentTag>();
+        auto atoms = IndexList {};
+        for (const auto& action : heuristic->get_relaxed_plan())
+        {
+            for (const auto& effect : action->get_conditional_effects())
+            {
+                for (const auto atom : effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+                {
+                    if (!fluent_atoms.get(atom))
+                    {
+                        atoms.push_back(atom);
+                    }
+                }
+            }
+        }
+        std::sort(atoms.begin(), atoms.end());
+        atoms.erase(std::unique(atoms.begin(), atoms.end()), atoms.end());
+
+        relaxed_plans.push_back(std::move(atoms));
+        return static_cast<Index>(relaxed_plans.size() - 1);
+    };
+
+    const auto start_num_unsatisfied_goals = count_unsatisfied_goals(problem, start_state);
+    auto best_num_unsatisfied_goals = start_num_unsatisfied_goals;
+
+    event_handler->on_start_search(start_state, start_g_value, start_num_unsatisfied_goals);
+
+    auto& start_search_node = get_or_create_search_node(start_state.get_index(), search_nodes);
+    start_search_node.g_value = start_g_value;
+    start_search_node.num_unsatisfied_goals = start_num_unsatisfied_goals;
+    start_search_node.relaxed_plan = compute_relaxed_plan(start_state);
+    start_search_node.set_status((start_search_node.relaxed_plan == MAX_INDEX) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN);
+
+    /* Test whether start state is deadend. */
+
+    if (start_search_node.get_status() == SearchNodeStatus::DEAD_END)
+    {
+        event_handler->on_dead_end_state(start_state);
+        event_handler->on_unsolvable();
+
+        result.status = SearchStatus::UNSOLVABLE;
+        return result;
+    }
+
+    /* Test pruning of start state. */
+
+    if (pruning_strategy->test_prune_initial_state(start_state))
+    {
+        result.status = SearchStatus::FAILED;
+        return result;
+    }
+
+    auto openlist = Queue();
+    const auto start_novelty = partitions.test_novelty_and_update_tables(start_state, start_num_unsatisfied_goals, 0);
+    openlist.insert(QueueEntry { start_state.get_packed_state(), start_novelty, start_num_unsatisfied_goals, step++ });
+
+    auto stopwatch = StopWatch(options.max_time_in_ms);
+    stopwatch.start();
+
+    auto memory_limit = MemoryLimit(options.max_memory_in_bytes);
+    auto get_num_bytes_for_search = [&]()
+    {
+        auto num_bytes_for_relaxed_plans = relaxed_plans.capacity() * sizeof(IndexList);
+        for (const auto& atoms : relaxed_plans)
+        {
+            num_bytes_for_relaxed_plans += atoms.capacity() * sizeof(Index);
+        }
+        return search_nodes.capacity() * sizeof(SearchNode) + openlist.get_estimated_memory_usage_in_bytes() + partitions.get_estimated_memory_usage_in_bytes()
+               + num_bytes_for_relaxed_plans;
+    };
+
+    auto successors = SuccessorBatch();
+
+    while (!openlist.empty())
+    {
+        if (stopwatch.has_finished())
+        {
+            result.status = SearchStatus::OUT_OF_TIME;
+            return result;
+        }
+
+        if (memory_limit.has_exceeded(*context, get_num_bytes_for_search))
+        {
+            end_search();
+
+            result.status = SearchStatus::OUT_OF_MEMORY;
+            return result;
+        }
+
+        const auto state = state_repository.get_state(*openlist.top());
+        openlist.pop();
+        auto& search_node = get_or_create_search_node(state.get_index(), search_nodes);
+
+        /* Close state. */
+
+        if (search_node.get_status() == SearchNodeStatus::CLOSED)
+        {
+            continue;
+        }
+
+        /* Expand the successors of the state. */
+
+        event_handler->on_expand_state(state);
+
+        search_node.set_status(SearchNodeStatus::CLOSED);
+
+        const auto g_value = search_node.g_value;
+        const auto num_unsatisfied_goals = search_node.num_unsatisfied_goals;
+        const auto relaxed_plan = search_node.relaxed_plan;
+
+        state_repository.expand(state, g_value, applicable_action_generator, successors);
+
+        for (const auto& [action, successor_state, successor_state_metric_value] : successors)
+        {
+            auto& successor_search_node = get_or_create_search_node(successor_state.get_index(), search_nodes);
+            const auto action_cost = successor_state_metric_value - g_value;
+
+            if (std::isnan(successor_state_metric_value))
+            {
+                throw std::runtime_error("bfws::find_solution(...): evaluating the metric on the successor state yielded NaN.");
+            }
+
+            const bool is_new_successor_state = (successor_search_node.get_status() == SearchNodeStatus::NEW);
+
+            if (is_new_successor_state && search_nodes.size() >= options.max_num_states)
+            {
+                result.status = SearchStatus::OUT_OF_STATES;
+                return result;
+            }
+
+            /* Skip previously generated state. */
+
+            if (!is_new_successor_state)
+            {
+                continue;
+            }
+
+            /* Customization point 1: pruning strategy, default never prunes. */
+
+            if (pruning_strategy->test_prune_successor_state(state, successor_state, is_new_successor_state))
+            {
+                event_handler->on_prune_state(successor_state);
+                continue;
+            }
+
+            /* Open state. */
+
+            successor_search_node.set_status(SearchNodeStatus::OPEN);
+            successor_search_node.parent_state = state.get_index();
+            set_parent_action(successor_search_node, action->get_index());
+            successor_search_node.g_value = successor_state_metric_value;
+
+            /* Early goal test. */
+
+            if (goal_strategy->test_dynamic_goal(successor_state))
+            {
+                successor_search_node.set_status(SearchNodeStatus::GOAL);
+
+                event_handler->on_expand_goal_state(state);
+
+                end_search();
+
+                result.plan = extract_total_ordered_plan(start_state, start_g_value, successor_search_node, successor_state.get_index(), search_nodes, context);
+                result.goal_state = successor_state;
+                result.status = SearchStatus::SOLVED;
+
+                event_handler->on_solved(result.plan.value());
+
+                return result;
+            }
+
+            /* Compute #g, and a new relaxed plan if #g decreased. */
+
+            const auto successor_num_unsatisfied_goals = count_unsatisfied_goals(problem, successor_state);
+            successor_search_node.num_unsatisfied_goals = successor_num_unsatisfied_goals;
+            successor_search_node.relaxed_plan =
+                (successor_num_unsatisfied_goals < num_unsatisfied_goals) ? compute_relaxed_plan(successor_state) : relaxed_plan;
+
+            if (successor_search_node.relaxed_plan == MAX_INDEX)
+            {
+                successor_search_node.set_status(SearchNodeStatus::DEAD_END);
+                event_handler->on_dead_end_state(successor_state);
+                continue;
+            }
+
+            if (successor_num_unsatisfied_goals < best_num_unsatisfied_goals)
+            {
+                best_num_unsatisfied_goals = successor_num_unsatisfied_goals;
+                event_handler->on_new_best_num_unsatisfied_goals(best_num_unsatisfied_goals);
+            }
+
+            /* Compute the novelty in the (#g, #r) partition. */
+
+            const auto num_relaxed_plan_atoms =
+                static_cast<Index>(count_set_intersection(relaxed_plans[successor_search_node.relaxed_plan], successor_state.get_atoms<FluentTag>()));
+            const auto successor_novelty =
+                partitions.test_novelty_and_update_tables(successor_state, successor_num_unsatisfied_goals, num_relaxed_plan_atoms);
+
+            event_handler->on_generate_state(state, action, action_cost, successor_state, successor_novelty);
+
+            openlist.insert(QueueEntry { successor_state.get_packed_state(), successor_novelty, successor_num_unsatisfied_goals, step++ });
+        }
+    }
+
+    end_search();
+    event_handler->on_exhausted();
+
+    result.status = SearchStatus::EXHAUSTED;
+    return result;
+}
+}
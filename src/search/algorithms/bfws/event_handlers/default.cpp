@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/bfws/event_handlers/default.hpp"
+
+#include "mimir/common/formatter.hpp"
+#include "mimir/formalism/formatter.hpp"
+#include "mimir/search/formatter.hpp"
+#include "mimir/search/plan.hpp"
+
+#include <iostream>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::bfws
+{
+void DefaultEventHandlerImpl::on_expand_state_impl(const State& state) const {}
+
+void DefaultEventHandlerImpl::on_expand_goal_state_impl(const State& state) const {}
+
+void DefaultEventHandlerImpl::on_generate_state_impl(const State& state,
+                                                     GroundAction action,
+                                                     ContinuousCost action_cost,
+                                                     const State& successor_state,
+                                                     size_t novelty) const
+{
+}
+
+void DefaultEventHandlerImpl::on_prune_state_impl(const State& state) const {}
+
+void DefaultEventHandlerImpl::on_dead_end_state_impl(const State& state) const {}
+
+void DefaultEventHandlerImpl::on_start_search_impl(const State& start_state, ContinuousCost g_value, size_t num_unsatisfied_goals) const
+{
+    std::cout << "[BFWS] Search started.\n"
+              << "[BFWS] Initial g_value: " << g_value << "\n"
+              << "[BFWS] Initial number of unsatisfied goals: " << num_unsatisfied_goals << std::endl;
+}
+
+void DefaultEventHandlerImpl::on_new_best_num_unsatisfied_goals_impl(size_t num_unsatisfied_goals,
+                                                                     uint64_t num_expanded_states,
+                                                                     uint64_t num_generated_states) const
+{
+    std::cout << "[BFWS] New best number of unsatisfied goals: " << num_unsatisfied_goals << " with num expanded states " << num_expanded_states
+              << " and num generated states " << num_generated_states << " (" << get_statistics().get_current_search_time_ms().count() << " ms)"
+              << std::endl;
+}
+
+void DefaultEventHandlerImpl::on_end_search_impl() const { std::cout << "[BFWS] Search ended.\n" << m_statistics << std::endl; }
+
+void DefaultEventHandlerImpl::on_solved_impl(const Plan& plan) const
+{
+    std::cout << "[BFWS] Plan found.\n"
+              << "[BFWS] Plan cost: " << plan.get_cost() << "\n"
+              << "[BFWS] Plan length: " << plan.get_actions().size() << std::endl;
+    for (size_t i = 0; i < plan.get_actions().size(); ++i)
+    {
+        std::cout << "[BFWS] " << i << ". ";
+        mimir::print(std::cout, std::make_tuple(std::cref(*plan.get_actions()[i]), std::cref(*m_problem), PlanFormatterTag {}));
+        std::cout << std::endl;
+    }
+}
+
+void DefaultEventHandlerImpl::on_unsolvable_impl() const { std::cout << "[BFWS] Unsolvable!" << std::endl; }
+
+void DefaultEventHandlerImpl::on_exhausted_impl() const { std::cout << "[BFWS] Exhausted!" << std::endl; }
+
+DefaultEventHandlerImpl::DefaultEventHandlerImpl(formalism::Problem problem, bool quiet) : EventHandlerBase<DefaultEventHandlerImpl>(problem, quiet) {}
+
+DefaultEventHandler DefaultEventHandlerImpl::create(formalism::Problem problem, bool quiet)
+{
+    return std::make_shared<DefaultEventHandlerImpl>(problem, quiet);
+}
+}
@@ -17,6 +17,7 @@
 
 #include "mimir/search/algorithms/brfs.hpp"
 
+#include "mimir/algorithms/bloom_filter.hpp"
 #include "mimir/common/segmented_vector.hpp"
 #include "mimir/common/timers.hpp"
 #include "mimir/formalism/problem.hpp"
@@ -31,7 +32,9 @@
 #include "mimir/search/search_node.hpp"
 #include "mimir/search/search_space.hpp"
 #include "mimir/search/state_repository.hpp"
+#include "state_records.hpp"
 
+#include <algorithm>
 #include <deque>
 
 using namespace mimir::formalism;
@@ -45,16 +48,21 @@ namespace mimir::search::brfs
 
 struct SearchNode
 {
+    static constexpr Index UNKNOWN_PARENT_ACTION = get_unknown_parent_action<32>();
+
     DiscreteCost g_value;
     Index parent_state;
+    Index parent_action;
     SearchNodeStatus status;
 };
 
+static_assert(sizeof(SearchNode) == 16);
+
 using SearchNodeVector = SegmentedVector<SearchNode>;
 
 static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVector& search_nodes)
 {
-    static constexpr auto default_node = SearchNode { DiscreteCost(0), std::numeric_limits<Index>::max(), SearchNodeStatus::NEW };
+    static constexpr auto default_node = SearchNode { DiscreteCost(0), std::numeric_limits<Index>::max(), SearchNode::UNKNOWN_PARENT_ACTION, SearchNodeStatus::NEW };
 
     while (state_index >= search_nodes.size())
     {
@@ -63,6 +71,220 @@ static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVecto
     return search_nodes[state_index];
 }
 
+/**
+ * Bitstate BrFS
+ */
+
+/// @brief The parent of a state in the previous layer and the index of the ground action that generated it.
+struct TraceEntry
+{
+    uint32_t parent;
+    Index action;
+};
+
+static_assert(sizeof(TraceEntry) == 8);
+
+using TraceEntryList = std::vector<TraceEntry>;
+
+/// @brief Replay the actions of the trace that ends at the state with the given position in the last layer.
+static Plan extract_bitstate_plan(const std::vector<TraceEntryList>& traces,
+                                  uint32_t final_position,
+                                  State start_state,
+                                  ContinuousCost start_state_metric_value,
+                                  const SearchContext& context)
+{
+    const auto& ground_action_repository =
+        boost::hana::at_key(context->get_problem()->get_repositories().get_hana_repositories(), boost::hana::type<GroundActionImpl> {});
+
+    auto actions = GroundActionList {};
+    auto position = final_position;
+    for (size_t layer = traces.size() - 1; layer > 0; --layer)
+    {
+        const auto& entry = traces[layer].at(position);
+        actions.push_back(ground_action_repository.at(entry.action));
+        position = entry.parent;
+    }
+    std::reverse(actions.begin(), actions.end());
+
+    auto states = StateList { start_state };
+    auto state_metric_value = start_state_metric_value;
+    for (const auto& action : actions)
+    {
+        const auto [successor_state, successor_state_metric_value] =
+            context->get_state_repository()->get_or_create_successor_state(states.back(), action, state_metric_value);
+        states.push_back(successor_state);
+        state_metric_value = successor_state_metric_value;
+    }
+
+    return Plan(context, std::move(states), std::move(actions), state_metric_value);
+}
+
+static SearchResult find_solution_bitstate(const SearchContext& context,
+                                           const Options& options,
+                                           const State& start_state,
+                                           ContinuousCost start_state_metric_value,
+                                           const EventHandler& event_handler,
+                                           const GoalStrategy& goal_strategy)
+{
+    const auto& problem = *context->get_problem();
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    auto result = SearchResult();
+
+    event_handler->on_start_search(start_state);
+
+    if (!goal_strategy->test_static_goal())
+    {
+        event_handler->on_unsolvable();
+
+        result.status = SearchStatus::UNSOLVABLE;
+        return result;
+    }
+
+    const auto& ground_action_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundActionImpl> {});
+    const auto& ground_axiom_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
+
+    auto closed_list = BloomFilter(options.bitstate_num_bits, options.bitstate_num_hash_functions);
+    auto materializer = StateMaterializer(context, options.bitstate_max_num_states_in_memory);
+    auto layer = std::vector<uint32_t> {};
+    auto next_layer = std::vector<uint32_t> {};
+    auto traces = std::vector<TraceEntryList> {};
+    auto successors = SuccessorBatch();
+
+    append_record(start_state, layer);
+    closed_list.insert(get_record_hash(RecordView(layer.data(), layer.size())));
+    traces.push_back(TraceEntryList { TraceEntry { std::numeric_limits<uint32_t>::max(), SearchNode::UNKNOWN_PARENT_ACTION } });
+
+    auto end_search = [&]()
+    {
+        event_handler->on_end_search(materializer.get_reached_fluent_ground_atoms_bitset().count(),
+                                     materializer.get_reached_derived_ground_atoms_bitset().count(),
+                                     closed_list.get_num_elements(),
+                                     closed_list.get_num_elements(),
+                                     ground_action_repository.size(),
+                                     ground_axiom_repository.size());
+        event_handler->on_end_bitstate_search(closed_list.get_num_bits(), closed_list.get_num_set_bits(), closed_list.get_estimated_omission_probability());
+        applicable_action_generator.on_end_search();
+        state_repository.get_axiom_evaluator()->on_end_search();
+    };
+
+    auto g_value = DiscreteCost(0);
+
+    event_handler->on_finish_g_layer(g_value);
+
+    auto stopwatch = StopWatch(options.max_time_in_ms);
+    stopwatch.start();
+
+    auto memory_limit = MemoryLimit(options.max_memory_in_bytes);
+    auto get_num_bytes_for_search = [&]()
+    {
+        auto num_bytes = closed_list.get_estimated_memory_usage_in_bytes() + (layer.capacity() + next_layer.capacity()) * sizeof(uint32_t);
+        for (const auto& trace : traces)
+        {
+            num_bytes += trace.capacity() * sizeof(TraceEntry);
+        }
+        return num_bytes;
+    };
+
+    while (!layer.empty())
+    {
+        auto next_trace = TraceEntryList {};
+
+        for (size_t pos = 0, position = 0; pos < layer.size(); pos += get_record_size(layer.data() + pos), ++position)
+        {
+            if (stopwatch.has_finished())
+            {
+                result.status = SearchStatus::OUT_OF_TIME;
+                return result;
+            }
+
+            if (memory_limit.has_exceeded(*context, get_num_bytes_for_search))
+            {
+                end_search();
+
+                result.status = SearchStatus::OUT_OF_MEMORY;
+                return result;
+            }
+
+            if (materializer.is_full())
+            {
+                materializer.reset();
+            }
+
+            const auto [state, state_metric_value] = materializer.get_or_create_state(RecordView(layer.data() + pos, get_record_size(layer.data() + pos)));
+
+            if (goal_strategy->test_dynamic_goal(state))
+            {
+                event_handler->on_expand_goal_state(state);
+
+                if (options.stop_if_goal)
+                {
+                    end_search();
+
+                    result.plan = extract_bitstate_plan(traces, position, start_state, start_state_metric_value, context);
+                    result.goal_state = result.plan.value().get_states().back();
+                    result.status = SearchStatus::SOLVED;
+
+                    event_handler->on_solved(result.plan.value());
+
+                    return result;
+                }
+            }
+
+            event_handler->on_expand_state(state);
+
+            auto& materialized_state_repository = materializer.get_state_repository();
+
+            materialized_state_repository.expand(state, state_metric_value, applicable_action_generator, successors);
+
+            for (const auto& [action, successor_state, successor_state_metric_value] : successors)
+            {
+                const auto action_cost = successor_state_metric_value - state_metric_value;
+
+                event_handler->on_generate_state(state, action, action_cost, successor_state);
+
+                // The record is written to the next layer first and hashed there, which avoids a separate buffer.
+                const auto record_pos = next_layer.size();
+                append_record(successor_state, next_layer);
+                if (!closed_list.insert(get_record_hash(RecordView(next_layer.data() + record_pos, next_layer.size() - record_pos))))
+                {
+                    next_layer.resize(record_pos);
+                    event_handler->on_generate_state_not_in_search_tree(state, action, action_cost, successor_state);
+                    continue;
+                }
+                event_handler->on_generate_state_in_search_tree(state, action, action_cost, successor_state);
+
+                next_trace.push_back(TraceEntry { static_cast<uint32_t>(position), action->get_index() });
+
+                if (closed_list.get_num_elements() >= options.max_num_states)
+                {
+                    result.status = SearchStatus::OUT_OF_STATES;
+                    return result;
+                }
+            }
+        }
+
+        layer.swap(next_layer);
+        next_layer.clear();
+        traces.push_back(std::move(next_trace));
+
+        if (!layer.empty())
+        {
+            applicable_action_generator.on_finish_search_layer();
+            state_repository.get_axiom_evaluator()->on_finish_search_layer();
+            event_handler->on_finish_g_layer(g_value);
+            ++g_value;
+        }
+    }
+
+    end_search();
+    event_handler->on_exhausted();
+
+    result.status = SearchStatus::EXHAUSTED;
+    return result;
+}
+
 /**
  * BrFS
  */
@@ -80,6 +302,11 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
     const auto goal_strategy = (options.goal_strategy) ? options.goal_strategy : ProblemGoalStrategyImpl::create(context->get_problem());
     const auto pruning_strategy = (options.pruning_strategy) ? options.pruning_strategy : DuplicatePruningStrategyImpl::create();
 
+    if (options.bitstate_num_bits > 0)
+    {
+        return find_solution_bitstate(context, options, start_state, start_g_value, event_handler, goal_strategy);
+    }
+
     auto result = SearchResult();
     auto search_nodes = SearchNodeVector();
     auto queue = std::deque<PackedState>();
@@ -101,7 +328,7 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
     const auto& ground_action_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundActionImpl> {});
     const auto& ground_axiom_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
 
-    auto applicable_actions = GroundActionList {};
+    auto successors = SuccessorBatch();
 
     if (pruning_strategy->test_prune_initial_state(start_state))
     {
@@ -118,6 +345,9 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
     auto stopwatch = StopWatch(options.max_time_in_ms);
     stopwatch.start();
 
+    auto memory_limit = MemoryLimit(options.max_memory_in_bytes);
+    auto get_num_bytes_for_search = [&]() { return search_nodes.capacity() * sizeof(SearchNode) + queue.size() * sizeof(PackedState); };
+
     while (!queue.empty())
     {
         if (stopwatch.has_finished())
@@ -126,6 +356,21 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
             return result;
         }
 
+        if (memory_limit.has_exceeded(*context, get_num_bytes_for_search))
+        {
+            event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
+                                         state_repository.get_reached_derived_ground_atoms_bitset().count(),
+                                         state_repository.get_state_count(),
+                                         search_nodes.size(),
+                                         ground_action_repository.size(),
+                                         ground_axiom_repository.size());
+            applicable_action_generator.on_end_search();
+            state_repository.get_axiom_evaluator()->on_end_search();
+
+            result.status = SearchStatus::OUT_OF_MEMORY;
+            return result;
+        }
+
         const auto state = state_repository.get_state(*queue.front());
         queue.pop_front();
 
@@ -180,10 +425,11 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
 
         search_node.status = SearchNodeStatus::CLOSED;
 
-        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        state_repository.expand(state, search_node.g_value, applicable_action_generator, successors);
+
+        for (const auto& [action, successor_state, successor_state_metric_value] : successors)
         {
             /* Open state. */
-            const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, search_node.g_value);
             auto& successor_search_node = get_or_create_search_node(successor_state.get_index(), search_nodes);
             auto action_cost = successor_state_metric_value - search_node.g_value;
 
@@ -197,6 +443,7 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
 
             successor_search_node.status = SearchNodeStatus::OPEN;
             successor_search_node.parent_state = state.get_index();
+            set_parent_action(successor_search_node, action->get_index());
             successor_search_node.g_value = search_node.g_value + 1;
 
             queue.emplace_back(successor_state.get_packed_state());
@@ -83,6 +83,13 @@ void DebugEventHandlerImpl::on_end_search_impl(uint64_t num_reached_fluent_atoms
     std::cout << "[BrFS] Search ended.\n" << m_statistics << std::endl;
 }
 
+void DebugEventHandlerImpl::on_end_bitstate_search_impl(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) const
+{
+    std::cout << "[BrFS] Number of bitstate bits: " << num_bits << "\n"
+              << "[BrFS] Number of set bitstate bits: " << num_set_bits << "\n"
+              << "[BrFS] Estimated omission probability: " << estimated_omission_probability << std::endl;
+}
+
 void DebugEventHandlerImpl::on_solved_impl(const Plan& plan) const
 {
     std::cout << "[BrFS] Plan found.\n"
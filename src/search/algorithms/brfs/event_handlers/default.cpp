@@ -69,6 +69,13 @@ void DefaultEventHandlerImpl::on_end_search_impl(uint64_t num_reached_fluent_ato
     std::cout << "[BrFS] Search ended.\n" << m_statistics << std::endl;
 }
 
+void DefaultEventHandlerImpl::on_end_bitstate_search_impl(uint64_t num_bits, uint64_t num_set_bits, double estimated_omission_probability) const
+{
+    std::cout << "[BrFS] Number of bitstate bits: " << num_bits << "\n"
+              << "[BrFS] Number of set bitstate bits: " << num_set_bits << "\n"
+              << "[BrFS] Estimated omission probability: " << estimated_omission_probability << std::endl;
+}
+
 void DefaultEventHandlerImpl::on_solved_impl(const Plan& plan) const
 {
     std::cout << "[BrFS] Plan found.\n"
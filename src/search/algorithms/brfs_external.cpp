@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/brfs_external.hpp"
+
+#include "cista/containers/mmap_vec.h"
+#include "cista/mmap.h"
+#include "mimir/common/timers.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/algorithms/brfs/event_handlers.hpp"
+#include "mimir/search/algorithms/brfs/event_handlers/interface.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/axiom_evaluators/interface.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "state_records.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::brfs_external
+{
+
+/**
+ * Layer files
+ */
+
+/// @brief A directory with a unique name that is removed with all its files on destruction.
+class WorkingDirectory
+{
+private:
+    fs::path m_path;
+
+public:
+    explicit WorkingDirectory(const fs::path& parent)
+    {
+        const auto base = parent.empty() ? fs::temp_directory_path() : parent;
+        fs::create_directories(base);
+
+        auto random_device = std::random_device();
+        do
+        {
+            m_path = base / ("mimir_brfs_external_" + std::to_string(random_device()));
+        } while (!fs::create_directory(m_path));
+    }
+
+    ~WorkingDirectory()
+    {
+        auto error = std::error_code();
+        fs::remove_all(m_path, error);
+    }
+
+    WorkingDirectory(const WorkingDirectory& other) = delete;
+    WorkingDirectory& operator=(const WorkingDirectory& other) = delete;
+
+    const fs::path& get_path() const { return m_path; }
+};
+
+/// @brief Sequentially reads the records of a file.
+class RecordReader
+{
+private:
+    cista::mmap m_mmap;
+    const uint32_t* m_words;
+    size_t m_num_words;
+    size_t m_pos;
+
+public:
+    explicit RecordReader(const fs::path& path) :
+        m_mmap(path.string().c_str(), cista::mmap::protection::READ),
+        m_words(reinterpret_cast<const uint32_t*>(m_mmap.data())),
+        m_num_words(m_mmap.size() / sizeof(uint32_t)),
+        m_pos(0)
+    {
+    }
+
+    bool has_record() const { return m_pos < m_num_words; }
+
+    RecordView get_record() const
+    {
+        assert(has_record());
+        return RecordView(m_words + m_pos, get_record_size(m_words + m_pos));
+    }
+
+    void next() { m_pos += get_record_size(m_words + m_pos); }
+};
+
+/// @brief Appends records to a file. The file is truncated to its content on destruction.
+class RecordWriter
+{
+private:
+    cista::basic_mmap_vec<uint32_t, uint64_t> m_words;
+
+public:
+    explicit RecordWriter(const fs::path& path) : m_words(cista::mmap(path.string().c_str(), cista::mmap::protection::WRITE)) {}
+
+    void append(RecordView record)
+    {
+        for (const auto word : record)
+        {
+            m_words.push_back(word);
+        }
+    }
+};
+
+/// @brief Collects records in memory and writes them to disk as sorted runs without duplicates.
+class RunWriter
+{
+private:
+    fs::path m_directory;
+    std::vector<uint32_t> m_words;
+    std::vector<size_t> m_offsets;
+    std::vector<fs::path> m_runs;
+
+    RecordView get_record(size_t offset) const { return RecordView(m_words.data() + offset, get_record_size(m_words.data() + offset)); }
+
+public:
+    explicit RunWriter(fs::path directory) : m_directory(std::move(directory)), m_words(), m_offsets(), m_runs() {}
+
+    void append(const State& state)
+    {
+        m_offsets.push_back(m_words.size());
+        append_record(state, m_words);
+    }
+
+    void flush()
+    {
+        if (m_offsets.empty())
+        {
+            return;
+        }
+
+        std::sort(m_offsets.begin(), m_offsets.end(), [&](auto&& lhs, auto&& rhs) { return is_less(get_record(lhs), get_record(rhs)); });
+        m_offsets.erase(std::unique(m_offsets.begin(), m_offsets.end(), [&](auto&& lhs, auto&& rhs) { return is_equal(get_record(lhs), get_record(rhs)); }),
+                        m_offsets.end());
+
+        m_runs.push_back(m_directory / ("run_" + std::to_string(m_runs.size()) + ".bin"));
+        {
+            auto writer = RecordWriter(m_runs.back());
+            for (const auto offset : m_offsets)
+            {
+                writer.append(get_record(offset));
+            }
+        }
+
+        m_words.clear();
+        m_offsets.clear();
+    }
+
+    /// @brief Merge all runs into `layer_path` with a k-way merge, skipping the records that occur in one of the `previous_layer_paths`.
+    /// @return the number of records in the new layer.
+    size_t merge(const fs::path& layer_path, const std::vector<fs::path>& previous_layer_paths)
+    {
+        flush();
+
+        auto runs = std::vector<RecordReader> {};
+        for (const auto& path : m_runs)
+        {
+            runs.emplace_back(path);
+        }
+        auto previous_layers = std::vector<RecordReader> {};
+        for (const auto& path : previous_layer_paths)
+        {
+            previous_layers.emplace_back(path);
+        }
+
+        // A min-heap of the runs ordered by their next record.
+        auto is_greater = [&](size_t lhs, size_t rhs) { return is_less(runs[rhs].get_record(), runs[lhs].get_record()); };
+        auto heap = std::vector<size_t> {};
+        for (size_t i = 0; i < runs.size(); ++i)
+        {
+            if (runs[i].has_record())
+            {
+                heap.push_back(i);
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), is_greater);
+
+        auto num_records = size_t(0);
+        auto record = Record {};  ///< The last merged record, which is empty before the first one because records have a header.
+        {
+            auto writer = RecordWriter(layer_path);
+
+            while (!heap.empty())
+            {
+                std::pop_heap(heap.begin(), heap.end(), is_greater);
+                auto& run = runs[heap.back()];
+
+                // Each run is free of duplicates, so equal records of other runs are popped next.
+                const auto is_merged = is_equal(run.get_record(), record);
+                if (!is_merged)
+                {
+                    const auto min_record = run.get_record();
+                    record.assign(min_record.begin(), min_record.end());
+                }
+
+                run.next();
+                if (run.has_record())
+                {
+                    std::push_heap(heap.begin(), heap.end(), is_greater);
+                }
+                else
+                {
+                    heap.pop_back();
+                }
+
+                if (is_merged)
+                {
+                    continue;
+                }
+
+                auto is_duplicate = false;
+                for (auto& previous_layer : previous_layers)
+                {
+                    while (previous_layer.has_record() && is_less(previous_layer.get_record(), record))
+                    {
+                        previous_layer.next();
+                    }
+                    if (previous_layer.has_record() && is_equal(previous_layer.get_record(), record))
+                    {
+                        is_duplicate = true;
+                        break;
+                    }
+                }
+
+                if (!is_duplicate)
+                {
+                    writer.append(record);
+                    ++num_records;
+                }
+            }
+        }
+
+        runs.clear();
+        for (const auto& path : m_runs)
+        {
+            fs::remove(path);
+        }
+        m_runs.clear();
+
+        return num_records;
+    }
+};
+
+/**
+ * Plan extraction
+ */
+
+/// @brief Walk backwards through the layers to find a predecessor of each state on the path to the goal,
+/// then replay the actions from the start state in the state repository of the `context`.
+static Plan extract_total_ordered_plan_from_layers(State start_state,
+                                       ContinuousCost start_state_metric_value,
+                                       RecordView goal_record,
+                                       const std::vector<fs::path>& layer_paths,
+                                       const SearchContext& context,
+                                       const Options& options)
+{
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+
+    auto materializer = StateMaterializer(context, options.max_num_states_in_memory);
+    auto target = Record(goal_record.begin(), goal_record.end());
+    auto successor_record = Record {};
+    auto reversed_actions = GroundActionList {};
+
+    for (size_t layer = layer_paths.size() - 1; layer-- > 0;)
+    {
+        auto found = false;
+
+        for (auto reader = RecordReader(layer_paths[layer]); reader.has_record() && !found; reader.next())
+        {
+            if (materializer.is_full())
+            {
+                materializer.reset();
+            }
+
+            const auto [state, state_metric_value] = materializer.get_or_create_state(reader.get_record());
+
+            for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+            {
+                const auto [successor_state, successor_state_metric_value] =
+                    materializer.get_state_repository().get_or_create_successor_state(state, action, state_metric_value);
+
+                successor_record.clear();
+                append_record(successor_state, successor_record);
+
+                if (is_equal(successor_record, target))
+                {
+                    reversed_actions.push_back(action);
+                    const auto record = reader.get_record();
+                    target.assign(record.begin(), record.end());
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        if (!found)
+            throw std::runtime_error("Failed to reconstruct plan from solution trace.");
+    }
+
+    auto actions = GroundActionList {};
+    auto states = StateList { start_state };
+
+    auto state = start_state;
+    auto state_metric_value = start_state_metric_value;
+
+    for (auto it = reversed_actions.rbegin(); it != reversed_actions.rend(); ++it)
+    {
+        const auto [successor_state, successor_state_metric_value] =
+            context->get_state_repository()->get_or_create_successor_state(state, *it, state_metric_value);
+
+        actions.push_back(*it);
+        states.push_back(successor_state);
+        state = successor_state;
+        state_metric_value = successor_state_metric_value;
+    }
+
+    return Plan(context, std::move(states), std::move(actions), state_metric_value);
+}
+
+/**
+ * External BrFS
+ */
+
+SearchResult find_solution(const SearchContext& context, const Options& options)
+{
+    const auto& problem = *context->get_problem();
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    const auto [start_state, start_g_value] = (options.start_state) ?
+                                                  std::make_pair(options.start_state.value(), compute_state_metric_value(options.start_state.value())) :
+                                                  state_repository.get_or_create_initial_state();
+    const auto event_handler = (options.event_handler) ? options.event_handler : brfs::DefaultEventHandlerImpl::create(context->get_problem());
+    const auto goal_strategy = (options.goal_strategy) ? options.goal_strategy : ProblemGoalStrategyImpl::create(context->get_problem());
+
+    auto result = SearchResult();
+
+    event_handler->on_start_search(start_state);
+
+    if (!goal_strategy->test_static_goal())
+    {
+        event_handler->on_unsolvable();
+
+        result.status = SearchStatus::UNSOLVABLE;
+        return result;
+    }
+
+    const auto& ground_action_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundActionImpl> {});
+    const auto& ground_axiom_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
+
+    const auto working_directory = WorkingDirectory(options.directory);
+    auto layer_paths = std::vector<fs::path> {};
+    auto get_layer_path = [&](DiscreteCost g_value) { return working_directory.get_path() / ("layer_" + std::to_string(g_value) + ".bin"); };
+
+    {
+        auto start_record = Record {};
+        append_record(start_state, start_record);
+        layer_paths.push_back(get_layer_path(0));
+        auto writer = RecordWriter(layer_paths.back());
+        writer.append(start_record);
+    }
+
+    auto num_states = size_t(1);
+    auto materializer = StateMaterializer(context, options.max_num_states_in_memory);
+    auto successors = RunWriter(working_directory.get_path());
+
+    auto end_search = [&]()
+    {
+        event_handler->on_end_search(materializer.get_reached_fluent_ground_atoms_bitset().count(),
+                                     materializer.get_reached_derived_ground_atoms_bitset().count(),
+                                     num_states,
+                                     num_states,
+                                     ground_action_repository.size(),
+                                     ground_axiom_repository.size());
+        applicable_action_generator.on_end_search();
+        state_repository.get_axiom_evaluator()->on_end_search();
+    };
+
+    auto g_value = DiscreteCost(0);
+
+    event_handler->on_finish_g_layer(g_value);
+
+    auto stopwatch = StopWatch(options.max_time_in_ms);
+    stopwatch.start();
+
+    while (true)
+    {
+        /* Expand the states of the current layer, collecting the successors in sorted runs. */
+
+        for (auto reader = RecordReader(layer_paths.back()); reader.has_record(); reader.next())
+        {
+            if (stopwatch.has_finished())
+            {
+                result.status = SearchStatus::OUT_OF_TIME;
+                return result;
+            }
+
+            if (materializer.is_full())
+            {
+                successors.flush();
+                materializer.reset();
+            }
+
+            const auto [state, state_metric_value] = materializer.get_or_create_state(reader.get_record());
+
+            if (goal_strategy->test_dynamic_goal(state))
+            {
+                event_handler->on_expand_goal_state(state);
+
+                if (options.stop_if_goal)
+                {
+                    end_search();
+
+                    result.plan = extract_total_ordered_plan_from_layers(start_state, start_g_value, reader.get_record(), layer_paths, context, options);
+                    result.goal_state = result.plan->get_states().back();
+                    result.status = SearchStatus::SOLVED;
+
+                    event_handler->on_solved(result.plan.value());
+
+                    return result;
+                }
+            }
+
+            event_handler->on_expand_state(state);
+
+            auto& materialized_state_repository = materializer.get_state_repository();
+
+            for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+            {
+                const auto num_materialized_states = materialized_state_repository.get_state_count();
+                const auto [successor_state, successor_state_metric_value] =
+                    materialized_state_repository.get_or_create_successor_state(state, action, state_metric_value);
+                const auto action_cost = successor_state_metric_value - state_metric_value;
+
+                event_handler->on_generate_state(state, action, action_cost, successor_state);
+
+                /* The state repository serves as hash table of the states in memory. */
+                if (materialized_state_repository.get_state_count() > num_materialized_states)
+                {
+                    event_handler->on_generate_state_in_search_tree(state, action, action_cost, successor_state);
+
+                    successors.append(successor_state);
+                }
+                else
+                {
+                    event_handler->on_generate_state_not_in_search_tree(state, action, action_cost, successor_state);
+                }
+            }
+        }
+
+        /* Delayed duplicate detection. */
+
+        const auto num_previous_layers = std::min(static_cast<size_t>(options.num_layers_for_duplicate_detection), layer_paths.size());
+        const auto previous_layer_paths = std::vector<fs::path>(layer_paths.end() - num_previous_layers, layer_paths.end());
+        layer_paths.push_back(get_layer_path(g_value + 1));
+        const auto num_layer_states = successors.merge(layer_paths.back(), previous_layer_paths);
+
+        if (num_layer_states == 0)
+        {
+            break;
+        }
+
+        num_states += num_layer_states;
+
+        if (num_states >= options.max_num_states)
+        {
+            result.status = SearchStatus::OUT_OF_STATES;
+            return result;
+        }
+
+        applicable_action_generator.on_finish_search_layer();
+        state_repository.get_axiom_evaluator()->on_finish_search_layer();
+        event_handler->on_finish_g_layer(g_value);
+        ++g_value;
+    }
+
+    end_search();
+    event_handler->on_exhausted();
+
+    result.status = SearchStatus::EXHAUSTED;
+    return result;
+}
+}
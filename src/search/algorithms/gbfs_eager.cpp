@@ -22,14 +22,17 @@
 #include "mimir/formalism/ground_function_expressions.hpp"
 #include "mimir/formalism/metric.hpp"
 #include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/checkpoint.hpp"
 #include "mimir/search/algorithms/gbfs_eager/event_handlers.hpp"
 #include "mimir/search/algorithms/strategies/exploration_strategy.hpp"
 #include "mimir/search/algorithms/strategies/goal_strategy.hpp"
 #include "mimir/search/algorithms/strategies/pruning_strategy.hpp"
 #include "mimir/search/applicable_action_generators/interface.hpp"
 #include "mimir/search/axiom_evaluators/interface.hpp"
+#include "mimir/search/heuristics/cache.hpp"
 #include "mimir/search/heuristics/interface.hpp"
 #include "mimir/search/openlists/alternating.hpp"
+#include "mimir/search/openlists/bucket.hpp"
 #include "mimir/search/openlists/interface.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
 #include "mimir/search/plan.hpp"
@@ -38,6 +41,8 @@
 #include "mimir/search/search_space.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include "heuristic_batch.hpp"
+
 using namespace mimir::formalism;
 
 namespace mimir::search::gbfs_eager
@@ -49,23 +54,30 @@ namespace mimir::search::gbfs_eager
 
 struct SearchNode
 {
+    static constexpr Index UNKNOWN_PARENT_ACTION = get_unknown_parent_action<28>();
+
     ContinuousCost g_value;
     Index parent_state;
-    SearchNodeStatus status;
-    bool compatible;
+    Index parent_action : 28;
+    Index status : 3;
+    Index compatible : 1;
+
+    SearchNodeStatus get_status() const { return static_cast<SearchNodeStatus>(status); }
+    void set_status(SearchNodeStatus value) { status = value; }
 };
 
 static_assert(sizeof(SearchNode) == 16);
 
 using SearchNodeVector = SegmentedVector<SearchNode>;
 
+static constexpr auto DEFAULT_SEARCH_NODE =
+    SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNode::UNKNOWN_PARENT_ACTION, SearchNodeStatus::NEW, false };
+
 static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVector& search_nodes)
 {
-    static constexpr auto default_node = SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNodeStatus::NEW, false };
-
     while (state_index >= search_nodes.size())
     {
-        search_nodes.push_back(default_node);
+        search_nodes.push_back(DEFAULT_SEARCH_NODE);
     }
     return search_nodes[state_index];
 }
@@ -85,6 +97,8 @@ struct GreedyQueueEntry
 
     KeyType get_key() const { return std::make_tuple(step, status); }
     ItemType get_item() const { return packed_state; }
+    /// @brief Steps are increasing, hence a single bucket with insertion order yields the same order.
+    ContinuousCost get_bucket() const { return 0.; }
 };
 
 static_assert(sizeof(GreedyQueueEntry) == 16);
@@ -106,9 +120,28 @@ struct ExhaustiveQueueEntry
 
 static_assert(sizeof(ExhaustiveQueueEntry) == 32);
 
-using GreedyQueue = PriorityQueue<GreedyQueueEntry>;
+using GreedyQueue = BucketOpenList<GreedyQueueEntry>;
+/// @brief Ties in h-value are broken by g-value, which a bucket queue over h-values does not preserve.
 using ExhaustiveQueue = PriorityQueue<ExhaustiveQueueEntry>;
 
+/// @brief A queue entry that refers to its state by index, as stored in checkpoints.
+struct CheckpointEntry
+{
+    enum Queue : uint32_t
+    {
+        COMPATIBLE_GREEDY = 0,
+        COMPATIBLE_EXHAUSTIVE = 1,
+        STANDARD = 2,
+    };
+
+    ContinuousCost g_value;
+    ContinuousCost h_value;
+    Index state_index;
+    Index step;
+    SearchNodeStatus status;
+    Queue queue;
+};
+
 /**
  * GBFS
  */
@@ -120,6 +153,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     auto& problem = *context->get_problem();
     auto& applicable_action_generator = *context->get_applicable_action_generator();
     auto& state_repository = *context->get_state_repository();
+    const auto start_unpacked_state_cache_statistics = state_repository.get_unpacked_state_cache_statistics();
 
     const auto [start_state, start_g_value] = (options.start_state) ?
                                                   std::make_pair(options.start_state.value(), compute_state_metric_value(options.start_state.value())) :
@@ -129,6 +163,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     const auto pruning_strategy = (options.pruning_strategy) ? options.pruning_strategy : NoPruningStrategyImpl::create();
     const auto openlist_weights = options.openlist_weights;
     const auto exploration_stategy = options.exploration_strategy;
+    const auto heuristic_cache = options.heuristic_cache;
 
     const auto& ground_action_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundActionImpl> {});
     const auto& ground_axiom_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
@@ -153,6 +188,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
     if (goal_strategy->test_dynamic_goal(start_state))
     {
+        report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
         event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
                                      state_repository.get_reached_derived_ground_atoms_bitset().count(),
                                      state_repository.get_state_count(),
@@ -183,18 +219,18 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     {
         throw std::runtime_error("find_solution(...): evaluating the metric on the start state yielded NaN.");
     }
-    const auto start_h_value = heuristic->compute_heuristic(start_state);
+    const auto start_h_value = compute_heuristic(*heuristic, heuristic_cache.get(), *event_handler, start_state);
     auto best_h_value = start_h_value;
 
     event_handler->on_start_search(start_state, start_g_value, start_h_value);
 
     auto& start_search_node = get_or_create_search_node(start_state.get_index(), search_nodes);
-    start_search_node.status = (start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN;
+    start_search_node.set_status((start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN);
     start_search_node.g_value = start_g_value;
 
     /* Test whether start state is deadend. */
 
-    if (start_search_node.status == SearchNodeStatus::DEAD_END)
+    if (start_search_node.get_status() == SearchNodeStatus::DEAD_END)
     {
         event_handler->on_unsolvable();
 
@@ -211,27 +247,127 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     }
 
     const auto use_exploration_strategy = std::any_of(options.openlist_weights.begin(), options.openlist_weights.begin() + 2, [](double w) { return w > 0; });
-    auto applicable_actions = GroundActionList {};
-    standard_openlist.insert(ExhaustiveQueueEntry { start_g_value, start_h_value, start_state.get_packed_state(), step++, start_search_node.status });
+    auto successors = SuccessorBatch();
+    auto heuristic_batch = HeuristicBatch();
+    const auto use_heuristic_batch = heuristic->supports_batch_evaluation();
+    auto opened_successors = std::vector<size_t> {};
+
+    if (options.resume_from_checkpoint && fs::exists(options.checkpoint_file))
+    {
+        search_nodes = SearchNodeVector();
+        const auto values = load_checkpoint<SearchNode, CheckpointEntry>(
+            options.checkpoint_file,
+            state_repository,
+            DEFAULT_SEARCH_NODE,
+            search_nodes,
+            [&](const CheckpointEntry& entry, PackedState packed_state)
+            {
+                switch (entry.queue)
+                {
+                    case CheckpointEntry::COMPATIBLE_GREEDY:
+                        compatible_greedy_openlist.insert(GreedyQueueEntry { packed_state, entry.step, entry.status });
+                        break;
+                    case CheckpointEntry::COMPATIBLE_EXHAUSTIVE:
+                        compatible_exhaustive_openlist.insert(ExhaustiveQueueEntry { entry.g_value, entry.h_value, packed_state, entry.step, entry.status });
+                        break;
+                    case CheckpointEntry::STANDARD:
+                        standard_openlist.insert(ExhaustiveQueueEntry { entry.g_value, entry.h_value, packed_state, entry.step, entry.status });
+                        break;
+                }
+            });
+        step = static_cast<Index>(values.at(0));
+        best_h_value = values.at(1);
+    }
+    else
+    {
+        standard_openlist.insert(ExhaustiveQueueEntry { start_g_value, start_h_value, start_state.get_packed_state(), step++, start_search_node.get_status() });
+    }
 
     auto stopwatch = StopWatch(options.max_time_in_ms);
     stopwatch.start();
 
+    auto memory_limit = MemoryLimit(options.max_memory_in_bytes);
+    auto get_num_bytes_for_search = [&]()
+    {
+        return search_nodes.capacity() * sizeof(SearchNode) + openlist.get_estimated_memory_usage_in_bytes()
+               + ((heuristic_cache) ? heuristic_cache->get_estimated_memory_usage_in_bytes() : 0);
+    };
+
+    auto checkpoint_stopwatch = StopWatch(options.checkpoint_interval_in_ms);
+    checkpoint_stopwatch.start();
+    auto write_checkpoint = [&]()
+    {
+        auto entries = std::vector<CheckpointEntry> {};
+        compatible_greedy_openlist.for_each(
+            [&](const GreedyQueueEntry& entry)
+            {
+                entries.push_back(CheckpointEntry { 0., 0., state_repository.get_state_index(*entry.packed_state), entry.step, entry.status, CheckpointEntry::COMPATIBLE_GREEDY });
+            });
+        compatible_exhaustive_openlist.for_each(
+            [&](const ExhaustiveQueueEntry& entry)
+            {
+                entries.push_back(CheckpointEntry { entry.g_value,
+                                                    entry.h_value,
+                                                    state_repository.get_state_index(*entry.packed_state),
+                                                    entry.step,
+                                                    entry.status,
+                                                    CheckpointEntry::COMPATIBLE_EXHAUSTIVE });
+            });
+        standard_openlist.for_each(
+            [&](const ExhaustiveQueueEntry& entry)
+            {
+                entries.push_back(CheckpointEntry { entry.g_value,
+                                                    entry.h_value,
+                                                    state_repository.get_state_index(*entry.packed_state),
+                                                    entry.step,
+                                                    entry.status,
+                                                    CheckpointEntry::STANDARD });
+            });
+        save_checkpoint(options.checkpoint_file, state_repository, search_nodes, entries, std::vector<double> { static_cast<double>(step), best_h_value });
+        checkpoint_stopwatch.start();
+    };
+
     while (!openlist.empty())
     {
         if (stopwatch.has_finished())
         {
+            if (!options.checkpoint_file.empty())
+            {
+                write_checkpoint();
+            }
+
             result.status = SearchStatus::OUT_OF_TIME;
             return result;
         }
 
+        if (!options.checkpoint_file.empty() && checkpoint_stopwatch.has_finished())
+        {
+            write_checkpoint();
+        }
+
+        if (memory_limit.has_exceeded(*context, get_num_bytes_for_search))
+        {
+            report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
+            event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
+                                         state_repository.get_reached_derived_ground_atoms_bitset().count(),
+                                         state_repository.get_state_count(),
+                                         search_nodes.size(),
+                                         ground_action_repository.size(),
+                                         ground_axiom_repository.size());
+            applicable_action_generator.on_end_search();
+            state_repository.get_axiom_evaluator()->on_end_search();
+
+            result.status = SearchStatus::OUT_OF_MEMORY;
+            return result;
+        }
+
         const auto state = state_repository.get_state(*openlist.top());
         openlist.pop();
         auto& search_node = get_or_create_search_node(state.get_index(), search_nodes);
 
         /* Close state. */
 
-        if (search_node.status == SearchNodeStatus::CLOSED || search_node.status == SearchNodeStatus::DEAD_END)
+        if (search_node.get_status() == SearchNodeStatus::CLOSED || search_node.get_status() == SearchNodeStatus::DEAD_END)
         {
             continue;
         }
@@ -242,22 +378,27 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         /* Ensure that the state is closed */
 
-        search_node.status = SearchNodeStatus::CLOSED;
+        search_node.set_status(SearchNodeStatus::CLOSED);
 
         auto first_compatible = true;
 
-        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        state_repository.expand(state, search_node.g_value, applicable_action_generator, successors);
+
+        // Open the successors first, so that pruned successors and goal states are not evaluated.
+        opened_successors.clear();
+        heuristic_batch.clear();
+
+        for (size_t pos = 0; pos < successors.size(); ++pos)
         {
-            const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, search_node.g_value);
+            const auto& [action, successor_state, successor_state_metric_value] = successors[pos];
             auto& successor_search_node = get_or_create_search_node(successor_state.get_index(), search_nodes);
-            const auto action_cost = successor_state_metric_value - search_node.g_value;
 
             if (std::isnan(successor_state_metric_value))
             {
                 throw std::runtime_error("find_solution(...): evaluating the metric on the successor state yielded NaN.");
             }
 
-            const bool is_new_successor_state = (successor_search_node.status == SearchNodeStatus::NEW);
+            const bool is_new_successor_state = (successor_search_node.get_status() == SearchNodeStatus::NEW);
 
             if (is_new_successor_state && search_nodes.size() >= options.max_num_states)
             {
@@ -282,8 +423,9 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
             /* Open state. */
 
-            successor_search_node.status = SearchNodeStatus::OPEN;
+            successor_search_node.set_status(SearchNodeStatus::OPEN);
             successor_search_node.parent_state = state.get_index();
+            set_parent_action(successor_search_node, action->get_index());
             successor_search_node.g_value = successor_state_metric_value;
 
             /* Early goal test. */
@@ -291,10 +433,11 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             const auto successor_is_goal_state = goal_strategy->test_dynamic_goal(successor_state);
             if (successor_is_goal_state)
             {
-                successor_search_node.status = SearchNodeStatus::GOAL;
+                successor_search_node.set_status(SearchNodeStatus::GOAL);
 
                 event_handler->on_expand_goal_state(state);
 
+                report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
                 event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
                                              state_repository.get_reached_derived_ground_atoms_bitset().count(),
                                              state_repository.get_state_count(),
@@ -314,12 +457,31 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                 return result;
             }
 
+            opened_successors.push_back(pos);
+            if (use_heuristic_batch)
+            {
+                heuristic_batch.add(successor_state, heuristic_cache.get());
+            }
+        }
+
+        if (use_heuristic_batch)
+        {
+            heuristic_batch.compute(*heuristic);
+        }
+
+        for (const auto pos : opened_successors)
+        {
+            const auto& [action, successor_state, successor_state_metric_value] = successors[pos];
+            auto& successor_search_node = search_nodes[successor_state.get_index()];
+            const auto action_cost = successor_state_metric_value - search_node.g_value;
+
             /* Compute heuristic since state is new. */
 
-            const auto successor_h_value = heuristic->compute_heuristic(successor_state);
+            const auto successor_h_value =
+                compute_heuristic(*heuristic, heuristic_cache.get(), *event_handler, successor_state, use_heuristic_batch ? &heuristic_batch : nullptr);
             if (successor_h_value == INFINITY_CONTINUOUS_COST)
             {
-                successor_search_node.status = SearchNodeStatus::DEAD_END;
+                successor_search_node.set_status(SearchNodeStatus::DEAD_END);
                 continue;
             }
 
@@ -344,7 +506,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             if (options.openlist_weights[0] > 0 && is_compatible && first_compatible)
             {
                 first_compatible = false;
-                compatible_greedy_openlist.insert(GreedyQueueEntry { successor_state.get_packed_state(), step++, successor_search_node.status });
+                compatible_greedy_openlist.insert(GreedyQueueEntry { successor_state.get_packed_state(), step++, successor_search_node.get_status() });
             }
             else if (options.openlist_weights[1] > 0 && is_compatible)
             {
@@ -352,7 +514,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                                                                              successor_h_value,
                                                                              successor_state.get_packed_state(),
                                                                              step++,
-                                                                             successor_search_node.status });
+                                                                             successor_search_node.get_status() });
             }
             else
             {
@@ -360,11 +522,12 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                                                                 successor_h_value,
                                                                 successor_state.get_packed_state(),
                                                                 step++,
-                                                                successor_search_node.status });
+                                                                successor_search_node.get_status() });
             }
         }
     }
 
+    report_unpacked_state_cache_statistics(state_repository, start_unpacked_state_cache_statistics, *event_handler);
     event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
                                  state_repository.get_reached_derived_ground_atoms_bitset().count(),
                                  state_repository.get_state_count(),
@@ -31,6 +31,7 @@
 #include "mimir/search/axiom_evaluators/interface.hpp"
 #include "mimir/search/heuristics/interface.hpp"
 #include "mimir/search/openlists/alternating.hpp"
+#include "mimir/search/openlists/bucket.hpp"
 #include "mimir/search/openlists/interface.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
 #include "mimir/search/plan.hpp"
@@ -50,11 +51,17 @@ namespace mimir::search::gbfs_lazy
 
 struct SearchNode
 {
+    static constexpr Index UNKNOWN_PARENT_ACTION = get_unknown_parent_action<27>();
+
     ContinuousCost g_value;
     Index parent_state;
-    SearchNodeStatus status;
-    bool preferred;
-    bool compatible;
+    Index parent_action : 27;
+    Index status : 3;
+    Index preferred : 1;
+    Index compatible : 1;
+
+    SearchNodeStatus get_status() const { return static_cast<SearchNodeStatus>(status); }
+    void set_status(SearchNodeStatus value) { status = value; }
 };
 
 static_assert(sizeof(SearchNode) == 16);
@@ -63,7 +70,7 @@ using SearchNodeVector = SegmentedVector<SearchNode>;
 
 static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVector& search_nodes)
 {
-    static constexpr auto default_node = SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNodeStatus::NEW, false, false };
+    static constexpr auto default_node = SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), MAX_INDEX, SearchNode::UNKNOWN_PARENT_ACTION, SearchNodeStatus::NEW, false, false };
 
     while (state_index >= search_nodes.size())
     {
@@ -87,13 +94,15 @@ struct GreedyQueueEntry
 
     KeyType get_key() const { return std::make_tuple(step, status); }
     ItemType get_item() const { return packed_state; }
+    /// @brief Steps are increasing, hence a single bucket with insertion order yields the same order.
+    ContinuousCost get_bucket() const { return 0.; }
 };
 
 static_assert(sizeof(GreedyQueueEntry) == 16);
 
 struct ExhaustiveQueueEntry
 {
-    using KeyType = std::tuple<ContinuousCost, ContinuousCost, Index, SearchNodeStatus>;
+    using KeyType = std::tuple<ContinuousCost, Index>;
     using ItemType = PackedState;
 
     ContinuousCost g_value;
@@ -102,14 +111,17 @@ struct ExhaustiveQueueEntry
     Index step;
     SearchNodeStatus status;
 
-    KeyType get_key() const { return std::make_tuple(h_value, g_value, step, status); }
+    /// @brief Order by h-value and break ties by insertion order, i.e., by step, which is unique.
+    /// The bucket queue realizes this order in constant time by bucketing on the h-value and removing in FIFO order.
+    KeyType get_key() const { return std::make_tuple(h_value, step); }
     ItemType get_item() const { return packed_state; }
+    ContinuousCost get_bucket() const { return h_value; }
 };
 
 static_assert(sizeof(ExhaustiveQueueEntry) == 32);
 
-using GreedyQueue = PriorityQueue<GreedyQueueEntry>;
-using ExhaustiveQueue = PriorityQueue<ExhaustiveQueueEntry>;
+using GreedyQueue = BucketOpenList<GreedyQueueEntry>;
+using ExhaustiveQueue = BucketOpenList<ExhaustiveQueueEntry>;
 
 /**
  * GBFS
@@ -199,14 +211,14 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     event_handler->on_start_search(start_state, start_g_value, start_h_value);
 
     auto& start_search_node = get_or_create_search_node(start_state.get_index(), search_nodes);
-    start_search_node.status = (start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN;
+    start_search_node.set_status((start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN);
     start_search_node.g_value = start_g_value;
     start_search_node.preferred = start_preferred;
     start_search_node.compatible = false;
 
     /* Test whether start state is deadend. */
 
-    if (start_search_node.status == SearchNodeStatus::DEAD_END)
+    if (start_search_node.get_status() == SearchNodeStatus::DEAD_END)
     {
         event_handler->on_unsolvable();
 
@@ -224,11 +236,14 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
     const auto use_exploration_strategy = std::any_of(options.openlist_weights.begin(), options.openlist_weights.begin() + 4, [](double w) { return w > 0; });
     auto applicable_actions = GroundActionList {};
-    standard_openlist.insert(ExhaustiveQueueEntry { start_g_value, start_h_value, start_state.get_packed_state(), step++, start_search_node.status });
+    standard_openlist.insert(ExhaustiveQueueEntry { start_g_value, start_h_value, start_state.get_packed_state(), step++, start_search_node.get_status() });
 
     auto stopwatch = StopWatch(options.max_time_in_ms);
     stopwatch.start();
 
+    auto memory_limit = MemoryLimit(options.max_memory_in_bytes);
+    auto get_num_bytes_for_search = [&]() { return search_nodes.capacity() * sizeof(SearchNode) + openlist.get_estimated_memory_usage_in_bytes(); };
+
     while (!openlist.empty())
     {
         if (stopwatch.has_finished())
@@ -237,13 +252,28 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             return result;
         }
 
+        if (memory_limit.has_exceeded(*context, get_num_bytes_for_search))
+        {
+            event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
+                                         state_repository.get_reached_derived_ground_atoms_bitset().count(),
+                                         state_repository.get_state_count(),
+                                         search_nodes.size(),
+                                         ground_action_repository.size(),
+                                         ground_axiom_repository.size());
+            applicable_action_generator.on_end_search();
+            state_repository.get_axiom_evaluator()->on_end_search();
+
+            result.status = SearchStatus::OUT_OF_MEMORY;
+            return result;
+        }
+
         const auto state = state_repository.get_state(*openlist.top());
         openlist.pop();
         auto& search_node = get_or_create_search_node(state.get_index(), search_nodes);
 
         /* Close state. */
 
-        if (search_node.status == SearchNodeStatus::CLOSED || search_node.status == SearchNodeStatus::DEAD_END)
+        if (search_node.get_status() == SearchNodeStatus::CLOSED || search_node.get_status() == SearchNodeStatus::DEAD_END)
         {
             continue;
         }
@@ -251,7 +281,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
         const auto state_h_value = heuristic->compute_heuristic(state);
         if (state_h_value == INFINITY_CONTINUOUS_COST)
         {
-            search_node.status = SearchNodeStatus::DEAD_END;
+            search_node.set_status(SearchNodeStatus::DEAD_END);
             continue;
         }
 
@@ -271,7 +301,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         /* Ensure that the state is closed */
 
-        search_node.status = SearchNodeStatus::CLOSED;
+        search_node.set_status(SearchNodeStatus::CLOSED);
 
         auto first_compatible = true;
 
@@ -287,7 +317,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             }
 
             const auto is_preferred = preferred_actions.data.contains(action);
-            const auto is_new_successor_state = (successor_search_node.status == SearchNodeStatus::NEW);
+            const auto is_new_successor_state = (successor_search_node.get_status() == SearchNodeStatus::NEW);
 
             if (is_new_successor_state && search_nodes.size() >= options.max_num_states)
             {
@@ -312,8 +342,9 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
             /* Open new state. */
 
-            successor_search_node.status = SearchNodeStatus::OPEN;
+            successor_search_node.set_status(SearchNodeStatus::OPEN);
             successor_search_node.parent_state = state.get_index();
+            set_parent_action(successor_search_node, action->get_index());
             successor_search_node.g_value = successor_state_metric_value;
             successor_search_node.preferred = is_preferred;
 
@@ -323,7 +354,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
             if (successor_is_goal_state)
             {
-                successor_search_node.status = SearchNodeStatus::GOAL;
+                successor_search_node.set_status(SearchNodeStatus::GOAL);
 
                 event_handler->on_expand_goal_state(state);
 
@@ -361,12 +392,13 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             if (options.openlist_weights[0] > 0 && is_compatible && is_preferred && first_compatible)
             {
                 first_compatible = false;
-                compatible_greedy_and_preferred_openlist.insert(GreedyQueueEntry { successor_state.get_packed_state(), step++, successor_search_node.status });
+                compatible_greedy_and_preferred_openlist.insert(
+                    GreedyQueueEntry { successor_state.get_packed_state(), step++, successor_search_node.get_status() });
             }
             else if (options.openlist_weights[1] > 0 && is_compatible && first_compatible)
             {
                 first_compatible = false;
-                compatible_greedy_openlist.insert(GreedyQueueEntry { successor_state.get_packed_state(), step++, successor_search_node.status });
+                compatible_greedy_openlist.insert(GreedyQueueEntry { successor_state.get_packed_state(), step++, successor_search_node.get_status() });
             }
             else if (options.openlist_weights[2] > 0 && is_compatible && is_preferred)
             {
@@ -374,7 +406,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                                                                                            state_h_value,
                                                                                            successor_state.get_packed_state(),
                                                                                            step++,
-                                                                                           successor_search_node.status });
+                                                                                           successor_search_node.get_status() });
             }
             else if (options.openlist_weights[3] > 0 && is_compatible)
             {
@@ -382,7 +414,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                                                                              state_h_value,
                                                                              successor_state.get_packed_state(),
                                                                              step++,
-                                                                             successor_search_node.status });
+                                                                             successor_search_node.get_status() });
             }
             else if (options.openlist_weights[4] > 0 && is_preferred)
             {
@@ -390,7 +422,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                                                                  state_h_value,
                                                                  successor_state.get_packed_state(),
                                                                  step++,
-                                                                 successor_search_node.status });
+                                                                 successor_search_node.get_status() });
             }
             else
             {
@@ -398,7 +430,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                                                                 state_h_value,
                                                                 successor_state.get_packed_state(),
                                                                 step++,
-                                                                successor_search_node.status });
+                                                                successor_search_node.get_status() });
             }
         }
     }
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SRC_SEARCH_ALGORITHMS_HEURISTIC_BATCH_HPP_
+#define MIMIR_SRC_SEARCH_ALGORITHMS_HEURISTIC_BATCH_HPP_
+
+#include "mimir/search/heuristics/cache.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/state.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <optional>
+#include <vector>
+
+namespace mimir::search
+{
+
+/// @brief `HeuristicBatch` evaluates the heuristic on the successors of an expansion with a single call to `IHeuristic::compute_heuristics`
+/// and holds the values until the search consumes them.
+/// Searches only use it if `IHeuristic::supports_batch_evaluation` is true, since the default batch evaluation has no benefit.
+class HeuristicBatch
+{
+private:
+    StateList m_states;
+    std::vector<ContinuousCost> m_h_values;
+    absl::flat_hash_map<Index, ContinuousCost> m_state_index_to_h_value;
+
+public:
+    /// @brief Remove all states and values of the previous batch.
+    void clear()
+    {
+        m_states.clear();
+        m_state_index_to_h_value.clear();
+    }
+
+    /// @brief Add `state` to the batch unless it was added before or its value is cached.
+    void add(const State& state, const HeuristicCacheImpl* heuristic_cache)
+    {
+        const auto state_index = state.get_index();
+        if (!(heuristic_cache && heuristic_cache->get(state_index)) && m_state_index_to_h_value.emplace(state_index, ContinuousCost(0)).second)
+        {
+            m_states.push_back(state);
+        }
+    }
+
+    /// @brief Evaluate the heuristic on all states of the batch.
+    void compute(IHeuristic& heuristic)
+    {
+        m_h_values.resize(m_states.size());
+        heuristic.compute_heuristics(m_states, m_h_values);
+
+        for (size_t i = 0; i < m_states.size(); ++i)
+        {
+            m_state_index_to_h_value[m_states[i].get_index()] = m_h_values[i];
+        }
+    }
+
+    /// @brief Return the heuristic value of the state with index `state_index` if it was evaluated in the batch.
+    std::optional<ContinuousCost> get(Index state_index) const
+    {
+        const auto it = m_state_index_to_h_value.find(state_index);
+        if (it == m_state_index_to_h_value.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+};
+
+/// @brief Return the heuristic value of `state`, taken from `heuristic_batch` if it was evaluated there, and otherwise computed by `heuristic`.
+/// If `heuristic_cache` is given, the value is memoized and cache hits and misses are reported to `event_handler`.
+template<typename EventHandler>
+ContinuousCost compute_heuristic(IHeuristic& heuristic,
+                                 HeuristicCacheImpl* heuristic_cache,
+                                 EventHandler& event_handler,
+                                 const State& state,
+                                 const HeuristicBatch* heuristic_batch = nullptr)
+{
+    const auto batch_h_value = (heuristic_batch) ? heuristic_batch->get(state.get_index()) : std::nullopt;
+
+    if (!heuristic_cache)
+    {
+        return (batch_h_value) ? batch_h_value.value() : heuristic.compute_heuristic(state);
+    }
+
+    const auto [h_value, is_cached] = (batch_h_value) ? heuristic_cache->get_or_insert_heuristic(state, batch_h_value.value()) :
+                                                        heuristic_cache->get_or_compute_heuristic(heuristic, state);
+
+    if (is_cached)
+    {
+        event_handler.on_heuristic_cache_hit(state);
+    }
+    else
+    {
+        event_handler.on_heuristic_cache_miss(state);
+    }
+
+    return h_value;
+}
+
+}
+
+#endif
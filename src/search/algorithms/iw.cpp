@@ -695,24 +695,88 @@ StatePairTupleIndexGenerator::const_iterator StatePairTupleIndexGenerator::end()
  * DynamicNoveltyTable
  */
 
-DynamicNoveltyTable::DynamicNoveltyTable(size_t arity) :
-    m_tuple_index_mapper(arity),
-    m_table(std::vector<bool>(m_tuple_index_mapper.get_max_tuple_index() + 1, false)),
-    m_state_tuple_index_generator(&m_tuple_index_mapper),
-    m_state_pair_tuple_index_generator(&m_tuple_index_mapper)
+/// @brief Return the number of entries of a dense table, saturated slightly above `MAX_DENSE_TABLE_SIZE`.
+static size_t get_dense_table_size(size_t arity, size_t num_atoms)
 {
+    auto size = size_t(1);
+    for (size_t i = 0; i < arity && size <= MAX_DENSE_TABLE_SIZE; ++i)
+    {
+        size *= num_atoms + 1;  ///< +1 to account for placeholder.
+    }
+    return size;
 }
 
+static constexpr size_t WORD_SIZE = 64;
+
+/// @brief Return the number of words of a dense table with the given number of entries.
+/// The additional word allows reading and writing 64 bits at any entry.
+static size_t get_num_dense_table_words(size_t num_entries) { return (num_entries + WORD_SIZE - 1) / WORD_SIZE + 1; }
+
+static bool test_bit(const std::vector<uint64_t>& words, size_t position) { return words[position / WORD_SIZE] & (uint64_t(1) << (position % WORD_SIZE)); }
+
+static void set_bit(std::vector<uint64_t>& words, size_t position) { words[position / WORD_SIZE] |= uint64_t(1) << (position % WORD_SIZE); }
+
+/// @brief Set the bits of `value` at the given bit offset.
+/// @return true iff at least one of the bits was not set before.
+static bool test_and_set_bits(std::vector<uint64_t>& words, size_t bit_offset, uint64_t value)
+{
+    if (!value)
+    {
+        return false;
+    }
+    const auto word = bit_offset / WORD_SIZE;
+    const auto shift = bit_offset % WORD_SIZE;
+    auto old_value = words[word] >> shift;
+    if (shift > 0)
+    {
+        old_value |= words[word + 1] << (WORD_SIZE - shift);
+    }
+    words[word] |= value << shift;
+    if (shift > 0)
+    {
+        words[word + 1] |= value >> (WORD_SIZE - shift);
+    }
+    return value & ~old_value;
+}
+
+static uint64_t get_block(const FlatBitset& bitset, size_t index) { return (index < bitset.blocks().size()) ? bitset.blocks()[index] : 0; }
+
+DynamicNoveltyTable::DynamicNoveltyTable(size_t arity) : DynamicNoveltyTable(arity, 0) {}
+
 DynamicNoveltyTable::DynamicNoveltyTable(size_t arity, size_t num_atoms) :
     m_tuple_index_mapper(TupleIndexMapper(arity, num_atoms)),
-    m_table(std::vector<bool>(m_tuple_index_mapper.get_max_tuple_index() + 1, false)),
+    m_table(),
+    m_is_sparse(false),
+    m_num_bits_per_atom((arity > 0) ? 64 / arity : 64),
+    m_sparse_table(),
     m_state_tuple_index_generator(&m_tuple_index_mapper),
-    m_state_pair_tuple_index_generator(&m_tuple_index_mapper)
+    m_state_pair_tuple_index_generator(&m_tuple_index_mapper),
+    m_atom_indices(),
+    m_next_added_atom_positions(),
+    m_added_atom_words()
 {
+    if (get_dense_table_size(arity, num_atoms) > MAX_DENSE_TABLE_SIZE)
+    {
+        m_is_sparse = true;
+    }
+    else
+    {
+        m_table.resize(get_num_dense_table_words(m_tuple_index_mapper.get_max_tuple_index() + 1), 0);
+    }
 }
 
 void DynamicNoveltyTable::resize_to_fit(AtomIndex atom_index)
 {
+    if (m_is_sparse)
+    {
+        if (m_num_bits_per_atom < 64 && uint64_t(atom_index) + 1 >= (uint64_t(1) << m_num_bits_per_atom))
+        {
+            throw std::runtime_error("DynamicNoveltyTable::resize_to_fit: atom index " + std::to_string(atom_index)
+                                     + " does not fit into a sparse tuple key of arity " + std::to_string(m_tuple_index_mapper.get_arity()) + ".");
+        }
+        return;  // atom fits.
+    }
+
     if (atom_index < m_tuple_index_mapper.get_num_atoms())
     {
         return;  // atom fits.
@@ -729,18 +793,25 @@ void DynamicNoveltyTable::resize_to_fit(AtomIndex atom_index)
     }
     const auto new_placeholder = new_size;
 
+    if (get_dense_table_size(arity, new_size) > MAX_DENSE_TABLE_SIZE)
+    {
+        switch_to_sparse_table();
+        resize_to_fit(atom_index);
+        return;
+    }
+
     const auto old_tuple_index_mapper = m_tuple_index_mapper;  ///< backup old tuple index mapper for remapping
 
     m_tuple_index_mapper.initialize(arity, new_size);  ///< resize to fit all tuples
 
-    auto new_table = std::vector<bool>(m_tuple_index_mapper.get_max_tuple_index() + 1, false);
+    auto new_table = std::vector<uint64_t>(get_num_dense_table_words(m_tuple_index_mapper.get_max_tuple_index() + 1), 0);
 
     // Convert tuple indices that are not novel from old to new table.
     auto atom_indices = AtomIndexList(arity);
 
-    for (TupleIndex tuple_index = 0; tuple_index < m_table.size(); ++tuple_index)
+    for (TupleIndex tuple_index = 0; tuple_index <= old_tuple_index_mapper.get_max_tuple_index(); ++tuple_index)
     {
-        if (m_table[tuple_index])
+        if (test_bit(m_table, tuple_index))
         {
             old_tuple_index_mapper.to_atom_indices(tuple_index, atom_indices);
 
@@ -751,7 +822,7 @@ void DynamicNoveltyTable::resize_to_fit(AtomIndex atom_index)
 
             const auto new_tuple_index = m_tuple_index_mapper.to_tuple_index(atom_indices);
 
-            new_table[new_tuple_index] = true;
+            set_bit(new_table, new_tuple_index);
         }
     }
 
@@ -773,19 +844,135 @@ void DynamicNoveltyTable::resize_to_fit(const State& state)
     resize_to_fit(*it);
 }
 
+void DynamicNoveltyTable::switch_to_sparse_table()
+{
+    // Move the tuples that are not novel from the dense to the sparse table.
+    auto atom_indices = AtomIndexList {};
+
+    for (TupleIndex tuple_index = 0; tuple_index <= m_tuple_index_mapper.get_max_tuple_index(); ++tuple_index)
+    {
+        if (test_bit(m_table, tuple_index))
+        {
+            m_tuple_index_mapper.to_atom_indices(tuple_index, atom_indices);
+
+            m_sparse_table.insert(to_sparse_key(atom_indices));
+        }
+    }
+
+    m_table = std::vector<uint64_t>();
+    m_is_sparse = true;
+}
+
+uint64_t DynamicNoveltyTable::to_sparse_key(const AtomIndexList& atom_indices) const
+{
+    assert(std::is_sorted(atom_indices.begin(), atom_indices.end()));
+    assert(atom_indices.size() <= m_tuple_index_mapper.get_arity());
+
+    // The i-th field stores the i-th atom index + 1, and 0 is the placeholder.
+    auto key = uint64_t(0);
+    for (size_t i = 0; i < atom_indices.size(); ++i)
+    {
+        key |= (uint64_t(atom_indices[i]) + 1) << (i * m_num_bits_per_atom);
+    }
+    return key;
+}
+
+void DynamicNoveltyTable::to_atom_indices(uint64_t sparse_key, AtomIndexList& out_atom_indices) const
+{
+    out_atom_indices.clear();
+
+    const auto mask = (m_num_bits_per_atom < 64) ? (uint64_t(1) << m_num_bits_per_atom) - 1 : ~uint64_t(0);
+    for (size_t i = 0; i < m_tuple_index_mapper.get_arity(); ++i)
+    {
+        const auto field = (sparse_key >> (i * m_num_bits_per_atom)) & mask;
+
+        if (field == 0)  // filter placeholder
+        {
+            break;
+        }
+
+        out_atom_indices.push_back(field - 1);
+    }
+}
+
+/// @brief Call the callback on the keys of all tuples of size at most arity over `m_atom_indices`, including the empty tuple.
+template<typename Callback>
+void DynamicNoveltyTable::for_each_sparse_key(size_t begin, size_t depth, uint64_t key, Callback& callback) const
+{
+    callback(key);
+
+    if (depth == m_tuple_index_mapper.get_arity())
+    {
+        return;
+    }
+
+    for (size_t i = begin; i < m_atom_indices.size(); ++i)
+    {
+        for_each_sparse_key(i + 1, depth + 1, key | ((uint64_t(m_atom_indices[i]) + 1) << (depth * m_num_bits_per_atom)), callback);
+    }
+}
+
+/// @brief Call the callback on the keys of all tuples of size at most arity over `m_atom_indices`
+/// that contain at least one added atom, as given by `m_next_added_atom_positions`.
+template<typename Callback>
+void DynamicNoveltyTable::for_each_sparse_pair_key(size_t begin, size_t depth, uint64_t key, bool has_added_atom, Callback& callback) const
+{
+    if (has_added_atom)
+    {
+        callback(key);
+    }
+
+    const auto num_atoms = m_atom_indices.size();
+    if (depth == m_tuple_index_mapper.get_arity() || (!has_added_atom && m_next_added_atom_positions[begin] == num_atoms))
+    {
+        return;
+    }
+
+    // Without an added atom so far, the last position must be an added atom.
+    const auto must_add = !has_added_atom && depth + 1 == m_tuple_index_mapper.get_arity();
+
+    for (size_t i = must_add ? m_next_added_atom_positions[begin] : begin; i < num_atoms; i = must_add ? m_next_added_atom_positions[i + 1] : i + 1)
+    {
+        for_each_sparse_pair_key(i + 1,
+                                 depth + 1,
+                                 key | ((uint64_t(m_atom_indices[i]) + 1) << (depth * m_num_bits_per_atom)),
+                                 has_added_atom || m_next_added_atom_positions[i] == i,
+                                 callback);
+    }
+}
+
 void DynamicNoveltyTable::compute_novel_tuples(const State& state, std::vector<AtomIndexList>& out_novel_tuples)
 {
     out_novel_tuples.clear();
 
     resize_to_fit(state);
 
+    if (m_is_sparse)
+    {
+        const auto& fluent_atoms = state.get_atoms<FluentTag>();
+        m_atom_indices.assign(fluent_atoms.begin(), fluent_atoms.end());
+
+        auto atom_indices = AtomIndexList {};
+        auto callback = [&](uint64_t key)
+        {
+            if (!m_sparse_table.contains(key))
+            {
+                to_atom_indices(key, atom_indices);
+                out_novel_tuples.push_back(atom_indices);
+            }
+        };
+        for_each_sparse_key(0, 0, 0, callback);
+
+        return;
+    }
+
     for (auto it = m_state_tuple_index_generator.begin(state); it != m_state_tuple_index_generator.end(); ++it)
     {
         const auto tuple_index = *it;
 
-        assert(tuple_index < m_table.size());
+        assert(tuple_index <= m_tuple_index_mapper.get_max_tuple_index());
 
-        if (!m_table[tuple_index])
+        if (!test_bit(m_table, tuple_index))
         {
             out_novel_tuples.push_back(m_tuple_index_mapper.to_atom_indices(tuple_index));
         }
@@ -796,11 +983,17 @@ void DynamicNoveltyTable::insert_tuples(const std::vector<AtomIndexList>& tuples
 {
     for (const auto& tuple : tuples)
     {
+        if (m_is_sparse)
+        {
+            m_sparse_table.insert(to_sparse_key(tuple));
+            continue;
+        }
+
         const auto tuple_index = m_tuple_index_mapper.to_tuple_index(tuple);
 
-        assert(tuple_index < m_table.size());
+        assert(tuple_index <= m_tuple_index_mapper.get_max_tuple_index());
 
-        m_table[tuple_index] = true;
+        set_bit(m_table, tuple_index);
     }
 }
 
@@ -809,18 +1002,30 @@ bool DynamicNoveltyTable::test_novelty_and_update_table(const State& state)
     resize_to_fit(state);
 
     bool is_novel = false;
+
+    if (m_is_sparse)
+    {
+        const auto& fluent_atoms = state.get_atoms<FluentTag>();
+        m_atom_indices.assign(fluent_atoms.begin(), fluent_atoms.end());
+
+        auto callback = [&](uint64_t key) { is_novel |= m_sparse_table.insert(key).second; };
+        for_each_sparse_key(0, 0, 0, callback);
+
+        return is_novel;
+    }
+
     for (auto it = m_state_tuple_index_generator.begin(state); it != m_state_tuple_index_generator.end(); ++it)
     {
         const auto tuple_index = *it;
         // std::cout << tuple_index << " " << m_tuple_index_mapper.tuple_index_to_string(tuple_index) << std::endl;
 
-        assert(tuple_index < m_table.size());
+        assert(tuple_index <= m_tuple_index_mapper.get_max_tuple_index());
 
-        if (!is_novel && !m_table[tuple_index])
+        if (!is_novel && !test_bit(m_table, tuple_index))
         {
             is_novel = true;
         }
-        m_table[tuple_index] = true;
+        set_bit(m_table, tuple_index);
     }
     return is_novel;
 }
@@ -831,25 +1036,132 @@ bool DynamicNoveltyTable::test_novelty_and_update_table(const State& state, cons
     resize_to_fit(succ_state);
 
     bool is_novel = false;
+
+    if (m_is_sparse)
+    {
+        const auto& fluent_atoms = state.get_atoms<FluentTag>();
+        const auto& succ_fluent_atoms = succ_state.get_atoms<FluentTag>();
+        m_atom_indices.assign(succ_fluent_atoms.begin(), succ_fluent_atoms.end());
+
+        // Mark the atoms of the successor state that are not in the state.
+        const auto num_atoms = m_atom_indices.size();
+        m_next_added_atom_positions.resize(num_atoms + 1);
+        m_next_added_atom_positions[num_atoms] = num_atoms;
+        for (size_t i = num_atoms; i-- > 0;)
+        {
+            m_next_added_atom_positions[i] = fluent_atoms.get(m_atom_indices[i]) ? m_next_added_atom_positions[i + 1] : i;
+        }
+
+        auto callback = [&](uint64_t key) { is_novel |= m_sparse_table.insert(key).second; };
+        for_each_sparse_pair_key(0, 0, 0, false, callback);
+
+        return is_novel;
+    }
+
+    switch (m_tuple_index_mapper.get_arity())
+    {
+        case 1:
+            return test_novelty_and_update_dense_table_of_arity_one(state, succ_state);
+        case 2:
+            return test_novelty_and_update_dense_table_of_arity_two(state, succ_state);
+        default:
+            break;
+    }
+
     for (auto it = m_state_pair_tuple_index_generator.begin(state, succ_state); it != m_state_pair_tuple_index_generator.end(); ++it)
     {
         const auto tuple_index = *it;
         // std::cout << tuple_index << " " << m_tuple_index_mapper.tuple_index_to_string(tuple_index) << std::endl;
 
-        assert(tuple_index < m_table.size());
+        assert(tuple_index <= m_tuple_index_mapper.get_max_tuple_index());
 
-        if (!is_novel && !m_table[tuple_index])
+        if (!is_novel && !test_bit(m_table, tuple_index))
         {
             is_novel = true;
         }
-        m_table[tuple_index] = true;
+        set_bit(m_table, tuple_index);
     }
     return is_novel;
 }
 
-void DynamicNoveltyTable::reset() { std::fill(m_table.begin(), m_table.end(), false); }
+bool DynamicNoveltyTable::test_novelty_and_update_dense_table_of_arity_one(const State& state, const State& succ_state)
+{
+    const auto& fluent_atoms = state.get_atoms<FluentTag>();
+    const auto& succ_fluent_atoms = succ_state.get_atoms<FluentTag>();
+
+    // The tuple index of an atom is the atom index. All atoms are smaller than the placeholder, hence they fit into the table.
+    bool is_novel = false;
+    const auto num_words = std::min(succ_fluent_atoms.blocks().size(), m_table.size());
+    for (size_t i = 0; i < num_words; ++i)
+    {
+        is_novel |= test_and_set_bits(m_table, i * WORD_SIZE, succ_fluent_atoms.blocks()[i] & ~get_block(fluent_atoms, i));
+    }
+    return is_novel;
+}
+
+bool DynamicNoveltyTable::test_novelty_and_update_dense_table_of_arity_two(const State& state, const State& succ_state)
+{
+    const auto& fluent_atoms = state.get_atoms<FluentTag>();
+    const auto& succ_fluent_atoms = succ_state.get_atoms<FluentTag>();
+    const auto placeholder = m_tuple_index_mapper.get_num_atoms();
+    const auto row_size = placeholder + 1;
+
+    m_added_atom_words.clear();
+    for (size_t i = 0; i < succ_fluent_atoms.blocks().size(); ++i)
+    {
+        m_added_atom_words.push_back(succ_fluent_atoms.blocks()[i] & ~get_block(fluent_atoms, i));
+    }
+
+    // The tuple index of a pair a < b is a + b * row_size, i.e., row b contains the pairs with larger atom b,
+    // and the row of the placeholder contains the tuples of size one.
+    bool is_novel = false;
+    const auto test_and_set_row = [&](size_t row, const auto& columns, size_t num_columns)
+    {
+        const auto num_full_words = num_columns / WORD_SIZE;
+        const auto num_remaining_columns = num_columns % WORD_SIZE;
+        for (size_t i = 0; i < num_full_words && i < columns.size(); ++i)
+        {
+            is_novel |= test_and_set_bits(m_table, row * row_size + i * WORD_SIZE, columns[i]);
+        }
+        if (num_remaining_columns > 0 && num_full_words < columns.size())
+        {
+            const auto mask = (uint64_t(1) << num_remaining_columns) - 1;
+            is_novel |= test_and_set_bits(m_table, row * row_size + num_full_words * WORD_SIZE, columns[num_full_words] & mask);
+        }
+    };
+
+    test_and_set_row(placeholder, m_added_atom_words, placeholder);
+
+    // A pair with larger atom b contains an added atom iff b is added or the smaller atom is added.
+    for (const auto atom : succ_fluent_atoms)
+    {
+        if (fluent_atoms.get(atom))
+        {
+            test_and_set_row(atom, m_added_atom_words, atom);
+        }
+        else
+        {
+            test_and_set_row(atom, succ_fluent_atoms.blocks(), atom);
+        }
+    }
+    return is_novel;
+}
+
+void DynamicNoveltyTable::reset()
+{
+    std::fill(m_table.begin(), m_table.end(), 0);
+    m_sparse_table.clear();
+}
+
 const TupleIndexMapper& DynamicNoveltyTable::get_tuple_index_mapper() const { return m_tuple_index_mapper; }
 
+bool DynamicNoveltyTable::is_sparse() const { return m_is_sparse; }
+
+size_t DynamicNoveltyTable::get_estimated_memory_usage_in_bytes() const
+{
+    return m_table.capacity() * sizeof(uint64_t) + m_sparse_table.capacity() * (sizeof(uint64_t) + 1) + m_added_atom_words.capacity() * sizeof(uint64_t);
+}
+
 /**
  * NoveltyPruning
  */
@@ -868,7 +1180,7 @@ bool ArityZeroNoveltyPruningStrategyImpl::test_prune_successor_state(const State
     return state != m_initial_state || state == succ_state;
 }
 
-ArityKNoveltyPruningStrategyImpl::ArityKNoveltyPruningStrategyImpl(size_t arity, size_t num_atoms) : m_novelty_table(arity) {}
+ArityKNoveltyPruningStrategyImpl::ArityKNoveltyPruningStrategyImpl(size_t arity, size_t num_atoms) : m_novelty_table(arity, num_atoms) {}
 
 PruningStrategy ArityKNoveltyPruningStrategyImpl::create(size_t arity, size_t num_atoms)
 {
@@ -904,6 +1216,8 @@ bool ArityKNoveltyPruningStrategyImpl::test_prune_successor_state(const State& s
     return !m_novelty_table.test_novelty_and_update_table(state, succ_state);
 }
 
+const DynamicNoveltyTable& ArityKNoveltyPruningStrategyImpl::get_novelty_table() const { return m_novelty_table; }
+
 /* IterativeWidthAlgorithm */
 
 SearchResult find_solution(const SearchContext& context, const Options& options)
@@ -936,12 +1250,23 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
         options_i.start_state = start_state;
         options_i.event_handler = brfs_event_handler;
         options_i.goal_strategy = goal_strategy;
-        options_i.pruning_strategy = (cur_arity > 0) ? ArityKNoveltyPruningStrategyImpl::create(cur_arity, INITIAL_TABLE_ATOMS) :
-                                                       ArityZeroNoveltyPruningStrategyImpl::create(start_state);
+        options_i.max_memory_in_bytes = options.max_memory_in_bytes;
+        auto novelty_pruning_strategy = ArityKNoveltyPruningStrategy(nullptr);
+        if (cur_arity > 0)
+        {
+            novelty_pruning_strategy = std::make_shared<ArityKNoveltyPruningStrategyImpl>(cur_arity, INITIAL_TABLE_ATOMS);
+            options_i.pruning_strategy = novelty_pruning_strategy;
+        }
+        else
+        {
+            options_i.pruning_strategy = ArityZeroNoveltyPruningStrategyImpl::create(start_state);
+        }
 
         const auto result = brfs::find_solution(context, options_i);
 
-        iw_event_handler->on_end_arity_search(brfs_event_handler->get_statistics());
+        const auto novelty_table_memory_usage_in_bytes =
+            (novelty_pruning_strategy) ? novelty_pruning_strategy->get_novelty_table().get_estimated_memory_usage_in_bytes() : size_t(0);
+        iw_event_handler->on_end_arity_search(brfs_event_handler->get_statistics(), novelty_table_memory_usage_in_bytes);
 
         if (result.status == SearchStatus::SOLVED)
         {
@@ -961,6 +1286,13 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
 
             return result;
         }
+        else if (result.status == SearchStatus::OUT_OF_MEMORY)
+        {
+            // The states of the lower arity searches are still stored, so a higher arity cannot recover.
+            iw_event_handler->on_end_search();
+
+            return result;
+        }
 
         ++cur_arity;
     }
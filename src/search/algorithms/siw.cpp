@@ -111,6 +111,7 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
         iw_options.max_arity = max_arity;
         iw_options.iw_event_handler = iw_event_handler;
         iw_options.brfs_event_handler = brfs_event_handler;
+        iw_options.max_memory_in_bytes = options.max_memory_in_bytes;
         iw_options.goal_strategy = std::make_shared<ProblemGoalStrategyImplCounter>(context->get_problem(), cur_state);
 
         const auto sub_result = iw::find_solution(context, iw_options);
@@ -124,6 +125,14 @@ SearchResult find_solution(const SearchContext& context, const Options& options)
             return result;
         }
 
+        if (sub_result.status == SearchStatus::OUT_OF_MEMORY)
+        {
+            siw_event_handler->on_end_search();
+
+            result.status = SearchStatus::OUT_OF_MEMORY;
+            return result;
+        }
+
         if (sub_result.status == SearchStatus::FAILED)
         {
             siw_event_handler->on_end_search();
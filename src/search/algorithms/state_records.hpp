@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SRC_SEARCH_ALGORITHMS_STATE_RECORDS_HPP_
+#define MIMIR_SRC_SEARCH_ALGORITHMS_STATE_RECORDS_HPP_
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/axiom_evaluators/interface.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <vector>
+
+namespace mimir::search
+{
+
+/**
+ * State records
+ *
+ * A record is the sequence of words [num_atoms, num_numeric_variables, fluent atom indices..., numeric variables...]
+ * where the fluent atom indices are increasing and each numeric variable occupies two words.
+ * Derived atoms are recomputed when a record is turned back into a state.
+ * Records are compared lexicographically, which is a total order that is consistent with the equality of states.
+ */
+
+using Record = std::vector<uint32_t>;
+using RecordView = std::span<const uint32_t>;
+
+inline size_t get_record_size(const uint32_t* data) { return 2 + data[0] + 2 * static_cast<size_t>(data[1]); }
+
+inline void append_record(const State& state, std::vector<uint32_t>& out_words)
+{
+    const auto& numeric_variables = state.get_numeric_variables();
+
+    const auto header_pos = out_words.size();
+    out_words.push_back(0);
+    out_words.push_back(static_cast<uint32_t>(numeric_variables.size()));
+    for (const auto atom_index : state.get_atoms<formalism::FluentTag>())
+    {
+        out_words.push_back(atom_index);
+        ++out_words[header_pos];
+    }
+    for (const auto value : numeric_variables)
+    {
+        const auto bits = std::bit_cast<uint64_t>(value);
+        out_words.push_back(static_cast<uint32_t>(bits >> 32));
+        out_words.push_back(static_cast<uint32_t>(bits));
+    }
+}
+
+/// @brief Return a hash of the atoms and numeric variables of a record that does not depend on how its state is packed.
+inline uint64_t get_record_hash(RecordView record)
+{
+    auto hash = uint64_t(0xCBF29CE484222325);
+    for (const auto word : record)
+    {
+        hash = (hash ^ word) * uint64_t(0x100000001B3);
+    }
+    return hash;
+}
+
+inline bool is_less(RecordView lhs, RecordView rhs) { return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+
+inline bool is_equal(RecordView lhs, RecordView rhs) { return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+
+/// @brief Rebuilds states from records, storing them in a state repository with at most `max_num_states` states.
+/// The repository packs its states into private tables, so the memory of discarded states is freed
+/// instead of remaining in the tables of the problem.
+class StateMaterializer
+{
+private:
+    SearchContext m_context;
+    size_t m_max_num_states;
+    StateRepositoryImpl::Options m_options;
+
+    StateRepository m_state_repository;
+
+    FlatBitset m_reached_fluent_atoms;
+    FlatBitset m_reached_derived_atoms;
+
+    formalism::GroundAtomList<formalism::FluentTag> m_atoms;
+    FlatDoubleList m_numeric_variables;
+
+    static StateRepositoryImpl::Options create_options()
+    {
+        auto options = StateRepositoryImpl::Options();
+        options.private_tables = true;
+        return options;
+    }
+
+public:
+    StateMaterializer(SearchContext context, size_t max_num_states) :
+        m_context(std::move(context)),
+        m_max_num_states(std::max(max_num_states, size_t(1))),
+        m_options(create_options()),
+        m_state_repository(StateRepositoryImpl::create(m_context->get_state_repository()->get_axiom_evaluator(), m_options)),
+        m_reached_fluent_atoms(),
+        m_reached_derived_atoms(),
+        m_atoms(),
+        m_numeric_variables()
+    {
+    }
+
+    std::pair<State, ContinuousCost> get_or_create_state(RecordView record)
+    {
+        const auto num_atoms = record[0];
+        const auto num_numeric_variables = record[1];
+        const auto atom_indices = record.subspan(2, num_atoms);
+        const auto numeric_words = record.subspan(2 + num_atoms, 2 * num_numeric_variables);
+
+        m_context->get_problem()->get_repositories().get_ground_atoms_from_indices<formalism::FluentTag>(atom_indices, m_atoms);
+
+        m_numeric_variables.clear();
+        for (size_t i = 0; i < numeric_words.size(); i += 2)
+        {
+            m_numeric_variables.push_back(std::bit_cast<double>((static_cast<uint64_t>(numeric_words[i]) << 32) | numeric_words[i + 1]));
+        }
+
+        return m_state_repository->get_or_create_state(m_atoms, m_numeric_variables);
+    }
+
+    /// @brief Return true iff the repository is full and `reset` must be called before creating further states.
+    bool is_full() const { return m_state_repository->get_state_count() >= m_max_num_states; }
+
+    /// @brief Discard all states and their tables. States that were returned earlier remain valid and keep their tables alive.
+    void reset()
+    {
+        m_reached_fluent_atoms |= m_state_repository->get_reached_fluent_ground_atoms_bitset();
+        m_reached_derived_atoms |= m_state_repository->get_reached_derived_ground_atoms_bitset();
+        m_state_repository = StateRepositoryImpl::create(m_context->get_state_repository()->get_axiom_evaluator(), m_options);
+    }
+
+    StateRepositoryImpl& get_state_repository() { return *m_state_repository; }
+
+    const FlatBitset& get_reached_fluent_ground_atoms_bitset()
+    {
+        m_reached_fluent_atoms |= m_state_repository->get_reached_fluent_ground_atoms_bitset();
+        return m_reached_fluent_atoms;
+    }
+
+    const FlatBitset& get_reached_derived_ground_atoms_bitset()
+    {
+        m_reached_derived_atoms |= m_state_repository->get_reached_derived_ground_atoms_bitset();
+        return m_reached_derived_atoms;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/strategies/symmetry_pruning_strategy.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/state.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+using namespace mimir::formalism;
+
+namespace mimir::search
+{
+
+SymmetryPruningStrategyImpl::SymmetryPruningStrategyImpl(Problem problem, CertificateType certificate_type) :
+    m_problem(std::move(problem)),
+    m_certificate_type(certificate_type),
+    m_gi_certificate_to_representative(),
+    m_wl1_certificate_to_representative(),
+    m_state_to_representative(),
+    m_representative_to_g_value(),
+    m_object_graph_builder(m_problem),
+    m_statistics()
+{
+    if (!m_problem->get_initial_function_values<FluentTag>().empty())
+    {
+        throw std::runtime_error("SymmetryPruningStrategyImpl::SymmetryPruningStrategyImpl: object graphs do not encode fluent numeric variables.");
+    }
+}
+
+SymmetryPruningStrategy SymmetryPruningStrategyImpl::create(Problem problem, CertificateType certificate_type)
+{
+    return std::make_shared<SymmetryPruningStrategyImpl>(std::move(problem), certificate_type);
+}
+
+Index SymmetryPruningStrategyImpl::get_or_create_representative(const State& state)
+{
+    const auto it = m_state_to_representative.find(state.get_index());
+    if (it != m_state_to_representative.end())
+    {
+        ++m_statistics.num_certificate_cache_hits;
+        return it->second;
+    }
+
+    const auto start_time_point = std::chrono::high_resolution_clock::now();
+
+    m_object_graph_builder.update(state);
+
+    auto representative = state.get_index();
+    switch (m_certificate_type)
+    {
+        case CertificateType::GI:
+        {
+            auto certificate = m_object_graph_builder.create_nauty_graph();
+            certificate.canonize();
+            representative = m_gi_certificate_to_representative.emplace(std::move(certificate), state.get_index()).first->second;
+            break;
+        }
+        case CertificateType::WL1:
+        {
+            const auto certificate = graphs::color_refinement::compute_certificate(m_object_graph_builder.get_graph());
+            representative = m_wl1_certificate_to_representative.emplace(*certificate, state.get_index()).first->second;
+            break;
+        }
+        default:
+        {
+            throw std::logic_error("SymmetryPruningStrategyImpl::get_or_create_representative: unexpected certificate type.");
+        }
+    }
+
+    m_statistics.certificate_time += std::chrono::high_resolution_clock::now() - start_time_point;
+    ++m_statistics.num_certificates;
+    if (representative == state.get_index())
+    {
+        ++m_statistics.num_equivalence_classes;
+    }
+
+    m_state_to_representative.emplace(state.get_index(), representative);
+
+    return representative;
+}
+
+bool SymmetryPruningStrategyImpl::test_prune_initial_state(const State& state)
+{
+    // The initial state is reached with the lowest cost of the search, hence every symmetric state can be pruned.
+    const auto representative = get_or_create_representative(state);
+    m_representative_to_g_value[representative] = -std::numeric_limits<ContinuousCost>::infinity();
+
+    return false;
+}
+
+bool SymmetryPruningStrategyImpl::test_prune_successor_state(const State& state, const State& succ_state, bool is_new_succ)
+{
+    if (!is_new_succ)
+    {
+        // The search handles states that it already generated, e.g., by reopening them.
+        return false;
+    }
+
+    const auto is_symmetric_to_earlier_state = (get_or_create_representative(succ_state) != succ_state.get_index());
+    if (is_symmetric_to_earlier_state)
+    {
+        ++m_statistics.num_pruned_states;
+    }
+    return is_symmetric_to_earlier_state;
+}
+
+bool SymmetryPruningStrategyImpl::test_prune_successor_state_with_g_value(const State& state,
+                                                                          const State& succ_state,
+                                                                          bool is_new_succ,
+                                                                          ContinuousCost succ_g_value)
+{
+    const auto representative = get_or_create_representative(succ_state);
+    const auto [it, inserted] = m_representative_to_g_value.emplace(representative, succ_g_value);
+
+    if (succ_g_value < it->second)
+    {
+        it->second = succ_g_value;
+        if (is_new_succ && representative != succ_state.get_index())
+        {
+            ++m_statistics.num_improving_states;
+        }
+        return false;
+    }
+
+    if (inserted || !is_new_succ || representative == succ_state.get_index())
+    {
+        // The search handles states that it already generated, e.g., by reopening them.
+        return false;
+    }
+
+    ++m_statistics.num_pruned_states;
+    return true;
+}
+
+SymmetryPruningStrategyImpl::CertificateType SymmetryPruningStrategyImpl::get_certificate_type() const { return m_certificate_type; }
+
+const Problem& SymmetryPruningStrategyImpl::get_problem() const { return m_problem; }
+
+const SymmetryPruningStrategyImpl::Statistics& SymmetryPruningStrategyImpl::get_statistics() const { return m_statistics; }
+
+}
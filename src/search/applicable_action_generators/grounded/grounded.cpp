@@ -24,6 +24,8 @@
 #include "mimir/search/state.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <algorithm>
+
 using namespace mimir::formalism;
 
 namespace mimir::search
@@ -67,6 +69,13 @@ mimir::generator<GroundAction> GroundedApplicableActionGeneratorImpl::create_app
     }
 }
 
+void GroundedApplicableActionGeneratorImpl::generate_applicable_actions(const State& state, GroundActionList& out_actions)
+{
+    m_match_tree->generate_applicable_elements_iteratively(state.get_unpacked_state(), out_actions);
+
+    assert(std::all_of(out_actions.begin(), out_actions.end(), [&](auto&& action) { return is_applicable(action, state); }));
+}
+
 const Problem& GroundedApplicableActionGeneratorImpl::get_problem() const { return m_problem; }
 
 void GroundedApplicableActionGeneratorImpl::on_finish_search_layer() { m_event_handler->on_finish_search_layer(); }
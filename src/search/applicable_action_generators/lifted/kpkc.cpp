@@ -60,8 +60,14 @@ KPKCLiftedApplicableActionGeneratorImpl::KPKCLiftedApplicableActionGeneratorImpl
     m_event_handler(event_handler ? event_handler : DefaultEventHandlerImpl::create()),
     m_binding_event_handler(binding_event_handler ? binding_event_handler : satisficing_binding_generator::DefaultEventHandlerImpl::create()),
     m_action_grounding_data(),
-    m_dynamic_assignment_sets(*m_problem)
+    m_dynamic_assignment_sets(*m_problem),
+    m_object_graph_builder()
 {
+    if (m_options.pruning != SearchContextImpl::SymmetryPruning::OFF)
+    {
+        m_object_graph_builder.emplace(m_problem);
+    }
+
     /* 2. Initialize the condition grounders for each action schema. */
     const auto& actions = problem->get_domain()->get_actions();
     for (size_t i = 0; i < actions.size(); ++i)
@@ -82,7 +88,7 @@ KPKCLiftedApplicableActionGenerator KPKCLiftedApplicableActionGeneratorImpl::cre
 
 mimir::generator<GroundAction> KPKCLiftedApplicableActionGeneratorImpl::create_applicable_action_generator(const State& state)
 {
-    initialize(state.get_unpacked_state(), m_dynamic_assignment_sets);
+    update(state.get_unpacked_state(), m_dynamic_assignment_sets);
 
     /* Generate applicable actions */
 
@@ -103,11 +109,11 @@ mimir::generator<GroundAction> KPKCLiftedApplicableActionGeneratorImpl::create_a
 
             auto vertex_mask = std::optional<boost::dynamic_bitset<>> { std::nullopt };
 
-            for (auto&& binding : condition_grounder.create_binding_generator(state, m_dynamic_assignment_sets, vertex_mask))
+            for (const auto& binding : condition_grounder.create_binding_generator(state, m_dynamic_assignment_sets, vertex_mask))
             {
                 const auto num_ground_actions = ground_action_repository.size();
 
-                const auto ground_action = m_problem->ground(condition_grounder.get_action(), std::move(binding));
+                const auto ground_action = m_problem->ground(condition_grounder.get_action(), binding);
 
                 assert(is_applicable(ground_action, state));
 
@@ -124,29 +130,28 @@ mimir::generator<GroundAction> KPKCLiftedApplicableActionGeneratorImpl::create_a
     {
         // --- Step 1: Create object graph, compute mapping from vertex to orbit where the object with index i corresponds to vertex with index i. ---
 
-        auto object_graph = datasets::create_object_graph(state, *m_problem);
-        // std::cout << object_graph << std::endl;
+        m_object_graph_builder->update(state);
 
-        auto vertex_to_orbit = IndexList(object_graph.get_num_vertices());
+        auto vertex_to_orbit = IndexList(m_object_graph_builder->get_num_vertices());
 
         if (m_options.pruning == SearchContextImpl::SymmetryPruning::GI)
         {
-            auto nauty_graph = graphs::nauty::SparseGraph(object_graph);
+            auto nauty_graph = m_object_graph_builder->create_nauty_graph();
             nauty_graph.canonize();
             // std::cout << "orbits: " << to_string(nauty_graph.get_orbits()) << std::endl;
 
-            for (Index i = 0; i < (Index) object_graph.get_num_vertices(); ++i)
+            for (Index i = 0; i < (Index) vertex_to_orbit.size(); ++i)
             {
                 vertex_to_orbit[i] = nauty_graph.get_orbits()[i];
             }
         }
         else if (m_options.pruning == SearchContextImpl::SymmetryPruning::WL1)
         {
-            const auto certificate = graphs::color_refinement::compute_certificate(object_graph);
+            const auto certificate = graphs::color_refinement::compute_certificate(m_object_graph_builder->get_graph());
             // std::cout << "orbits: " << to_string(certificate->get_hash_to_color()) << std::endl;
 
             auto color_to_index = IndexMap<Index> {};
-            for (Index i = 0; i < (Index) object_graph.get_num_vertices(); ++i)
+            for (Index i = 0; i < (Index) vertex_to_orbit.size(); ++i)
             {
                 const auto [it, success] = color_to_index.emplace(certificate->get_hash_to_color()[i], color_to_index.size());
                 vertex_to_orbit[i] = it->second;
@@ -166,7 +171,7 @@ mimir::generator<GroundAction> KPKCLiftedApplicableActionGeneratorImpl::create_a
             // --- Step 2: Compute number of times each orbits is touched by an action parameter. ---
 
             auto touched_orbits = IndexSet {};
-            auto count_touched_orbits = IndexList(object_graph.get_num_vertices(), 0);
+            auto count_touched_orbits = IndexList(vertex_to_orbit.size(), 0);
 
             // std::cout << "get_objects_by_parameter_index: " << to_string(condition_grounder.get_static_consistency_graph().get_objects_by_parameter_index())
             //           << std::endl;
@@ -231,11 +236,11 @@ mimir::generator<GroundAction> KPKCLiftedApplicableActionGeneratorImpl::create_a
                 }
             }
 
-            for (auto&& binding : condition_grounder.create_binding_generator(state, m_dynamic_assignment_sets, vertex_mask))
+            for (const auto& binding : condition_grounder.create_binding_generator(state, m_dynamic_assignment_sets, vertex_mask))
             {
                 const auto num_ground_actions = ground_action_repository.size();
 
-                const auto ground_action = m_problem->ground(condition_grounder.get_action(), std::move(binding));
+                const auto ground_action = m_problem->ground(condition_grounder.get_action(), binding);
 
                 assert(is_applicable(ground_action, state));
 
@@ -0,0 +1,596 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/applicable_action_generators/stubborn_sets.hpp"
+
+#include "mimir/formalism/action.hpp"
+#include "mimir/formalism/atom.hpp"
+#include "mimir/formalism/conjunctive_condition.hpp"
+#include "mimir/formalism/consistency_graph.hpp"
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/effects.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/ground_effects.hpp"
+#include "mimir/formalism/literal.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/parameter.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/formalism/term.hpp"
+#include "mimir/formalism/type.hpp"
+#include "mimir/formalism/variable.hpp"
+#include "mimir/search/applicability.hpp"
+#include "mimir/search/state.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+using namespace mimir::formalism;
+
+namespace mimir::search
+{
+
+static void add_action(std::vector<std::optional<IndexList>>& ref_atom_to_actions, Index atom, Index action)
+{
+    if (atom >= ref_atom_to_actions.size())
+    {
+        ref_atom_to_actions.resize(atom + 1);
+    }
+    auto& actions = ref_atom_to_actions[atom];
+    if (!actions)
+    {
+        actions.emplace();
+    }
+    actions->push_back(action);
+}
+
+/// @brief Return true iff the problem has no derived predicates, conditional effects, numeric constraints, or fluent numeric effects.
+static bool is_supported(const ProblemImpl& problem)
+{
+    if (!problem.get_problem_and_domain_derived_predicates().empty() || !problem.get_goal_condition()->get_numeric_constraints().empty())
+    {
+        return false;
+    }
+
+    for (const auto& action : problem.get_domain()->get_actions())
+    {
+        if (!action->get_conjunctive_condition()->get_numeric_constraints().empty())
+        {
+            return false;
+        }
+        for (const auto& effect : action->get_conditional_effects())
+        {
+            const auto condition = effect->get_conjunctive_condition();
+            if (!condition->get_literals<StaticTag>().empty() || !condition->get_literals<FluentTag>().empty() || !condition->get_literals<DerivedTag>().empty()
+                || !condition->get_numeric_constraints().empty() || !effect->get_conjunctive_effect()->get_fluent_numeric_effects().empty())
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/// @brief Extend the binding of the action parameters such that the atom matches the ground atom, and return false if this is impossible.
+/// Variables of universal effects are not bound, which overapproximates the matching bindings.
+static bool unify(Atom<FluentTag> atom, GroundAtom<FluentTag> ground_atom, ObjectList& ref_binding)
+{
+    if (atom->get_predicate() != ground_atom->get_predicate())
+    {
+        return false;
+    }
+
+    const auto& terms = atom->get_terms();
+    const auto& objects = ground_atom->get_objects();
+
+    for (size_t pos = 0; pos < terms.size(); ++pos)
+    {
+        const auto object = objects[pos];
+
+        if (const auto term_object = std::get_if<Object>(&terms[pos]->get_variant()))
+        {
+            if (*term_object != object)
+            {
+                return false;
+            }
+        }
+        else if (const auto variable = std::get_if<Variable>(&terms[pos]->get_variant()))
+        {
+            const auto parameter_index = (*variable)->get_parameter_index();
+            if (parameter_index >= ref_binding.size())
+            {
+                continue;
+            }
+            if (ref_binding[parameter_index] && ref_binding[parameter_index] != object)
+            {
+                return false;
+            }
+            ref_binding[parameter_index] = object;
+        }
+    }
+
+    return true;
+}
+
+StubbornSetsApplicableActionGeneratorImpl::StubbornSetsApplicableActionGeneratorImpl(ApplicableActionGenerator applicable_action_generator,
+                                                                                     const Options& options) :
+    m_applicable_action_generator(std::move(applicable_action_generator)),
+    m_options(options),
+    m_statistics(),
+    m_is_lifted(true),
+    m_parameter_domains(),
+    m_ground_actions(),
+    m_interfering_actions(),
+    m_achievers(),
+    m_deleters(),
+    m_positive_requirers(),
+    m_negative_requirers(),
+    m_is_stubborn(),
+    m_stubborn_actions(),
+    m_queue()
+{
+    if (!m_applicable_action_generator)
+    {
+        throw std::runtime_error("StubbornSetsApplicableActionGeneratorImpl::StubbornSetsApplicableActionGeneratorImpl: "
+                                 "Expected an applicable action generator.");
+    }
+
+    m_statistics.is_supported = is_supported(*get_problem());
+}
+
+StubbornSetsApplicableActionGeneratorImpl::StubbornSetsApplicableActionGeneratorImpl(ApplicableActionGenerator applicable_action_generator,
+                                                                                     const GroundActionList& ground_actions,
+                                                                                     const Options& options) :
+    StubbornSetsApplicableActionGeneratorImpl(std::move(applicable_action_generator), options)
+{
+    m_is_lifted = false;
+    initialize(ground_actions);
+}
+
+StubbornSetsApplicableActionGenerator StubbornSetsApplicableActionGeneratorImpl::create(ApplicableActionGenerator applicable_action_generator,
+                                                                                        const Options& options)
+{
+    return std::make_shared<StubbornSetsApplicableActionGeneratorImpl>(std::move(applicable_action_generator), options);
+}
+
+StubbornSetsApplicableActionGenerator StubbornSetsApplicableActionGeneratorImpl::create(ApplicableActionGenerator applicable_action_generator,
+                                                                                        const GroundActionList& ground_actions,
+                                                                                        const Options& options)
+{
+    return std::make_shared<StubbornSetsApplicableActionGeneratorImpl>(std::move(applicable_action_generator), ground_actions, options);
+}
+
+void StubbornSetsApplicableActionGeneratorImpl::initialize(const GroundActionList& ground_actions)
+{
+    if (!m_statistics.is_supported)
+    {
+        return;
+    }
+
+    for (const auto& action : ground_actions)
+    {
+        const auto action_index = action->get_index();
+        if (action_index < m_ground_actions.size() && m_ground_actions[action_index])
+        {
+            continue;
+        }
+        add_ground_action(action);
+
+        const auto condition = action->get_conjunctive_condition();
+        for (const auto atom : condition->get_precondition<PositiveTag, FluentTag>())
+        {
+            add_action(m_positive_requirers, atom, action_index);
+        }
+        for (const auto atom : condition->get_precondition<NegativeTag, FluentTag>())
+        {
+            add_action(m_negative_requirers, atom, action_index);
+        }
+
+        for (const auto& effect : action->get_conditional_effects())
+        {
+            for (const auto atom : effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+            {
+                add_action(m_achievers, atom, action_index);
+            }
+            for (const auto atom : effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>())
+            {
+                add_action(m_deleters, atom, action_index);
+            }
+        }
+    }
+
+    if (m_options.precompute_interference)
+    {
+        for (size_t action_index = 0; action_index < m_ground_actions.size(); ++action_index)
+        {
+            if (m_ground_actions[action_index])
+            {
+                get_or_create_interfering_actions(m_ground_actions[action_index]);
+            }
+        }
+    }
+}
+
+void StubbornSetsApplicableActionGeneratorImpl::add_ground_action(GroundAction action)
+{
+    const auto action_index = action->get_index();
+    if (action_index >= m_ground_actions.size())
+    {
+        m_ground_actions.resize(action_index + 1, nullptr);
+        m_interfering_actions.resize(action_index + 1);
+        m_is_stubborn.resize(action_index + 1, false);
+    }
+    if (!m_ground_actions[action_index])
+    {
+        m_ground_actions[action_index] = action;
+        ++m_statistics.num_ground_actions;
+    }
+}
+
+const IndexList& StubbornSetsApplicableActionGeneratorImpl::get_or_create_actions(std::vector<std::optional<IndexList>>& ref_atom_to_actions,
+                                                                                  Index atom,
+                                                                                  bool polarity,
+                                                                                  bool is_effect)
+{
+    if (atom >= ref_atom_to_actions.size())
+    {
+        ref_atom_to_actions.resize(atom + 1);
+    }
+    if (!ref_atom_to_actions[atom])
+    {
+        auto actions = IndexList {};
+        if (m_is_lifted)
+        {
+            ground_unifying_actions(atom, polarity, is_effect, actions);
+        }
+        ref_atom_to_actions[atom] = std::move(actions);
+    }
+    return *ref_atom_to_actions[atom];
+}
+
+void StubbornSetsApplicableActionGeneratorImpl::ground_unifying_actions(Index atom, bool polarity, bool is_effect, IndexList& out_actions)
+{
+    const auto& problem = *get_problem();
+    const auto& actions = problem.get_domain()->get_actions();
+
+    if (m_parameter_domains.size() != actions.size())
+    {
+        m_parameter_domains.clear();
+        for (const auto& action : actions)
+        {
+            auto parameter_domains = std::vector<ObjectList> {};
+            for (const auto& parameter : action->get_parameters())
+            {
+                auto domain = ObjectList {};
+                for (const auto& object : problem.get_problem_and_domain_objects())
+                {
+                    // An untyped parameter admits all objects.
+                    if (parameter->get_bases().empty() || is_subtypeeq(object->get_bases(), parameter->get_bases()))
+                    {
+                        domain.push_back(object);
+                    }
+                }
+                parameter_domains.push_back(std::move(domain));
+            }
+            m_parameter_domains.push_back(std::move(parameter_domains));
+        }
+    }
+
+    const auto ground_atom = problem.get_repositories().get_ground_atom<FluentTag>(atom);
+
+    for (size_t action_schema_pos = 0; action_schema_pos < actions.size(); ++action_schema_pos)
+    {
+        const auto& action = actions[action_schema_pos];
+
+        const auto ground_unifying_bindings = [&](const LiteralList<FluentTag>& literals)
+        {
+            for (const auto& literal : literals)
+            {
+                auto binding = ObjectList(action->get_arity(), nullptr);
+                if (literal->get_polarity() == polarity && unify(literal->get_atom(), ground_atom, binding))
+                {
+                    ground_consistent_bindings(action_schema_pos, 0, binding, out_actions);
+                }
+            }
+        };
+
+        if (is_effect)
+        {
+            for (const auto& effect : action->get_conditional_effects())
+            {
+                ground_unifying_bindings(effect->get_conjunctive_effect()->get_literals());
+            }
+        }
+        else
+        {
+            ground_unifying_bindings(action->get_conjunctive_condition()->get_literals<FluentTag>());
+        }
+    }
+
+    std::sort(out_actions.begin(), out_actions.end());
+    out_actions.erase(std::unique(out_actions.begin(), out_actions.end()), out_actions.end());
+}
+
+void StubbornSetsApplicableActionGeneratorImpl::ground_consistent_bindings(size_t action_schema_pos,
+                                                                           size_t parameter_index,
+                                                                           ObjectList& ref_binding,
+                                                                           IndexList& out_actions)
+{
+    const auto& problem = get_problem();
+    const auto action = problem->get_domain()->get_actions()[action_schema_pos];
+
+    if (parameter_index == ref_binding.size())
+    {
+        const auto ground_action = problem->ground(action, ref_binding);
+
+        // The pairwise checks overapproximate the static consistency of bindings with more than two parameters per static atom.
+        if (is_statically_applicable(ground_action->get_conjunctive_condition(), problem->get_positive_static_initial_atoms_bitset()))
+        {
+            add_ground_action(ground_action);
+            out_actions.push_back(ground_action->get_index());
+        }
+        return;
+    }
+
+    const auto& static_literals = action->get_conjunctive_condition()->get_literals<StaticTag>();
+    const auto& static_predicate_assignment_sets = problem->get_static_assignment_sets().static_predicate_assignment_sets;
+
+    const auto is_consistent = [&](Object object)
+    {
+        const auto vertex = StaticConsistencyGraph::Vertex(0, parameter_index, object->get_index());
+        if (!vertex.consistent_literals(static_literals, static_predicate_assignment_sets))
+        {
+            return false;
+        }
+        for (size_t other_parameter_index = 0; other_parameter_index < parameter_index; ++other_parameter_index)
+        {
+            const auto other_vertex = StaticConsistencyGraph::Vertex(0, other_parameter_index, ref_binding[other_parameter_index]->get_index());
+            if (!StaticConsistencyGraph::Edge(other_vertex, vertex).consistent_literals(static_literals, static_predicate_assignment_sets))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (const auto object = ref_binding[parameter_index])
+    {
+        // The object was bound by the unification.
+        const auto& parameter = action->get_parameters()[parameter_index];
+        if ((parameter->get_bases().empty() || is_subtypeeq(object->get_bases(), parameter->get_bases())) && is_consistent(object))
+        {
+            ground_consistent_bindings(action_schema_pos, parameter_index + 1, ref_binding, out_actions);
+        }
+        return;
+    }
+
+    for (const auto& object : m_parameter_domains[action_schema_pos][parameter_index])
+    {
+        if (is_consistent(object))
+        {
+            ref_binding[parameter_index] = object;
+            ground_consistent_bindings(action_schema_pos, parameter_index + 1, ref_binding, out_actions);
+        }
+    }
+    ref_binding[parameter_index] = nullptr;
+}
+
+const IndexList& StubbornSetsApplicableActionGeneratorImpl::get_or_create_interfering_actions(GroundAction action)
+{
+    const auto action_index = action->get_index();
+
+    if (m_interfering_actions[action_index])
+    {
+        return *m_interfering_actions[action_index];
+    }
+
+    auto result = IndexList {};
+    const auto append = [&](const IndexList& actions) { result.insert(result.end(), actions.begin(), actions.end()); };
+
+    // Actions that the action disables, or whose effects conflict with the effects of the action.
+    for (const auto& effect : action->get_conditional_effects())
+    {
+        for (const auto atom : effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+        {
+            append(get_or_create_actions(m_negative_requirers, atom, false, false));
+            append(get_or_create_actions(m_deleters, atom, false, true));
+        }
+        for (const auto atom : effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>())
+        {
+            append(get_or_create_actions(m_positive_requirers, atom, true, false));
+            append(get_or_create_actions(m_achievers, atom, true, true));
+        }
+    }
+
+    // Actions that disable the action.
+    const auto condition = action->get_conjunctive_condition();
+    for (const auto atom : condition->get_precondition<PositiveTag, FluentTag>())
+    {
+        append(get_or_create_actions(m_deleters, atom, false, true));
+    }
+    for (const auto atom : condition->get_precondition<NegativeTag, FluentTag>())
+    {
+        append(get_or_create_actions(m_achievers, atom, true, true));
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    result.erase(std::remove(result.begin(), result.end(), action_index), result.end());
+
+    ++m_statistics.num_interference_lists;
+    // Computing the relations in lifted mode may add ground actions, hence the list is stored after.
+    m_interfering_actions[action_index] = std::move(result);
+
+    return *m_interfering_actions[action_index];
+}
+
+void StubbornSetsApplicableActionGeneratorImpl::add_to_stubborn_set(const IndexList& actions)
+{
+    for (const auto action_index : actions)
+    {
+        if (!m_is_stubborn[action_index])
+        {
+            m_is_stubborn[action_index] = true;
+            m_stubborn_actions.push_back(action_index);
+            m_queue.push_back(action_index);
+        }
+    }
+}
+
+void StubbornSetsApplicableActionGeneratorImpl::add_necessary_enabling_set(Index atom, bool polarity)
+{
+    add_to_stubborn_set(polarity ? get_or_create_actions(m_achievers, atom, true, true) : get_or_create_actions(m_deleters, atom, false, true));
+}
+
+mimir::generator<GroundAction> StubbornSetsApplicableActionGeneratorImpl::create_applicable_action_generator(const State& state)
+{
+    auto ground_actions = GroundActionList {};
+    generate_applicable_actions(state, ground_actions);
+
+    for (const auto& ground_action : ground_actions)
+    {
+        co_yield ground_action;
+    }
+}
+
+void StubbornSetsApplicableActionGeneratorImpl::generate_applicable_actions(const State& state, GroundActionList& out_actions)
+{
+    m_applicable_action_generator->generate_applicable_actions(state, out_actions);
+
+    if (!m_statistics.is_supported || m_statistics.is_disabled || out_actions.empty())
+    {
+        return;
+    }
+
+    for (const auto& action : out_actions)
+    {
+        if (m_is_lifted)
+        {
+            add_ground_action(action);
+        }
+        else if (action->get_index() >= m_ground_actions.size() || m_ground_actions[action->get_index()] != action)
+        {
+            // Do not prune if an applicable action is unknown, e.g., because the search did not start in a state reachable from the initial state.
+            return;
+        }
+    }
+
+    const auto& fluent_atoms = state.get_atoms<FluentTag>();
+    const auto find_unsatisfied_literal = [&](GroundConjunctiveCondition condition) -> std::optional<std::pair<Index, bool>>
+    {
+        for (const auto atom : condition->get_precondition<PositiveTag, FluentTag>())
+        {
+            if (!fluent_atoms.get(atom))
+            {
+                return std::make_pair(atom, true);
+            }
+        }
+        for (const auto atom : condition->get_precondition<NegativeTag, FluentTag>())
+        {
+            if (fluent_atoms.get(atom))
+            {
+                return std::make_pair(atom, false);
+            }
+        }
+        return std::nullopt;
+    };
+
+    // Goal states are not pruned.
+    const auto unsatisfied_goal_literal = find_unsatisfied_literal(get_problem()->get_goal_condition());
+    if (!unsatisfied_goal_literal)
+    {
+        return;
+    }
+
+    /* Compute the strong stubborn set. */
+
+    m_stubborn_actions.clear();
+    m_queue.clear();
+
+    add_necessary_enabling_set(unsatisfied_goal_literal->first, unsatisfied_goal_literal->second);
+
+    while (!m_queue.empty())
+    {
+        const auto action = m_ground_actions[m_queue.back()];
+        m_queue.pop_back();
+
+        const auto unsatisfied_literal = find_unsatisfied_literal(action->get_conjunctive_condition());
+        if (unsatisfied_literal)
+        {
+            add_necessary_enabling_set(unsatisfied_literal->first, unsatisfied_literal->second);
+        }
+        else
+        {
+            add_to_stubborn_set(get_or_create_interfering_actions(action));
+        }
+    }
+
+    /* Keep the applicable actions in the stubborn set. */
+
+    const auto num_unpruned_actions = out_actions.size();
+    std::erase_if(out_actions, [&](auto&& action) { return !m_is_stubborn[action->get_index()]; });
+
+    for (const auto action_index : m_stubborn_actions)
+    {
+        m_is_stubborn[action_index] = false;
+    }
+
+    ++m_statistics.num_states;
+    m_statistics.num_unpruned_actions += num_unpruned_actions;
+    m_statistics.num_pruned_actions += num_unpruned_actions - out_actions.size();
+
+    if (m_statistics.num_states == m_options.num_states_before_checking && m_statistics.get_pruning_ratio() < m_options.min_pruning_ratio)
+    {
+        m_statistics.is_disabled = true;
+    }
+}
+
+void StubbornSetsApplicableActionGeneratorImpl::on_finish_search_layer() { m_applicable_action_generator->on_finish_search_layer(); }
+
+void StubbornSetsApplicableActionGeneratorImpl::on_end_search()
+{
+    m_applicable_action_generator->on_end_search();
+}
+
+const Problem& StubbornSetsApplicableActionGeneratorImpl::get_problem() const { return m_applicable_action_generator->get_problem(); }
+
+const ApplicableActionGenerator& StubbornSetsApplicableActionGeneratorImpl::get_applicable_action_generator() const { return m_applicable_action_generator; }
+
+const StubbornSetsApplicableActionGeneratorImpl::Options& StubbornSetsApplicableActionGeneratorImpl::get_options() const { return m_options; }
+
+const StubbornSetsApplicableActionGeneratorImpl::Statistics& StubbornSetsApplicableActionGeneratorImpl::get_statistics() const { return m_statistics; }
+
+std::ostream& operator<<(std::ostream& os, const StubbornSetsApplicableActionGeneratorImpl::Statistics& statistics)
+{
+    os << "[StubbornSets] Number of states: " << statistics.num_states << std::endl
+       << "[StubbornSets] Number of applicable actions: " << statistics.num_unpruned_actions << std::endl
+       << "[StubbornSets] Number of pruned actions: " << statistics.num_pruned_actions << std::endl
+       << "[StubbornSets] Pruning ratio: " << statistics.get_pruning_ratio() << std::endl
+       << "[StubbornSets] Number of computed interference lists: " << statistics.num_interference_lists << std::endl
+       << "[StubbornSets] Number of ground actions: " << statistics.num_ground_actions << std::endl
+       << "[StubbornSets] Pruning is " << (!statistics.is_supported ? "unsupported" : (statistics.is_disabled ? "disabled" : "enabled"));
+
+    return os;
+}
+
+}
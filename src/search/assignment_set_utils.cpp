@@ -17,34 +17,223 @@
 
 #include "mimir/search/assignment_set_utils.hpp"
 
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_function.hpp"
+#include "mimir/formalism/predicate.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/search/state_unpacked.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
 namespace mimir::search
 {
+
+template<formalism::IsFluentOrDerivedTag P>
+static void initialize(const formalism::Repositories& pddl_repositories,
+                       const FlatBitset& dense_atoms,
+                       formalism::PredicateAssignmentSets<P>& out_predicate_assignment_sets,
+                       FlatBitset& out_atoms)
+{
+    auto& atoms = out_predicate_assignment_sets.get_atoms_scratch();
+    pddl_repositories.get_ground_atoms_from_indices(dense_atoms, atoms);
+    out_predicate_assignment_sets.reset();
+    out_predicate_assignment_sets.insert_ground_atoms(atoms);
+    out_atoms = dense_atoms;
+}
+
+static void initialize(const formalism::Repositories& pddl_repositories,
+                       const FlatDoubleList& dense_numeric_variables,
+                       formalism::FunctionSkeletonAssignmentSets<formalism::FluentTag>& out_function_skeleton_assignment_sets,
+                       FlatDoubleList& out_numeric_variables)
+{
+    auto& functions = out_function_skeleton_assignment_sets.get_functions_scratch();
+    pddl_repositories.get_ground_functions(dense_numeric_variables.size(), functions);
+    out_function_skeleton_assignment_sets.reset();
+    out_function_skeleton_assignment_sets.insert_ground_function_values(functions, dense_numeric_variables);
+    out_numeric_variables = dense_numeric_variables;
+}
+
+static uint64_t get_block(const FlatBitset& bitset, size_t index) { return (index < bitset.blocks().size()) ? bitset.blocks()[index] : 0; }
+
+/// @brief Call `callback(atom, is_added)` for each atom that is in exactly one of the bitsets.
+template<typename Callback>
+static void for_each_changed_atom(const FlatBitset& old_atoms, const FlatBitset& new_atoms, Callback&& callback)
+{
+    const auto num_blocks = std::max(old_atoms.blocks().size(), new_atoms.blocks().size());
+    for (size_t i = 0; i < num_blocks; ++i)
+    {
+        const auto new_block = get_block(new_atoms, i);
+        for (auto changed = get_block(old_atoms, i) ^ new_block; changed; changed &= changed - 1)
+        {
+            const auto offset = std::countr_zero(changed);
+            callback(static_cast<Index>(i * FlatBitset::block_size + offset), static_cast<bool>((new_block >> offset) & 1));
+        }
+    }
+}
+
+template<formalism::IsFluentOrDerivedTag P>
+static void update(const formalism::Repositories& pddl_repositories,
+                   const FlatBitset& dense_atoms,
+                   formalism::PredicateAssignmentSets<P>& out_predicate_assignment_sets,
+                   FlatBitset& out_atoms)
+{
+    auto num_changed_atoms = size_t(0);
+    auto deleted_predicates = formalism::PredicateList<P> {};
+    for_each_changed_atom(out_atoms,
+                          dense_atoms,
+                          [&](Index atom_index, bool is_added)
+                          {
+                              ++num_changed_atoms;
+                              const auto predicate = pddl_repositories.get_ground_atom<P>(atom_index)->get_predicate();
+                              if (!is_added && std::find(deleted_predicates.begin(), deleted_predicates.end(), predicate) == deleted_predicates.end())
+                              {
+                                  deleted_predicates.push_back(predicate);
+                              }
+                          });
+
+    if (num_changed_atoms == 0)
+    {
+        return;
+    }
+
+    if (num_changed_atoms > dense_atoms.count())
+    {
+        initialize(pddl_repositories, dense_atoms, out_predicate_assignment_sets, out_atoms);
+        return;
+    }
+
+    const auto is_deleted_predicate = [&](formalism::Predicate<P> predicate)
+    { return std::find(deleted_predicates.begin(), deleted_predicates.end(), predicate) != deleted_predicates.end(); };
+
+    // A deleted atom may share assignments with atoms that remain true, hence the set of its predicate is rebuilt.
+    if (!deleted_predicates.empty())
+    {
+        for (const auto& predicate : deleted_predicates)
+        {
+            out_predicate_assignment_sets.reset(predicate);
+        }
+        for (const auto atom_index : dense_atoms)
+        {
+            const auto atom = pddl_repositories.get_ground_atom<P>(atom_index);
+            if (is_deleted_predicate(atom->get_predicate()))
+            {
+                out_predicate_assignment_sets.insert_ground_atom(atom);
+            }
+        }
+    }
+
+    for_each_changed_atom(out_atoms,
+                          dense_atoms,
+                          [&](Index atom_index, bool is_added)
+                          {
+                              const auto atom = pddl_repositories.get_ground_atom<P>(atom_index);
+                              if (is_added && !is_deleted_predicate(atom->get_predicate()))
+                              {
+                                  out_predicate_assignment_sets.insert_ground_atom(atom);
+                              }
+                          });
+
+    out_atoms = dense_atoms;
+}
+
+static void update(const formalism::Repositories& pddl_repositories,
+                   const FlatDoubleList& dense_numeric_variables,
+                   formalism::FunctionSkeletonAssignmentSets<formalism::FluentTag>& out_function_skeleton_assignment_sets,
+                   FlatDoubleList& out_numeric_variables)
+{
+    if (dense_numeric_variables.size() != out_numeric_variables.size())
+    {
+        initialize(pddl_repositories, dense_numeric_variables, out_function_skeleton_assignment_sets, out_numeric_variables);
+        return;
+    }
+
+    const auto is_changed = [&](size_t i)
+    {
+        const auto old_value = out_numeric_variables[i];
+        const auto new_value = dense_numeric_variables[i];
+        return old_value != new_value && !(std::isnan(old_value) && std::isnan(new_value));
+    };
+
+    auto first_changed = size_t(0);
+    while (first_changed < dense_numeric_variables.size() && !is_changed(first_changed))
+    {
+        ++first_changed;
+    }
+    if (first_changed == dense_numeric_variables.size())
+    {
+        return;
+    }
+
+    // The intervals cannot shrink by removing a value, hence the sets of function skeletons with a changed value are rebuilt.
+    auto& functions = out_function_skeleton_assignment_sets.get_functions_scratch();
+    pddl_repositories.get_ground_functions(dense_numeric_variables.size(), functions);
+
+    auto changed_function_skeletons = formalism::FunctionSkeletonList<formalism::FluentTag> {};
+    const auto is_changed_function_skeleton = [&](formalism::FunctionSkeleton<formalism::FluentTag> function_skeleton)
+    { return std::find(changed_function_skeletons.begin(), changed_function_skeletons.end(), function_skeleton) != changed_function_skeletons.end(); };
+
+    for (size_t i = first_changed; i < dense_numeric_variables.size(); ++i)
+    {
+        const auto function_skeleton = functions[i]->get_function_skeleton();
+        if (is_changed(i) && !is_changed_function_skeleton(function_skeleton))
+        {
+            changed_function_skeletons.push_back(function_skeleton);
+            out_function_skeleton_assignment_sets.reset(function_skeleton);
+        }
+    }
+    for (size_t i = 0; i < dense_numeric_variables.size(); ++i)
+    {
+        if (is_changed_function_skeleton(functions[i]->get_function_skeleton()))
+        {
+            out_function_skeleton_assignment_sets.insert_ground_function_value(functions[i], dense_numeric_variables[i]);
+        }
+    }
+
+    out_numeric_variables = dense_numeric_variables;
+}
+
 void initialize(const UnpackedStateImpl& unpacked_state, formalism::DynamicAssignmentSets& out_dynamic_assignment_sets)
 {
     const auto& pddl_repositories = unpacked_state.get_problem().get_repositories();
-    const auto& dense_fluent_atoms = unpacked_state.get_atoms<formalism::FluentTag>();
-    const auto& dense_derived_atoms = unpacked_state.get_atoms<formalism::DerivedTag>();
-    const auto& dense_numeric_variables = unpacked_state.get_numeric_variables();
-
-    auto& fluent_predicate_assignment_set = out_dynamic_assignment_sets.fluent_predicate_assignment_sets;
-    auto& fluent_atoms = fluent_predicate_assignment_set.get_atoms_scratch();
-    pddl_repositories.get_ground_atoms_from_indices(dense_fluent_atoms, fluent_atoms);
-    fluent_predicate_assignment_set.reset();
-    fluent_predicate_assignment_set.insert_ground_atoms(fluent_atoms);
-
-    auto& derived_predicate_assignment_set = out_dynamic_assignment_sets.derived_predicate_assignment_sets;
-    auto& derived_atoms = derived_predicate_assignment_set.get_atoms_scratch();
-    pddl_repositories.get_ground_atoms_from_indices(dense_derived_atoms, derived_atoms);
-    derived_predicate_assignment_set.reset();
-    derived_predicate_assignment_set.insert_ground_atoms(derived_atoms);
-
-    auto& fluent_function_assignment_set = out_dynamic_assignment_sets.fluent_function_skeleton_assignment_sets;
-    auto& fluent_functions = fluent_function_assignment_set.get_functions_scratch();
-    pddl_repositories.get_ground_functions(dense_numeric_variables.size(), fluent_functions);
-    fluent_function_assignment_set.reset();
-    fluent_function_assignment_set.insert_ground_function_values(fluent_functions, dense_numeric_variables);
+
+    initialize(pddl_repositories,
+               unpacked_state.get_atoms<formalism::FluentTag>(),
+               out_dynamic_assignment_sets.fluent_predicate_assignment_sets,
+               out_dynamic_assignment_sets.fluent_atoms);
+    initialize(pddl_repositories,
+               unpacked_state.get_atoms<formalism::DerivedTag>(),
+               out_dynamic_assignment_sets.derived_predicate_assignment_sets,
+               out_dynamic_assignment_sets.derived_atoms);
+    initialize(pddl_repositories,
+               unpacked_state.get_numeric_variables(),
+               out_dynamic_assignment_sets.fluent_function_skeleton_assignment_sets,
+               out_dynamic_assignment_sets.numeric_variables);
+    out_dynamic_assignment_sets.is_initialized = true;
+}
+
+void update(const UnpackedStateImpl& unpacked_state, formalism::DynamicAssignmentSets& out_dynamic_assignment_sets)
+{
+    if (!out_dynamic_assignment_sets.is_initialized)
+    {
+        initialize(unpacked_state, out_dynamic_assignment_sets);
+        return;
+    }
+
+    const auto& pddl_repositories = unpacked_state.get_problem().get_repositories();
+
+    update(pddl_repositories,
+           unpacked_state.get_atoms<formalism::FluentTag>(),
+           out_dynamic_assignment_sets.fluent_predicate_assignment_sets,
+           out_dynamic_assignment_sets.fluent_atoms);
+    update(pddl_repositories,
+           unpacked_state.get_atoms<formalism::DerivedTag>(),
+           out_dynamic_assignment_sets.derived_predicate_assignment_sets,
+           out_dynamic_assignment_sets.derived_atoms);
+    update(pddl_repositories,
+           unpacked_state.get_numeric_variables(),
+           out_dynamic_assignment_sets.fluent_function_skeleton_assignment_sets,
+           out_dynamic_assignment_sets.numeric_variables);
 }
 }
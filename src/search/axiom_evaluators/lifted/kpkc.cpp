@@ -65,7 +65,7 @@ KPKCLiftedAxiomEvaluatorImpl::create(Problem problem, EventHandler event_handler
 
 void KPKCLiftedAxiomEvaluatorImpl::generate_and_apply_axioms(UnpackedStateImpl& unpacked_state)
 {
-    initialize(unpacked_state, m_dynamic_assignment_sets);
+    update(unpacked_state, m_dynamic_assignment_sets);
 
     /* 2. Fixed point computation */
 
@@ -103,11 +103,11 @@ void KPKCLiftedAxiomEvaluatorImpl::generate_and_apply_axioms(UnpackedStateImpl&
 
                 auto vertex_mask = std::optional<boost::dynamic_bitset<>> { std::nullopt };
 
-                for (auto&& binding : condition_grounder.create_binding_generator(unpacked_state, m_dynamic_assignment_sets, vertex_mask))
+                for (const auto& binding : condition_grounder.create_binding_generator(unpacked_state, m_dynamic_assignment_sets, vertex_mask))
                 {
                     const auto num_ground_axioms = ground_axiom_repository.size();
 
-                    const auto ground_axiom = m_problem->ground(axiom, std::move(binding));
+                    const auto ground_axiom = m_problem->ground(axiom, binding);
 
                     assert(is_applicable(ground_axiom, unpacked_state));
 
@@ -138,6 +138,7 @@ void KPKCLiftedAxiomEvaluatorImpl::generate_and_apply_axioms(UnpackedStateImpl&
 
                     // Update the assignment set
                     m_dynamic_assignment_sets.derived_predicate_assignment_sets.insert_ground_atom(new_ground_atom);
+                    m_dynamic_assignment_sets.derived_atoms.set(grounded_atom_index);
                     // Update the state
                     unpacked_state.get_atoms<DerivedTag>().set(grounded_atom_index);
 
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/finite_domain_state_encoding.hpp"
+
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+
+#include <absl/hash/hash.h>
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+using namespace mimir::formalism;
+
+namespace mimir::search
+{
+
+static constexpr size_t WORD_SIZE = 64;
+
+/// @brief Write the lowest `num_bits` bits of `value` at the given bit offset, assuming that the target bits are zero.
+static void write_bits(uint64_t* words, size_t bit_offset, size_t num_bits, uint64_t value)
+{
+    const auto word = bit_offset / WORD_SIZE;
+    const auto shift = bit_offset % WORD_SIZE;
+    words[word] |= value << shift;
+    if (shift + num_bits > WORD_SIZE)
+    {
+        words[word + 1] |= value >> (WORD_SIZE - shift);
+    }
+}
+
+static uint64_t read_bits(const uint64_t* words, size_t bit_offset, size_t num_bits)
+{
+    const auto word = bit_offset / WORD_SIZE;
+    const auto shift = bit_offset % WORD_SIZE;
+    auto value = words[word] >> shift;
+    if (shift + num_bits > WORD_SIZE)
+    {
+        value |= words[word + 1] << (WORD_SIZE - shift);
+    }
+    return (num_bits == WORD_SIZE) ? value : value & ((uint64_t(1) << num_bits) - 1);
+}
+
+FiniteDomainStateEncodingImpl::FiniteDomainStateEncodingImpl(Problem problem, const MutexGroupList& mutex_groups) :
+    m_problem(std::move(problem)),
+    m_variables(),
+    m_atom_to_variable_and_value(),
+    m_num_bits(0),
+    m_num_words(0)
+{
+    const auto& repositories = m_problem->get_repositories();
+    const auto num_atoms = static_cast<size_t>(std::ranges::distance(repositories.get_ground_atoms<FluentTag>()));
+    m_atom_to_variable_and_value.resize(num_atoms, { MAX_INDEX, MAX_INDEX });
+
+    auto sorted_groups = std::vector<const MutexGroup*> {};
+    for (const auto& group : mutex_groups)
+    {
+        sorted_groups.push_back(&group);
+    }
+    std::stable_sort(sorted_groups.begin(), sorted_groups.end(), [](auto&& lhs, auto&& rhs) { return lhs->size() > rhs->size(); });
+
+    const auto add_variable = [&](IndexList atoms)
+    {
+        const auto variable = static_cast<Index>(m_variables.size());
+        for (size_t i = 0; i < atoms.size(); ++i)
+        {
+            m_atom_to_variable_and_value[atoms[i]] = { variable, static_cast<Index>(i + 1) };
+        }
+        const auto num_bits = static_cast<size_t>(std::bit_width(atoms.size()));
+        m_variables.push_back(Variable { std::move(atoms), m_num_bits, num_bits });
+        m_num_bits += num_bits;
+    };
+
+    for (const auto* group : sorted_groups)
+    {
+        auto atoms = IndexList {};
+        for (const auto atom : *group)
+        {
+            if (atom >= num_atoms)
+            {
+                throw std::runtime_error("FiniteDomainStateEncodingImpl::FiniteDomainStateEncodingImpl: unknown fluent ground atom index "
+                                         + std::to_string(atom) + " in mutex group.");
+            }
+            if (m_atom_to_variable_and_value[atom].first == MAX_INDEX && std::find(atoms.begin(), atoms.end(), atom) == atoms.end())
+            {
+                atoms.push_back(atom);
+            }
+        }
+        if (atoms.size() >= 2)
+        {
+            add_variable(std::move(atoms));
+        }
+    }
+
+    for (size_t atom = 0; atom < num_atoms; ++atom)
+    {
+        if (m_atom_to_variable_and_value[atom].first == MAX_INDEX)
+        {
+            add_variable(IndexList { static_cast<Index>(atom) });
+        }
+    }
+
+    m_num_words = (m_num_bits + WORD_SIZE - 1) / WORD_SIZE;
+}
+
+FiniteDomainStateEncoding FiniteDomainStateEncodingImpl::create(const IGrounder& grounder)
+{
+    return std::make_shared<FiniteDomainStateEncodingImpl>(grounder.get_problem(), compute_mutex_groups(grounder));
+}
+
+FiniteDomainStateEncoding FiniteDomainStateEncodingImpl::create(Problem problem, const MutexGroupList& mutex_groups)
+{
+    return std::make_shared<FiniteDomainStateEncodingImpl>(std::move(problem), mutex_groups);
+}
+
+void FiniteDomainStateEncodingImpl::encode(const FlatBitset& fluent_atoms, uint64_t* out_words) const
+{
+    std::fill(out_words, out_words + m_num_words, uint64_t(0));
+
+    for (const auto atom : fluent_atoms)
+    {
+        if (atom >= m_atom_to_variable_and_value.size())
+        {
+            throw std::runtime_error("FiniteDomainStateEncodingImpl::encode: fluent ground atom index " + std::to_string(atom)
+                                     + " was created after the encoding.");
+        }
+        const auto [variable, value] = m_atom_to_variable_and_value[atom];
+        const auto& info = m_variables[variable];
+        if (read_bits(out_words, info.bit_offset, info.num_bits) != 0)
+        {
+            throw std::runtime_error("FiniteDomainStateEncodingImpl::encode: the state violates a mutex group of fluent ground atom index "
+                                     + std::to_string(atom) + ".");
+        }
+        write_bits(out_words, info.bit_offset, info.num_bits, value);
+    }
+}
+
+void FiniteDomainStateEncodingImpl::decode(const uint64_t* words, FlatBitset& out_fluent_atoms) const
+{
+    out_fluent_atoms.unset_all();
+
+    for (const auto& variable : m_variables)
+    {
+        const auto value = read_bits(words, variable.bit_offset, variable.num_bits);
+        if (value != 0)
+        {
+            out_fluent_atoms.set(variable.atoms[value - 1]);
+        }
+    }
+}
+
+const Problem& FiniteDomainStateEncodingImpl::get_problem() const { return m_problem; }
+
+const std::vector<FiniteDomainStateEncodingImpl::Variable>& FiniteDomainStateEncodingImpl::get_variables() const { return m_variables; }
+
+size_t FiniteDomainStateEncodingImpl::get_num_bits() const { return m_num_bits; }
+
+size_t FiniteDomainStateEncodingImpl::get_num_words() const { return m_num_words; }
+
+size_t FiniteDomainStateEncodingImpl::get_num_bytes_per_state() const { return m_num_words * sizeof(uint64_t); }
+
+/**
+ * FiniteDomainStateSet
+ */
+
+size_t FiniteDomainStateSet::WordsHash::operator()(Index index) const { return (*this)(set->get_words(index)); }
+
+size_t FiniteDomainStateSet::WordsHash::operator()(absl::Span<const uint64_t> words) const { return absl::Hash<absl::Span<const uint64_t>> {}(words); }
+
+bool FiniteDomainStateSet::WordsEqualTo::operator()(Index lhs, Index rhs) const { return lhs == rhs; }
+
+bool FiniteDomainStateSet::WordsEqualTo::operator()(Index lhs, absl::Span<const uint64_t> rhs) const { return set->get_words(lhs) == rhs; }
+
+bool FiniteDomainStateSet::WordsEqualTo::operator()(absl::Span<const uint64_t> lhs, Index rhs) const { return lhs == set->get_words(rhs); }
+
+FiniteDomainStateSet::FiniteDomainStateSet(FiniteDomainStateEncoding encoding) :
+    m_encoding(std::move(encoding)),
+    m_words(),
+    m_indices(0, WordsHash { this }, WordsEqualTo { this }),
+    m_buffer(m_encoding->get_num_words())
+{
+}
+
+absl::Span<const uint64_t> FiniteDomainStateSet::get_words(Index index) const
+{
+    const auto num_words = m_encoding->get_num_words();
+    return absl::MakeConstSpan(m_words.data() + index * num_words, num_words);
+}
+
+std::pair<Index, bool> FiniteDomainStateSet::insert(const FlatBitset& fluent_atoms)
+{
+    m_encoding->encode(fluent_atoms, m_buffer.data());
+
+    const auto it = m_indices.find(absl::MakeConstSpan(m_buffer));
+    if (it != m_indices.end())
+    {
+        return { *it, false };
+    }
+
+    const auto index = static_cast<Index>(size());
+    m_words.insert(m_words.end(), m_buffer.begin(), m_buffer.end());
+    m_indices.insert(index);
+
+    return { index, true };
+}
+
+bool FiniteDomainStateSet::contains(const FlatBitset& fluent_atoms) const
+{
+    m_encoding->encode(fluent_atoms, m_buffer.data());
+
+    return m_indices.contains(absl::MakeConstSpan(m_buffer));
+}
+
+void FiniteDomainStateSet::get_fluent_atoms(Index index, FlatBitset& out_fluent_atoms) const
+{
+    m_encoding->decode(get_words(index).data(), out_fluent_atoms);
+}
+
+const FiniteDomainStateEncoding& FiniteDomainStateSet::get_encoding() const { return m_encoding; }
+
+size_t FiniteDomainStateSet::size() const { return m_indices.size(); }
+
+size_t FiniteDomainStateSet::get_estimated_memory_usage_in_bytes() const
+{
+    return m_words.capacity() * sizeof(uint64_t) + m_buffer.capacity() * sizeof(uint64_t) + m_indices.capacity() * (sizeof(Index) + 1);
+}
+
+}
@@ -21,6 +21,7 @@
 #include "mimir/formalism/formatter.hpp"
 #include "mimir/search/algorithms/astar_eager/event_handlers/statistics.hpp"
 #include "mimir/search/algorithms/astar_lazy/event_handlers/statistics.hpp"
+#include "mimir/search/algorithms/bfws/event_handlers/statistics.hpp"
 #include "mimir/search/algorithms/brfs/event_handlers/statistics.hpp"
 #include "mimir/search/algorithms/gbfs_eager/event_handlers/statistics.hpp"
 #include "mimir/search/algorithms/gbfs_lazy/event_handlers/statistics.hpp"
@@ -82,6 +83,11 @@ namespace astar_lazy
 std::ostream& operator<<(std::ostream& out, const Statistics& element) { return mimir::print(out, element); }
 }  // end astar_lazy
 
+namespace bfws
+{
+std::ostream& operator<<(std::ostream& out, const Statistics& element) { return mimir::print(out, element); }
+}  // end bfws
+
 namespace brfs
 {
 std::ostream& operator<<(std::ostream& out, const Statistics& element) { return mimir::print(out, element); }
@@ -116,6 +122,11 @@ std::ostream& print(std::ostream& out, const mimir::search::astar_eager::Statist
                "[AStar] Number of generated states: {}\n"
                "[AStar] Number of expanded states: {}\n"
                "[AStar] Number of pruned states: {}\n"
+               "[AStar] Number of heuristic cache hits: {}\n"
+               "[AStar] Number of heuristic cache misses: {}\n"
+               "[AStar] Number of unpacked state cache hits: {}\n"
+               "[AStar] Number of unpacked state cache misses: {}\n"
+               "[AStar] Number of bytes for unpacked state cache: {}\n"
                "[AStar] Number of generated states until last f-layer: {}\n"
                "[AStar] Number of expanded states until last f-layer: {}\n"
                "[AStar] Number of pruned states until last f-layer: {}\n"
@@ -127,6 +138,11 @@ std::ostream& print(std::ostream& out, const mimir::search::astar_eager::Statist
                element.get_num_generated(),
                element.get_num_expanded(),
                element.get_num_pruned(),
+               element.get_num_heuristic_cache_hits(),
+               element.get_num_heuristic_cache_misses(),
+               element.get_num_unpacked_state_cache_hits(),
+               element.get_num_unpacked_state_cache_misses(),
+               element.get_num_bytes_for_unpacked_state_cache(),
                element.get_num_generated_until_f_value().empty() ? 0 : element.get_num_generated_until_f_value().rbegin()->second,
                element.get_num_expanded_until_f_value().empty() ? 0 : element.get_num_expanded_until_f_value().rbegin()->second,
                element.get_num_pruned_until_f_value().empty() ? 0 : element.get_num_pruned_until_f_value().rbegin()->second,
@@ -167,6 +183,39 @@ std::ostream& print(std::ostream& out, const mimir::search::astar_lazy::Statisti
     return out;
 }
 
+std::ostream& print(std::ostream& out, const mimir::search::bfws::Statistics& element)
+{
+    fmt::print(out,
+               "[BFWS] Search time: {}ms\n"
+               "[BFWS] Number of generated states: {}\n"
+               "[BFWS] Number of generated states by novelty: {}\n"
+               "[BFWS] Number of expanded states: {}\n"
+               "[BFWS] Number of pruned states: {}\n"
+               "[BFWS] Number of dead end states: {}\n"
+               "[BFWS] Number of relaxed plans: {}\n"
+               "[BFWS] Number of novelty partitions: {}\n"
+               "[BFWS] Novelty table memory usage: {} bytes\n"
+               "[BFWS] Number of reached fluent atoms: {}\n"
+               "[BFWS] Number of reached derived atoms: {}\n"
+               "[BFWS] Number of states: {}\n"
+               "[BFWS] Number of nodes: {}",
+               element.get_search_time_ms().count(),
+               element.get_num_generated(),
+               element.get_num_generated_by_novelty(),
+               element.get_num_expanded(),
+               element.get_num_pruned(),
+               element.get_num_deadends(),
+               element.get_num_relaxed_plans(),
+               element.get_num_partitions(),
+               element.get_novelty_table_memory_usage_in_bytes(),
+               element.get_num_reached_fluent_atoms(),
+               element.get_num_reached_derived_atoms(),
+               element.get_num_states(),
+               element.get_num_nodes());
+
+    return out;
+}
+
 std::ostream& print(std::ostream& out, const mimir::search::brfs::Statistics& element)
 {
     fmt::print(out,
@@ -193,6 +242,15 @@ std::ostream& print(std::ostream& out, const mimir::search::brfs::Statistics& el
                element.get_num_states(),
                element.get_num_nodes());
 
+    if (element.get_num_bitstate_bits() > 0)
+    {
+        fmt::print(out,
+                   "\n[BrFS] Number of bitstate bits: {}\n"
+                   "[BrFS] Estimated omission probability: {}",
+                   element.get_num_bitstate_bits(),
+                   element.get_estimated_omission_probability());
+    }
+
     return out;
 }
 
@@ -203,6 +261,11 @@ std::ostream& print(std::ostream& out, const mimir::search::gbfs_eager::Statisti
                "[GBFS] Number of generated states: {}\n"
                "[GBFS] Number of expanded states: {}\n"
                "[GBFS] Number of pruned states: {}\n"
+               "[GBFS] Number of heuristic cache hits: {}\n"
+               "[GBFS] Number of heuristic cache misses: {}\n"
+               "[GBFS] Number of unpacked state cache hits: {}\n"
+               "[GBFS] Number of unpacked state cache misses: {}\n"
+               "[GBFS] Number of bytes for unpacked state cache: {}\n"
                "[GBFS] Number of reached fluent atoms: {}\n"
                "[GBFS] Number of reached derived atoms: {}\n"
                "[GBFS] Number of states: {}\n"
@@ -211,6 +274,11 @@ std::ostream& print(std::ostream& out, const mimir::search::gbfs_eager::Statisti
                element.get_num_generated(),
                element.get_num_expanded(),
                element.get_num_pruned(),
+               element.get_num_heuristic_cache_hits(),
+               element.get_num_heuristic_cache_misses(),
+               element.get_num_unpacked_state_cache_hits(),
+               element.get_num_unpacked_state_cache_misses(),
+               element.get_num_bytes_for_unpacked_state_cache(),
                element.get_num_reached_fluent_atoms(),
                element.get_num_reached_derived_atoms(),
                element.get_num_states(),
@@ -252,7 +320,8 @@ std::ostream& print(std::ostream& out, const mimir::search::iw::Statistics& elem
                "[IW] Number of pruned states: {}\n"
                "[IW] Number of generated states until last g-layer: {}\n"
                "[IW] Number of expanded states until last g-layer: {}\n"
-               "[IW] Number of pruned states until last g-layer: {}",
+               "[IW] Number of pruned states until last g-layer: {}\n"
+               "[IW] Novelty table memory usage: {} bytes",
                element.get_search_time_ms().count(),
                element.get_effective_width(),
                element.get_brfs_statistics_by_arity().back().get_num_generated(),
@@ -266,7 +335,8 @@ std::ostream& print(std::ostream& out, const mimir::search::iw::Statistics& elem
                    element.get_brfs_statistics_by_arity().back().get_num_expanded_until_g_value().back(),
                element.get_brfs_statistics_by_arity().back().get_num_pruned_until_g_value().empty() ?
                    0 :
-                   element.get_brfs_statistics_by_arity().back().get_num_pruned_until_g_value().back());
+                   element.get_brfs_statistics_by_arity().back().get_num_pruned_until_g_value().back(),
+               element.get_novelty_table_memory_usage_in_bytes_by_arity().empty() ? 0 : element.get_novelty_table_memory_usage_in_bytes_by_arity().back());
 
     return out;
 }
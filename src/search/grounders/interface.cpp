@@ -108,15 +108,28 @@ IGrounder::create_grounded_applicable_action_generator(const match_tree::Options
     event_handler->on_start_ground_action_instantiation();
     const auto start_time = std::chrono::high_resolution_clock::now();
 
-    auto& problem = *m_problem;
-    auto& repositories = problem.get_repositories();
-
-    auto ground_actions = create_ground_actions();
+    const auto ground_actions = create_ground_actions();
 
     const auto end_time = std::chrono::high_resolution_clock::now();
     const auto total_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     event_handler->on_finish_ground_action_instantiation(total_time);
 
+    return create_grounded_applicable_action_generator(ground_actions, options, std::move(event_handler));
+}
+
+GroundedApplicableActionGenerator
+IGrounder::create_grounded_applicable_action_generator(const GroundActionList& ground_actions,
+                                                       const match_tree::Options& options,
+                                                       GroundedApplicableActionGeneratorImpl::EventHandler event_handler) const
+{
+    if (!event_handler)
+    {
+        event_handler = GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create();
+    }
+
+    auto& problem = *m_problem;
+    auto& repositories = problem.get_repositories();
+
     event_handler->on_start_build_action_match_tree();
 
     auto match_tree = match_tree::MatchTreeImpl<GroundActionImpl>::create(repositories, ground_actions, options);
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/heuristics/cache.hpp"
+
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/state.hpp"
+
+#include <cmath>
+
+namespace mimir::search
+{
+
+/* Unknown values are marked as NaN since no heuristic yields NaN. */
+static constexpr ContinuousCost UNKNOWN_H_VALUE = std::numeric_limits<ContinuousCost>::quiet_NaN();
+
+HeuristicCacheImpl::HeuristicCacheImpl(size_t max_num_bytes) :
+    m_values(),
+    m_max_num_entries(max_num_bytes / sizeof(ContinuousCost)),
+    m_num_hits(0),
+    m_num_misses(0)
+{
+}
+
+HeuristicCache HeuristicCacheImpl::create(size_t max_num_bytes) { return std::make_shared<HeuristicCacheImpl>(max_num_bytes); }
+
+std::pair<ContinuousCost, bool> HeuristicCacheImpl::get_or_compute_heuristic(IHeuristic& heuristic, const State& state)
+{
+    if (const auto h_value = get(state.get_index()))
+    {
+        ++m_num_hits;
+        return std::make_pair(h_value.value(), true);
+    }
+
+    ++m_num_misses;
+    const auto h_value = heuristic.compute_heuristic(state);
+    insert(state.get_index(), h_value);
+    return std::make_pair(h_value, false);
+}
+
+std::pair<ContinuousCost, bool> HeuristicCacheImpl::get_or_insert_heuristic(const State& state, ContinuousCost h_value)
+{
+    if (const auto cached_h_value = get(state.get_index()))
+    {
+        ++m_num_hits;
+        return std::make_pair(cached_h_value.value(), true);
+    }
+
+    ++m_num_misses;
+    insert(state.get_index(), h_value);
+    return std::make_pair(h_value, false);
+}
+
+std::optional<ContinuousCost> HeuristicCacheImpl::get(Index state_index) const
+{
+    if (state_index >= m_values.size() || std::isnan(m_values[state_index]))
+    {
+        return std::nullopt;
+    }
+    return m_values[state_index];
+}
+
+void HeuristicCacheImpl::insert(Index state_index, ContinuousCost h_value)
+{
+    if (state_index >= m_max_num_entries)
+    {
+        return;
+    }
+    while (state_index >= m_values.size())
+    {
+        m_values.push_back(UNKNOWN_H_VALUE);
+    }
+    m_values[state_index] = h_value;
+}
+
+void HeuristicCacheImpl::clear()
+{
+    m_values = SegmentedVector<ContinuousCost>();
+    m_num_hits = 0;
+    m_num_misses = 0;
+}
+
+size_t HeuristicCacheImpl::get_max_num_entries() const { return m_max_num_entries; }
+
+uint64_t HeuristicCacheImpl::get_num_hits() const { return m_num_hits; }
+
+uint64_t HeuristicCacheImpl::get_num_misses() const { return m_num_misses; }
+
+size_t HeuristicCacheImpl::get_estimated_memory_usage_in_bytes() const { return m_values.size() * sizeof(ContinuousCost); }
+}
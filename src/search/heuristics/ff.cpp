@@ -201,7 +201,7 @@ DiscreteCost FFHeuristicImpl::extract_impl(const State& state)
     // Ensure that this function is called only if the goal is satisfied in the relaxed exploration.
     assert(this->m_num_unsat_goals == 0);
 
-    get_relaxed_plan().clear();
+    m_relaxed_plan.clear();
     this->m_preferred_actions.data.clear();
 
     for (const auto proposition_index : this->get_goal_propositions())
@@ -212,7 +212,7 @@ DiscreteCost FFHeuristicImpl::extract_impl(const State& state)
     // std::cout << "Total cost: " << get_relaxed_plan().size() << std::endl;
     // std::cout << "Num preferred actions: " << get_preferred_actions().size() << std::endl;
 
-    return get_relaxed_plan().size();
+    return m_relaxed_plan.size();
 }
 
 }
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/interface.hpp"
+
+#include "mimir/search/state.hpp"
+
+#include <stdexcept>
+
+namespace mimir::search
+{
+
+void IHeuristic::compute_heuristics(std::span<const State> states, std::span<ContinuousCost> out_values, formalism::GroundConjunctiveCondition goal)
+{
+    if (states.size() != out_values.size())
+    {
+        throw std::runtime_error("IHeuristic::compute_heuristics: the number of states and values must be equal.");
+    }
+
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        out_values[i] = compute_heuristic(states[i], goal);
+    }
+}
+
+}
@@ -17,6 +17,10 @@
 
 #include "mimir/search/heuristics/max.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
 namespace mimir::search
 {
 using namespace rpg;
@@ -25,7 +29,32 @@ using namespace rpg;
  * HMax
  */
 
-MaxHeuristicImpl::MaxHeuristicImpl(const IGrounder& grounder) : RelaxedPlanningGraph<MaxHeuristicImpl>(grounder) {}
+MaxHeuristicImpl::MaxHeuristicImpl(const IGrounder& grounder) :
+    RelaxedPlanningGraph<MaxHeuristicImpl>(grounder),
+    m_bit_parallel_actions(),
+    m_bit_parallel_axioms(),
+    m_reached(),
+    m_next_reached()
+{
+    auto action_effects = IndexList {};
+    for (const auto& action : get<Action>(this->get_structures()))
+    {
+        action_effects.push_back(action.get_polarity() ? get<formalism::PositiveTag, formalism::FluentTag>(this->get_offsets())[action.get_effect()] :
+                                                         get<formalism::NegativeTag, formalism::FluentTag>(this->get_offsets())[action.get_effect()]);
+    }
+    m_bit_parallel_actions = create_bit_parallel_structures(get<Action>(this->get_structures()), action_effects, this->get_propositions());
+
+    auto axiom_effects = IndexList {};
+    for (const auto& axiom : get<Axiom>(this->get_structures()))
+    {
+        axiom_effects.push_back(axiom.get_polarity() ? get<formalism::PositiveTag, formalism::DerivedTag>(this->get_offsets())[axiom.get_effect()] :
+                                                       get<formalism::NegativeTag, formalism::DerivedTag>(this->get_offsets())[axiom.get_effect()]);
+    }
+    m_bit_parallel_axioms = create_bit_parallel_structures(get<Axiom>(this->get_structures()), axiom_effects, this->get_propositions());
+
+    m_reached.resize(this->get_propositions().size());
+    m_next_reached.resize(this->get_propositions().size());
+}
 
 MaxHeuristic MaxHeuristicImpl::create(const IGrounder& grounder) { return std::make_shared<MaxHeuristicImpl>(grounder); }
 
@@ -114,4 +143,136 @@ DiscreteCost MaxHeuristicImpl::extract_impl(const State&)
 
     return total_cost;
 }
+
+/**
+ * Bit-parallel HMax
+ */
+
+template<IsStructure S>
+MaxHeuristicImpl::BitParallelStructures
+MaxHeuristicImpl::create_bit_parallel_structures(const std::vector<S>& structures, const IndexList& effects, const PropositionList& propositions)
+{
+    // Invert the "is precondition of" relation, where the dummy proposition is always reached.
+    auto structure_preconditions = std::vector<IndexList>(structures.size());
+    for (const auto& proposition : propositions)
+    {
+        if (proposition.get_index() != DUMMY_PROPOSITION_INDEX)
+        {
+            for (const auto structure_index : proposition.template is_precondition_of<S>())
+            {
+                structure_preconditions[structure_index].push_back(proposition.get_index());
+            }
+        }
+    }
+
+    auto result = BitParallelStructures();
+    result.precondition_begins.push_back(0);
+    for (const auto& structure : structures)
+    {
+        const auto& preconditions = structure_preconditions[structure.get_index()];
+        result.preconditions.insert(result.preconditions.end(), preconditions.begin(), preconditions.end());
+        result.precondition_begins.push_back(result.preconditions.size());
+        // The counting exploration never applies a structure with a precondition that is not linked to it.
+        result.effects.push_back((preconditions.size() == structure.get_num_preconditions()) ? effects[structure.get_index()] : MAX_INDEX);
+    }
+    return result;
+}
+
+bool MaxHeuristicImpl::apply_bit_parallel_structures(const BitParallelStructures& structures,
+                                                     uint64_t active,
+                                                     const std::vector<uint64_t>& reached,
+                                                     std::vector<uint64_t>& ref_next_reached)
+{
+    auto changed = false;
+    for (size_t i = 0; i < structures.effects.size(); ++i)
+    {
+        const auto effect = structures.effects[i];
+        if (effect == MAX_INDEX || (ref_next_reached[effect] & active) == active)
+        {
+            continue;
+        }
+
+        auto applicable = active;
+        for (auto j = structures.precondition_begins[i]; j < structures.precondition_begins[i + 1] && applicable; ++j)
+        {
+            applicable &= reached[structures.preconditions[j]];
+        }
+
+        if (applicable & ~ref_next_reached[effect])
+        {
+            ref_next_reached[effect] |= applicable;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void MaxHeuristicImpl::compute_heuristics_chunk(std::span<const State> states, std::span<ContinuousCost> out_values)
+{
+    assert(states.size() <= 64);
+
+    const auto active = (states.size() == 64) ? ~uint64_t(0) : (uint64_t(1) << states.size()) - 1;
+
+    /* Layer 0: the propositions that are true in each state. */
+
+    std::fill(m_reached.begin(), m_reached.end(), 0);
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        const auto bit = uint64_t(1) << i;
+        this->for_each_initial_proposition(states[i], [&](const Proposition& proposition) { m_reached[proposition.get_index()] |= bit; });
+    }
+
+    auto unsolved = active;
+    for (auto layer = DiscreteCost(0);; ++layer)
+    {
+        // Axioms have cost 0, hence they are applied until a fixed point within the layer.
+        while (apply_bit_parallel_structures(m_bit_parallel_axioms, active, m_reached, m_reached)) {}
+
+        auto solved = active;
+        for (const auto proposition_index : this->get_goal_propositions())
+        {
+            solved &= m_reached[proposition_index];
+        }
+        for (auto newly_solved = solved & unsolved; newly_solved; newly_solved &= newly_solved - 1)
+        {
+            out_values[std::countr_zero(newly_solved)] = layer;
+        }
+        unsolved &= ~solved;
+
+        if (!unsolved)
+        {
+            return;
+        }
+
+        // Actions have cost 1, hence their effects are only available in the next layer.
+        m_next_reached = m_reached;
+        if (!apply_bit_parallel_structures(m_bit_parallel_actions, active, m_reached, m_next_reached))
+        {
+            break;
+        }
+        std::swap(m_reached, m_next_reached);
+    }
+
+    for (; unsolved; unsolved &= unsolved - 1)
+    {
+        out_values[std::countr_zero(unsolved)] = INFINITY_CONTINUOUS_COST;
+    }
+}
+
+void MaxHeuristicImpl::compute_heuristics(std::span<const State> states, std::span<ContinuousCost> out_values, formalism::GroundConjunctiveCondition goal)
+{
+    if (states.size() != out_values.size())
+    {
+        throw std::runtime_error("MaxHeuristicImpl::compute_heuristics: the number of states and values must be equal.");
+    }
+
+    if (goal)
+        initialize_goal_propositions(goal, this->get_offsets(), this->get_proposition_annotations(), this->get_goal_propositions());
+
+    for (size_t offset = 0; offset < states.size(); offset += 64)
+    {
+        const auto size = std::min(states.size() - offset, size_t(64));
+        compute_heuristics_chunk(states.subspan(offset, size), out_values.subspan(offset, size));
+    }
+}
 }
@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/mutex_groups.hpp"
+
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/ground_effects.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/predicate.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <algorithm>
+#include <deque>
+#include <ranges>
+#include <set>
+
+using namespace mimir::formalism;
+
+namespace mimir::search
+{
+
+/// @brief A part of a candidate invariant: the atoms of a fluent predicate, whose instance is given by the objects at the key positions.
+/// At most one argument position is not a key position, and it is counted.
+struct Part
+{
+    Index predicate;
+    IndexList key_positions;
+
+    auto operator<=>(const Part& other) const = default;
+};
+
+/// @brief A candidate invariant: the atoms of its parts with the same instance form a mutex group.
+using Candidate = std::vector<Part>;
+
+static constexpr size_t MAX_NUM_PARTS = 4;
+static constexpr size_t MAX_NUM_CANDIDATES = 10000;
+
+static const Part* get_part(const Candidate& candidate, GroundAtom<FluentTag> atom)
+{
+    for (const auto& part : candidate)
+    {
+        if (part.predicate == atom->get_predicate()->get_index())
+        {
+            return &part;
+        }
+    }
+    return nullptr;
+}
+
+static IndexList get_instance(const Part& part, GroundAtom<FluentTag> atom)
+{
+    auto instance = IndexList {};
+    for (const auto position : part.key_positions)
+    {
+        instance.push_back(atom->get_objects()[position]->get_index());
+    }
+    return instance;
+}
+
+template<std::ranges::input_range Range>
+static bool contains(const Range& range, Index element)
+{
+    for (const auto other : range)
+    {
+        if (other == element)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool is_unconditional(GroundConditionalEffect effect)
+{
+    const auto condition = effect->get_conjunctive_condition();
+    return condition->get_num_preconditions<StaticTag, FluentTag, DerivedTag>() == 0 && condition->get_numeric_constraints().empty();
+}
+
+/// @brief Test whether the initial state contains at most one atom of each instance of the candidate.
+static bool is_initially_satisfied(const Candidate& candidate, const ProblemImpl& problem)
+{
+    auto instances = absl::flat_hash_set<IndexList> {};
+    for (const auto& atom : problem.get_fluent_initial_atoms())
+    {
+        const auto part = get_part(candidate, atom);
+        if (part && !instances.insert(get_instance(*part, atom)).second)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Extend the candidate by a part for `atom` such that the instance of `atom` is `instance`.
+static void refine(const Candidate& candidate, GroundAtom<FluentTag> atom, const IndexList& instance, std::vector<Candidate>& out_candidates)
+{
+    const auto arity = atom->get_arity();
+    if (candidate.size() >= MAX_NUM_PARTS || get_part(candidate, atom) || (arity != instance.size() && arity != instance.size() + 1))
+    {
+        return;
+    }
+
+    for (size_t counted_position = 0; counted_position < arity + 1; ++counted_position)
+    {
+        if ((arity == instance.size()) != (counted_position == arity))
+        {
+            continue;
+        }
+
+        // Map each key position to an argument position with the same object.
+        auto key_positions = IndexList {};
+        auto used = std::vector<bool>(arity, false);
+        for (const auto object : instance)
+        {
+            for (size_t position = 0; position < arity; ++position)
+            {
+                if (position != counted_position && !used[position] && atom->get_objects()[position]->get_index() == object)
+                {
+                    key_positions.push_back(position);
+                    used[position] = true;
+                    break;
+                }
+            }
+        }
+        if (key_positions.size() == instance.size())
+        {
+            auto refined_candidate = candidate;
+            refined_candidate.push_back(Part { atom->get_predicate()->get_index(), std::move(key_positions) });
+            std::sort(refined_candidate.begin(), refined_candidate.end());
+            out_candidates.push_back(std::move(refined_candidate));
+        }
+    }
+}
+
+/// @brief Test whether every atom of the candidate that `action` can add is balanced by a delete of a required atom of the same instance.
+/// Otherwise, add the refinements of the candidate by the predicates of the required deleted atoms to `out_candidates`.
+static bool is_balanced(const Candidate& candidate, GroundAction action, const ProblemImpl& problem, std::vector<Candidate>& out_candidates)
+{
+    const auto& repositories = problem.get_repositories();
+    const auto is_required = [&](Index atom, GroundConditionalEffect effect)
+    {
+        return contains(action->get_conjunctive_condition()->get_precondition<PositiveTag, FluentTag>(), atom)
+               || contains(effect->get_conjunctive_condition()->get_precondition<PositiveTag, FluentTag>(), atom);
+    };
+
+    auto added_atoms = absl::flat_hash_set<Index> {};
+    for (const auto& effect : action->get_conditional_effects())
+    {
+        for (const auto atom : effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+        {
+            added_atoms.insert(atom);
+        }
+    }
+
+    // The single atom of each instance that the action may make true.
+    auto increased_instances = absl::flat_hash_map<IndexList, Index> {};
+
+    for (const auto& effect : action->get_conditional_effects())
+    {
+        for (const auto added_index : effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+        {
+            const auto added_atom = repositories.get_ground_atom<FluentTag>(added_index);
+            const auto added_part = get_part(candidate, added_atom);
+            if (!added_part || is_required(added_index, effect))
+            {
+                continue;
+            }
+
+            const auto instance = get_instance(*added_part, added_atom);
+            const auto [it, inserted] = increased_instances.emplace(instance, added_index);
+            if (!inserted && it->second != added_index)
+            {
+                return false;
+            }
+
+            auto is_balanced_by_delete = false;
+            auto unbalanced_deleted_atoms = GroundAtomList<FluentTag> {};
+            for (const auto& deleting_effect : action->get_conditional_effects())
+            {
+                if (deleting_effect != effect && !is_unconditional(deleting_effect))
+                {
+                    continue;
+                }
+                for (const auto deleted_index : deleting_effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>())
+                {
+                    if (deleted_index == added_index || !is_required(deleted_index, effect) || added_atoms.contains(deleted_index))
+                    {
+                        continue;
+                    }
+                    const auto deleted_atom = repositories.get_ground_atom<FluentTag>(deleted_index);
+                    const auto deleted_part = get_part(candidate, deleted_atom);
+                    if (!deleted_part)
+                    {
+                        unbalanced_deleted_atoms.push_back(deleted_atom);
+                    }
+                    else if (get_instance(*deleted_part, deleted_atom) == instance)
+                    {
+                        is_balanced_by_delete = true;
+                    }
+                }
+            }
+            if (!is_balanced_by_delete)
+            {
+                for (const auto& deleted_atom : unbalanced_deleted_atoms)
+                {
+                    refine(candidate, deleted_atom, instance, out_candidates);
+                }
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+MutexGroupList compute_mutex_groups(const IGrounder& grounder)
+{
+    const auto& problem = *grounder.get_problem();
+    const auto& repositories = problem.get_repositories();
+    const auto ground_actions = grounder.create_ground_actions();
+
+    /* Start from the candidates with a single part and refine unbalanced candidates. */
+    auto queue = std::deque<Candidate> {};
+    for (const auto& predicate : problem.get_domain()->get_predicates<FluentTag>())
+    {
+        const auto arity = predicate->get_arity();
+        for (size_t counted_position = 0; counted_position < std::max(arity, size_t(1)); ++counted_position)
+        {
+            auto key_positions = IndexList {};
+            for (size_t position = 0; position < arity; ++position)
+            {
+                if (position != counted_position)
+                {
+                    key_positions.push_back(position);
+                }
+            }
+            queue.push_back(Candidate { Part { predicate->get_index(), std::move(key_positions) } });
+        }
+    }
+
+    auto visited = std::set<Candidate>(queue.begin(), queue.end());
+    auto invariants = std::vector<Candidate> {};
+    auto refinements = std::vector<Candidate> {};
+    while (!queue.empty() && visited.size() <= MAX_NUM_CANDIDATES)
+    {
+        const auto candidate = std::move(queue.front());
+        queue.pop_front();
+
+        if (!is_initially_satisfied(candidate, problem))
+        {
+            continue;
+        }
+
+        refinements.clear();
+        const auto is_invariant =
+            std::all_of(ground_actions.begin(), ground_actions.end(), [&](auto&& action) { return is_balanced(candidate, action, problem, refinements); });
+        if (is_invariant)
+        {
+            invariants.push_back(candidate);
+        }
+        for (auto& refinement : refinements)
+        {
+            if (visited.insert(refinement).second)
+            {
+                queue.push_back(std::move(refinement));
+            }
+        }
+    }
+
+    /* Instantiate the groups over the atoms that were created by grounding. */
+    auto groups = std::set<MutexGroup> {};
+    for (const auto& invariant : invariants)
+    {
+        auto instance_to_group = absl::flat_hash_map<IndexList, MutexGroup> {};
+        for (const auto& atom : repositories.get_ground_atoms<FluentTag>())
+        {
+            const auto part = get_part(invariant, atom);
+            if (part)
+            {
+                instance_to_group[get_instance(*part, atom)].push_back(atom->get_index());
+            }
+        }
+        for (auto& [instance, group] : instance_to_group)
+        {
+            if (group.size() >= 2)
+            {
+                std::sort(group.begin(), group.end());
+                groups.insert(std::move(group));
+            }
+        }
+    }
+
+    return MutexGroupList(groups.begin(), groups.end());
+}
+
+}
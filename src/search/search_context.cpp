@@ -19,11 +19,14 @@
 
 #include "mimir/common/declarations.hpp"
 #include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
 #include "mimir/search/applicable_action_generators.hpp"
 #include "mimir/search/axiom_evaluators.hpp"
 #include "mimir/search/grounders.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <valla/indexed_hash_set.hpp>
+
 using namespace mimir::formalism;
 
 namespace mimir::search
@@ -32,7 +35,11 @@ namespace mimir::search
 SearchContextImpl::SearchContextImpl(formalism::Problem problem, ApplicableActionGenerator applicable_action_generator, StateRepository state_repository) :
     m_problem(std::move(problem)),
     m_applicable_action_generator(std::move(applicable_action_generator)),
-    m_state_repository(std::move(state_repository))
+    m_state_repository(std::move(state_repository)),
+    m_ground_action_storage(),
+    m_ground_conjunctive_condition_storage(),
+    m_ground_conjunctive_effect_storage(),
+    m_ground_axiom_storage()
 {
 }
 
@@ -43,6 +50,15 @@ SearchContext SearchContextImpl::create(const fs::path& domain_filepath, const f
 
 SearchContext SearchContextImpl::create(Problem problem, const Options& options)
 {
+    const auto create_lifted_applicable_action_generator = [&](ApplicableActionGenerator applicable_action_generator) -> ApplicableActionGenerator
+    {
+        if (options.stubborn_sets)
+        {
+            return StubbornSetsApplicableActionGeneratorImpl::create(std::move(applicable_action_generator));
+        }
+        return applicable_action_generator;
+    };
+
     return std::visit(
         [&](auto&& mode) -> SearchContext
         {
@@ -52,8 +68,20 @@ SearchContext SearchContextImpl::create(Problem problem, const Options& options)
             {
                 auto grounder = std::make_unique<LiftedGrounder>(problem);
 
+                // Ground the actions once for both the match tree and, if enabled, the interference relation.
+                const auto ground_actions = grounder->create_ground_actions();
+
+                auto applicable_action_generator = ApplicableActionGenerator(grounder->create_grounded_applicable_action_generator(ground_actions));
+                if (options.stubborn_sets)
+                {
+                    auto stubborn_sets_options = StubbornSetsApplicableActionGeneratorImpl::Options();
+                    stubborn_sets_options.precompute_interference = true;
+                    applicable_action_generator =
+                        StubbornSetsApplicableActionGeneratorImpl::create(std::move(applicable_action_generator), ground_actions, stubborn_sets_options);
+                }
+
                 return create(problem,
-                              grounder->create_grounded_applicable_action_generator(),
+                              std::move(applicable_action_generator),
                               std::make_shared<StateRepositoryImpl>(grounder->create_grounded_axiom_evaluator()));
             }
             else if constexpr (std::is_same_v<ModeT, LiftedOptions>)
@@ -66,13 +94,13 @@ SearchContext SearchContextImpl::create(Problem problem, const Options& options)
                         if constexpr (std::is_same_v<OptionT, LiftedOptions::KPKCOptions>)
                         {
                             return create(problem,
-                                          std::make_shared<KPKCLiftedApplicableActionGeneratorImpl>(problem, option),
+                                          create_lifted_applicable_action_generator(std::make_shared<KPKCLiftedApplicableActionGeneratorImpl>(problem, option)),
                                           std::make_shared<StateRepositoryImpl>(std::make_shared<KPKCLiftedAxiomEvaluatorImpl>(problem)));
                         }
                         else if constexpr (std::is_same_v<OptionT, LiftedOptions::ExhaustiveOptions>)
                         {
                             return create(problem,
-                                          std::make_shared<ExhaustiveLiftedApplicableActionGeneratorImpl>(problem),
+                                          create_lifted_applicable_action_generator(std::make_shared<ExhaustiveLiftedApplicableActionGeneratorImpl>(problem)),
                                           std::make_shared<StateRepositoryImpl>(std::make_shared<ExhaustiveLiftedAxiomEvaluatorImpl>(problem)));
                         }
                         else
@@ -109,4 +137,76 @@ const Problem& SearchContextImpl::get_problem() const { return m_problem; }
 const ApplicableActionGenerator SearchContextImpl::get_applicable_action_generator() const { return m_applicable_action_generator; }
 
 const StateRepository SearchContextImpl::get_state_repository() const { return m_state_repository; }
+
+size_t SearchContextImpl::MemoryUsage::get_total() const
+{
+    return num_bytes_for_index_tree_table + num_bytes_for_double_leaf_table + num_bytes_for_states + num_bytes_for_ground_actions
+           + num_bytes_for_ground_axioms + num_bytes_for_lists;
+}
+
+/// @brief Estimate the memory of a repository from its elements and the pointer and index stored per element in its hash map.
+template<typename T>
+static size_t get_repository_memory_usage_in_bytes(const Repositories& repositories)
+{
+    const auto& repository = boost::hana::at_key(repositories.get_hana_repositories(), boost::hana::type<T> {});
+
+    return repository.size() * (sizeof(T) + sizeof(const T*) + sizeof(Index) + 1);
+}
+
+/// @brief The bytes of the vectors owned by a ground object.
+static size_t get_dynamic_storage_in_bytes(const GroundActionImpl& action)
+{
+    return action.get_objects().capacity() * sizeof(Object) + action.get_conditional_effects().capacity() * sizeof(GroundConditionalEffect);
+}
+
+static size_t get_dynamic_storage_in_bytes(const GroundConjunctiveConditionImpl& condition)
+{
+    return condition.get_numeric_constraints().capacity() * sizeof(GroundNumericConstraint);
+}
+
+static size_t get_dynamic_storage_in_bytes(const GroundConjunctiveEffectImpl& effect)
+{
+    return effect.get_fluent_numeric_effects().capacity() * sizeof(GroundNumericEffect<FluentTag>);
+}
+
+static size_t get_dynamic_storage_in_bytes(const GroundAxiomImpl& axiom) { return axiom.get_objects().capacity() * sizeof(Object); }
+
+/// @brief Add the dynamic storage of the ground objects that were created since the last update of `ref_storage`.
+template<typename T, typename Storage>
+static size_t update_dynamic_storage(const Repositories& repositories, Storage& ref_storage)
+{
+    const auto& repository = boost::hana::at_key(repositories.get_hana_repositories(), boost::hana::type<T> {});
+
+    for (; ref_storage.num_objects < repository.size(); ++ref_storage.num_objects)
+    {
+        ref_storage.num_bytes += get_dynamic_storage_in_bytes(*repository.at(ref_storage.num_objects));
+    }
+
+    return ref_storage.num_bytes;
+}
+
+SearchContextImpl::MemoryUsage SearchContextImpl::get_memory_usage() const
+{
+    const auto& repositories = m_problem->get_repositories();
+
+    auto memory_usage = MemoryUsage();
+    memory_usage.num_bytes_for_index_tree_table = m_problem->get_index_tree_table().mem_usage();
+    memory_usage.num_bytes_for_double_leaf_table = m_problem->get_double_leaf_table().mem_usage();
+    memory_usage.num_bytes_for_states = m_state_repository->get_estimated_memory_usage_in_bytes();
+    memory_usage.num_bytes_for_ground_actions = get_repository_memory_usage_in_bytes<GroundActionImpl>(repositories)
+                                                + get_repository_memory_usage_in_bytes<GroundConjunctiveConditionImpl>(repositories)
+                                                + get_repository_memory_usage_in_bytes<GroundConditionalEffectImpl>(repositories)
+                                                + get_repository_memory_usage_in_bytes<GroundConjunctiveEffectImpl>(repositories)
+                                                + get_repository_memory_usage_in_bytes<GroundNumericConstraintImpl>(repositories)
+                                                + get_repository_memory_usage_in_bytes<GroundNumericEffectImpl<FluentTag>>(repositories)
+                                                + get_repository_memory_usage_in_bytes<GroundNumericEffectImpl<AuxiliaryTag>>(repositories)
+                                                + update_dynamic_storage<GroundActionImpl>(repositories, m_ground_action_storage)
+                                                + update_dynamic_storage<GroundConjunctiveConditionImpl>(repositories, m_ground_conjunctive_condition_storage)
+                                                + update_dynamic_storage<GroundConjunctiveEffectImpl>(repositories, m_ground_conjunctive_effect_storage);
+    memory_usage.num_bytes_for_ground_axioms =
+        get_repository_memory_usage_in_bytes<GroundAxiomImpl>(repositories) + update_dynamic_storage<GroundAxiomImpl>(repositories, m_ground_axiom_storage);
+    memory_usage.num_bytes_for_lists = m_problem->get_estimated_memory_usage_of_lists_in_bytes();
+
+    return memory_usage;
+}
 }
@@ -17,17 +17,26 @@
 
 #include "mimir/search/state_repository.hpp"
 
+#include "cista/containers/string.h"
+#include "cista/containers/vector.h"
+#include "cista/mmap.h"
+#include "cista/serialization.h"
+#include "cista/targets/buf.h"
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/domain.hpp"
 #include "mimir/formalism/ground_action.hpp"
 #include "mimir/formalism/ground_atom.hpp"
 #include "mimir/formalism/ground_literal.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/predicate.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/formalism/repositories.hpp"
 #include "mimir/search/applicability.hpp"
 #include "mimir/search/axiom_evaluators/interface.hpp"
 #include "mimir/search/search_context.hpp"
 
+#include <absl/container/flat_hash_map.h>
+#include <algorithm>
 #include <valla/indexed_hash_set.hpp>
 #include <valla/valla.hpp>
 
@@ -50,19 +59,168 @@ ContinuousCost compute_state_metric_value(const State& state)
                0.;
 }
 
-StateRepositoryImpl::StateRepositoryImpl(AxiomEvaluator axiom_evaluator) :
+/// @brief Lock `mutex` only if the repository is thread-safe.
+template<typename Lock, typename Mutex>
+static Lock lock_if(Mutex& mutex, bool enabled)
+{
+    return enabled ? Lock(mutex) : Lock(mutex, std::defer_lock);
+}
+
+static std::atomic<uint64_t> s_next_repository_id = 1;
+
+StateRepositoryImpl::ThreadContext::ThreadContext(size_t unpacked_state_cache_size) :
+    candidate(),
+    successor_fluent_atoms(),
+    successor_parent_index(MAX_INDEX),
+    index_list(),
+    reached_fluent_atoms(),
+    reached_derived_atoms(),
+    unpacked_state_pool(),
+    unpacked_state_cache(unpacked_state_cache_size),
+    num_unpacked_state_cache_hits(0),
+    num_unpacked_state_cache_misses(0)
+{
+}
+
+StateRepositoryImpl::StateRepositoryImpl(AxiomEvaluator axiom_evaluator, const Options& options) :
+    m_options(options),
+    m_id(s_next_repository_id.fetch_add(1, std::memory_order_relaxed)),
     m_axiom_evaluator(std::move(axiom_evaluator)),
+    m_private_index_tree_table(options.private_tables ? std::make_unique<valla::IndexedHashSet<valla::Slot<Index>, Index>>() : nullptr),
+    m_private_double_leaf_table(options.private_tables ? std::make_unique<valla::IndexedHashSet<double, Index>>() : nullptr),
+    m_private_table_mutex(),
+    m_index_tree_table(options.private_tables ? m_private_index_tree_table.get() : &m_axiom_evaluator->get_problem()->get_index_tree_table()),
+    m_double_leaf_table(options.private_tables ? m_private_double_leaf_table.get() : &m_axiom_evaluator->get_problem()->get_double_leaf_table()),
+    m_table_mutex(options.private_tables ? &m_private_table_mutex : &m_axiom_evaluator->get_problem()->get_table_mutex()),
     m_states(),
+    m_state_mutexes((options.thread_safe) ? std::max(options.num_shards, size_t(1)) : 1),
+    m_num_states(0),
+    m_axiom_evaluator_mutex(),
+    m_thread_contexts_mutex(),
+    m_thread_contexts(),
+    m_num_released_unpacked_state_cache_hits(0),
+    m_num_released_unpacked_state_cache_misses(0),
     m_reached_fluent_atoms(),
-    m_reached_derived_atoms(),
-    m_applied_positive_effect_atoms(),
-    m_applied_negative_effect_atoms(),
-    m_index_list(),
-    m_unpacked_state_pool()
+    m_reached_derived_atoms()
+{
+    m_states.resize(m_state_mutexes.size());
+
+    // The context of the constructing thread is also used by all threads if the repository is not thread-safe.
+    m_thread_contexts.emplace_back(std::this_thread::get_id(), std::make_unique<ThreadContext>(m_options.unpacked_state_cache_size));
+}
+
+StateRepository StateRepositoryImpl::create(AxiomEvaluator axiom_evaluator, const Options& options)
+{
+    return std::make_shared<StateRepositoryImpl>(axiom_evaluator, options);
+}
+
+std::pair<uint64_t, StateRepositoryImpl::ThreadContext*>& StateRepositoryImpl::get_cached_thread_context()
+{
+    thread_local auto cached_thread_context = std::pair<uint64_t, ThreadContext*>(0, nullptr);
+    return cached_thread_context;
+}
+
+StateRepositoryImpl::ThreadContext& StateRepositoryImpl::get_thread_context()
+{
+    if (!m_options.thread_safe)
+    {
+        return *m_thread_contexts.front().second;
+    }
+
+    // Cache the context of the most recently used repository to avoid the lookup.
+    auto& [cached_id, cached_context] = get_cached_thread_context();
+
+    if (cached_id == m_id)
+    {
+        return *cached_context;
+    }
+
+    const auto thread_id = std::this_thread::get_id();
+
+    auto lock = std::lock_guard<std::mutex>(m_thread_contexts_mutex);
+
+    auto it = std::find_if(m_thread_contexts.begin(), m_thread_contexts.end(), [&](auto&& element) { return element.first == thread_id; });
+    if (it == m_thread_contexts.end())
+    {
+        m_thread_contexts.emplace_back(thread_id, std::make_unique<ThreadContext>(m_options.unpacked_state_cache_size));
+        it = std::prev(m_thread_contexts.end());
+    }
+
+    cached_id = m_id;
+    cached_context = it->second.get();
+
+    return *cached_context;
+}
+
+void StateRepositoryImpl::release_thread_context()
+{
+    if (!m_options.thread_safe)
+    {
+        return;
+    }
+
+    auto& [cached_id, cached_context] = get_cached_thread_context();
+    if (cached_id == m_id)
+    {
+        cached_id = 0;
+        cached_context = nullptr;
+    }
+
+    const auto thread_id = std::this_thread::get_id();
+
+    auto lock = std::lock_guard<std::mutex>(m_thread_contexts_mutex);
+
+    const auto it = std::find_if(m_thread_contexts.begin(), m_thread_contexts.end(), [&](auto&& element) { return element.first == thread_id; });
+    if (it == m_thread_contexts.end())
+    {
+        return;
+    }
+
+    const auto& thread_context = *it->second;
+    m_reached_fluent_atoms |= thread_context.reached_fluent_atoms;
+    m_reached_derived_atoms |= thread_context.reached_derived_atoms;
+    m_num_released_unpacked_state_cache_hits += thread_context.num_unpacked_state_cache_hits;
+    m_num_released_unpacked_state_cache_misses += thread_context.num_unpacked_state_cache_misses;
+
+    m_thread_contexts.erase(it);
+}
+
+size_t StateRepositoryImpl::get_shard(const PackedStateImpl& state) const
+{
+    if (m_states.size() == 1)
+    {
+        return 0;
+    }
+    // Select the shard from the high bits of a remixed hash because the shard-local hash maps consume the low bits.
+    const auto hash = static_cast<uint64_t>(loki::Hash<PackedStateImpl> {}(state)) * uint64_t(0x9E3779B97F4A7C15);
+    return (hash >> 32) % m_states.size();
+}
+
+std::pair<PackedState, Index> StateRepositoryImpl::find_state(const PackedStateImpl& state)
 {
+    const auto shard = get_shard(state);
+    auto lock = lock_if<std::unique_lock<std::mutex>>(m_state_mutexes[shard], m_options.thread_safe);
+
+    const auto it = m_states[shard].find(state);
+    if (it == m_states[shard].end())
+    {
+        return { nullptr, MAX_INDEX };
+    }
+    return { &it->first, it->second };
 }
 
-StateRepository StateRepositoryImpl::create(AxiomEvaluator axiom_evaluator) { return std::make_shared<StateRepositoryImpl>(axiom_evaluator); }
+std::pair<PackedState, Index> StateRepositoryImpl::get_or_create_state_index(const PackedStateImpl& state)
+{
+    const auto shard = get_shard(state);
+    auto lock = lock_if<std::unique_lock<std::mutex>>(m_state_mutexes[shard], m_options.thread_safe);
+
+    const auto [it, inserted] = m_states[shard].try_emplace(state, MAX_INDEX);
+    if (inserted)
+    {
+        it->second = m_num_states.fetch_add(1, std::memory_order_relaxed);
+    }
+    return { &it->first, it->second };
+}
 
 std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_initial_state()
 {
@@ -84,11 +242,13 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_state(const
                                                                           const FlatDoubleList& fluent_numeric_variables)
 {
     auto& problem = *m_axiom_evaluator->get_problem();
-    auto& index_tree_table = problem.get_index_tree_table();
-    auto& double_leaf_table = problem.get_double_leaf_table();
+    auto& index_tree_table = *m_index_tree_table;
+    auto& double_leaf_table = *m_double_leaf_table;
+    auto& thread_context = get_thread_context();
+    auto& index_list = thread_context.index_list;
 
     /* Dense state */
-    auto unpacked_state = m_unpacked_state_pool.get_or_allocate(problem);
+    auto unpacked_state = thread_context.unpacked_state_pool.get_or_allocate(problem);
     auto& dense_fluent_atoms = unpacked_state->get_atoms<FluentTag>();
     dense_fluent_atoms.unset_all();
     auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();
@@ -104,32 +264,41 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_state(const
     /* 2.1 Numeric state variables */
     dense_fluent_numeric_variables = fluent_numeric_variables;
 
-    m_index_list.clear();
-    valla::encode_as_unsigned_integrals(dense_fluent_numeric_variables, double_leaf_table, std::back_inserter(m_index_list));
-    state_numeric_variables = valla::insert_sequence(m_index_list, index_tree_table);
-
     /* 2.2. Propositional state */
     for (const auto& atom : atoms)
     {
         dense_fluent_atoms.set(atom->get_index());
     }
 
-    state_fluent_atoms_slot = valla::insert_sequence(dense_fluent_atoms, index_tree_table);
+    {
+        auto lock = lock_if<std::unique_lock<std::shared_mutex>>(*m_table_mutex, m_options.thread_safe);
+
+        index_list.clear();
+        valla::encode_as_unsigned_integrals(dense_fluent_numeric_variables, double_leaf_table, std::back_inserter(index_list));
+        state_numeric_variables = valla::insert_sequence(index_list, index_tree_table);
+
+        state_fluent_atoms_slot = valla::insert_sequence(dense_fluent_atoms, index_tree_table);
+    }
 
-    update_reached_fluent_atoms(dense_fluent_atoms, m_reached_fluent_atoms);
+    update_reached_fluent_atoms(dense_fluent_atoms, thread_context.reached_fluent_atoms);
 
     // Test whether there exists an extended state for the given non extended state
-    auto it = m_states.find(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables));
-    if (it != m_states.end())
+    const auto [existing_state, existing_index] = find_state(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables));
+    if (existing_state)
     {
-        m_index_list.clear();
-        valla::read_sequence(it->first.get_atoms<DerivedTag>(), index_tree_table, std::back_inserter(m_index_list));
-        for (const auto index : m_index_list)
+        {
+            auto lock = lock_if<std::shared_lock<std::shared_mutex>>(*m_table_mutex, m_options.thread_safe);
+
+            index_list.clear();
+            valla::read_sequence(existing_state->get_atoms<DerivedTag>(), index_tree_table, std::back_inserter(index_list));
+        }
+        for (const auto index : index_list)
         {
             dense_derived_atoms.set(index);
         }
 
-        auto state = State(it->second, &it->first, std::move(unpacked_state), shared_from_this());
+        thread_context.unpacked_state_cache.insert(existing_index, unpacked_state);
+        auto state = State(existing_index, existing_state, std::move(unpacked_state), shared_from_this());
         return { state, compute_state_metric_value(state) };
     }
 
@@ -138,17 +307,26 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_state(const
         if (!m_axiom_evaluator->get_problem()->get_problem_and_domain_axioms().empty())
         {
             // Evaluate axioms
-            m_axiom_evaluator->generate_and_apply_axioms(*unpacked_state);
+            {
+                auto lock = lock_if<std::unique_lock<std::mutex>>(m_axiom_evaluator_mutex, m_options.thread_safe);
 
-            state_derived_atoms_slot = valla::insert_sequence(dense_derived_atoms, index_tree_table);
+                m_axiom_evaluator->generate_and_apply_axioms(*unpacked_state);
+            }
+            {
+                auto lock = lock_if<std::unique_lock<std::shared_mutex>>(*m_table_mutex, m_options.thread_safe);
 
-            update_reached_derived_atoms(dense_derived_atoms, m_reached_derived_atoms);
+                state_derived_atoms_slot = valla::insert_sequence(dense_derived_atoms, index_tree_table);
+            }
+
+            update_reached_derived_atoms(dense_derived_atoms, thread_context.reached_derived_atoms);
         }
     }
 
     // Cache and return the extended state.
-    auto result = m_states.emplace(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables), m_states.size());
-    auto state = State(result.first->second, &result.first->first, std::move(unpacked_state), shared_from_this());
+    const auto [packed_state, index] =
+        get_or_create_state_index(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables));
+    thread_context.unpacked_state_cache.insert(index, unpacked_state);
+    auto state = State(index, packed_state, std::move(unpacked_state), shared_from_this());
 
     return { state, compute_state_metric_value(state) };
 }
@@ -226,26 +404,43 @@ static void collect_applied_auxiliary_numeric_effects(const GroundNumericEffect<
     apply_numeric_effect(assign_operator_and_value, ref_successor_state_metric_score);
 }
 
-static void apply_action_effects(GroundAction action,
-                                 const ProblemImpl& problem,
-                                 State state,
-                                 const UnpackedStateImpl& unpacked_state,
-                                 FlatBitset& ref_dense_fluent_atoms,
-                                 FlatBitset& ref_negative_applied_effects,
-                                 FlatBitset& ref_positive_applied_effects,
-                                 FlatDoubleList& ref_fluent_numeric_variables,
-                                 ContinuousCost& ref_successor_state_metric_score)
+/// @brief Collect the add and delete lists and apply the numeric effects of the conditional effects of `action` that fire in `state`.
+/// The numeric variables of `state` are only copied to `ref_fluent_numeric_variables` if a fluent numeric effect fires.
+static void collect_action_effects(GroundAction action,
+                                   const ProblemImpl& problem,
+                                   const State& state,
+                                   IndexList& ref_negative_applied_effects,
+                                   IndexList& ref_positive_applied_effects,
+                                   FlatDoubleList& ref_fluent_numeric_variables,
+                                   bool& ref_fluent_numeric_variables_changed,
+                                   ContinuousCost& ref_successor_state_metric_score)
 {
     const auto& const_fluent_numeric_variables = state.get_numeric_variables();
     const auto& const_static_numeric_variables = problem.get_initial_function_to_value<StaticTag>();
 
+    ref_negative_applied_effects.clear();
+    ref_positive_applied_effects.clear();
+    ref_fluent_numeric_variables_changed = false;
+
     for (const auto& conditional_effect : action->get_conditional_effects())
     {
-        if (is_applicable(conditional_effect, unpacked_state))
+        if (is_applicable(conditional_effect, state.get_unpacked_state()))
         {
-            insert_into_bitset(conditional_effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>(), ref_negative_applied_effects);
-            insert_into_bitset(conditional_effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>(), ref_positive_applied_effects);
-            collect_applied_fluent_numeric_effects(conditional_effect->get_conjunctive_effect()->get_fluent_numeric_effects(),
+            for (const auto index : conditional_effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>())
+            {
+                ref_negative_applied_effects.push_back(index);
+            }
+            for (const auto index : conditional_effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+            {
+                ref_positive_applied_effects.push_back(index);
+            }
+            const auto& fluent_numeric_effects = conditional_effect->get_conjunctive_effect()->get_fluent_numeric_effects();
+            if (!fluent_numeric_effects.empty() && !ref_fluent_numeric_variables_changed)
+            {
+                ref_fluent_numeric_variables = const_fluent_numeric_variables;
+                ref_fluent_numeric_variables_changed = true;
+            }
+            collect_applied_fluent_numeric_effects(fluent_numeric_effects,
                                                    const_static_numeric_variables,
                                                    const_fluent_numeric_variables,
                                                    ref_fluent_numeric_variables);
@@ -259,144 +454,633 @@ static void apply_action_effects(GroundAction action,
         }
     }
 
-    // Update propositional state atoms.
-    ref_dense_fluent_atoms -= ref_negative_applied_effects;
-    ref_dense_fluent_atoms |= ref_positive_applied_effects;
+    // Assignments may leave the numeric variables unchanged.
+    ref_fluent_numeric_variables_changed = ref_fluent_numeric_variables_changed && (ref_fluent_numeric_variables != const_fluent_numeric_variables);
 
     // Update metric in case of a fluent one.
     if (!problem.get_domain()->get_auxiliary_function_skeleton().has_value())
     {
-        ref_successor_state_metric_score =
-            problem.get_optimization_metric().has_value() ?
-                evaluate(problem.get_optimization_metric().value()->get_function_expression(), const_static_numeric_variables, ref_fluent_numeric_variables) :
-                ref_successor_state_metric_score + 1;
+        const auto& successor_fluent_numeric_variables =
+            ref_fluent_numeric_variables_changed ? ref_fluent_numeric_variables : const_fluent_numeric_variables;
+        ref_successor_state_metric_score = problem.get_optimization_metric().has_value() ?
+                                               evaluate(problem.get_optimization_metric().value()->get_function_expression(),
+                                                        const_static_numeric_variables,
+                                                        successor_fluent_numeric_variables) :
+                                               ref_successor_state_metric_score + 1;
     }
 }
 
-std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_successor_state(const State& state, GroundAction action, ContinuousCost state_metric_value)
+/// @brief Test whether applying the delete list followed by the add list changes the given `fluent_atoms`.
+static bool changes_fluent_atoms(const FlatBitset& fluent_atoms, const IndexList& negative_applied_effects, const IndexList& positive_applied_effects)
+{
+    for (const auto index : positive_applied_effects)
+    {
+        if (!fluent_atoms.get(index))
+        {
+            return true;
+        }
+    }
+    for (const auto index : negative_applied_effects)
+    {
+        if (fluent_atoms.get(index) && std::find(positive_applied_effects.begin(), positive_applied_effects.end(), index) == positive_applied_effects.end())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Apply the delete list followed by the add list to the given `ref_fluent_atoms`.
+static void apply_effects(const IndexList& negative_applied_effects, const IndexList& positive_applied_effects, FlatBitset& ref_fluent_atoms)
+{
+    for (const auto index : negative_applied_effects)
+    {
+        if (ref_fluent_atoms.get(index))
+        {
+            ref_fluent_atoms.unset(index);
+        }
+    }
+    for (const auto index : positive_applied_effects)
+    {
+        ref_fluent_atoms.set(index);
+    }
+}
+
+/// @brief Revert `apply_effects` by restoring the atoms in the add and delete lists to their values in `fluent_atoms`.
+static void revert_effects(const FlatBitset& fluent_atoms,
+                           const IndexList& negative_applied_effects,
+                           const IndexList& positive_applied_effects,
+                           FlatBitset& ref_fluent_atoms)
+{
+    const auto revert = [&](Index index)
+    {
+        if (fluent_atoms.get(index))
+        {
+            ref_fluent_atoms.set(index);
+        }
+        else if (ref_fluent_atoms.get(index))
+        {
+            ref_fluent_atoms.unset(index);
+        }
+    };
+    std::for_each(negative_applied_effects.begin(), negative_applied_effects.end(), revert);
+    std::for_each(positive_applied_effects.begin(), positive_applied_effects.end(), revert);
+}
+
+void StateRepositoryImpl::create_successor_candidate(const State& state,
+                                                     GroundAction action,
+                                                     ContinuousCost state_metric_value,
+                                                     ThreadContext& thread_context,
+                                                     SuccessorBatch::Candidate& out_candidate)
 {
     auto& problem = *m_axiom_evaluator->get_problem();
-    auto& index_tree_table = problem.get_index_tree_table();
-    auto& double_leaf_table = problem.get_double_leaf_table();
+    auto& index_tree_table = *m_index_tree_table;
+    auto& double_leaf_table = *m_double_leaf_table;
+    auto& index_list = thread_context.index_list;
+    auto& negative_applied_effects = out_candidate.applied_negative_effect_atoms;
+    auto& positive_applied_effects = out_candidate.applied_positive_effect_atoms;
+    const auto& parent_fluent_atoms = state.get_atoms<FluentTag>();
+
+    /* Sparse state: start from the packed parent and replace the components that change. */
+    out_candidate.fluent_atoms = state.get_packed_state()->get_atoms<FluentTag>();
+    out_candidate.numeric_variables = state.get_packed_state()->get_numeric_variables();
+    out_candidate.state_metric_value = state_metric_value;
+
+    /* 1. Collect the effects without touching any dense state. */
+
+    collect_action_effects(action,
+                           problem,
+                           state,
+                           negative_applied_effects,
+                           positive_applied_effects,
+                           out_candidate.fluent_numeric_variables,
+                           out_candidate.fluent_numeric_variables_changed,
+                           out_candidate.state_metric_value);
+
+    const auto fluent_atoms_changed = changes_fluent_atoms(parent_fluent_atoms, negative_applied_effects, positive_applied_effects);
+
+    out_candidate.is_parent = !fluent_atoms_changed && !out_candidate.fluent_numeric_variables_changed;
+    if (out_candidate.is_parent)
+    {
+        // The successor is the extended state itself.
+        return;
+    }
 
-    /* Dense state*/
-    auto unpacked_state = m_unpacked_state_pool.get_or_allocate(problem);
-    auto& dense_fluent_atoms = unpacked_state->get_atoms<FluentTag>();
-    dense_fluent_atoms = state.get_unpacked_state().get_atoms<FluentTag>();
-    auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();
-    dense_derived_atoms = state.get_unpacked_state().get_atoms<DerivedTag>();
-    auto& dense_fluent_numeric_variables = unpacked_state->get_numeric_variables();
-    dense_fluent_numeric_variables = state.get_unpacked_state().get_numeric_variables();
-    /* Temporaries */
-    m_applied_negative_effect_atoms.unset_all();
-    m_applied_positive_effect_atoms.unset_all();
-    /* Sparse state */
-    auto state_fluent_atoms_slot = valla::Slot<Index>();
-    auto state_derived_atoms_slot = valla::Slot<Index>();
-    auto state_numeric_variables = valla::Slot<Index>();
+    /* 2. Apply the delete list followed by the add list in place to the parent's fluent atoms, which are copied once per parent. */
+
+    auto& successor_fluent_atoms = thread_context.successor_fluent_atoms;
+    if (fluent_atoms_changed)
+    {
+        if (thread_context.successor_parent_index != state.get_index())
+        {
+            successor_fluent_atoms = parent_fluent_atoms;
+            thread_context.successor_parent_index = state.get_index();
+        }
+        apply_effects(negative_applied_effects, positive_applied_effects, successor_fluent_atoms);
+    }
+
+    {
+        auto lock = lock_if<std::unique_lock<std::shared_mutex>>(*m_table_mutex, m_options.thread_safe);
+
+        if (fluent_atoms_changed)
+        {
+            out_candidate.fluent_atoms = valla::insert_sequence(successor_fluent_atoms, index_tree_table);
+        }
 
-    auto successor_state_metric_value = state_metric_value;
+        if (out_candidate.fluent_numeric_variables_changed)
+        {
+            index_list.clear();
+            valla::encode_as_unsigned_integrals(out_candidate.fluent_numeric_variables, double_leaf_table, std::back_inserter(index_list));
+            out_candidate.numeric_variables = valla::insert_sequence(index_list, index_tree_table);
+        }
+    }
 
-    /* 2. Apply action effects to construct non-extended state. */
+    if (fluent_atoms_changed)
+    {
+        revert_effects(parent_fluent_atoms, negative_applied_effects, positive_applied_effects, successor_fluent_atoms);
+    }
 
-    apply_action_effects(action,
-                         problem,
-                         state,
-                         *unpacked_state,
-                         dense_fluent_atoms,
-                         m_applied_negative_effect_atoms,
-                         m_applied_positive_effect_atoms,
-                         dense_fluent_numeric_variables,
-                         successor_state_metric_value);
+    // Atoms of the parent were already reached, so only the add list can contribute new ones.
+    insert_into_bitset(positive_applied_effects, thread_context.reached_fluent_atoms);
+}
 
-    state_fluent_atoms_slot = valla::insert_sequence(dense_fluent_atoms, index_tree_table);
+SharedObjectPoolPtr<UnpackedStateImpl>
+StateRepositoryImpl::unpack_successor_state(const State& state, ThreadContext& thread_context, const SuccessorBatch::Candidate& candidate)
+{
+    auto& problem = *m_axiom_evaluator->get_problem();
 
-    update_reached_fluent_atoms(dense_fluent_atoms, m_reached_fluent_atoms);
+    auto unpacked_state = thread_context.unpacked_state_pool.get_or_allocate(problem);
+    auto& dense_fluent_atoms = unpacked_state->get_atoms<FluentTag>();
+    dense_fluent_atoms = state.get_atoms<FluentTag>();
+    apply_effects(candidate.applied_negative_effect_atoms, candidate.applied_positive_effect_atoms, dense_fluent_atoms);
 
-    m_index_list.clear();
-    valla::encode_as_unsigned_integrals(dense_fluent_numeric_variables, double_leaf_table, std::back_inserter(m_index_list));
-    state_numeric_variables = valla::insert_sequence(m_index_list, index_tree_table);
+    unpacked_state->get_numeric_variables() = candidate.fluent_numeric_variables_changed ? candidate.fluent_numeric_variables : state.get_numeric_variables();
+
+    // Derived atoms only exist in problems with axioms, so a pooled state has none otherwise.
+    if (!problem.get_problem_and_domain_axioms().empty())
+    {
+        unpacked_state->get_atoms<DerivedTag>().unset_all();
+    }
+
+    return unpacked_state;
+}
+
+std::pair<State, ContinuousCost>
+StateRepositoryImpl::intern_successor_state(const State& state, ThreadContext& thread_context, SuccessorBatch::Candidate& candidate)
+{
+    if (candidate.is_parent)
+    {
+        return { state, candidate.state_metric_value };
+    }
+
+    auto& problem = *m_axiom_evaluator->get_problem();
+    auto& index_tree_table = *m_index_tree_table;
+    auto& index_list = thread_context.index_list;
+    auto state_derived_atoms_slot = valla::Slot<Index>();
 
     // Check if non-extended state exists in cache
-    auto it = m_states.find(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables));
-    if (it != m_states.end())
+    const auto [existing_state, existing_index] = find_state(PackedStateImpl(candidate.fluent_atoms, state_derived_atoms_slot, candidate.numeric_variables));
+    if (existing_state)
     {
-        dense_derived_atoms.unset_all();  ///< Important: now we must clear the buffer before inserting the derived atoms of the successor state.
-        m_index_list.clear();
-        valla::read_sequence(it->first.get_atoms<DerivedTag>(), index_tree_table, std::back_inserter(m_index_list));
-        for (const auto index : m_index_list)
+        // Reuse the dense state of a recently used duplicate.
+        if (const auto cached_unpacked_state = thread_context.unpacked_state_cache.find(existing_index))
+        {
+            return { State(existing_index, existing_state, *cached_unpacked_state, shared_from_this()), candidate.state_metric_value };
+        }
+
+        auto unpacked_state = unpack_successor_state(state, thread_context, candidate);
+        auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();
+        {
+            auto lock = lock_if<std::shared_lock<std::shared_mutex>>(*m_table_mutex, m_options.thread_safe);
+
+            index_list.clear();
+            valla::read_sequence(existing_state->get_atoms<DerivedTag>(), index_tree_table, std::back_inserter(index_list));
+        }
+        for (const auto index : index_list)
         {
             dense_derived_atoms.set(index);
         }
-        auto state = State(it->second, &it->first, std::move(unpacked_state), shared_from_this());
-        return { state, successor_state_metric_value };
+        thread_context.unpacked_state_cache.insert(existing_index, unpacked_state);
+        auto successor_state = State(existing_index, existing_state, std::move(unpacked_state), shared_from_this());
+        return { successor_state, candidate.state_metric_value };
     }
 
+    auto unpacked_state = unpack_successor_state(state, thread_context, candidate);
+
     /* 3. If necessary, apply axioms to construct extended state. */
     {
-        if (!m_axiom_evaluator->get_problem()->get_problem_and_domain_axioms().empty())
+        if (!problem.get_problem_and_domain_axioms().empty())
         {
+            auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();
+
             // Evaluate axioms
-            dense_derived_atoms.unset_all();  ///< Important: now we must clear the buffer before evaluating for the updated fluent atoms.
-            m_axiom_evaluator->generate_and_apply_axioms(*unpacked_state);
+            {
+                auto lock = lock_if<std::unique_lock<std::mutex>>(m_axiom_evaluator_mutex, m_options.thread_safe);
+
+                m_axiom_evaluator->generate_and_apply_axioms(*unpacked_state);
+            }
+            {
+                auto lock = lock_if<std::unique_lock<std::shared_mutex>>(*m_table_mutex, m_options.thread_safe);
 
-            state_derived_atoms_slot = valla::insert_sequence(dense_derived_atoms, index_tree_table);
+                state_derived_atoms_slot = valla::insert_sequence(dense_derived_atoms, index_tree_table);
+            }
 
-            update_reached_fluent_atoms(dense_derived_atoms, m_reached_derived_atoms);
+            update_reached_derived_atoms(dense_derived_atoms, thread_context.reached_derived_atoms);
         }
     }
 
     // Cache and return the extended state.
-    auto result = m_states.emplace(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables), m_states.size());
-    auto successor_state = State(result.first->second, &result.first->first, std::move(unpacked_state), shared_from_this());
+    const auto [packed_state, index] =
+        get_or_create_state_index(PackedStateImpl(candidate.fluent_atoms, state_derived_atoms_slot, candidate.numeric_variables));
+    thread_context.unpacked_state_cache.insert(index, unpacked_state);
+    auto successor_state = State(index, packed_state, std::move(unpacked_state), shared_from_this());
+
+    return { successor_state, candidate.state_metric_value };
+}
+
+std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_successor_state(const State& state, GroundAction action, ContinuousCost state_metric_value)
+{
+    auto& thread_context = get_thread_context();
+
+    create_successor_candidate(state, action, state_metric_value, thread_context, thread_context.candidate);
 
-    return { successor_state, successor_state_metric_value };
+    return intern_successor_state(state, thread_context, thread_context.candidate);
+}
+
+void StateRepositoryImpl::expand(const State& state,
+                                 ContinuousCost state_metric_value,
+                                 IApplicableActionGenerator& applicable_action_generator,
+                                 SuccessorBatch& out_batch)
+{
+    auto& thread_context = get_thread_context();
+
+    out_batch.clear();
+
+    /* 1. Collect the applicable actions. */
+
+    applicable_action_generator.generate_applicable_actions(state, out_batch.m_actions);
+
+    /* 2. Pack all successors before the state map is probed. */
+
+    out_batch.m_candidates.resize(out_batch.m_actions.size());
+    for (size_t i = 0; i < out_batch.m_actions.size(); ++i)
+    {
+        create_successor_candidate(state, out_batch.m_actions[i], state_metric_value, thread_context, out_batch.m_candidates[i]);
+    }
+
+    /* 3. Prefetch the buckets of the state map, which are only stable without concurrent insertions. */
+
+    if (!m_options.thread_safe)
+    {
+        for (const auto& candidate : out_batch.m_candidates)
+        {
+            if (!candidate.is_parent)
+            {
+                m_states.front().prefetch(PackedStateImpl(candidate.fluent_atoms, valla::Slot<Index>(), candidate.numeric_variables));
+            }
+        }
+    }
+
+    /* 4. Intern the successors in the order of the actions to obtain the same state indices as successive calls. */
+
+    out_batch.m_successors.reserve(out_batch.m_actions.size());
+    for (size_t i = 0; i < out_batch.m_actions.size(); ++i)
+    {
+        const auto [successor_state, successor_state_metric_value] = intern_successor_state(state, thread_context, out_batch.m_candidates[i]);
+        out_batch.m_successors.push_back(SuccessorBatch::Successor { out_batch.m_actions[i], successor_state, successor_state_metric_value });
+    }
 }
 
 State StateRepositoryImpl::get_state(const PackedStateImpl& state)
 {
+    auto& problem = *m_axiom_evaluator->get_problem();
+    auto& thread_context = get_thread_context();
+    auto& index_list = thread_context.index_list;
+    const auto state_index = get_state_index(state);
+
+    // Skip the decompression of recently used states
+    if (const auto cached_unpacked_state = thread_context.unpacked_state_cache.find(state_index))
+    {
+        ++thread_context.num_unpacked_state_cache_hits;
+        return State(state_index, &state, *cached_unpacked_state, shared_from_this());
+    }
+    ++thread_context.num_unpacked_state_cache_misses;
+
     // Unpack the internal state into dense state
-    const auto& problem = *m_axiom_evaluator->get_problem();
-    auto unpacked_state = m_unpacked_state_pool.get_or_allocate(problem);
+    auto unpacked_state = thread_context.unpacked_state_pool.get_or_allocate(problem);
     auto& dense_fluent_atoms = unpacked_state->get_atoms<FluentTag>();
     auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();
     auto& dense_fluent_numeric_variables = unpacked_state->get_numeric_variables();
 
+    auto lock = lock_if<std::shared_lock<std::shared_mutex>>(*m_table_mutex, m_options.thread_safe);
+
     dense_fluent_atoms.unset_all();
-    m_index_list.clear();
-    valla::read_sequence(state.get_atoms<FluentTag>(), problem.get_index_tree_table(), std::back_inserter(m_index_list));
-    for (const auto index : m_index_list)
+    index_list.clear();
+    valla::read_sequence(state.get_atoms<FluentTag>(), *m_index_tree_table, std::back_inserter(index_list));
+    for (const auto index : index_list)
     {
         dense_fluent_atoms.set(index);
     }
 
     dense_derived_atoms.unset_all();
-    m_index_list.clear();
-    valla::read_sequence(state.get_atoms<DerivedTag>(), problem.get_index_tree_table(), std::back_inserter(m_index_list));
-    for (const auto index : m_index_list)
+    index_list.clear();
+    valla::read_sequence(state.get_atoms<DerivedTag>(), *m_index_tree_table, std::back_inserter(index_list));
+    for (const auto index : index_list)
     {
         dense_derived_atoms.set(index);
     }
 
-    m_index_list.clear();
-    valla::read_sequence(state.get_numeric_variables(), problem.get_index_tree_table(), std::back_inserter(m_index_list));
+    index_list.clear();
+    valla::read_sequence(state.get_numeric_variables(), *m_index_tree_table, std::back_inserter(index_list));
     dense_fluent_numeric_variables.clear();
-    valla::decode_from_unsigned_integrals(m_index_list, problem.get_double_leaf_table(), std::back_inserter(dense_fluent_numeric_variables));
+    valla::decode_from_unsigned_integrals(index_list, *m_double_leaf_table, std::back_inserter(dense_fluent_numeric_variables));
+
+    if (lock.owns_lock())
+    {
+        lock.unlock();
+    }
+
+    thread_context.unpacked_state_cache.insert(state_index, unpacked_state);
+
+    return State(state_index, &state, std::move(unpacked_state), shared_from_this());
+}
+
+Index StateRepositoryImpl::get_state_index(const PackedStateImpl& state)
+{
+    const auto shard = get_shard(state);
+    auto lock = lock_if<std::unique_lock<std::mutex>>(m_state_mutexes[shard], m_options.thread_safe);
 
-    return State(m_states.at(state), &state, std::move(unpacked_state), shared_from_this());
+    return m_states[shard].at(state);
 }
 
-Index StateRepositoryImpl::get_state_index(const PackedStateImpl& state) { return m_states.at(state); }
+/**
+ * Serialization
+ */
+
+/// @brief The layout of a file written by `StateRepositoryImpl::serialize`.
+struct SerializedStates
+{
+    cista::offset::string domain_name;
+    cista::offset::string problem_name;
+    cista::offset::vector<cista::offset::string> predicate_names;
+    cista::offset::vector<cista::offset::string> object_names;
+    cista::offset::vector<Index> atom_predicates;           ///< The position in `predicate_names` of each fluent ground atom.
+    cista::offset::vector<Index> atom_objects;              ///< The positions in `object_names` of the objects of all fluent ground atoms.
+    cista::offset::vector<uint64_t> atom_object_offsets;    ///< The objects of atom i are in the range [offsets[i], offsets[i + 1]).
+    cista::offset::vector<Index> state_atoms;               ///< The fluent atoms of all states ordered by state index.
+    cista::offset::vector<uint64_t> state_atom_offsets;     ///< The fluent atoms of state i are in the range [offsets[i], offsets[i + 1]).
+    cista::offset::vector<double> state_numeric_variables;  ///< The numeric variables of all states ordered by state index.
+    cista::offset::vector<uint64_t> state_numeric_variable_offsets;
+};
+
+static constexpr auto SERIALIZATION_MODE = cista::mode::WITH_VERSION | cista::mode::WITH_INTEGRITY;
+
+void StateRepositoryImpl::serialize(const fs::path& file) const
+{
+    const auto& problem = *m_axiom_evaluator->get_problem();
+    const auto& repositories = problem.get_repositories();
+    const auto& index_tree_table = *m_index_tree_table;
+    const auto& double_leaf_table = *m_double_leaf_table;
+
+    auto data = SerializedStates();
+    data.domain_name = problem.get_domain()->get_name();
+    data.problem_name = problem.get_name();
+
+    /* Ground atoms */
+
+    auto predicate_positions = absl::flat_hash_map<Predicate<FluentTag>, Index> {};
+    auto object_positions = absl::flat_hash_map<Object, Index> {};
+
+    const auto num_atoms = boost::hana::at_key(repositories.get_hana_repositories(), boost::hana::type<GroundAtomImpl<FluentTag>> {}).size();
+    data.atom_object_offsets.push_back(0);
+    for (size_t atom_index = 0; atom_index < num_atoms; ++atom_index)
+    {
+        const auto atom = repositories.get_ground_atom<FluentTag>(atom_index);
+
+        const auto [predicate_it, predicate_inserted] = predicate_positions.emplace(atom->get_predicate(), data.predicate_names.size());
+        if (predicate_inserted)
+        {
+            data.predicate_names.emplace_back(atom->get_predicate()->get_name());
+        }
+        data.atom_predicates.push_back(predicate_it->second);
+
+        for (const auto& object : atom->get_objects())
+        {
+            const auto [object_it, object_inserted] = object_positions.emplace(object, data.object_names.size());
+            if (object_inserted)
+            {
+                data.object_names.emplace_back(object->get_name());
+            }
+            data.atom_objects.push_back(object_it->second);
+        }
+        data.atom_object_offsets.push_back(data.atom_objects.size());
+    }
+
+    /* States */
+
+    auto states = std::vector<PackedState>(get_state_count(), nullptr);
+    for (const auto& shard : m_states)
+    {
+        for (const auto& [state, index] : shard)
+        {
+            states[index] = &state;
+        }
+    }
+
+    auto index_list = IndexList {};
+    auto numeric_variables = FlatDoubleList {};
+
+    data.state_atom_offsets.push_back(0);
+    data.state_numeric_variable_offsets.push_back(0);
+    for (const auto& state : states)
+    {
+        index_list.clear();
+        valla::read_sequence(state->get_atoms<FluentTag>(), index_tree_table, std::back_inserter(index_list));
+        for (const auto atom_index : index_list)
+        {
+            data.state_atoms.push_back(atom_index);
+        }
+        data.state_atom_offsets.push_back(data.state_atoms.size());
+
+        index_list.clear();
+        valla::read_sequence(state->get_numeric_variables(), index_tree_table, std::back_inserter(index_list));
+        numeric_variables.clear();
+        valla::decode_from_unsigned_integrals(index_list, double_leaf_table, std::back_inserter(numeric_variables));
+        for (const auto value : numeric_variables)
+        {
+            data.state_numeric_variables.push_back(value);
+        }
+        data.state_numeric_variable_offsets.push_back(data.state_numeric_variables.size());
+    }
+
+    auto buf = cista::buf<cista::mmap>(cista::mmap(file.string().c_str(), cista::mmap::protection::WRITE));
+    cista::serialize<SERIALIZATION_MODE>(buf, data);
+}
+
+std::vector<PackedState> StateRepositoryImpl::deserialize(const fs::path& file)
+{
+    const auto& problem = m_axiom_evaluator->get_problem();
+
+    const auto mmap = cista::mmap(file.string().c_str(), cista::mmap::protection::READ);
+    const auto* data = cista::deserialize<const SerializedStates, SERIALIZATION_MODE>(mmap.data(), mmap.data() + mmap.size());
+
+    if (data->domain_name.view() != problem->get_domain()->get_name() || data->problem_name.view() != problem->get_name())
+    {
+        throw std::runtime_error("StateRepositoryImpl::deserialize: the file " + file.string() + " stores the states of a different problem.");
+    }
+
+    /* Map the stored ground atoms to the ground atoms of the problem. */
+
+    const auto& name_to_predicate = problem->get_domain()->get_name_to_predicate<FluentTag>();
+    const auto name_to_object = problem->get_name_to_problem_or_domain_object();
+
+    auto predicates = PredicateList<FluentTag> {};
+    for (const auto& name : data->predicate_names)
+    {
+        const auto it = name_to_predicate.find(std::string(name.view()));
+        if (it == name_to_predicate.end())
+        {
+            throw std::runtime_error("StateRepositoryImpl::deserialize: undefined predicate " + std::string(name.view()) + ".");
+        }
+        predicates.push_back(it->second);
+    }
+    auto objects = ObjectList {};
+    for (const auto& name : data->object_names)
+    {
+        const auto it = name_to_object.find(std::string(name.view()));
+        if (it == name_to_object.end())
+        {
+            throw std::runtime_error("StateRepositoryImpl::deserialize: undefined object " + std::string(name.view()) + ".");
+        }
+        objects.push_back(it->second);
+    }
+
+    auto atoms = GroundAtomList<FluentTag> {};
+    auto binding = ObjectList {};
+    for (size_t i = 0; i < data->atom_predicates.size(); ++i)
+    {
+        binding.clear();
+        for (auto pos = data->atom_object_offsets[i]; pos < data->atom_object_offsets[i + 1]; ++pos)
+        {
+            binding.push_back(objects[data->atom_objects[pos]]);
+        }
+        atoms.push_back(problem->get_or_create_ground_atom(predicates[data->atom_predicates[i]], binding));
+    }
+
+    /* Get or create the states in the order of their stored indices. */
+
+    auto state_atoms = GroundAtomList<FluentTag> {};
+    auto numeric_variables = FlatDoubleList {};
+    auto packed_states = std::vector<PackedState> {};
+
+    for (size_t i = 0; i + 1 < data->state_atom_offsets.size(); ++i)
+    {
+        state_atoms.clear();
+        for (auto pos = data->state_atom_offsets[i]; pos < data->state_atom_offsets[i + 1]; ++pos)
+        {
+            state_atoms.push_back(atoms[data->state_atoms[pos]]);
+        }
+        numeric_variables.clear();
+        for (auto pos = data->state_numeric_variable_offsets[i]; pos < data->state_numeric_variable_offsets[i + 1]; ++pos)
+        {
+            numeric_variables.push_back(data->state_numeric_variables[pos]);
+        }
+
+        packed_states.push_back(get_or_create_state(state_atoms, numeric_variables).first.get_packed_state());
+    }
+
+    return packed_states;
+}
 
 const Problem& StateRepositoryImpl::get_problem() const { return m_axiom_evaluator->get_problem(); }
 
-size_t StateRepositoryImpl::get_state_count() const { return m_states.size(); }
+const StateRepositoryImpl::Options& StateRepositoryImpl::get_options() const { return m_options; }
+
+size_t StateRepositoryImpl::get_state_count() const { return m_num_states.load(std::memory_order_relaxed); }
+
+const std::vector<PackedStateImplMap>& StateRepositoryImpl::get_states() const { return m_states; }
+
+const FlatBitset& StateRepositoryImpl::get_reached_fluent_ground_atoms_bitset() const
+{
+    auto lock = std::lock_guard<std::mutex>(m_thread_contexts_mutex);
+
+    for (const auto& [thread_id, thread_context] : m_thread_contexts)
+    {
+        m_reached_fluent_atoms |= thread_context->reached_fluent_atoms;
+    }
+    return m_reached_fluent_atoms;
+}
+
+const FlatBitset& StateRepositoryImpl::get_reached_derived_ground_atoms_bitset() const
+{
+    auto lock = std::lock_guard<std::mutex>(m_thread_contexts_mutex);
+
+    for (const auto& [thread_id, thread_context] : m_thread_contexts)
+    {
+        m_reached_derived_atoms |= thread_context->reached_derived_atoms;
+    }
+    return m_reached_derived_atoms;
+}
+
+static size_t get_memory_usage_in_bytes(const FlatBitset& bitset) { return sizeof(uint64_t) * bitset.blocks().size(); }
+
+static size_t get_memory_usage_in_bytes(const UnpackedStateImpl& unpacked_state)
+{
+    return sizeof(UnpackedStateImpl) + get_memory_usage_in_bytes(unpacked_state.get_atoms<FluentTag>())
+           + get_memory_usage_in_bytes(unpacked_state.get_atoms<DerivedTag>()) + sizeof(double) * unpacked_state.get_numeric_variables().size();
+}
+
+size_t StateRepositoryImpl::get_estimated_memory_usage_in_bytes() const
+{
+    auto num_bytes = size_t(0);
+
+    if (m_options.private_tables)
+    {
+        num_bytes += m_private_index_tree_table->mem_usage() + m_private_double_leaf_table->mem_usage();
+    }
 
-const PackedStateImplMap& StateRepositoryImpl::get_states() const { return m_states; }
+    // absl::node_hash_map stores a pointer and a control byte per slot and allocates each element separately.
+    for (const auto& states : m_states)
+    {
+        num_bytes += states.capacity() * (sizeof(void*) + 1) + states.size() * sizeof(PackedStateImplMap::value_type);
+    }
 
-const FlatBitset& StateRepositoryImpl::get_reached_fluent_ground_atoms_bitset() const { return m_reached_fluent_atoms; }
+    auto lock = std::lock_guard<std::mutex>(m_thread_contexts_mutex);
 
-const FlatBitset& StateRepositoryImpl::get_reached_derived_ground_atoms_bitset() const { return m_reached_derived_atoms; }
+    for (const auto& [thread_id, thread_context] : m_thread_contexts)
+    {
+        // Pooled unpacked states have at most as many atoms as reached so far.
+        const auto num_bytes_per_unpacked_state = sizeof(std::pair<size_t, UnpackedStateImpl>)
+                                                  + get_memory_usage_in_bytes(thread_context->reached_fluent_atoms)
+                                                  + get_memory_usage_in_bytes(thread_context->reached_derived_atoms);
+        num_bytes += thread_context->unpacked_state_pool.get_size() * num_bytes_per_unpacked_state;
+        num_bytes += get_memory_usage_in_bytes(thread_context->reached_fluent_atoms) + get_memory_usage_in_bytes(thread_context->reached_derived_atoms);
+        num_bytes += get_memory_usage_in_bytes(thread_context->successor_fluent_atoms);
+        num_bytes += sizeof(Index)
+                     * (thread_context->index_list.capacity() + thread_context->candidate.applied_positive_effect_atoms.capacity()
+                        + thread_context->candidate.applied_negative_effect_atoms.capacity());
+    }
+
+    return num_bytes;
+}
+
+StateRepositoryImpl::UnpackedStateCacheStatistics StateRepositoryImpl::get_unpacked_state_cache_statistics() const
+{
+    auto lock = std::lock_guard<std::mutex>(m_thread_contexts_mutex);
+
+    auto statistics = UnpackedStateCacheStatistics();
+    statistics.num_hits = m_num_released_unpacked_state_cache_hits;
+    statistics.num_misses = m_num_released_unpacked_state_cache_misses;
+    for (const auto& [thread_id, thread_context] : m_thread_contexts)
+    {
+        statistics.num_hits += thread_context->num_unpacked_state_cache_hits;
+        statistics.num_misses += thread_context->num_unpacked_state_cache_misses;
+        statistics.num_entries += thread_context->unpacked_state_cache.size();
+        thread_context->unpacked_state_cache.for_each(
+            [&](Index, const SharedObjectPoolPtr<UnpackedStateImpl>& unpacked_state) { statistics.num_bytes += get_memory_usage_in_bytes(*unpacked_state); });
+    }
+    return statistics;
+}
 
 const AxiomEvaluator& StateRepositoryImpl::get_axiom_evaluator() const { return m_axiom_evaluator; }
 }
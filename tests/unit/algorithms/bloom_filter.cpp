@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/algorithms/bloom_filter.hpp"
+
+#include <gtest/gtest.h>
+
+namespace mimir::tests
+{
+
+TEST(MimirTests, AlgorithmsBloomFilterTest)
+{
+    auto filter = BloomFilter(1 << 16, 3);
+    EXPECT_EQ(filter.get_num_elements(), 0);
+    EXPECT_EQ(filter.get_false_positive_probability(), 0.);
+    EXPECT_EQ(filter.get_estimated_omission_probability(), 0.);
+
+    // Consecutive hash values, as produced by weak hash functions, must not collide systematically.
+    for (uint64_t hash = 0; hash < 1000; ++hash)
+    {
+        filter.insert(hash);
+    }
+    for (uint64_t hash = 0; hash < 1000; ++hash)
+    {
+        EXPECT_TRUE(filter.contains(hash));
+        EXPECT_FALSE(filter.insert(hash));
+    }
+    EXPECT_GE(filter.get_num_elements(), 995);
+    EXPECT_LE(filter.get_num_set_bits(), 3000);
+
+    auto num_false_positives = 0;
+    for (uint64_t hash = 1000; hash < 11000; ++hash)
+    {
+        num_false_positives += filter.contains(hash);
+    }
+    EXPECT_LT(num_false_positives, 10);
+
+    EXPECT_GT(filter.get_false_positive_probability(), 0.);
+    EXPECT_GT(filter.get_estimated_omission_probability(), 0.);
+    EXPECT_LT(filter.get_estimated_omission_probability(), 1.);
+    EXPECT_GT(filter.get_expected_num_omissions(), 0.);
+
+    filter.clear();
+    EXPECT_EQ(filter.get_num_set_bits(), 0);
+    EXPECT_FALSE(filter.contains(0));
+}
+
+TEST(MimirTests, AlgorithmsBloomFilterBitstateTest)
+{
+    // With a single hash function and as many bits as elements, a substantial fraction of the elements is omitted.
+    auto filter = BloomFilter(1000, 1);
+    auto num_new = 0;
+    for (uint64_t hash = 0; hash < 1000; ++hash)
+    {
+        num_new += filter.insert(hash * uint64_t(0x9E3779B97F4A7C15));
+    }
+    EXPECT_EQ(filter.get_num_elements(), num_new);
+    EXPECT_EQ(filter.get_num_set_bits(), num_new);
+    EXPECT_LT(num_new, 800);
+    EXPECT_GT(filter.get_estimated_omission_probability(), 0.99);
+    EXPECT_GT(filter.get_expected_num_omissions(), 100.);
+
+    EXPECT_THROW(BloomFilter(0, 1), std::runtime_error);
+    EXPECT_THROW(BloomFilter(64, 0), std::runtime_error);
+}
+
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/algorithms/kpkc.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+
+namespace mimir::tests
+{
+
+using Clique = std::vector<uint32_t>;
+
+template<typename Generator>
+static std::set<Clique> collect_k_cliques(Generator&& generator)
+{
+    auto result = std::set<Clique> {};
+    for (const auto& clique : generator)
+    {
+        auto sorted_clique = clique;
+        std::sort(sorted_clique.begin(), sorted_clique.end());
+        EXPECT_TRUE(result.insert(sorted_clique).second);
+    }
+    return result;
+}
+
+static std::set<Clique> enumerate_k_cliques(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix, const std::vector<std::vector<uint32_t>>& partitions)
+{
+    return collect_k_cliques(create_k_clique_in_k_partite_graph_generator(adjacency_matrix, partitions));
+}
+
+static std::set<Clique> enumerate_k_cliques(const KPartiteGraph& graph) { return collect_k_cliques(create_k_clique_in_k_partite_graph_generator(graph)); }
+
+/// @brief Enumerate the k-cliques by choosing one vertex per partition in order.
+static void enumerate_k_cliques_naively(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
+                                        const std::vector<std::vector<uint32_t>>& partitions,
+                                        Clique& partial_clique,
+                                        std::set<Clique>& out_cliques)
+{
+    if (partial_clique.size() == partitions.size())
+    {
+        auto sorted_clique = partial_clique;
+        std::sort(sorted_clique.begin(), sorted_clique.end());
+        out_cliques.insert(sorted_clique);
+        return;
+    }
+    for (const auto vertex : partitions[partial_clique.size()])
+    {
+        if (std::all_of(partial_clique.begin(), partial_clique.end(), [&](auto&& other) { return adjacency_matrix[other][vertex]; }))
+        {
+            partial_clique.push_back(vertex);
+            enumerate_k_cliques_naively(adjacency_matrix, partitions, partial_clique, out_cliques);
+            partial_clique.pop_back();
+        }
+    }
+}
+
+TEST(MimirTests, AlgorithmsKPKCTest)
+{
+    // Partitions {0, 1}, {2}, {3, 4} with the triangles 0-2-3 and 1-2-4, and the additional edge 0-4.
+    const auto partitions = std::vector<std::vector<uint32_t>> { { 0, 1 }, { 2 }, { 3, 4 } };
+    auto adjacency_matrix = std::vector<boost::dynamic_bitset<>>(5, boost::dynamic_bitset<>(5));
+    for (const auto& [u, v] : std::vector<std::pair<uint32_t, uint32_t>> { { 0, 2 }, { 2, 3 }, { 0, 3 }, { 1, 2 }, { 2, 4 }, { 1, 4 }, { 0, 4 } })
+    {
+        adjacency_matrix[u][v] = 1;
+        adjacency_matrix[v][u] = 1;
+    }
+    EXPECT_EQ(enumerate_k_cliques(adjacency_matrix, partitions), (std::set<Clique> { { 0, 2, 3 }, { 0, 2, 4 }, { 1, 2, 4 } }));
+
+    // The sparse representation yields the same cliques, and resetting removes all edges.
+    auto graph = KPartiteGraph(partitions, 0);
+    EXPECT_TRUE(graph.is_sparse());
+    graph.add_edge(0, 2);
+    EXPECT_TRUE(enumerate_k_cliques(graph).empty());
+    graph.reset();
+    for (uint32_t u = 0; u < 5; ++u)
+    {
+        for (auto v = adjacency_matrix[u].find_next(u); v < 5; v = adjacency_matrix[u].find_next(v))
+        {
+            graph.add_edge(u, v);
+        }
+    }
+    EXPECT_EQ(enumerate_k_cliques(graph), (std::set<Clique> { { 0, 2, 3 }, { 0, 2, 4 }, { 1, 2, 4 } }));
+    graph.reset();
+    EXPECT_TRUE(enumerate_k_cliques(graph).empty());
+
+    // An empty partition admits no k-clique.
+    EXPECT_TRUE(enumerate_k_cliques(adjacency_matrix, std::vector<std::vector<uint32_t>> { { 0, 1 }, { 2 }, { 3, 4 }, {} }).empty());
+}
+
+TEST(MimirTests, AlgorithmsKPKCRandomTest)
+{
+    // Partitions with more than one word of vertices exercise the word-parallel kernels of both representations.
+    auto rng = std::mt19937(42);
+    for (size_t iteration = 0; iteration < 200; ++iteration)
+    {
+        const auto k = 1 + rng() % 4;
+        const auto max_partition_size = (iteration % 4 == 0) ? 100 : 8;
+
+        auto partitions = std::vector<std::vector<uint32_t>>(k);
+        auto num_vertices = uint32_t(0);
+        for (auto& partition : partitions)
+        {
+            const auto partition_size = 1 + rng() % max_partition_size;
+            for (size_t i = 0; i < partition_size; ++i)
+            {
+                partition.push_back(num_vertices++);
+            }
+        }
+
+        auto partition_of = std::vector<size_t>(num_vertices);
+        for (size_t p = 0; p < k; ++p)
+        {
+            for (const auto vertex : partitions[p])
+            {
+                partition_of[vertex] = p;
+            }
+        }
+
+        const auto density = (max_partition_size > 8) ? 5 : 60;
+        auto adjacency_matrix = std::vector<boost::dynamic_bitset<>>(num_vertices, boost::dynamic_bitset<>(num_vertices));
+        auto dense_graph = KPartiteGraph(partitions, num_vertices);
+        auto sparse_graph = KPartiteGraph(partitions, 0);
+        for (uint32_t u = 0; u < num_vertices; ++u)
+        {
+            for (uint32_t v = u + 1; v < num_vertices; ++v)
+            {
+                if (partition_of[u] != partition_of[v] && static_cast<int>(rng() % 100) < density)
+                {
+                    adjacency_matrix[u][v] = 1;
+                    adjacency_matrix[v][u] = 1;
+                    dense_graph.add_edge(u, v);
+                    sparse_graph.add_edge(u, v);
+                }
+            }
+        }
+
+        auto expected_cliques = std::set<Clique> {};
+        auto partial_clique = Clique {};
+        enumerate_k_cliques_naively(adjacency_matrix, partitions, partial_clique, expected_cliques);
+
+        EXPECT_EQ(enumerate_k_cliques(adjacency_matrix, partitions), expected_cliques);
+        EXPECT_FALSE(dense_graph.is_sparse());
+        EXPECT_EQ(enumerate_k_cliques(dense_graph), expected_cliques);
+        EXPECT_EQ(enumerate_k_cliques(sparse_graph), expected_cliques);
+    }
+}
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/algorithms/lru_cache.hpp"
+
+#include "mimir/algorithms/shared_object_pool.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace mimir::tests
+{
+
+TEST(MimirTests, AlgorithmsLRUCacheTest)
+{
+    auto cache = LRUCache<int, std::string>(2);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.find(1), nullptr);
+
+    cache.insert(1, "a");
+    cache.insert(2, "b");
+    EXPECT_EQ(cache.size(), 2);
+
+    // Touch 1 so that 2 becomes the least recently used entry.
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(*cache.find(1), "a");
+
+    cache.insert(3, "c");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.find(2), nullptr);
+    EXPECT_EQ(*cache.find(1), "a");
+    EXPECT_EQ(*cache.find(3), "c");
+
+    // Overwriting marks the entry as most recently used.
+    cache.insert(1, "d");
+    cache.insert(4, "e");
+    EXPECT_EQ(cache.find(3), nullptr);
+    EXPECT_EQ(*cache.find(1), "d");
+    EXPECT_EQ(*cache.find(4), "e");
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.find(1), nullptr);
+}
+
+TEST(MimirTests, AlgorithmsLRUCacheZeroCapacityTest)
+{
+    auto cache = LRUCache<int, int>(0);
+    cache.insert(1, 1);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.find(1), nullptr);
+}
+
+TEST(MimirTests, AlgorithmsLRUCacheSharedObjectPoolTest)
+{
+    auto pool = SharedObjectPool<int>();
+    {
+        auto cache = LRUCache<int, SharedObjectPoolPtr<int>>(1);
+        cache.insert(0, pool.get_or_allocate());
+        EXPECT_EQ(pool.get_num_free(), 0);
+
+        // Evicting returns the object to the pool.
+        cache.insert(1, pool.get_or_allocate());
+        EXPECT_EQ(pool.get_size(), 2);
+        EXPECT_EQ(pool.get_num_free(), 1);
+    }
+    EXPECT_EQ(pool.get_num_free(), 2);
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/algorithms/mailbox.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace mimir::tests
+{
+
+TEST(MimirTests, AlgorithmsMailboxTest)
+{
+    Mailbox<int> mailbox;
+    EXPECT_TRUE(mailbox.empty());
+
+    mailbox.push(1);
+    mailbox.push(2);
+    mailbox.push(3);
+    EXPECT_FALSE(mailbox.empty());
+
+    // Messages are received in the order in which they were pushed.
+    auto received = std::vector<int> {};
+    EXPECT_EQ(mailbox.drain([&](int&& value) { received.push_back(value); }), 3);
+    EXPECT_EQ(received, (std::vector<int> { 1, 2, 3 }));
+    EXPECT_TRUE(mailbox.empty());
+    EXPECT_EQ(mailbox.drain([&](int&& value) { received.push_back(value); }), 0);
+}
+
+TEST(MimirTests, AlgorithmsMailboxConcurrentTest)
+{
+    Mailbox<int> mailbox;
+    const int num_producers = 4;
+    const int num_messages = 10000;
+
+    auto producers = std::vector<std::thread> {};
+    for (int p = 0; p < num_producers; ++p)
+    {
+        producers.emplace_back(
+            [&]()
+            {
+                for (int i = 0; i < num_messages; ++i)
+                {
+                    mailbox.push(i);
+                }
+            });
+    }
+
+    long sum = 0;
+    size_t count = 0;
+    while (count < size_t(num_producers * num_messages))
+    {
+        count += mailbox.drain([&](int&& value) { sum += value; });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_EQ(count, num_producers * num_messages);
+    EXPECT_EQ(sum, long(num_producers) * num_messages * (num_messages - 1) / 2);
+    EXPECT_TRUE(mailbox.empty());
+}
+
+TEST(MimirTests, AlgorithmsMailboxWaitTest)
+{
+    Mailbox<int> mailbox;
+    const int num_messages = 1000;
+
+    auto producer = std::thread(
+        [&]()
+        {
+            for (int i = 0; i < num_messages; ++i)
+            {
+                mailbox.push(i);
+            }
+        });
+
+    // The consumer blocks instead of polling while the mailbox is empty.
+    long sum = 0;
+    size_t count = 0;
+    while (count < size_t(num_messages))
+    {
+        mailbox.wait();
+        count += mailbox.drain([&](int&& value) { sum += value; });
+    }
+    producer.join();
+
+    EXPECT_EQ(count, num_messages);
+    EXPECT_EQ(sum, long(num_messages) * (num_messages - 1) / 2);
+}
+
+}
@@ -21,11 +21,14 @@
 #include "mimir/common/hash.hpp"
 #include "mimir/datasets/state_space.hpp"
 #include "mimir/formalism/problem.hpp"
+#include "mimir/graphs/algorithms/color_refinement.hpp"
 #include "mimir/graphs/algorithms/nauty.hpp"
 #include "mimir/search/search_context.hpp"
 
 #include <gtest/gtest.h>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 using namespace mimir::datasets;
 using namespace mimir::formalism;
@@ -54,4 +57,51 @@ TEST(MimirTests, DataSetsObjectGraphSparseTest)
     EXPECT_EQ(certificates.size(), 12);
 }
 
+TEST(MimirTests, DataSetsObjectGraphBuilderTest)
+{
+    for (const auto& domain_name : std::vector<std::string> { "blocks_4", "gripper" })
+    {
+        const auto domain_file = fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl");
+        const auto problem_file = fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl");
+
+        auto options = state_space::Options();
+        options.symmetry_pruning = false;
+        const auto context = search::SearchContextImpl::create(domain_file, problem_file);
+        const auto state_space_result = StateSpaceImpl::create(context, options);
+        ASSERT_TRUE(state_space_result.has_value());
+
+        auto builder = ObjectGraphBuilder(context->get_problem());
+        auto certificates = UnorderedSet<nauty::SparseGraph> {};
+        auto builder_certificates = UnorderedSet<nauty::SparseGraph> {};
+
+        // Consecutive vertices are not necessarily adjacent, hence the builder also patches the graphs of unrelated states.
+        for (const auto& vertex : state_space_result->first->get_graph().get_vertices())
+        {
+            const auto object_graph = create_object_graph(get_state(vertex), *get_problem(vertex));
+
+            builder.update(get_state(vertex));
+            EXPECT_EQ(builder.get_num_vertices(), object_graph.get_num_vertices());
+            EXPECT_EQ(builder.get_num_edges(), object_graph.get_num_edges());
+
+            const auto certificate = nauty::SparseGraph(object_graph).canonize();
+            const auto builder_certificate = builder.create_nauty_graph().canonize();
+            EXPECT_TRUE(loki::EqualTo<nauty::SparseGraph>()(builder_certificate, certificate));
+            EXPECT_EQ(*color_refinement::compute_certificate(builder.get_graph()), *color_refinement::compute_certificate(object_graph));
+
+            certificates.insert(certificate);
+            builder_certificates.insert(builder_certificate);
+        }
+
+        EXPECT_EQ(builder_certificates.size(), certificates.size());
+
+        // Returning to the initial state frees the slots of all other atoms and yields the initial graph again.
+        const auto initial_state = context->get_state_repository()->get_or_create_initial_state().first;
+        builder.update(initial_state);
+        const auto object_graph = create_object_graph(initial_state, *context->get_problem());
+        EXPECT_EQ(builder.get_num_vertices(), object_graph.get_num_vertices());
+        EXPECT_EQ(builder.get_num_edges(), object_graph.get_num_edges());
+        EXPECT_TRUE(loki::EqualTo<nauty::SparseGraph>()(builder.create_nauty_graph().canonize(), nauty::SparseGraph(object_graph).canonize()));
+    }
+}
+
 }
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/grounding_table.hpp"
+
+#include "mimir/formalism/action.hpp"
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/grounders/lifted.hpp"
+
+#include <gtest/gtest.h>
+#include <set>
+
+using namespace mimir::formalism;
+using namespace mimir::search;
+
+namespace mimir::tests
+{
+
+TEST(MimirTests, FormalismGroundingTableTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "logistics/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "logistics/test_problem.pddl"));
+    const auto grounder = LiftedGrounder(problem);
+    const auto ground_actions = grounder.create_ground_actions();
+    ASSERT_FALSE(ground_actions.empty());
+
+    const auto& actions = problem->get_domain()->get_actions();
+    const auto& objects = problem->get_problem_and_domain_objects();
+
+    auto ranked_tables = std::vector<GroundingTable<GroundAction>> {};
+    auto hashed_tables = std::vector<GroundingTable<GroundAction>> {};
+    auto ranks = std::vector<std::set<size_t>>(actions.size());
+    for (const auto& action : actions)
+    {
+        ranked_tables.emplace_back(action->get_parameters(), objects);
+        hashed_tables.emplace_back(action->get_parameters(), objects, 0);
+        EXPECT_TRUE(ranked_tables.back().is_ranked());
+        EXPECT_FALSE(hashed_tables.back().is_ranked());
+    }
+
+    for (const auto& ground_action : ground_actions)
+    {
+        const auto action_index = ground_action->get_action()->get_index();
+        ASSERT_LT(action_index, actions.size());
+        ASSERT_EQ(actions[action_index], ground_action->get_action());
+
+        // Distinct bindings of a schema have distinct ranks.
+        const auto hash = PerfectBindingHash(actions[action_index]->get_parameters(), objects);
+        const auto rank = hash.get_binding_rank(ground_action->get_objects());
+        EXPECT_LT(rank, hash.size());
+        EXPECT_TRUE(ranks[action_index].insert(rank).second);
+        EXPECT_EQ(hash.get_binding(rank), ground_action->get_objects());
+
+        EXPECT_EQ(ranked_tables[action_index].find(ground_action->get_objects()), nullptr);
+        ranked_tables[action_index].insert(ground_action->get_objects(), ground_action);
+        hashed_tables[action_index].insert(ground_action->get_objects(), ground_action);
+    }
+
+    for (const auto& ground_action : ground_actions)
+    {
+        const auto action_index = ground_action->get_action()->get_index();
+        EXPECT_EQ(ranked_tables[action_index].find(ground_action->get_objects()), ground_action);
+        EXPECT_EQ(hashed_tables[action_index].find(ground_action->get_objects()), ground_action);
+    }
+
+    auto num_ground_actions = size_t(0);
+    for (const auto& table : ranked_tables)
+    {
+        num_ground_actions += table.size();
+    }
+    EXPECT_EQ(num_ground_actions, ground_actions.size());
+
+    // Non-empty tables account for the memory of their groundings.
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        if (ranked_tables[i].size() > 0)
+        {
+            EXPECT_GT(ranked_tables[i].get_estimated_memory_usage_in_bytes(), 0);
+            EXPECT_GT(hashed_tables[i].get_estimated_memory_usage_in_bytes(), 0);
+        }
+    }
+
+    // A binding of the wrong size is not ranked, and is not contained.
+    EXPECT_EQ(PerfectBindingHash(actions.front()->get_parameters(), objects).get_binding_rank(ObjectList {}), PerfectBindingHash::NO_RANK);
+    EXPECT_EQ(ranked_tables.front().find(ObjectList {}), nullptr);
+}
+
+}
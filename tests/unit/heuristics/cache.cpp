@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/heuristics/cache.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+
+namespace mimir::tests
+{
+
+TEST(MimirTests, SearchHeuristicsCacheTest)
+{
+    auto cache = HeuristicCacheImpl::create();
+
+    EXPECT_FALSE(cache->get(0).has_value());
+
+    cache->insert(5, 3.);
+    cache->insert(0, INFINITY_CONTINUOUS_COST);
+
+    EXPECT_EQ(cache->get(5), 3.);
+    EXPECT_EQ(cache->get(0), INFINITY_CONTINUOUS_COST);
+    EXPECT_FALSE(cache->get(1).has_value());
+    EXPECT_FALSE(cache->get(6).has_value());
+
+    cache->clear();
+
+    EXPECT_FALSE(cache->get(5).has_value());
+}
+
+TEST(MimirTests, SearchHeuristicsCacheMemoryLimitTest)
+{
+    auto cache = HeuristicCacheImpl::create(4 * sizeof(ContinuousCost));
+
+    EXPECT_EQ(cache->get_max_num_entries(), 4);
+
+    cache->insert(3, 1.);
+    cache->insert(4, 2.);
+
+    EXPECT_EQ(cache->get(3), 1.);
+    EXPECT_FALSE(cache->get(4).has_value());
+    EXPECT_LE(cache->get_estimated_memory_usage_in_bytes(), 4 * sizeof(ContinuousCost));
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/max.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/grounders/lifted.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <deque>
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+class MaxHeuristicBatchTest : public testing::TestWithParam<std::string>
+{
+};
+
+TEST_P(MaxHeuristicBatchTest, SearchHeuristicsMaxBatchTest)
+{
+    const auto domain_name = GetParam();
+    const auto domain_file = fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl");
+
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::GroundedOptions()));
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto& state_repository = *search_context->get_state_repository();
+
+    // Collect more states than fit into a single word.
+    auto states = StateList {};
+    auto queue = std::deque<State> {};
+    auto successors = SuccessorBatch();
+    queue.push_back(state_repository.get_or_create_initial_state().first);
+    while (!queue.empty() && states.size() < 150)
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+        states.push_back(state);
+
+        // New states receive consecutive indices in the order of the successors.
+        auto next_state_index = static_cast<Index>(state_repository.get_state_count());
+        state_repository.expand(state, 0., applicable_action_generator, successors);
+        for (const auto& successor : successors)
+        {
+            if (successor.state.get_index() == next_state_index)
+            {
+                queue.push_back(successor.state);
+                ++next_state_index;
+            }
+        }
+    }
+
+    const auto grounder = LiftedGrounder(problem);
+    const auto hmax = MaxHeuristicImpl::create(grounder);
+
+    EXPECT_TRUE(hmax->supports_batch_evaluation());
+
+    auto h_values = std::vector<ContinuousCost>(states.size());
+    hmax->compute_heuristics(states, h_values);
+
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        EXPECT_EQ(h_values[i], hmax->compute_heuristic(states[i]));
+    }
+
+    EXPECT_THROW(hmax->compute_heuristics(states, std::span<ContinuousCost>(h_values.data(), 1)), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(MimirTests,
+                         MaxHeuristicBatchTest,
+                         testing::Values("blocks_4", "childsnack", "gripper", "logistics", "miconic", "philosophers", "spanner", "visitall"));
+}
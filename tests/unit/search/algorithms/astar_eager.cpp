@@ -19,6 +19,10 @@
 
 #include "mimir/formalism/repositories.hpp"
 #include "mimir/search/algorithms.hpp"
+#include "mimir/search/algorithms/checkpoint.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/algorithms/strategies/symmetry_pruning_strategy.hpp"
+#include "mimir/search/applicability.hpp"
 #include "mimir/search/applicable_action_generators.hpp"
 #include "mimir/search/axiom_evaluators.hpp"
 #include "mimir/search/grounders.hpp"
@@ -227,6 +231,11 @@ TEST(MimirTests, SearchAlgorithmsAStarGroundedBlindGripperTest)
 
     EXPECT_EQ(astar_statistics.get_num_generated_until_f_value().rbegin()->second, 44);
     EXPECT_EQ(astar_statistics.get_num_expanded_until_f_value().rbegin()->second, 12);
+
+    // Every expanded state is looked up in the unpacked state cache of the state repository.
+    EXPECT_GE(astar_statistics.get_num_unpacked_state_cache_hits() + astar_statistics.get_num_unpacked_state_cache_misses(),
+              astar_statistics.get_num_expanded());
+    EXPECT_GT(astar_statistics.get_num_bytes_for_unpacked_state_cache(), 0);
 }
 
 TEST(MimirTests, SearchAlgorithmsAStarLiftedBlindGripperTest)
@@ -246,6 +255,130 @@ TEST(MimirTests, SearchAlgorithmsAStarLiftedBlindGripperTest)
     EXPECT_EQ(astar_statistics.get_num_expanded_until_f_value().rbegin()->second, 12);
 }
 
+/// @brief Forward single evaluations to a heuristic but hide its batch evaluation from the search.
+class UnbatchedHeuristic : public IHeuristic
+{
+private:
+    Heuristic m_heuristic;
+
+public:
+    explicit UnbatchedHeuristic(Heuristic heuristic) : m_heuristic(std::move(heuristic)) {}
+
+    ContinuousCost compute_heuristic(const State& state, GroundConjunctiveCondition goal = nullptr) override
+    {
+        return m_heuristic->compute_heuristic(state, goal);
+    }
+};
+
+TEST(MimirTests, SearchAlgorithmsAStarBatchedMaxGripperTest)
+{
+    auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                    fs::path(std::string(DATA_DIR) + "gripper/p-2-0.pddl"),
+                                                    SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    const auto grounder = LiftedGrounder(search_context->get_problem());
+    const auto hmax = MaxHeuristicImpl::create(grounder);
+    ASSERT_TRUE(hmax->supports_batch_evaluation());
+
+    auto batched_options = astar_eager::Options();
+    batched_options.event_handler = astar_eager::DefaultEventHandlerImpl::create(search_context->get_problem());
+    auto unbatched_options = astar_eager::Options();
+    unbatched_options.event_handler = astar_eager::DefaultEventHandlerImpl::create(search_context->get_problem());
+
+    const auto batched_result = astar_eager::find_solution(search_context, hmax, batched_options);
+    const auto unbatched_result = astar_eager::find_solution(search_context, std::make_shared<UnbatchedHeuristic>(hmax), unbatched_options);
+
+    ASSERT_EQ(batched_result.status, SearchStatus::SOLVED);
+    ASSERT_EQ(unbatched_result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(batched_result.plan.value().get_cost(), unbatched_result.plan.value().get_cost());
+    EXPECT_EQ(batched_options.event_handler->get_statistics().get_num_expanded(), unbatched_options.event_handler->get_statistics().get_num_expanded());
+    EXPECT_EQ(batched_options.event_handler->get_statistics().get_num_generated(), unbatched_options.event_handler->get_statistics().get_num_generated());
+}
+
+TEST(MimirTests, SearchAlgorithmsAStarCheckpointGripperTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl");
+    const auto checkpoint_file = fs::temp_directory_path() / "mimir_astar_checkpoint_test.bin";
+
+    auto astar_options = astar_eager::Options();
+    astar_options.checkpoint_file = checkpoint_file;
+    astar_options.resume_from_checkpoint = true;
+
+    {
+        // The search runs out of time immediately and writes a checkpoint.
+        auto search_context =
+            SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+        auto options = astar_options;
+        options.max_time_in_ms = 0;
+        const auto result = astar_eager::find_solution(search_context, BlindHeuristicImpl::create(search_context->get_problem()), options);
+
+        EXPECT_EQ(result.status, SearchStatus::OUT_OF_TIME);
+        EXPECT_TRUE(fs::exists(checkpoint_file));
+        EXPECT_TRUE(fs::exists(get_checkpoint_states_file(checkpoint_file)));
+    }
+
+    // A new search on a freshly parsed problem resumes from the checkpoint.
+    auto search_context =
+        SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    const auto result = astar_eager::find_solution(search_context, BlindHeuristicImpl::create(search_context->get_problem()), astar_options);
+    fs::remove(checkpoint_file);
+    fs::remove(get_checkpoint_states_file(checkpoint_file));
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+}
+
+TEST(MimirTests, SearchAlgorithmsAStarCheckpointResumeGripperTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/p-2-0.pddl");
+    const auto checkpoint_file = fs::temp_directory_path() / "mimir_astar_checkpoint_resume_test.bin";
+
+    auto astar_options = astar_eager::Options();
+    astar_options.checkpoint_file = checkpoint_file;
+    astar_options.resume_from_checkpoint = true;
+
+    auto optimal_plan_cost = ContinuousCost(0);
+    {
+        auto search_context =
+            SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+        const auto result = astar_eager::find_solution(search_context, BlindHeuristicImpl::create(search_context->get_problem()));
+        ASSERT_EQ(result.status, SearchStatus::SOLVED);
+        optimal_plan_cost = result.plan.value().get_cost();
+    }
+    {
+        // A checkpoint is written before each expansion until the search runs out of states.
+        auto search_context =
+            SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+        auto options = astar_options;
+        options.checkpoint_interval_in_ms = 0;
+        options.max_num_states = 20;
+        const auto result = astar_eager::find_solution(search_context, BlindHeuristicImpl::create(search_context->get_problem()), options);
+
+        EXPECT_EQ(result.status, SearchStatus::OUT_OF_STATES);
+        EXPECT_TRUE(fs::exists(checkpoint_file));
+    }
+
+    // The resumed search grounds actions in a different order, so the plan must not depend on the ground action indices of the checkpoint.
+    auto search_context =
+        SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    const auto result = astar_eager::find_solution(search_context, BlindHeuristicImpl::create(search_context->get_problem()), astar_options);
+    fs::remove(checkpoint_file);
+    fs::remove(get_checkpoint_states_file(checkpoint_file));
+
+    ASSERT_EQ(result.status, SearchStatus::SOLVED);
+    const auto& plan = result.plan.value();
+    EXPECT_EQ(plan.get_cost(), optimal_plan_cost);
+    ASSERT_EQ(plan.get_states().size(), plan.get_actions().size() + 1);
+    for (size_t i = 0; i < plan.get_actions().size(); ++i)
+    {
+        EXPECT_TRUE(is_applicable(plan.get_actions()[i], plan.get_states()[i]));
+        const auto [successor_state, successor_state_metric_value] =
+            search_context->get_state_repository()->get_or_create_successor_state(plan.get_states()[i], plan.get_actions()[i], 0.);
+        EXPECT_EQ(successor_state.get_index(), plan.get_states()[i + 1].get_index());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// Numeric planning
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -364,4 +497,88 @@ TEST(MimirTests, SearchAlgorithmsAStarLiftedBlindZenotravelNumericTest)
     EXPECT_EQ(astar_statistics.get_num_expanded_until_f_value().rbegin()->second, 170);
 }
 
+
+/**
+ * Symmetry pruning
+ */
+
+TEST(MimirTests, SearchAlgorithmsAStarSymmetryPruningGripperTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "gripper/test_problem2.pddl"));
+
+    auto solve = [&](PruningStrategy pruning_strategy)
+    {
+        const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::GroundedOptions()));
+        auto astar_options = astar_eager::Options();
+        astar_options.event_handler = astar_eager::DefaultEventHandlerImpl::create(problem, true);
+        astar_options.pruning_strategy = pruning_strategy;
+        auto result = astar_eager::find_solution(search_context, BlindHeuristicImpl::create(problem), astar_options);
+        return std::make_pair(result, astar_options.event_handler->get_statistics().get_num_generated());
+    };
+
+    const auto [unpruned_result, unpruned_num_generated] = solve(NoPruningStrategyImpl::create());
+
+    for (const auto certificate_type : { SymmetryPruningStrategyImpl::CertificateType::GI, SymmetryPruningStrategyImpl::CertificateType::WL1 })
+    {
+        const auto pruning_strategy = SymmetryPruningStrategyImpl::create(problem, certificate_type);
+        const auto [result, num_generated] = solve(pruning_strategy);
+
+        EXPECT_EQ(result.status, SearchStatus::SOLVED);
+        EXPECT_EQ(result.plan.value().get_cost(), unpruned_result.plan.value().get_cost());
+        EXPECT_LT(num_generated, unpruned_num_generated);
+
+        // The plan is a path in the original state space.
+        const auto& states = result.plan.value().get_states();
+        const auto& actions = result.plan.value().get_actions();
+        ASSERT_EQ(states.size(), actions.size() + 1);
+        for (size_t i = 0; i < actions.size(); ++i)
+        {
+            EXPECT_TRUE(is_applicable(actions[i], states[i]));
+        }
+        EXPECT_TRUE(ProblemGoalStrategyImpl::create(problem)->test_dynamic_goal(states.back()));
+
+        const auto& statistics = pruning_strategy->get_statistics();
+        EXPECT_GT(statistics.num_pruned_states, 0);
+        EXPECT_GT(statistics.num_certificate_cache_hits, 0);
+        EXPECT_LE(statistics.num_equivalence_classes, statistics.num_certificates);
+    }
+}
+
+TEST(MimirTests, SearchAlgorithmsAStarSymmetryPruningTransportTest)
+{
+    // Transport has action costs, and h_max is not blind, so the first generated state of a class need not be the cheapest one.
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "transport/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "transport/test_problem.pddl"));
+
+    auto solve = [&](PruningStrategy pruning_strategy)
+    {
+        const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::GroundedOptions()));
+        const auto grounder = LiftedGrounder(problem);
+        auto astar_options = astar_eager::Options();
+        astar_options.pruning_strategy = pruning_strategy;
+        return astar_eager::find_solution(search_context, MaxHeuristicImpl::create(grounder), astar_options);
+    };
+
+    const auto unpruned_result = solve(NoPruningStrategyImpl::create());
+    ASSERT_EQ(unpruned_result.status, SearchStatus::SOLVED);
+
+    for (const auto certificate_type : { SymmetryPruningStrategyImpl::CertificateType::GI, SymmetryPruningStrategyImpl::CertificateType::WL1 })
+    {
+        const auto pruning_strategy = SymmetryPruningStrategyImpl::create(problem, certificate_type);
+        const auto result = solve(pruning_strategy);
+
+        ASSERT_EQ(result.status, SearchStatus::SOLVED);
+        EXPECT_EQ(result.plan.value().get_cost(), unpruned_result.plan.value().get_cost());
+        EXPECT_GT(pruning_strategy->get_statistics().num_pruned_states, 0);
+
+        const auto& states = result.plan.value().get_states();
+        const auto& actions = result.plan.value().get_actions();
+        for (size_t i = 0; i < actions.size(); ++i)
+        {
+            EXPECT_TRUE(is_applicable(actions[i], states[i]));
+        }
+    }
+}
+
 }
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/astar_parallel.hpp"
+
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/algorithms.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/grounders.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Instantiate a grounded parallel AStar with one applicable action generator and one heuristic per thread.
+class GroundedParallelAStarPlanner
+{
+private:
+    Problem m_problem;
+    LiftedGrounder m_delete_relaxed_problem_explorator;
+    GroundedApplicableActionGeneratorImpl::EventHandler m_applicable_action_generator_event_handler;
+    GroundedApplicableActionGenerator m_applicable_action_generator;
+    GroundedAxiomEvaluatorImpl::EventHandler m_axiom_evaluator_event_handler;
+    GroundedAxiomEvaluator m_axiom_evaluator;
+    StateRepository m_state_repository;
+    Heuristic m_heuristic;
+    astar_eager::EventHandler m_astar_event_handler;
+    SearchContext m_search_context;
+
+    static StateRepositoryImpl::Options create_state_repository_options()
+    {
+        auto options = StateRepositoryImpl::Options();
+        options.thread_safe = true;
+        return options;
+    }
+
+public:
+    GroundedParallelAStarPlanner(const fs::path& domain_file, const fs::path& problem_file) :
+        m_problem(ProblemImpl::create(domain_file, problem_file)),
+        m_delete_relaxed_problem_explorator(m_problem),
+        m_applicable_action_generator_event_handler(GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create()),
+        m_applicable_action_generator(
+            m_delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(match_tree::Options(),
+                                                                                            m_applicable_action_generator_event_handler)),
+        m_axiom_evaluator_event_handler(GroundedAxiomEvaluatorImpl::DefaultEventHandlerImpl::create()),
+        m_axiom_evaluator(m_delete_relaxed_problem_explorator.create_grounded_axiom_evaluator(match_tree::Options(), m_axiom_evaluator_event_handler)),
+        m_state_repository(StateRepositoryImpl::create(m_axiom_evaluator, create_state_repository_options())),
+        m_heuristic(BlindHeuristicImpl::create(m_problem)),
+        m_astar_event_handler(astar_eager::DefaultEventHandlerImpl::create(m_problem)),
+        m_search_context(SearchContextImpl::create(m_problem, m_applicable_action_generator, m_state_repository))
+    {
+    }
+
+    SearchResult find_solution(size_t num_threads)
+    {
+        auto astar_options = astar_parallel::Options();
+        astar_options.event_handler = m_astar_event_handler;
+        astar_options.num_threads = num_threads;
+        astar_options.create_applicable_action_generator = [this]()
+        { return m_delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(); };
+        astar_options.create_heuristic = [this]() { return BlindHeuristicImpl::create(m_problem); };
+
+        return astar_parallel::find_solution(m_search_context, m_heuristic, astar_options);
+    }
+
+    SearchResult find_serial_solution()
+    {
+        auto astar_options = astar_eager::Options();
+        astar_options.event_handler = m_astar_event_handler;
+
+        return astar_eager::find_solution(m_search_context, m_heuristic, astar_options);
+    }
+};
+
+/**
+ * Gripper
+ */
+
+TEST(MimirTests, SearchAlgorithmsAStarParallelGroundedBlindGripperTest)
+{
+    for (const auto num_threads : { 1, 2, 4 })
+    {
+        auto astar = GroundedParallelAStarPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                  fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+        auto result = astar.find_solution(num_threads);
+
+        EXPECT_EQ(result.status, SearchStatus::SOLVED);
+        EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+    }
+}
+
+/**
+ * Fo-counters
+ */
+
+TEST(MimirTests, SearchAlgorithmsAStarParallelGroundedBlindFoCountersTest)
+{
+    for (const auto num_threads : { 1, 4 })
+    {
+        auto astar = GroundedParallelAStarPlanner(fs::path(std::string(DATA_DIR) + "fo-counters/domain.pddl"),
+                                                  fs::path(std::string(DATA_DIR) + "fo-counters/test_problem.pddl"));
+        auto result = astar.find_solution(num_threads);
+
+        EXPECT_EQ(result.status, SearchStatus::SOLVED);
+        EXPECT_EQ(result.plan.value().get_actions().size(), 5);
+    }
+}
+
+/**
+ * Lifted
+ */
+
+TEST(MimirTests, SearchAlgorithmsAStarParallelLiftedRejectsMultipleThreadsTest)
+{
+    const auto problem =
+        ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    auto state_repository_options = StateRepositoryImpl::Options();
+    state_repository_options.thread_safe = true;
+    const auto search_context = SearchContextImpl::create(problem,
+                                                          KPKCLiftedApplicableActionGeneratorImpl::create(problem),
+                                                          StateRepositoryImpl::create(KPKCLiftedAxiomEvaluatorImpl::create(problem), state_repository_options));
+    const auto heuristic = BlindHeuristicImpl::create(problem);
+
+    auto astar_options = astar_parallel::Options();
+    astar_options.num_threads = 2;
+    astar_options.create_applicable_action_generator = [&]() { return KPKCLiftedApplicableActionGeneratorImpl::create(problem); };
+    astar_options.create_heuristic = [&]() { return BlindHeuristicImpl::create(problem); };
+
+    EXPECT_THROW(astar_parallel::find_solution(search_context, heuristic, astar_options), std::runtime_error);
+}
+
+/**
+ * Serial A* comparison
+ */
+
+TEST(MimirTests, SearchAlgorithmsAStarParallelGroundedBlindMatchesSerialTest)
+{
+    const auto instances = std::vector<std::pair<std::string, std::string>> {
+        { "blocks_4/domain.pddl", "blocks_4/test_problem.pddl" },
+        { "childsnack/domain.pddl", "childsnack/test_problem.pddl" },
+        { "delivery/domain.pddl", "delivery/test_problem.pddl" },
+        { "ferry/domain.pddl", "ferry/test_problem.pddl" },
+        { "logistics/domain.pddl", "logistics/test_problem.pddl" },
+        { "miconic/domain.pddl", "miconic/test_problem.pddl" },
+        { "miconic-fulladl/domain.pddl", "miconic-fulladl/test_problem.pddl" },
+        { "spanner/domain.pddl", "spanner/test_problem.pddl" },
+        { "tpp/numeric/domain.pddl", "tpp/numeric/test_problem.pddl" },
+    };
+
+    for (const auto& [domain_file, problem_file] : instances)
+    {
+        const auto serial_result = GroundedParallelAStarPlanner(fs::path(std::string(DATA_DIR) + domain_file), fs::path(std::string(DATA_DIR) + problem_file))
+                                       .find_serial_solution();
+        ASSERT_EQ(serial_result.status, SearchStatus::SOLVED) << domain_file;
+
+        for (const auto num_threads : { 1, 3, 4 })
+        {
+            auto astar = GroundedParallelAStarPlanner(fs::path(std::string(DATA_DIR) + domain_file), fs::path(std::string(DATA_DIR) + problem_file));
+            const auto result = astar.find_solution(num_threads);
+
+            EXPECT_EQ(result.status, SearchStatus::SOLVED) << domain_file << " with " << num_threads << " threads";
+            EXPECT_EQ(result.plan.value().get_cost(), serial_result.plan.value().get_cost()) << domain_file << " with " << num_threads << " threads";
+        }
+    }
+}
+
+}
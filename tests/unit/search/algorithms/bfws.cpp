@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/bfws.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms.hpp"
+#include "mimir/search/grounders.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Instantiate a BFWS search with the FF heuristic
+class BFWSPlanner
+{
+private:
+    Problem m_problem;
+    SearchContext m_search_context;
+    FFHeuristic m_heuristic;
+    bfws::EventHandler m_event_handler;
+
+public:
+    BFWSPlanner(const fs::path& domain_file, const fs::path& problem_file, SearchContextImpl::Options options) :
+        m_problem(ProblemImpl::create(domain_file, problem_file)),
+        m_search_context(SearchContextImpl::create(m_problem, options)),
+        m_heuristic(FFHeuristicImpl::create(LiftedGrounder(m_problem))),
+        m_event_handler(bfws::DefaultEventHandlerImpl::create(m_problem))
+    {
+    }
+
+    SearchResult find_solution(size_t max_arity)
+    {
+        auto bfws_options = bfws::Options();
+        bfws_options.event_handler = m_event_handler;
+        bfws_options.max_arity = max_arity;
+
+        return bfws::find_solution(m_search_context, m_heuristic, bfws_options);
+    }
+
+    const bfws::Statistics& get_statistics() const { return m_event_handler->get_statistics(); }
+};
+
+static void check_statistics(const bfws::Statistics& statistics)
+{
+    const auto& num_generated_by_novelty = statistics.get_num_generated_by_novelty();
+
+    EXPECT_GT(statistics.get_num_expanded(), 0);
+    EXPECT_GT(statistics.get_num_relaxed_plans(), 0);
+    EXPECT_GT(statistics.get_num_partitions(), 0);
+    EXPECT_EQ(std::accumulate(num_generated_by_novelty.begin(), num_generated_by_novelty.end(), uint64_t(0)), statistics.get_num_generated());
+}
+
+/**
+ * Gripper
+ */
+
+TEST(MimirTests, SearchAlgorithmsBFWSGroundedGripperTest)
+{
+    auto bfws = BFWSPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                            fs::path(std::string(DATA_DIR) + "gripper/test_problem2.pddl"),
+                            SearchContextImpl::Options(SearchContextImpl::GroundedOptions()));
+    const auto result = bfws.find_solution(2);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_GE(result.plan.value().get_actions().size(), 7);
+
+    check_statistics(bfws.get_statistics());
+}
+
+TEST(MimirTests, SearchAlgorithmsBFWSLiftedGripperTest)
+{
+    auto bfws = BFWSPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                            fs::path(std::string(DATA_DIR) + "gripper/test_problem2.pddl"),
+                            SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    const auto result = bfws.find_solution(2);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_GE(result.plan.value().get_actions().size(), 7);
+
+    check_statistics(bfws.get_statistics());
+}
+
+/**
+ * Miconic
+ */
+
+TEST(MimirTests, SearchAlgorithmsBFWSLiftedMiconicTest)
+{
+    auto bfws = BFWSPlanner(fs::path(std::string(DATA_DIR) + "miconic/domain.pddl"),
+                            fs::path(std::string(DATA_DIR) + "miconic/test_problem.pddl"),
+                            SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    const auto result = bfws.find_solution(1);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+
+    check_statistics(bfws.get_statistics());
+}
+
+TEST(MimirTests, SearchAlgorithmsBFWSInvalidArityTest)
+{
+    auto bfws = BFWSPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                            fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                            SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    EXPECT_THROW(bfws.find_solution(0), std::runtime_error);
+}
+
+}
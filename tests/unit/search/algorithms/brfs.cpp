@@ -17,8 +17,10 @@
 
 #include "mimir/search/algorithms/brfs.hpp"
 
+#include "mimir/formalism/problem.hpp"
 #include "mimir/formalism/repositories.hpp"
 #include "mimir/search/algorithms.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
 #include "mimir/search/applicable_action_generators.hpp"
 #include "mimir/search/axiom_evaluators.hpp"
 #include "mimir/search/grounders.hpp"
@@ -1003,4 +1005,164 @@ TEST(MimirTests, SearchAlgorithmsBrFSLiftedZenotravelNumericTest)
     EXPECT_EQ(brfs_statistics.get_num_expanded_until_g_value().back(), 1084);
 }
 
+TEST(MimirTests, SearchAlgorithmsBrFSOutOfMemoryTest)
+{
+    auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                    fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                                                    SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+    auto brfs_options = brfs::Options();
+    brfs_options.max_memory_in_bytes = 1;
+
+    const auto result = brfs::find_solution(search_context, brfs_options);
+    EXPECT_EQ(result.status, SearchStatus::OUT_OF_MEMORY);
+    EXPECT_FALSE(result.plan.has_value());
+
+    const auto memory_usage = search_context->get_memory_usage();
+    EXPECT_GT(memory_usage.num_bytes_for_states, 0);
+    EXPECT_GT(memory_usage.num_bytes_for_ground_actions, 0);
+    EXPECT_GT(memory_usage.num_bytes_for_lists, 0);
+    EXPECT_GT(memory_usage.get_total(), brfs_options.max_memory_in_bytes);
+    // Only ground objects created since the last call are visited, which must not change the estimate.
+    EXPECT_EQ(search_context->get_memory_usage().num_bytes_for_ground_actions, memory_usage.num_bytes_for_ground_actions);
+
+    // A budget above the final memory usage does not change the outcome.
+    brfs_options.max_memory_in_bytes = std::numeric_limits<uint32_t>::max();
+    EXPECT_EQ(brfs::find_solution(search_context, brfs_options).status, SearchStatus::SOLVED);
+}
+
+TEST(MimirTests, SearchAlgorithmsBrFSExternalTest)
+{
+    auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                    fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                                                    SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+    auto brfs_options = brfs::Options();
+    brfs_options.event_handler = brfs::DefaultEventHandlerImpl::create(search_context->get_problem());
+    brfs_options.stop_if_goal = false;
+
+    auto brfs_external_options = brfs_external::Options();
+    brfs_external_options.event_handler = brfs::DefaultEventHandlerImpl::create(search_context->get_problem());
+    brfs_external_options.stop_if_goal = false;
+    // Force several sorted runs per layer.
+    brfs_external_options.max_num_states_in_memory = 4;
+
+    EXPECT_EQ(brfs::find_solution(search_context, brfs_options).status, SearchStatus::EXHAUSTED);
+    EXPECT_EQ(brfs_external::find_solution(search_context, brfs_external_options).status, SearchStatus::EXHAUSTED);
+
+    const auto& brfs_statistics = brfs_options.event_handler->get_statistics();
+    const auto& brfs_external_statistics = brfs_external_options.event_handler->get_statistics();
+
+    EXPECT_EQ(brfs_external_statistics.get_num_expanded_until_g_value(), brfs_statistics.get_num_expanded_until_g_value());
+    EXPECT_EQ(brfs_external_statistics.get_num_generated_until_g_value(), brfs_statistics.get_num_generated_until_g_value());
+    EXPECT_EQ(brfs_external_statistics.get_num_expanded(), brfs_statistics.get_num_expanded());
+
+    brfs_external_options.stop_if_goal = true;
+    const auto result = brfs_external::find_solution(search_context, brfs_external_options);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+    EXPECT_EQ(result.plan.value().get_states().back().get_index(), result.goal_state.value().get_index());
+}
+
+TEST(MimirTests, SearchAlgorithmsBrFSExternalWindowTest)
+{
+    auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                    fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                                                    SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    search_context->get_state_repository()->get_or_create_initial_state();
+    const auto num_bytes_for_index_tree_table = search_context->get_problem()->get_index_tree_table().mem_usage();
+
+    auto brfs_options = brfs::Options();
+    brfs_options.event_handler = brfs::DefaultEventHandlerImpl::create(search_context->get_problem());
+    brfs_options.stop_if_goal = false;
+
+    // Every action in gripper can be undone by one action, so a window of two layers detects all duplicates.
+    auto brfs_external_options = brfs_external::Options();
+    brfs_external_options.event_handler = brfs::DefaultEventHandlerImpl::create(search_context->get_problem());
+    brfs_external_options.stop_if_goal = false;
+    brfs_external_options.max_num_states_in_memory = 4;
+    brfs_external_options.num_layers_for_duplicate_detection = 2;
+
+    EXPECT_EQ(brfs_external::find_solution(search_context, brfs_external_options).status, SearchStatus::EXHAUSTED);
+
+    // The materialized states are packed into private tables.
+    EXPECT_EQ(search_context->get_problem()->get_index_tree_table().mem_usage(), num_bytes_for_index_tree_table);
+
+    EXPECT_EQ(brfs::find_solution(search_context, brfs_options).status, SearchStatus::EXHAUSTED);
+    EXPECT_EQ(brfs_external_options.event_handler->get_statistics().get_num_expanded_until_g_value(),
+              brfs_options.event_handler->get_statistics().get_num_expanded_until_g_value());
+}
+
+TEST(MimirTests, SearchAlgorithmsBrFSBitstateTest)
+{
+    auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                    fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                                                    SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+    auto brfs_options = brfs::Options();
+    brfs_options.event_handler = brfs::DefaultEventHandlerImpl::create(search_context->get_problem());
+    brfs_options.stop_if_goal = false;
+
+    auto brfs_bitstate_options = brfs::Options();
+    brfs_bitstate_options.event_handler = brfs::DefaultEventHandlerImpl::create(search_context->get_problem());
+    brfs_bitstate_options.stop_if_goal = false;
+    brfs_bitstate_options.bitstate_num_bits = 1 << 20;
+    brfs_bitstate_options.bitstate_num_hash_functions = 2;
+    // Force several resets of the temporary state repository per layer.
+    brfs_bitstate_options.bitstate_max_num_states_in_memory = 4;
+
+    EXPECT_EQ(brfs::find_solution(search_context, brfs_options).status, SearchStatus::EXHAUSTED);
+    EXPECT_EQ(brfs::find_solution(search_context, brfs_bitstate_options).status, SearchStatus::EXHAUSTED);
+
+    const auto& brfs_statistics = brfs_options.event_handler->get_statistics();
+    const auto& brfs_bitstate_statistics = brfs_bitstate_options.event_handler->get_statistics();
+
+    // With a sparse filter, no state is omitted and the layers coincide.
+    EXPECT_EQ(brfs_bitstate_statistics.get_num_states(), 28);
+    EXPECT_EQ(brfs_bitstate_statistics.get_num_expanded_until_g_value(), brfs_statistics.get_num_expanded_until_g_value());
+    EXPECT_EQ(brfs_bitstate_statistics.get_num_generated_until_g_value(), brfs_statistics.get_num_generated_until_g_value());
+    EXPECT_EQ(brfs_bitstate_statistics.get_num_bitstate_bits(), 1 << 20);
+    EXPECT_GT(brfs_bitstate_statistics.get_estimated_omission_probability(), 0.);
+    EXPECT_LT(brfs_bitstate_statistics.get_estimated_omission_probability(), 1e-6);
+    EXPECT_EQ(brfs_statistics.get_estimated_omission_probability(), 0.);
+
+    // With a dense filter, states are omitted, which is reflected in the estimate.
+    brfs_bitstate_options.bitstate_num_bits = 16;
+    brfs_bitstate_options.bitstate_num_hash_functions = 1;
+    EXPECT_EQ(brfs::find_solution(search_context, brfs_bitstate_options).status, SearchStatus::EXHAUSTED);
+    EXPECT_LE(brfs_bitstate_statistics.get_num_states(), 16);
+    EXPECT_GT(brfs_bitstate_statistics.get_estimated_omission_probability(), 0.5);
+
+    // A solved search returns an optimal plan that is replayed from the traces.
+    brfs_bitstate_options.bitstate_num_bits = 1 << 20;
+    brfs_bitstate_options.stop_if_goal = true;
+    const auto result = brfs::find_solution(search_context, brfs_bitstate_options);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    ASSERT_TRUE(result.plan.has_value());
+    EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+    EXPECT_EQ(result.plan.value().get_states().front(), search_context->get_state_repository()->get_or_create_initial_state().first);
+    EXPECT_TRUE(ProblemGoalStrategyImpl::create(search_context->get_problem())->test_dynamic_goal(result.goal_state.value()));
+}
+
+TEST(MimirTests, SearchAlgorithmsBrFSBitstateInitialCostTest)
+{
+    // The initial total-cost is 1000, which the plan costs of all extractors include.
+    auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "transport/domain.pddl"),
+                                                    fs::path(std::string(DATA_DIR) + "transport/test_problem2.pddl"),
+                                                    SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+    auto brfs_options = brfs::Options();
+    auto brfs_bitstate_options = brfs::Options();
+    brfs_bitstate_options.bitstate_num_bits = 1 << 20;
+
+    const auto result = brfs::find_solution(search_context, brfs_options);
+    const auto bitstate_result = brfs::find_solution(search_context, brfs_bitstate_options);
+    ASSERT_EQ(result.status, SearchStatus::SOLVED);
+    ASSERT_EQ(bitstate_result.status, SearchStatus::SOLVED);
+
+    EXPECT_EQ(bitstate_result.plan.value().get_actions().size(), result.plan.value().get_actions().size());
+    EXPECT_GT(result.plan.value().get_cost(), 1000.);
+    EXPECT_GT(bitstate_result.plan.value().get_cost(), 1000.);
+}
+
 }
@@ -21,6 +21,7 @@
 #include "mimir/formalism/repositories.hpp"
 #include "mimir/search/algorithms.hpp"
 #include "mimir/search/algorithms/iw/event_handlers.hpp"
+#include "mimir/search/algorithms/iw/novelty_table.hpp"
 #include "mimir/search/algorithms/iw/tuple_index_generators.hpp"
 #include "mimir/search/algorithms/iw/tuple_index_mapper.hpp"
 #include "mimir/search/applicable_action_generators.hpp"
@@ -30,7 +31,10 @@
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <algorithm>
+#include <deque>
 #include <gtest/gtest.h>
+#include <unordered_set>
 
 using namespace mimir::search;
 using namespace mimir::formalism;
@@ -326,6 +330,142 @@ TEST(MimirTests, SearchAlgorithmsIWStatePairTupleIndexGeneratorWidth2Test3)
     EXPECT_EQ(++iter, generator.end());
 }
 
+/// @brief The sparse novelty table yields the same novelty tests and novel tuples as the dense novelty table.
+TEST(MimirTests, SearchAlgorithmsIWSparseNoveltyTableTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto& state_repository = *search_context->get_state_repository();
+
+    for (const size_t arity : { 1, 2, 3 })
+    {
+        auto dense_novelty_table = iw::DynamicNoveltyTable(arity);
+        auto sparse_novelty_table = iw::DynamicNoveltyTable(arity, size_t(1) << 20);
+        EXPECT_FALSE(dense_novelty_table.is_sparse());
+        EXPECT_TRUE(sparse_novelty_table.is_sparse());
+
+        const auto initial_state = state_repository.get_or_create_initial_state().first;
+
+        auto dense_novel_tuples = std::vector<iw::AtomIndexList> {};
+        auto sparse_novel_tuples = std::vector<iw::AtomIndexList> {};
+        dense_novelty_table.compute_novel_tuples(initial_state, dense_novel_tuples);
+        sparse_novelty_table.compute_novel_tuples(initial_state, sparse_novel_tuples);
+        std::sort(dense_novel_tuples.begin(), dense_novel_tuples.end());
+        std::sort(sparse_novel_tuples.begin(), sparse_novel_tuples.end());
+        EXPECT_EQ(dense_novel_tuples, sparse_novel_tuples);
+
+        EXPECT_TRUE(dense_novelty_table.test_novelty_and_update_table(initial_state));
+        EXPECT_TRUE(sparse_novelty_table.test_novelty_and_update_table(initial_state));
+
+        // Test novelty along a breadth-first enumeration of the state space.
+        auto queue = std::deque<State> { initial_state };
+        auto visited = std::unordered_set<Index> { initial_state.get_index() };
+        auto applicable_actions = GroundActionList {};
+        while (!queue.empty())
+        {
+            const auto state = queue.front();
+            queue.pop_front();
+
+            applicable_actions.clear();
+            for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+            {
+                applicable_actions.push_back(action);
+            }
+            for (const auto& action : applicable_actions)
+            {
+                const auto successor_state = state_repository.get_or_create_successor_state(state, action, 0.).first;
+                EXPECT_EQ(dense_novelty_table.test_novelty_and_update_table(state, successor_state),
+                          sparse_novelty_table.test_novelty_and_update_table(state, successor_state));
+
+                if (visited.insert(successor_state.get_index()).second)
+                {
+                    queue.push_back(successor_state);
+                }
+            }
+        }
+
+        EXPECT_GT(sparse_novelty_table.get_estimated_memory_usage_in_bytes(), 0);
+    }
+}
+
+TEST(MimirTests, SearchAlgorithmsIWWordParallelNoveltyTableTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto& state_repository = *search_context->get_state_repository();
+
+    // Collect the state pairs of a breadth-first enumeration of the state space.
+    const auto initial_state = state_repository.get_or_create_initial_state().first;
+    auto states = StateList { initial_state };
+    auto state_pairs = std::vector<std::pair<State, State>> {};
+    auto visited = std::unordered_set<Index> { initial_state.get_index() };
+    auto applicable_actions = GroundActionList {};
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        const auto state = states[i];
+
+        applicable_actions.clear();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            applicable_actions.push_back(action);
+        }
+        for (const auto& action : applicable_actions)
+        {
+            const auto successor_state = state_repository.get_or_create_successor_state(state, action, 0.).first;
+            state_pairs.emplace_back(state, successor_state);
+
+            if (visited.insert(successor_state.get_index()).second)
+            {
+                states.push_back(successor_state);
+            }
+        }
+    }
+    const auto num_atoms = static_cast<size_t>(std::ranges::distance(problem->get_repositories().get_ground_atoms<FluentTag>()));
+
+    // Compare the word-parallel updates of arity one and two against the generic tuple index generators.
+    for (const size_t arity : { 1, 2 })
+    {
+        auto novelty_table = iw::DynamicNoveltyTable(arity, num_atoms);
+        const auto tuple_index_mapper = novelty_table.get_tuple_index_mapper();
+        auto state_pair_tuple_index_generator = iw::StatePairTupleIndexGenerator(&tuple_index_mapper);
+        auto expected_table = std::vector<bool>(tuple_index_mapper.get_max_tuple_index() + 1, false);
+
+        for (const auto& [state, successor_state] : state_pairs)
+        {
+            auto expected_is_novel = false;
+            for (auto it = state_pair_tuple_index_generator.begin(state, successor_state); it != state_pair_tuple_index_generator.end(); ++it)
+            {
+                expected_is_novel |= !expected_table[*it];
+                expected_table[*it] = true;
+            }
+            EXPECT_EQ(novelty_table.test_novelty_and_update_table(state, successor_state), expected_is_novel);
+        }
+        EXPECT_EQ(novelty_table.get_tuple_index_mapper().get_num_atoms(), tuple_index_mapper.get_num_atoms());
+
+        auto state_tuple_index_generator = iw::StateTupleIndexGenerator(&tuple_index_mapper);
+        auto novel_tuples = std::vector<iw::AtomIndexList> {};
+        for (const auto& state : states)
+        {
+            auto expected_novel_tuples = std::vector<iw::AtomIndexList> {};
+            for (auto it = state_tuple_index_generator.begin(state); it != state_tuple_index_generator.end(); ++it)
+            {
+                if (!expected_table[*it])
+                {
+                    expected_novel_tuples.push_back(tuple_index_mapper.to_atom_indices(*it));
+                }
+            }
+            novelty_table.compute_novel_tuples(state, novel_tuples);
+            std::sort(novel_tuples.begin(), novel_tuples.end());
+            std::sort(expected_novel_tuples.begin(), expected_novel_tuples.end());
+            EXPECT_EQ(novel_tuples, expected_novel_tuples);
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// Classical planning
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -20,11 +20,14 @@
 #include "mimir/search/algorithms.hpp"
 #include "mimir/search/applicable_action_generators.hpp"
 #include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/grounders.hpp"
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <deque>
 #include <gtest/gtest.h>
+#include <unordered_set>
 
 using namespace mimir::search;
 using namespace mimir::formalism;
@@ -66,4 +69,48 @@ TEST(MimirTests, SearchApplicableActionGeneratorsLiftedTest)
     EXPECT_EQ(brfs_statistics.get_num_expanded_until_g_value().back(), 41);
 }
 
+TEST(MimirTests, SearchApplicableActionGeneratorsLiftedIncrementalAssignmentSetsTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl");
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+
+    // The lifted generator and axiom evaluator update their assignment sets from the previous state,
+    // which in a breadth-first enumeration is often not the parent state.
+    const auto lifted_applicable_action_generator = KPKCLiftedApplicableActionGeneratorImpl::create(problem, SearchContextImpl::LiftedOptions::KPKCOptions());
+    const auto state_repository = StateRepositoryImpl::create(KPKCLiftedAxiomEvaluatorImpl::create(problem));
+    const auto grounded_applicable_action_generator = LiftedGrounder(problem).create_grounded_applicable_action_generator();
+
+    const auto initial_state = state_repository->get_or_create_initial_state().first;
+    auto queue = std::deque<State> { initial_state };
+    auto visited = std::unordered_set<Index> { initial_state.get_index() };
+    while (!queue.empty())
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+
+        auto lifted_applicable_actions = std::unordered_set<GroundAction> {};
+        for (const auto& action : lifted_applicable_action_generator->create_applicable_action_generator(state))
+        {
+            lifted_applicable_actions.insert(action);
+        }
+        auto grounded_applicable_actions = std::unordered_set<GroundAction> {};
+        for (const auto& action : grounded_applicable_action_generator->create_applicable_action_generator(state))
+        {
+            grounded_applicable_actions.insert(action);
+        }
+        EXPECT_EQ(lifted_applicable_actions, grounded_applicable_actions);
+
+        for (const auto& action : grounded_applicable_actions)
+        {
+            const auto successor_state = state_repository->get_or_create_successor_state(state, action, 0.).first;
+            if (visited.insert(successor_state.get_index()).second)
+            {
+                queue.push_back(successor_state);
+            }
+        }
+    }
+    EXPECT_EQ(visited.size(), state_repository->get_state_count());
+}
+
 }
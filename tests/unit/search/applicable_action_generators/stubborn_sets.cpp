@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/applicable_action_generators/stubborn_sets.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+static StubbornSetsApplicableActionGenerator get_stubborn_sets(const SearchContext& context)
+{
+    return std::dynamic_pointer_cast<StubbornSetsApplicableActionGeneratorImpl>(context->get_applicable_action_generator());
+}
+
+/// @brief Blind A* with strong stubborn sets finds plans of optimal cost in grounded and lifted mode.
+TEST(MimirTests, SearchApplicableActionGeneratorsStubbornSetsAStarTest)
+{
+    for (const auto& domain_name : std::vector<std::string> { "gripper", "logistics", "transport" })
+    {
+        const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                                 fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl"));
+
+        const auto context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::GroundedOptions()));
+        const auto result = astar_eager::find_solution(context, BlindHeuristicImpl::create(problem));
+        ASSERT_EQ(result.status, SearchStatus::SOLVED);
+
+        for (const auto& mode : std::vector<SearchContextImpl::SearchMode> { SearchContextImpl::GroundedOptions(), SearchContextImpl::LiftedOptions() })
+        {
+            const auto stubborn_sets_context = SearchContextImpl::create(problem, SearchContextImpl::Options(mode, true));
+            const auto stubborn_sets = get_stubborn_sets(stubborn_sets_context);
+            ASSERT_TRUE(stubborn_sets);
+
+            const auto stubborn_sets_result = astar_eager::find_solution(stubborn_sets_context, BlindHeuristicImpl::create(problem));
+            ASSERT_EQ(stubborn_sets_result.status, SearchStatus::SOLVED);
+            EXPECT_EQ(stubborn_sets_result.plan.value().get_cost(), result.plan.value().get_cost());
+
+            const auto& statistics = stubborn_sets->get_statistics();
+            EXPECT_TRUE(statistics.is_supported);
+            EXPECT_GT(statistics.num_states, 0);
+            EXPECT_LE(statistics.num_pruned_actions, statistics.num_unpruned_actions);
+            EXPECT_GT(statistics.num_ground_actions, 0);
+        }
+    }
+}
+
+/// @brief Pruning is disabled for problems with derived predicates and conditional effects.
+TEST(MimirTests, SearchApplicableActionGeneratorsStubbornSetsUnsupportedTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl"));
+    const auto context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::LiftedOptions(), true));
+
+    const auto result = brfs::find_solution(context);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+
+    const auto& statistics = get_stubborn_sets(context)->get_statistics();
+    EXPECT_FALSE(statistics.is_supported);
+    EXPECT_EQ(statistics.num_pruned_actions, 0);
+}
+
+/// @brief Pruning is disabled after the given number of states if the pruning ratio is below the minimum.
+TEST(MimirTests, SearchApplicableActionGeneratorsStubbornSetsDisableTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    const auto base_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+    auto options = StubbornSetsApplicableActionGeneratorImpl::Options();
+    options.min_pruning_ratio = 1.1;
+    options.num_states_before_checking = 1;
+    const auto stubborn_sets = StubbornSetsApplicableActionGeneratorImpl::create(base_context->get_applicable_action_generator(), options);
+    const auto context = SearchContextImpl::create(problem, stubborn_sets, base_context->get_state_repository());
+
+    const auto result = brfs::find_solution(context);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+
+    const auto& statistics = stubborn_sets->get_statistics();
+    EXPECT_TRUE(statistics.is_disabled);
+    EXPECT_EQ(statistics.num_states, 1);
+}
+
+}
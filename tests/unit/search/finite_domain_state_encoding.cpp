@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/finite_domain_state_encoding.hpp"
+
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/predicate.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/grounders/lifted.hpp"
+#include "mimir/search/mutex_groups.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <deque>
+#include <gtest/gtest.h>
+#include <set>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+static IndexList to_index_list(const FlatBitset& bitset) { return IndexList(bitset.begin(), bitset.end()); }
+
+TEST(MimirTests, SearchMutexGroupsGripperTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    const auto grounder = LiftedGrounder(problem);
+    const auto mutex_groups = compute_mutex_groups(grounder);
+
+    auto group_predicates = std::set<std::set<std::string>> {};
+    for (const auto& group : mutex_groups)
+    {
+        auto predicates = std::set<std::string> {};
+        for (const auto atom : group)
+        {
+            predicates.insert(problem->get_repositories().get_ground_atom<FluentTag>(atom)->get_predicate()->get_name());
+        }
+        group_predicates.insert(predicates);
+    }
+
+    // The robot is in one room, each ball is in a room or in a gripper, and each gripper is free or carries a ball.
+    EXPECT_TRUE(group_predicates.contains(std::set<std::string> { "at-robby" }));
+    EXPECT_TRUE(group_predicates.contains(std::set<std::string> { "at", "carry" }));
+    EXPECT_TRUE(group_predicates.contains(std::set<std::string> { "carry", "free" }));
+}
+
+TEST(MimirTests, SearchFiniteDomainStateEncodingGripperTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    const auto grounder = LiftedGrounder(problem);
+    const auto encoding = FiniteDomainStateEncodingImpl::create(grounder);
+
+    const auto num_fluent_atoms = static_cast<size_t>(std::ranges::distance(problem->get_repositories().get_ground_atoms<FluentTag>()));
+    EXPECT_LT(encoding->get_num_bits(), num_fluent_atoms);
+    EXPECT_EQ(encoding->get_num_bytes_per_state(), encoding->get_num_words() * sizeof(uint64_t));
+
+    // Enumerate the reachable states and insert them into a finite-domain state set.
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto& state_repository = *search_context->get_state_repository();
+
+    auto state_set = FiniteDomainStateSet(encoding);
+    auto queue = std::deque<State> {};
+    auto applicable_actions = GroundActionList {};
+    auto decoded_atoms = FlatBitset();
+
+    const auto initial_state = state_repository.get_or_create_initial_state().first;
+    EXPECT_TRUE(state_set.insert(initial_state.get_atoms<FluentTag>()).second);
+    queue.push_back(initial_state);
+    while (!queue.empty())
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+
+        applicable_actions.clear();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            applicable_actions.push_back(action);
+        }
+        for (const auto& action : applicable_actions)
+        {
+            const auto successor_state = state_repository.get_or_create_successor_state(state, action, 0.).first;
+            const auto [index, inserted] = state_set.insert(successor_state.get_atoms<FluentTag>());
+            EXPECT_TRUE(state_set.contains(successor_state.get_atoms<FluentTag>()));
+
+            state_set.get_fluent_atoms(index, decoded_atoms);
+            EXPECT_EQ(to_index_list(decoded_atoms), to_index_list(successor_state.get_atoms<FluentTag>()));
+
+            if (inserted)
+            {
+                queue.push_back(successor_state);
+            }
+        }
+    }
+
+    EXPECT_EQ(state_set.size(), state_repository.get_state_count());
+    EXPECT_EQ(state_set.size(), 28);
+}
+
+}
@@ -70,6 +70,7 @@ TEST(MimirTests, SearchOpenListsAlternatingTest)
 
     EXPECT_EQ(alternating_queue.size(), 10);
     EXPECT_FALSE(alternating_queue.empty());
+    EXPECT_GE(alternating_queue.get_estimated_memory_usage_in_bytes(), 5 * sizeof(Queue0Entry) + 5 * sizeof(Queue1Entry));
     auto element = alternating_queue.top();
     alternating_queue.pop();
     EXPECT_EQ(element, 0);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/openlists.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace mimir::search;
+
+namespace mimir::tests
+{
+
+struct BucketQueueEntry
+{
+    using KeyType = std::pair<double, int>;
+    using ItemType = int;
+
+    double k;
+    int v;
+
+    KeyType get_key() const { return std::make_pair(k, v); }
+    ItemType get_item() const { return v; }
+    double get_bucket() const { return k; }
+};
+
+TEST(MimirTests, SearchOpenListsBucketTest)
+{
+    auto bucket_queue = BucketOpenList<BucketQueueEntry>();
+    bucket_queue.insert(BucketQueueEntry { 2., 0 });
+    bucket_queue.insert(BucketQueueEntry { 1., 1 });
+    bucket_queue.insert(BucketQueueEntry { 2., 2 });
+    bucket_queue.insert(BucketQueueEntry { 1., 3 });
+    EXPECT_EQ(bucket_queue.size(), 4);
+    EXPECT_FALSE(bucket_queue.uses_fallback());
+
+    /* Ties are broken by insertion order. */
+    EXPECT_EQ(bucket_queue.top(), 1);
+    bucket_queue.pop();
+    EXPECT_EQ(bucket_queue.top(), 3);
+    bucket_queue.pop();
+
+    /* Keys may decrease. */
+    bucket_queue.insert(BucketQueueEntry { 0., 4 });
+    EXPECT_EQ(bucket_queue.top(), 4);
+    bucket_queue.pop();
+    EXPECT_EQ(bucket_queue.top(), 0);
+    bucket_queue.pop();
+    EXPECT_EQ(bucket_queue.top(), 2);
+    bucket_queue.pop();
+    EXPECT_TRUE(bucket_queue.empty());
+}
+
+TEST(MimirTests, SearchOpenListsBucketFallbackTest)
+{
+    auto bucket_queue = BucketOpenList<BucketQueueEntry>();
+    bucket_queue.insert(BucketQueueEntry { 2., 0 });
+    bucket_queue.insert(BucketQueueEntry { 1., 1 });
+    bucket_queue.insert(BucketQueueEntry { 1.5, 2 });
+    EXPECT_TRUE(bucket_queue.uses_fallback());
+    EXPECT_EQ(bucket_queue.size(), 3);
+
+    EXPECT_EQ(bucket_queue.top(), 1);
+    bucket_queue.pop();
+    EXPECT_EQ(bucket_queue.top(), 2);
+    bucket_queue.pop();
+    EXPECT_EQ(bucket_queue.top(), 0);
+    bucket_queue.pop();
+    EXPECT_TRUE(bucket_queue.empty());
+
+    bucket_queue.clear();
+    EXPECT_FALSE(bucket_queue.uses_fallback());
+}
+
+TEST(MimirTests, SearchOpenListsBucketForEachTest)
+{
+    auto bucket_queue = BucketOpenList<BucketQueueEntry>();
+    bucket_queue.insert(BucketQueueEntry { 2., 0 });
+    bucket_queue.insert(BucketQueueEntry { 1., 1 });
+    bucket_queue.insert(BucketQueueEntry { 2., 2 });
+    bucket_queue.pop();
+
+    /* Reinserting the visited entries into an empty queue restores the order of removal. */
+    auto copy = BucketOpenList<BucketQueueEntry>();
+    bucket_queue.for_each([&](const BucketQueueEntry& entry) { copy.insert(entry); });
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy.top(), 0);
+    copy.pop();
+    EXPECT_EQ(copy.top(), 2);
+
+    bucket_queue.insert(BucketQueueEntry { 0.5, 3 });
+    EXPECT_TRUE(bucket_queue.uses_fallback());
+    auto items = std::vector<int> {};
+    bucket_queue.for_each([&](const BucketQueueEntry& entry) { items.push_back(entry.get_item()); });
+    std::sort(items.begin(), items.end());
+    EXPECT_EQ(items, (std::vector<int> { 0, 2, 3 }));
+}
+
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/openlists.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+
+namespace mimir::tests
+{
+
+struct RadixHeapQueueEntry
+{
+    using KeyType = std::pair<double, int>;
+    using ItemType = int;
+
+    double k;
+    int v;
+
+    KeyType get_key() const { return std::make_pair(k, v); }
+    ItemType get_item() const { return v; }
+    double get_bucket() const { return k; }
+};
+
+TEST(MimirTests, SearchOpenListsRadixHeapTest)
+{
+    auto radix_heap = RadixHeapOpenList<RadixHeapQueueEntry>();
+    radix_heap.insert(RadixHeapQueueEntry { 5., 0 });
+    radix_heap.insert(RadixHeapQueueEntry { 1000., 1 });
+    radix_heap.insert(RadixHeapQueueEntry { 3., 2 });
+
+    EXPECT_EQ(radix_heap.top(), 2);
+    radix_heap.pop();
+
+    /* Insert keys that are not smaller than the last removed key. */
+    radix_heap.insert(RadixHeapQueueEntry { 3., 3 });
+    radix_heap.insert(RadixHeapQueueEntry { 4., 4 });
+    EXPECT_FALSE(radix_heap.uses_fallback());
+
+    EXPECT_EQ(radix_heap.top(), 3);
+    radix_heap.pop();
+    EXPECT_EQ(radix_heap.top(), 4);
+    radix_heap.pop();
+    EXPECT_EQ(radix_heap.top(), 0);
+    radix_heap.pop();
+    EXPECT_EQ(radix_heap.top(), 1);
+    radix_heap.pop();
+    EXPECT_TRUE(radix_heap.empty());
+    EXPECT_FALSE(radix_heap.uses_fallback());
+}
+
+TEST(MimirTests, SearchOpenListsRadixHeapFallbackTest)
+{
+    auto radix_heap = RadixHeapOpenList<RadixHeapQueueEntry>();
+    radix_heap.insert(RadixHeapQueueEntry { 5., 0 });
+    radix_heap.insert(RadixHeapQueueEntry { 7., 1 });
+    EXPECT_EQ(radix_heap.top(), 0);
+    radix_heap.pop();
+
+    /* The key is smaller than the last removed key. */
+    radix_heap.insert(RadixHeapQueueEntry { 4., 2 });
+    EXPECT_TRUE(radix_heap.uses_fallback());
+    radix_heap.insert(RadixHeapQueueEntry { 4.5, 3 });
+
+    EXPECT_EQ(radix_heap.top(), 2);
+    radix_heap.pop();
+    EXPECT_EQ(radix_heap.top(), 3);
+    radix_heap.pop();
+    EXPECT_EQ(radix_heap.top(), 1);
+    radix_heap.pop();
+    EXPECT_TRUE(radix_heap.empty());
+}
+
+TEST(MimirTests, SearchOpenListsRadixHeapEqualBucketKeysTest)
+{
+    auto radix_heap = RadixHeapOpenList<RadixHeapQueueEntry>();
+    radix_heap.insert(RadixHeapQueueEntry { 3., 5 });
+    radix_heap.insert(RadixHeapQueueEntry { 3., 1 });
+    radix_heap.insert(RadixHeapQueueEntry { 6., 0 });
+    radix_heap.insert(RadixHeapQueueEntry { 3., 4 });
+
+    /* Entries with the same bucket key are removed in the order of their keys. */
+    EXPECT_EQ(radix_heap.top(), 1);
+    radix_heap.pop();
+
+    /* An entry with the last removed bucket key but a smaller key is still accepted and removed first. */
+    radix_heap.insert(RadixHeapQueueEntry { 3., 2 });
+    EXPECT_FALSE(radix_heap.uses_fallback());
+
+    EXPECT_EQ(radix_heap.top(), 2);
+    radix_heap.pop();
+    EXPECT_EQ(radix_heap.top(), 4);
+    radix_heap.pop();
+    EXPECT_EQ(radix_heap.top(), 5);
+    radix_heap.pop();
+    EXPECT_EQ(radix_heap.top(), 0);
+    radix_heap.pop();
+    EXPECT_TRUE(radix_heap.empty());
+    EXPECT_FALSE(radix_heap.uses_fallback());
+}
+
+}
@@ -24,4 +24,38 @@ using namespace mimir::search;
 namespace mimir::tests
 {
 
+struct TestSearchNode
+{
+    static constexpr Index UNKNOWN_PARENT_ACTION = get_unknown_parent_action<29>();
+
+    ContinuousCost g_value;
+    Index parent_state;
+    Index parent_action : 29;
+    Index status : 3;
+
+    SearchNodeStatus get_status() const { return static_cast<SearchNodeStatus>(status); }
+    void set_status(SearchNodeStatus value) { status = value; }
+};
+
+static_assert(sizeof(TestSearchNode) == 16);
+static_assert(IsSearchNodeWithParentAction<TestSearchNode>);
+
+TEST(MimirTests, SearchSearchNodeParentActionTest)
+{
+    auto search_node = TestSearchNode { 0., MAX_INDEX, TestSearchNode::UNKNOWN_PARENT_ACTION, SearchNodeStatus::NEW };
+    EXPECT_EQ(search_node.parent_action, TestSearchNode::UNKNOWN_PARENT_ACTION);
+
+    set_parent_action(search_node, 42);
+    EXPECT_EQ(search_node.parent_action, 42);
+    EXPECT_EQ(search_node.get_status(), SearchNodeStatus::NEW);
+
+    search_node.set_status(SearchNodeStatus::CLOSED);
+    EXPECT_EQ(search_node.parent_action, 42);
+
+    // Indices that do not fit into the bitfield are recorded as unknown.
+    set_parent_action(search_node, Index(1) << 29);
+    EXPECT_EQ(search_node.parent_action, TestSearchNode::UNKNOWN_PARENT_ACTION);
+    EXPECT_EQ(search_node.get_status(), SearchNodeStatus::CLOSED);
+}
+
 }
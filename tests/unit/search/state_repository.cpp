@@ -23,7 +23,9 @@
 #include "mimir/search/axiom_evaluators.hpp"
 #include "mimir/search/search_context.hpp"
 
+#include <deque>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace mimir::search;
 using namespace mimir::formalism;
@@ -53,4 +55,275 @@ TEST(MimirTests, SearchStateRepositoryImplTest)
     }
 }
 
+TEST(MimirTests, SearchStateRepositoryImplThreadSafeTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl");
+
+    auto search_context =
+        SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto options = StateRepositoryImpl::Options();
+    options.thread_safe = true;
+    options.num_shards = 4;
+    auto state_repository = StateRepositoryImpl::create(search_context->get_state_repository()->get_axiom_evaluator(), options);
+    auto [initial_state, initial_state_metric_value] = state_repository->get_or_create_initial_state();
+
+    auto applicable_actions = GroundActionList {};
+    for (const auto& action : applicable_action_generator.create_applicable_action_generator(initial_state))
+    {
+        applicable_actions.push_back(action);
+    }
+
+    // All threads generate the same successors concurrently and release their contexts on exit.
+    const size_t num_threads = 4;
+    auto successor_indices = std::vector<IndexList>(num_threads);
+    const auto run_threads = [&]()
+    {
+        auto threads = std::vector<std::thread> {};
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            threads.emplace_back(
+                [&, i]()
+                {
+                    successor_indices[i].clear();
+                    for (const auto& action : applicable_actions)
+                    {
+                        const auto [successor_state, successor_state_metric_value] =
+                            state_repository->get_or_create_successor_state(initial_state, action, initial_state_metric_value);
+                        successor_indices[i].push_back(successor_state.get_index());
+                    }
+                    state_repository->release_thread_context();
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    run_threads();
+    const auto num_reached_fluent_atoms = state_repository->get_reached_fluent_ground_atoms_bitset().count();
+    const auto num_bytes = state_repository->get_estimated_memory_usage_in_bytes();
+
+    // Released contexts do not accumulate over repeated runs, and their reached atoms are retained.
+    run_threads();
+    EXPECT_EQ(state_repository->get_estimated_memory_usage_in_bytes(), num_bytes);
+    EXPECT_EQ(state_repository->get_reached_fluent_ground_atoms_bitset().count(), num_reached_fluent_atoms);
+    EXPECT_GT(num_reached_fluent_atoms, 0);
+
+    // Every thread observes the same dense indices.
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        EXPECT_EQ(successor_indices[i], successor_indices[0]);
+    }
+    for (const auto index : successor_indices[0])
+    {
+        EXPECT_LT(index, state_repository->get_state_count());
+    }
+    auto num_states = size_t(0);
+    for (const auto& states : state_repository->get_states())
+    {
+        num_states += states.size();
+    }
+    EXPECT_EQ(num_states, state_repository->get_state_count());
+}
+
+TEST(MimirTests, SearchStateRepositoryImplUnpackedStateCacheTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl");
+
+    auto search_context =
+        SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+    auto options = StateRepositoryImpl::Options();
+    options.unpacked_state_cache_size = 1;
+    auto state_repository = StateRepositoryImpl::create(search_context->get_state_repository()->get_axiom_evaluator(), options);
+    auto [initial_state, initial_state_metric_value] = state_repository->get_or_create_initial_state();
+
+    // The initial state was cached on creation.
+    const auto state = state_repository->get_state(*initial_state.get_packed_state());
+    EXPECT_EQ(state, initial_state);
+    EXPECT_EQ(state.get_atoms<FluentTag>(), initial_state.get_atoms<FluentTag>());
+
+    auto statistics = state_repository->get_unpacked_state_cache_statistics();
+    EXPECT_EQ(statistics.num_hits, 1);
+    EXPECT_EQ(statistics.num_misses, 0);
+    EXPECT_EQ(statistics.num_entries, 1);
+    EXPECT_GT(statistics.num_bytes, 0);
+
+    // Creating the successors evicts the initial state from the cache of size 1.
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    for (const auto& action : applicable_action_generator.create_applicable_action_generator(initial_state))
+    {
+        [[maybe_unused]] const auto [successor_state, successor_state_metric_value] =
+            state_repository->get_or_create_successor_state(initial_state, action, initial_state_metric_value);
+    }
+    const auto unpacked_state = state_repository->get_state(*initial_state.get_packed_state());
+    EXPECT_EQ(unpacked_state.get_atoms<FluentTag>(), initial_state.get_atoms<FluentTag>());
+    EXPECT_EQ(unpacked_state.get_numeric_variables(), initial_state.get_numeric_variables());
+
+    statistics = state_repository->get_unpacked_state_cache_statistics();
+    EXPECT_EQ(statistics.num_hits, 1);
+    EXPECT_EQ(statistics.num_misses, 1);
+    EXPECT_EQ(statistics.num_entries, 1);
+}
+
+TEST(MimirTests, SearchStateRepositoryImplSuccessorUnpackTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl");
+
+    auto search_context =
+        SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto options = StateRepositoryImpl::Options();
+    options.unpacked_state_cache_size = 0;
+    auto state_repository = StateRepositoryImpl::create(search_context->get_state_repository()->get_axiom_evaluator(), options);
+    auto [initial_state, initial_state_metric_value] = state_repository->get_or_create_initial_state();
+
+    auto successor_states = StateList {};
+    for (const auto& action : applicable_action_generator.create_applicable_action_generator(initial_state))
+    {
+        const auto [successor_state, successor_state_metric_value] =
+            state_repository->get_or_create_successor_state(initial_state, action, initial_state_metric_value);
+        EXPECT_EQ(successor_state_metric_value, initial_state_metric_value + 1);
+        EXPECT_NE(successor_state, initial_state);
+        successor_states.push_back(successor_state);
+    }
+
+    // The packed successors built from the delete and add lists decompress to the same dense successors.
+    for (const auto& successor_state : successor_states)
+    {
+        const auto unpacked_state = state_repository->get_state(*successor_state.get_packed_state());
+        EXPECT_EQ(unpacked_state.get_index(), successor_state.get_index());
+        EXPECT_EQ(unpacked_state.get_atoms<FluentTag>(), successor_state.get_atoms<FluentTag>());
+        EXPECT_EQ(unpacked_state.get_atoms<DerivedTag>(), successor_state.get_atoms<DerivedTag>());
+        EXPECT_EQ(unpacked_state.get_numeric_variables(), successor_state.get_numeric_variables());
+    }
+}
+
+TEST(MimirTests, SearchStateRepositoryImplSerializationTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl");
+    const auto file = fs::temp_directory_path() / "mimir_state_repository_serialization_test.bin";
+
+    auto states = StateList {};
+    {
+        auto search_context =
+            SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+
+        auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+        auto& state_repository = *search_context->get_state_repository();
+        auto [initial_state, initial_state_metric_value] = state_repository.get_or_create_initial_state();
+        states.push_back(initial_state);
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(initial_state))
+        {
+            states.push_back(state_repository.get_or_create_successor_state(initial_state, action, initial_state_metric_value).first);
+        }
+
+        state_repository.serialize(file);
+    }
+
+    // Parse the problem again such that the ground atom indices may differ.
+    auto search_context =
+        SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    auto& state_repository = *search_context->get_state_repository();
+    const auto packed_states = state_repository.deserialize(file);
+    fs::remove(file);
+
+    ASSERT_EQ(packed_states.size(), states.size());
+    EXPECT_EQ(state_repository.get_state_count(), states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        const auto state = state_repository.get_state(*packed_states[i]);
+        EXPECT_EQ(state.get_index(), states[i].get_index());
+        EXPECT_EQ(state.get_atoms<FluentTag>().size(), states[i].get_atoms<FluentTag>().size());
+        EXPECT_EQ(state.get_numeric_variables(), states[i].get_numeric_variables());
+    }
+
+    // The loaded initial state is found again.
+    EXPECT_EQ(state_repository.get_or_create_initial_state().first.get_index(), states.front().get_index());
+}
+
+
+/// @brief Explore the reachable states with `expand` and with successive calls to `get_or_create_successor_state` in two fresh repositories.
+static void test_expand_matches_successive_successors(const std::string& domain_name, SearchContextImpl::Options options)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + domain_name + "/test_problem.pddl");
+
+    auto search_context = SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), options);
+
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    const auto& axiom_evaluator = search_context->get_state_repository()->get_axiom_evaluator();
+    auto batched_state_repository = StateRepositoryImpl::create(axiom_evaluator);
+    auto sequential_state_repository = StateRepositoryImpl::create(axiom_evaluator);
+
+    auto successors = SuccessorBatch();
+    auto applicable_actions = GroundActionList {};
+    auto queue = std::deque<std::pair<State, State>> {};
+
+    const auto [batched_initial_state, batched_initial_state_metric_value] = batched_state_repository->get_or_create_initial_state();
+    const auto [sequential_initial_state, sequential_initial_state_metric_value] = sequential_state_repository->get_or_create_initial_state();
+    queue.emplace_back(batched_initial_state, sequential_initial_state);
+
+    while (!queue.empty())
+    {
+        const auto [batched_state, sequential_state] = queue.front();
+        queue.pop_front();
+
+        batched_state_repository->expand(batched_state, 0., applicable_action_generator, successors);
+
+        applicable_actions.clear();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(sequential_state))
+        {
+            applicable_actions.push_back(action);
+        }
+
+        ASSERT_EQ(successors.size(), applicable_actions.size());
+        for (size_t i = 0; i < applicable_actions.size(); ++i)
+        {
+            const auto num_states = sequential_state_repository->get_state_count();
+            const auto [successor_state, successor_state_metric_value] =
+                sequential_state_repository->get_or_create_successor_state(sequential_state, applicable_actions[i], 0.);
+
+            EXPECT_EQ(successors[i].action, applicable_actions[i]);
+            EXPECT_EQ(successors[i].state.get_index(), successor_state.get_index());
+            EXPECT_EQ(successors[i].state_metric_value, successor_state_metric_value);
+            EXPECT_EQ(successors[i].state.get_atoms<FluentTag>(), successor_state.get_atoms<FluentTag>());
+            EXPECT_EQ(successors[i].state.get_atoms<DerivedTag>(), successor_state.get_atoms<DerivedTag>());
+            EXPECT_EQ(successors[i].state.get_numeric_variables(), successor_state.get_numeric_variables());
+
+            // Derived atoms of successors are recorded as reached derived atoms.
+            const auto& successor_derived_atoms = successor_state.get_atoms<DerivedTag>();
+            const auto& reached_derived_atoms = sequential_state_repository->get_reached_derived_ground_atoms_bitset();
+            for (size_t index = 0; index < successor_derived_atoms.size(); ++index)
+            {
+                EXPECT_TRUE(!successor_derived_atoms.get(index) || (index < reached_derived_atoms.size() && reached_derived_atoms.get(index)));
+            }
+
+            if (sequential_state_repository->get_state_count() > num_states)
+            {
+                queue.emplace_back(successors[i].state, successor_state);
+            }
+        }
+        EXPECT_EQ(batched_state_repository->get_state_count(), sequential_state_repository->get_state_count());
+    }
+}
+
+TEST(MimirTests, SearchStateRepositoryImplExpandTest)
+{
+    test_expand_matches_successive_successors("gripper", SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+    test_expand_matches_successive_successors("gripper", SearchContextImpl::Options(SearchContextImpl::GroundedOptions()));
+    // Derived atoms
+    test_expand_matches_successive_successors("philosophers", SearchContextImpl::Options(SearchContextImpl::GroundedOptions()));
+    // Numeric variables and metric
+    test_expand_matches_successive_successors("fo-counters", SearchContextImpl::Options(SearchContextImpl::LiftedOptions()));
+}
+
 }